@@ -5,11 +5,14 @@ from clp_ffi_py.ir.readers import *
 from typing import List
 
 __all__: List[str] = [
+    "AsyncClpIrStreamWriter",  # native
+    "ClpIrStreamWriter",  # native
     "Decoder",  # native
     "DecoderBuffer",  # native
     "FourByteEncoder",  # native
     "IncompleteStreamError",  # native
     "LogEvent",  # native
+    "LogEventIterator",  # native
     "Metadata",  # native
     "Query",  # native
     "QueryBuilder",  # query_builder
@@ -1,11 +1,22 @@
 from datetime import tzinfo
-from typing import Any, Dict, IO, List, Optional, Union
+from mmap import mmap
+from types import TracebackType
+from typing import Any, Dict, IO, Iterator, List, Optional, Sequence, Type, Union
 
+from clp_ffi_py.query_expression import QueryExpression, QueryOperand
+from clp_ffi_py.regex_query import RegexQuery
 from clp_ffi_py.wildcard_query import WildcardQuery
 
 class DecoderBuffer:
-    def __init__(self, input_stream: IO[bytes], initial_buffer_capacity: int = 4096): ...
+    def __init__(
+        self,
+        input_stream: IO[bytes],
+        initial_buffer_capacity: int = 4096,
+        trusted_stream: bool = False,
+        message_intern_cache_capacity: int = 0,
+    ): ...
     def get_num_decoded_log_messages(self) -> int: ...
+    def get_message_intern_cache_stats(self) -> Dict[str, int]: ...
     def _test_streaming(self, seed: int) -> bytearray: ...
 
 class Metadata:
@@ -17,6 +28,10 @@ class Metadata:
     def get_timezone(self) -> tzinfo: ...
 
 class LogEvent:
+    @staticmethod
+    def set_free_list_capacity(capacity: int) -> None: ...
+    @staticmethod
+    def get_free_list_stats() -> Dict[str, int]: ...
     def __init__(
         self,
         log_message: str,
@@ -33,7 +48,7 @@ class LogEvent:
     def get_index(self) -> int: ...
     def get_attributes(self) -> Dict[str, Optional[Union[str, int]]]: ...
     def get_formatted_message(self, timezone: Optional[tzinfo] = None) -> str: ...
-    def get_cached_encoded_log_event(self) -> Optional[bytearray]: ...
+    def get_cached_encoded_log_event(self) -> Optional[memoryview]: ...
     def match_query(self, query: Query) -> bool: ...
 
 class Query:
@@ -50,6 +65,8 @@ class Query:
         wildcard_queries: Optional[List[WildcardQuery]] = None,
         attribute_queries: Optional[Dict[str, Union[str, int]]] = None,
         search_time_termination_margin: int = default_search_time_termination_margin(),
+        regex_queries: Optional[List[RegexQuery]] = None,
+        expression: Optional[QueryOperand] = None,
     ): ...
     def __str__(self) -> str: ...
     def __repr__(self) -> str: ...
@@ -60,6 +77,10 @@ class Query:
     def get_search_time_termination_margin(self) -> int: ...
     def get_wildcard_queries(self) -> Optional[List[WildcardQuery]]: ...
     def get_attribute_queries(self) -> Optional[Dict[str, Union[str, int]]]: ...
+    def get_regex_queries(self) -> Optional[List[RegexQuery]]: ...
+    def get_expression(self) -> Optional[QueryOperand]: ...
+    def get_predicate_stats(self) -> List[Dict[str, Union[str, int, float]]]: ...
+    def reset_predicate_stats(self) -> None: ...
     def match_log_event(self, log_event: LogEvent) -> bool: ...
 
 class FourByteEncoder:
@@ -70,14 +91,113 @@ class FourByteEncoder:
         ref_timestamp: int, timestamp_format: str, timezone: str
     ) -> bytearray: ...
     @staticmethod
+    def encode_preamble_with_attributes(
+        ref_timestamp: int,
+        timestamp_format: str,
+        timezone: str,
+        attribute_table: Dict[str, Union[Type[str], Type[int]]],
+    ) -> bytearray: ...
+    @staticmethod
+    def encode_attributes(attributes: Sequence[Optional[Union[str, int]]]) -> bytearray: ...
+    @staticmethod
     def encode_message_and_timestamp_delta(timestamp_delta: int, msg: bytes) -> bytearray: ...
     @staticmethod
     def encode_message(msg: bytes) -> bytearray: ...
+    # Test-only helpers, not part of the public API.
+    @staticmethod
+    def _encode_message_with_clp_tokenizer(msg: bytes) -> bytearray: ...
+    @staticmethod
+    def _set_vectorized_tokenizer_enabled(enabled: bool) -> None: ...
     @staticmethod
     def encode_timestamp_delta(timestamp_delta: int) -> bytearray: ...
     @staticmethod
+    def encode_batch(
+        timestamps: Sequence[int],
+        messages: Union[Sequence[bytes], bytes, bytearray, memoryview],
+        ref_timestamp: int,
+        offsets: Optional[Sequence[int]] = None,
+        num_threads: int = 1,
+    ) -> bytearray: ...
+    @staticmethod
+    def encode_into(
+        buffer: Union[bytearray, memoryview, mmap],
+        offset: int,
+        msg: bytes,
+        timestamp_delta: Optional[int] = None,
+    ) -> int: ...
+    @staticmethod
+    def encode_batch_into(
+        buffer: Union[bytearray, memoryview, mmap],
+        offset: int,
+        timestamps: Sequence[int],
+        messages: Union[Sequence[bytes], bytes, bytearray, memoryview],
+        ref_timestamp: int,
+        offsets: Optional[Sequence[int]] = None,
+        num_threads: int = 1,
+    ) -> int: ...
+    @staticmethod
     def encode_end_of_ir() -> bytearray: ...
 
+class ClpIrStreamWriter:
+    def __init__(
+        self,
+        sink: Union[int, IO[bytes]],
+        ref_timestamp: int,
+        timestamp_format: str,
+        timezone: str,
+        enable_compression: bool = True,
+        compression_level: int = 3,
+        flush_threshold: int = 65536,
+        logtype_cache_capacity: int = 0,
+        attribute_table: Optional[Dict[str, Union[Type[str], Type[int]]]] = None,
+    ): ...
+    def __enter__(self) -> ClpIrStreamWriter: ...
+    def __exit__(
+        self,
+        exc_type: Optional[Type[BaseException]],
+        exc_value: Optional[BaseException],
+        traceback: Optional[TracebackType],
+    ) -> bool: ...
+    def write_log_event(
+        self,
+        timestamp: int,
+        log_message: Union[str, bytes],
+        attributes: Optional[Dict[str, Optional[Union[str, int]]]] = None,
+    ) -> None: ...
+    def flush(self) -> None: ...
+    def close(self) -> None: ...
+    def get_num_log_events(self) -> int: ...
+    def get_logtype_cache_stats(self) -> Dict[str, int]: ...
+
+class AsyncClpIrStreamWriter:
+    def __init__(
+        self,
+        sink: Union[int, IO[bytes]],
+        ref_timestamp: int,
+        timestamp_format: str,
+        timezone: str,
+        enable_compression: bool = True,
+        compression_level: int = 3,
+        queue_capacity: int = 65536,
+        flush_interval_ms: int = 1000,
+        flush_threshold: int = 65536,
+        overflow_policy: str = "block",
+        logtype_cache_capacity: int = 0,
+    ): ...
+    def __enter__(self) -> AsyncClpIrStreamWriter: ...
+    def __exit__(
+        self,
+        exc_type: Optional[Type[BaseException]],
+        exc_value: Optional[BaseException],
+        traceback: Optional[TracebackType],
+    ) -> bool: ...
+    def write_log_event(self, timestamp: int, log_message: Union[str, bytes]) -> bool: ...
+    def flush(self) -> None: ...
+    def close(self) -> None: ...
+    def get_num_log_events(self) -> int: ...
+    def get_num_dropped_log_events(self) -> int: ...
+    def get_logtype_cache_stats(self) -> Dict[str, int]: ...
+
 class Decoder:
     @staticmethod
     def decode_preamble(decoder_buffer: DecoderBuffer) -> Metadata: ...
@@ -88,5 +208,24 @@ class Decoder:
         allow_incomplete_stream: bool = False,
         cache_encoded_log_event: bool = False,
     ) -> Optional[LogEvent]: ...
+    @staticmethod
+    def export_log_events(
+        decoder_buffer: DecoderBuffer,
+        sink: Union[int, IO[bytes]],
+        format: str = "text",
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+    ) -> int: ...
+
+class LogEventIterator(Iterator[LogEvent]):
+    def __init__(
+        self,
+        decoder_buffer: DecoderBuffer,
+        query: Optional[Query] = None,
+        allow_incomplete_stream: bool = False,
+        cache_encoded_log_event: bool = False,
+    ): ...
+    def __iter__(self) -> LogEventIterator: ...
+    def __next__(self) -> LogEvent: ...
 
 class IncompleteStreamError(Exception): ...
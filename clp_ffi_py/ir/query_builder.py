@@ -4,6 +4,8 @@ from copy import deepcopy
 from typing import Dict, List, Optional, Union
 
 from clp_ffi_py.ir.native import Query
+from clp_ffi_py.query_expression import QueryOperand
+from clp_ffi_py.regex_query import RegexQuery
 from clp_ffi_py.wildcard_query import WildcardQuery
 
 
@@ -22,8 +24,10 @@ class QueryBuilder:
     configuring and resetting search parameters.
 
     For more details about the search query CLP IR stream supports, see
-    :class:`~clp_ffi_py.ir.native.Query` and
-    :class:`~clp_ffi_py.wildcard_query.WildcardQuery`.
+    :class:`~clp_ffi_py.ir.native.Query`,
+    :class:`~clp_ffi_py.wildcard_query.WildcardQuery`,
+    :class:`~clp_ffi_py.regex_query.RegexQuery`, and
+    :class:`~clp_ffi_py.query_expression.QueryExpression`.
     """
 
     def __init__(self) -> None:
@@ -32,6 +36,8 @@ class QueryBuilder:
         self._search_time_termination_margin: int = Query.default_search_time_termination_margin()
         self._wildcard_queries: List[WildcardQuery] = []
         self._attribute_queries: Dict[str, Union[str, int]] = {}
+        self._regex_queries: List[RegexQuery] = []
+        self._expression: Optional[QueryOperand] = None
 
     @property
     def search_time_lower_bound(self) -> int:
@@ -59,6 +65,17 @@ class QueryBuilder:
         """
         return deepcopy(self._attribute_queries)
 
+    @property
+    def regex_queries(self) -> List[RegexQuery]:
+        """
+        :return: A deep copy of the underlying regex query list.
+        """
+        return deepcopy(self._regex_queries)
+
+    @property
+    def expression(self) -> Optional[QueryOperand]:
+        return self._expression
+
     def set_search_time_lower_bound(self, ts: int) -> QueryBuilder:
         """
         :param ts: Start of the search time range (inclusive) as a UNIX epoch
@@ -120,6 +137,40 @@ class QueryBuilder:
         self._attribute_queries[attr_name] = attr_val
         return self
 
+    def add_regex_query(self, regex_query: str, case_sensitive: bool = False) -> QueryBuilder:
+        """
+        Constructs and adds a :class:`~clp_ffi_py.regex_query.RegexQuery` to
+        the regex query list.
+
+        :param regex_query: The regular expression to add.
+        :param case_sensitive: Whether to perform case-sensitive matching.
+        :return: self.
+        """
+        self._regex_queries.append(RegexQuery(regex_query, case_sensitive))
+        return self
+
+    def add_regex_queries(self, regex_queries: List[RegexQuery]) -> QueryBuilder:
+        """
+        Adds a list of regex queries to the regex query list.
+
+        :param regex_queries: The list of regex queries to add.
+        :return: self.
+        """
+        self._regex_queries.extend(regex_queries)
+        return self
+
+    def set_expression(self, expression: QueryOperand) -> QueryBuilder:
+        """
+        Sets the boolean query expression. A log event must match the
+        expression in addition to the other criteria of the query.
+
+        :param expression: The query expression (see
+            :class:`~clp_ffi_py.query_expression.QueryExpression`).
+        :return: self.
+        """
+        self._expression = expression
+        return self
+
     def reset_search_time_lower_bound(self) -> QueryBuilder:
         """
         Resets the search time lower bound to the default value.
@@ -165,6 +216,24 @@ class QueryBuilder:
         self._attribute_queries.clear()
         return self
 
+    def reset_regex_queries(self) -> QueryBuilder:
+        """
+        Clears the regex query list.
+
+        :return: self.
+        """
+        self._regex_queries.clear()
+        return self
+
+    def reset_expression(self) -> QueryBuilder:
+        """
+        Clears the query expression.
+
+        :return: self.
+        """
+        self._expression = None
+        return self
+
     def reset(self) -> QueryBuilder:
         """
         Resets all settings to their defaults.
@@ -174,6 +243,8 @@ class QueryBuilder:
         return (
             self.reset_wildcard_queries()
             .reset_attribute_queries()
+            .reset_regex_queries()
+            .reset_expression()
             .reset_search_time_termination_margin()
             .reset_search_time_upper_bound()
             .reset_search_time_lower_bound()
@@ -194,12 +265,17 @@ class QueryBuilder:
         attribute_queries: Optional[Dict[str, Union[str, int]]] = None
         if 0 != len(self._wildcard_queries):
             wildcard_queries = self._wildcard_queries
+        regex_queries: Optional[List[RegexQuery]] = None
         if 0 != len(self._attribute_queries):
             attribute_queries = self._attribute_queries
+        if 0 != len(self._regex_queries):
+            regex_queries = self._regex_queries
         return Query(
             search_time_lower_bound=self._search_time_lower_bound,
             search_time_upper_bound=self._search_time_upper_bound,
             search_time_termination_margin=self._search_time_termination_margin,
             wildcard_queries=wildcard_queries,
             attribute_queries=attribute_queries,
+            regex_queries=regex_queries,
+            expression=self._expression,
         )
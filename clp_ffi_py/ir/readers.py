@@ -1,21 +1,33 @@
 from __future__ import annotations
 
+import codecs
 from pathlib import Path
 from sys import stderr
 from types import TracebackType
-from typing import Generator, IO, Iterator, Optional, Type, Union
+from typing import IO, Iterable, Optional, Type, Union
 
 from zstandard import ZstdDecompressionReader, ZstdDecompressor
 
-from clp_ffi_py.ir.native import Decoder, DecoderBuffer, LogEvent, Metadata, Query
+from clp_ffi_py.ir.native import (
+    Decoder,
+    DecoderBuffer,
+    LogEvent,
+    LogEventIterator,
+    Metadata,
+    Query,
+)
 
 
-class ClpIrStreamReader(Iterator[LogEvent]):
+class ClpIrStreamReader(Iterable[LogEvent]):
     """
     This class represents a stream reader used to read/decode encoded log events
     from a CLP IR stream. It also provides method(s) to instantiate a log event
     generator with a customized search query.
 
+    The reader is iterable: each call to `iter` returns a native iterator over
+    the log events that haven't been read yet, so iterators created one after
+    another continue from where the previous one stopped.
+
     :param istream: Input stream that contains encoded CLP IR.
     :param decoder_buffer_size: Initial size of the decoder buffer.
     :param enable_compression: A flag indicating whether the istream is
@@ -25,6 +37,12 @@ class ClpIrStreamReader(Iterator[LogEvent]):
         is seen as reaching its end without raising any exceptions.
     :param cache_encoded_log_event: If set to `True`, the encoded log event with
         all the attributes, encoded variables, and logtype will be cached.
+    :param trusted_stream: If set to `True`, the IR stream is trusted to be
+        produced by a valid CLP IR encoder, and the decoded attributes of each
+        log event are not validated against the metadata.
+    :param message_intern_cache_capacity: If positive, log events with identical
+        messages share the same message string, as long as they are found in a
+        cache with the given number of entries.
     """
 
     DEFAULT_DECODER_BUFFER_SIZE: int = 65536
@@ -36,6 +54,8 @@ class ClpIrStreamReader(Iterator[LogEvent]):
         enable_compression: bool = True,
         allow_incomplete_stream: bool = False,
         cache_encoded_log_event: bool = False,
+        trusted_stream: bool = False,
+        message_intern_cache_capacity: int = 0,
     ):
         self.__istream: Union[IO[bytes], ZstdDecompressionReader]
         if enable_compression:
@@ -43,7 +63,12 @@ class ClpIrStreamReader(Iterator[LogEvent]):
             self.__istream = dctx.stream_reader(istream, read_across_frames=True)
         else:
             self.__istream = istream
-        self._decoder_buffer: DecoderBuffer = DecoderBuffer(self.__istream, decoder_buffer_size)
+        self._decoder_buffer: DecoderBuffer = DecoderBuffer(
+            self.__istream,
+            decoder_buffer_size,
+            trusted_stream=trusted_stream,
+            message_intern_cache_capacity=message_intern_cache_capacity,
+        )
         self._metadata: Optional[Metadata] = None
         self._allow_incomplete_stream: bool = allow_incomplete_stream
         self._cache_encoded_log_event: bool = cache_encoded_log_event
@@ -87,47 +112,73 @@ class ClpIrStreamReader(Iterator[LogEvent]):
     def has_metadata(self) -> bool:
         return None is not self._metadata
 
-    def search(self, query: Query) -> Generator[LogEvent, None, None]:
+    def search(self, query: Query) -> LogEventIterator:
         """
         Searches and yields log events that match a specific search query.
 
         :param query: The input query object used to match log events. Check the
             document of :class:`~clp_ffi_py.ir.Query` for more details.
-        :yield: The next unread encoded log event that matches the given search
-            query from the IR stream.
+        :return: A native iterator that yields the next unread encoded log event
+            that matches the given search query from the IR stream.
         """
         if False is self.has_metadata():
             self.read_preamble()
-        while True:
-            log_event: Optional[LogEvent] = Decoder.decode_next_log_event(
-                self._decoder_buffer,
-                query=query,
-                allow_incomplete_stream=self._allow_incomplete_stream,
-                cache_encoded_log_event=self._cache_encoded_log_event,
-            )
-            if None is log_event:
-                break
-            yield log_event
+        return LogEventIterator(
+            self._decoder_buffer,
+            query=query,
+            allow_incomplete_stream=self._allow_incomplete_stream,
+            cache_encoded_log_event=self._cache_encoded_log_event,
+        )
+
+    def export(
+        self, sink: Union[int, IO[bytes]], format: str = "text", query: Optional[Query] = None
+    ) -> int:
+        """
+        Decodes the unread log events (matching the query if given) and writes
+        them to the given sink natively in large batches.
+
+        :param sink: A file descriptor, or an object with a `write` method that
+            accepts bytes.
+        :param format: "text" to write the formatted message of each log event,
+            or "jsonl" to write each log event as a JSON object on its own line.
+            Check the document of
+            :meth:`~clp_ffi_py.ir.native.Decoder.export_log_events` for more
+            details.
+        :param query: The input query object used to filter log events.
+        :return: The number of exported log events.
+        """
+        if False is self.has_metadata():
+            self.read_preamble()
+        return Decoder.export_log_events(
+            self._decoder_buffer,
+            sink,
+            format=format,
+            query=query,
+            allow_incomplete_stream=self._allow_incomplete_stream,
+        )
 
     def close(self) -> None:
         self.__istream.close()
 
-    def __iter__(self) -> ClpIrStreamReader:
+    def __iter__(self) -> LogEventIterator:
+        """
+        :return: A native iterator that yields the unread log events from the
+            IR stream. Iterating through it is equivalent to, but faster than,
+            repeatedly calling :meth:`read_next_log_event`.
+        """
         if False is self.has_metadata():
             self.read_preamble()
-        return self
+        return LogEventIterator(
+            self._decoder_buffer,
+            allow_incomplete_stream=self._allow_incomplete_stream,
+            cache_encoded_log_event=self._cache_encoded_log_event,
+        )
 
     def __enter__(self) -> ClpIrStreamReader:
         if False is self.has_metadata():
             self.read_preamble()
         return self
 
-    def __next__(self) -> LogEvent:
-        next_log_event: Optional[LogEvent] = self.read_next_log_event()
-        if None is next_log_event:
-            raise StopIteration
-        return next_log_event
-
     def __exit__(
         self,
         exc_type: Optional[Type[BaseException]],
@@ -149,6 +200,8 @@ class ClpIrFileReader(ClpIrStreamReader):
         enable_compression: bool = True,
         allow_incomplete_stream: bool = False,
         cache_encoded_log_event: bool = False,
+        trusted_stream: bool = False,
+        message_intern_cache_capacity: int = 0,
     ):
         self._path: Path = fpath
         super().__init__(
@@ -157,8 +210,24 @@ class ClpIrFileReader(ClpIrStreamReader):
             enable_compression=enable_compression,
             allow_incomplete_stream=allow_incomplete_stream,
             cache_encoded_log_event=cache_encoded_log_event,
+            trusted_stream=trusted_stream,
+            message_intern_cache_capacity=message_intern_cache_capacity,
         )
 
     def dump(self, ostream: IO[str] = stderr) -> None:
-        for log_event in self:
-            ostream.write(str(log_event))
+        """
+        Writes the formatted messages of the unread log events to `ostream`. If
+        `ostream` is backed by a binary buffer in UTF-8, the log events are
+        exported to the buffer natively (see :meth:`export`).
+
+        :param ostream: The output text stream.
+        """
+        buffer: Optional[IO[bytes]] = getattr(ostream, "buffer", None)
+        encoding: Optional[str] = getattr(ostream, "encoding", None)
+        if None is buffer or None is encoding or "utf-8" != codecs.lookup(encoding).name:
+            for log_event in self:
+                ostream.write(str(log_event))
+            return
+        ostream.flush()
+        self.export(buffer)
+        buffer.flush()
@@ -0,0 +1,308 @@
+from __future__ import annotations
+
+from typing import Iterable, List, Optional, Union
+
+from clp_ffi_py.regex_query import RegexQuery
+from clp_ffi_py.wildcard_query import WildcardQuery
+
+
+class QueryExpression:
+    """
+    This class is the base class of the boolean query expressions that can be
+    attached to a :class:`~clp_ffi_py.ir.native.Query`. An expression is a tree
+    of AND, OR and NOT over the following predicates:
+
+    1. :class:`~clp_ffi_py.wildcard_query.WildcardQuery` and
+       :class:`~clp_ffi_py.regex_query.RegexQuery` on the log message.
+    2. :class:`AttributePredicate` subclasses on a log event attribute:
+       :class:`AttributeEquals`, :class:`AttributeRange`, :class:`AttributeIn`,
+       :class:`AttributePrefix`, and :class:`AttributeIsNull`.
+    3. :class:`TimeRange` on the log event timestamp.
+
+    Expressions can be combined using the operators `&` (AND), `|` (OR), and
+    `~` (NOT). The expression is compiled natively when the query is built and
+    evaluated with short-circuiting while decoding, so log events that don't
+    match are never materialized as Python objects.
+    """
+
+    def __and__(self, other: QueryOperand) -> AndExpression:
+        return AndExpression(self, other)
+
+    def __rand__(self, other: QueryOperand) -> AndExpression:
+        return AndExpression(other, self)
+
+    def __or__(self, other: QueryOperand) -> OrExpression:
+        return OrExpression(self, other)
+
+    def __ror__(self, other: QueryOperand) -> OrExpression:
+        return OrExpression(other, self)
+
+    def __invert__(self) -> NotExpression:
+        return NotExpression(self)
+
+    def __repr__(self) -> str:
+        """
+        :return: Same as `__str__` method.
+        """
+        return self.__str__()
+
+
+QueryOperand = Union[QueryExpression, WildcardQuery, RegexQuery]
+
+
+class AndExpression(QueryExpression):
+    """
+    This class defines an expression that matches if all of its operands match.
+    Operands are evaluated in order and the evaluation stops at the first
+    operand that doesn't match.
+    """
+
+    def __init__(self, *operands: QueryOperand):
+        """
+        :param operands: One or more operands.
+        :raises ValueError: If no operand is given.
+        """
+        if 0 == len(operands):
+            raise ValueError("AndExpression requires at least one operand.")
+        self._operands: List[QueryOperand] = list(operands)
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the AndExpression object.
+        """
+        return f"AndExpression({', '.join(str(operand) for operand in self._operands)})"
+
+    @property
+    def operands(self) -> List[QueryOperand]:
+        return self._operands
+
+
+class OrExpression(QueryExpression):
+    """
+    This class defines an expression that matches if any of its operands
+    matches. Operands are evaluated in order and the evaluation stops at the
+    first operand that matches.
+    """
+
+    def __init__(self, *operands: QueryOperand):
+        """
+        :param operands: One or more operands.
+        :raises ValueError: If no operand is given.
+        """
+        if 0 == len(operands):
+            raise ValueError("OrExpression requires at least one operand.")
+        self._operands: List[QueryOperand] = list(operands)
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the OrExpression object.
+        """
+        return f"OrExpression({', '.join(str(operand) for operand in self._operands)})"
+
+    @property
+    def operands(self) -> List[QueryOperand]:
+        return self._operands
+
+
+class NotExpression(QueryExpression):
+    """
+    This class defines an expression that matches if its operand doesn't match.
+    """
+
+    def __init__(self, operand: QueryOperand):
+        """
+        :param operand: The operand to negate.
+        """
+        self._operand: QueryOperand = operand
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the NotExpression object.
+        """
+        return f"NotExpression({self._operand})"
+
+    @property
+    def operand(self) -> QueryOperand:
+        return self._operand
+
+
+class AttributePredicate(QueryExpression):
+    """
+    This class is the base class of the predicates on a log event attribute.
+    Attribute predicates are evaluated natively on the decoded attribute values.
+    An attribute predicate on an attribute that doesn't exist in the log event
+    raises an exception when evaluated.
+    """
+
+    def __init__(self, name: str):
+        """
+        :param name: The name of the attribute.
+        """
+        self._name: str = name
+
+    @property
+    def name(self) -> str:
+        return self._name
+
+
+class AttributeEquals(AttributePredicate):
+    """
+    This class defines a predicate that matches if a log event attribute equals
+    to the given value. A value of None only matches null attributes.
+    """
+
+    def __init__(self, name: str, value: Optional[Union[str, int]]):
+        """
+        :param name: The name of the attribute.
+        :param value: The value to compare with.
+        """
+        super().__init__(name)
+        self._value: Optional[Union[str, int]] = value
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the AttributeEquals object.
+        """
+        return f'AttributeEquals(name="{self._name}", value={self._value!r})'
+
+    @property
+    def value(self) -> Optional[Union[str, int]]:
+        return self._value
+
+
+class AttributeRange(AttributePredicate):
+    """
+    This class defines a predicate that matches if a log event attribute is an
+    integer within the given range (inclusive). A bound of None leaves the range
+    open on that side. String and null attributes never match.
+    """
+
+    def __init__(
+        self, name: str, lower_bound: Optional[int] = None, upper_bound: Optional[int] = None
+    ):
+        """
+        :param name: The name of the attribute.
+        :param lower_bound: Start of the range (inclusive).
+        :param upper_bound: End of the range (inclusive).
+        """
+        super().__init__(name)
+        self._lower_bound: Optional[int] = lower_bound
+        self._upper_bound: Optional[int] = upper_bound
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the AttributeRange object.
+        """
+        return (
+            f'AttributeRange(name="{self._name}", lower_bound={self._lower_bound},'
+            f" upper_bound={self._upper_bound})"
+        )
+
+    @property
+    def lower_bound(self) -> Optional[int]:
+        return self._lower_bound
+
+    @property
+    def upper_bound(self) -> Optional[int]:
+        return self._upper_bound
+
+
+class AttributeIn(AttributePredicate):
+    """
+    This class defines a predicate that matches if a log event attribute equals
+    to any of the given values. The values are stored in a hash set natively, so
+    the cost of the lookup doesn't grow with the number of values. A value of
+    None matches null attributes.
+    """
+
+    def __init__(self, name: str, values: Iterable[Optional[Union[str, int]]]):
+        """
+        :param name: The name of the attribute.
+        :param values: The values to compare with.
+        """
+        super().__init__(name)
+        self._values: List[Optional[Union[str, int]]] = list(values)
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the AttributeIn object.
+        """
+        return f'AttributeIn(name="{self._name}", values={self._values!r})'
+
+    @property
+    def values(self) -> List[Optional[Union[str, int]]]:
+        return self._values
+
+
+class AttributePrefix(AttributePredicate):
+    """
+    This class defines a predicate that matches if a log event attribute is a
+    string that starts with the given prefix. Integer and null attributes never
+    match.
+    """
+
+    def __init__(self, name: str, prefix: str):
+        """
+        :param name: The name of the attribute.
+        :param prefix: The prefix to compare with.
+        """
+        super().__init__(name)
+        self._prefix: str = prefix
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the AttributePrefix object.
+        """
+        return f'AttributePrefix(name="{self._name}", prefix={self._prefix!r})'
+
+    @property
+    def prefix(self) -> str:
+        return self._prefix
+
+
+class AttributeIsNull(AttributePredicate):
+    """
+    This class defines a predicate that matches if a log event attribute is
+    null.
+    """
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the AttributeIsNull object.
+        """
+        return f'AttributeIsNull(name="{self._name}")'
+
+
+class TimeRange(QueryExpression):
+    """
+    This class defines a predicate that matches if a log event timestamp is
+    within the given range (inclusive). A bound of None leaves the range open on
+    that side.
+
+    Unlike the search time range of :class:`~clp_ffi_py.ir.native.Query`, this
+    predicate doesn't terminate the search early.
+    """
+
+    def __init__(self, lower_bound: Optional[int] = None, upper_bound: Optional[int] = None):
+        """
+        :param lower_bound: Start of the time range (inclusive) as a UNIX epoch
+            timestamp in milliseconds.
+        :param upper_bound: End of the time range (inclusive) as a UNIX epoch
+            timestamp in milliseconds.
+        """
+        self._lower_bound: Optional[int] = lower_bound
+        self._upper_bound: Optional[int] = upper_bound
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the TimeRange object.
+        """
+        return f"TimeRange(lower_bound={self._lower_bound}, upper_bound={self._upper_bound})"
+
+    @property
+    def lower_bound(self) -> Optional[int]:
+        return self._lower_bound
+
+    @property
+    def upper_bound(self) -> Optional[int]:
+        return self._upper_bound
@@ -0,0 +1,54 @@
+class RegexQuery:
+    """
+    This class defines a regex query, which includes a regular expression and a
+    boolean value to indicate if the match is case-sensitive.
+
+    A log message matches the query if any substring of the message matches the
+    regular expression, following the semantics of Python's `re.search` with
+    the `re.ASCII` flag: `\\d`, `\\w`, `\\s` and case-insensitive matching only
+    apply to ASCII characters, while `.` and negated classes match any
+    character, including non-ASCII ones. The regular expression is compiled
+    natively once the query is built, and must only contain ASCII characters.
+    The supported syntax is a subset of Python's `re` module:
+
+    1. Literals, `.`, character classes, and the escapes `\\\\d`, `\\\\w`, `\\\\s`
+       (and their negations).
+    2. Groups, non-capturing groups, and alternation.
+    3. Quantifiers `*`, `+`, `?`, `{m}`, `{m,}`, `{m,n}`, and their lazy forms.
+    4. Anchors `^` and `$`.
+
+    Backreferences and lookaround assertions are not supported.
+    """
+
+    def __init__(self, regex_query: str, case_sensitive: bool = False):
+        """
+        Initializes a regex query using the given parameters.
+
+        :param regex_query: Regular expression string.
+        :param case_sensitive: Case sensitive indicator.
+        """
+        self._regex_query: str = regex_query
+        self._case_sensitive: bool = case_sensitive
+
+    def __str__(self) -> str:
+        """
+        :return: The string representation of the RegexQuery object.
+        """
+        return (
+            f'RegexQuery(regex_query="{self._regex_query}",'
+            f" case_sensitive={self._case_sensitive})"
+        )
+
+    def __repr__(self) -> str:
+        """
+        :return: Same as `__str__` method.
+        """
+        return self.__str__()
+
+    @property
+    def regex_query(self) -> str:
+        return self._regex_query
+
+    @property
+    def case_sensitive(self) -> bool:
+        return self._case_sensitive
@@ -24,21 +24,41 @@ ir_native: Extension = Extension(
         "src/clp/components/core/src/BufferReader.cpp",
         "src/clp/components/core/src/ReaderInterface.cpp",
 
+        "src/clp_ffi_py/ir/native/AsyncIrStreamWriter.cpp",
+        "src/clp_ffi_py/ir/native/AttributeEncoder.cpp",
+        "src/clp_ffi_py/ir/native/AttributePredicate.cpp",
         "src/clp_ffi_py/ir/native/decoding_methods.cpp",
         "src/clp_ffi_py/ir/native/encoding_methods.cpp",
+        "src/clp_ffi_py/ir/native/FourByteMessageEncoder.cpp",
+        "src/clp_ffi_py/ir/native/IrStreamEncoder.cpp",
+        "src/clp_ffi_py/ir/native/IrStreamWriter.cpp",
+        "src/clp_ffi_py/ir/native/LogEventExporter.cpp",
+        "src/clp_ffi_py/ir/native/LogMessageInternCache.cpp",
+        "src/clp_ffi_py/ir/native/LogtypeCache.cpp",
+        "src/clp_ffi_py/ir/native/MessageTokenizer.cpp",
         "src/clp_ffi_py/ir/native/Metadata.cpp",
+        "src/clp_ffi_py/ir/native/OutputSink.cpp",
+        "src/clp_ffi_py/ir/native/PyAsyncClpIrStreamWriter.cpp",
+        "src/clp_ffi_py/ir/native/PyClpIrStreamWriter.cpp",
         "src/clp_ffi_py/ir/native/PyDecoder.cpp",
         "src/clp_ffi_py/ir/native/PyDecoderBuffer.cpp",
         "src/clp_ffi_py/ir/native/PyFourByteEncoder.cpp",
         "src/clp_ffi_py/ir/native/PyLogEvent.cpp",
+        "src/clp_ffi_py/ir/native/PyLogEventIterator.cpp",
         "src/clp_ffi_py/ir/native/PyMetadata.cpp",
         "src/clp_ffi_py/ir/native/PyQuery.cpp",
         "src/clp_ffi_py/ir/native/Query.cpp",
+        "src/clp_ffi_py/ir/native/QueryExpression.cpp",
+        "src/clp_ffi_py/ir/native/RegexMatcher.cpp",
+        "src/clp_ffi_py/ir/native/TimestampFormatter.cpp",
         "src/clp_ffi_py/ir/native/utils.cpp",
+        "src/clp_ffi_py/ir/native/ZstdCompressor.cpp",
         "src/clp_ffi_py/modules/ir_native.cpp",
+        "src/clp_ffi_py/PyFastcallArgParser.cpp",
         "src/clp_ffi_py/Py_utils.cpp",
         "src/clp_ffi_py/utils.cpp",
     ],
+    libraries=["zstd"],
     extra_compile_args=[
         "-std=c++17",
         "-O3",
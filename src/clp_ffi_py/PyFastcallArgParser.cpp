@@ -0,0 +1,114 @@
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include "PyFastcallArgParser.hpp"
+
+#include <utility>
+
+namespace clp_ffi_py {
+auto PyFastcallArgParser::parse(
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names,
+        gsl::span<PyObject*> parsed_args
+) -> bool {
+    auto const num_params{m_param_names.size()};
+    if (static_cast<size_t>(num_args) > num_params) {
+        PyErr_Format(
+                PyExc_TypeError,
+                "%s() takes at most %zu positional arguments (%zd given)",
+                m_func_name,
+                num_params,
+                num_args
+        );
+        return false;
+    }
+
+    size_t idx{0};
+    for (; idx < static_cast<size_t>(num_args); ++idx) {
+        parsed_args[idx] = args[idx];
+    }
+    for (; idx < num_params; ++idx) {
+        parsed_args[idx] = nullptr;
+    }
+
+    if (nullptr != keyword_names) {
+        if (false == intern_param_names()) {
+            return false;
+        }
+        auto const num_keyword_args{PyTuple_GET_SIZE(keyword_names)};
+        for (Py_ssize_t keyword_idx{0}; keyword_idx < num_keyword_args; ++keyword_idx) {
+            auto* keyword_name{PyTuple_GET_ITEM(keyword_names, keyword_idx)};
+            auto const param_idx{find_param_idx(keyword_name)};
+            if (num_params == param_idx) {
+                PyErr_Format(
+                        PyExc_TypeError,
+                        "%s() got an unexpected keyword argument '%U'",
+                        m_func_name,
+                        keyword_name
+                );
+                return false;
+            }
+            if (nullptr != parsed_args[param_idx]) {
+                PyErr_Format(
+                        PyExc_TypeError,
+                        "%s() got multiple values for argument '%s'",
+                        m_func_name,
+                        m_param_names[param_idx]
+                );
+                return false;
+            }
+            parsed_args[param_idx] = args[num_args + keyword_idx];
+        }
+    }
+
+    for (idx = 0; idx < m_num_required_params; ++idx) {
+        if (nullptr == parsed_args[idx]) {
+            PyErr_Format(
+                    PyExc_TypeError,
+                    "%s() missing required argument '%s' (pos %zu)",
+                    m_func_name,
+                    m_param_names[idx],
+                    idx + 1
+            );
+            return false;
+        }
+    }
+    return true;
+}
+
+auto PyFastcallArgParser::intern_param_names() -> bool {
+    if (m_interned_param_names.size() == m_param_names.size()) {
+        return true;
+    }
+    std::vector<PyObjectGlobalPtr<PyObject>> interned_param_names;
+    interned_param_names.reserve(m_param_names.size());
+    for (auto const* param_name : m_param_names) {
+        interned_param_names.emplace_back(PyUnicode_InternFromString(param_name));
+        if (nullptr == interned_param_names.back()) {
+            for (auto& interned_param_name : interned_param_names) {
+                Py_XDECREF(interned_param_name.get());
+            }
+            return false;
+        }
+    }
+    m_interned_param_names = std::move(interned_param_names);
+    return true;
+}
+
+auto PyFastcallArgParser::find_param_idx(PyObject* keyword_name) const -> size_t {
+    auto const num_params{m_interned_param_names.size()};
+    // Keyword names given at the call site are interned by the compiler, so
+    // they can usually be matched by identity.
+    for (size_t idx{0}; idx < num_params; ++idx) {
+        if (keyword_name == m_interned_param_names[idx].get()) {
+            return idx;
+        }
+    }
+    for (size_t idx{0}; idx < num_params; ++idx) {
+        if (0 == PyUnicode_Compare(keyword_name, m_interned_param_names[idx].get())) {
+            return idx;
+        }
+    }
+    return num_params;
+}
+}  // namespace clp_ffi_py
@@ -0,0 +1,89 @@
+#ifndef CLP_FFI_PY_PY_FASTCALL_ARG_PARSER_HPP
+#define CLP_FFI_PY_PY_FASTCALL_ARG_PARSER_HPP
+
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#include <gsl/span>
+
+#include <clp_ffi_py/PyObjectUtils.hpp>
+
+namespace clp_ffi_py {
+/**
+ * This class parses the arguments of a method registered with `METH_FASTCALL`
+ * (optionally with `METH_KEYWORDS`) or of a vectorcall function. Unlike
+ * `PyArg_ParseTupleAndKeywords`, it doesn't require the arguments to be packed
+ * into a tuple and a dictionary, and it doesn't interpret a format string on
+ * every call: it only matches the arguments to the parameters, leaving the
+ * conversion of each argument to the caller.
+ * <p>
+ * The parameter names are interned the first time the parser is used, so
+ * matching a keyword argument is usually a pointer comparison. A parser is
+ * meant to be declared as a function-local static variable, and must only be
+ * used while holding the GIL.
+ */
+class PyFastcallArgParser {
+public:
+    /**
+     * @param func_name The name of the parsed function, used in error
+     * messages.
+     * @param param_names The names of the parameters in positional order.
+     * @param num_required_params The number of leading parameters that must be
+     * given.
+     */
+    PyFastcallArgParser(
+            char const* func_name,
+            std::initializer_list<char const*> param_names,
+            size_t num_required_params
+    )
+            : m_func_name{func_name},
+              m_param_names{param_names},
+              m_num_required_params{num_required_params} {}
+
+    [[nodiscard]] auto get_num_params() const -> size_t { return m_param_names.size(); }
+
+    /**
+     * Matches the given arguments to the parameters.
+     * @param args The positional arguments followed by the values of the
+     * keyword arguments.
+     * @param num_args The number of positional arguments.
+     * @param keyword_names A tuple of the names of the keyword arguments, or
+     * nullptr if there are none.
+     * @param parsed_args Returns borrowed references to the argument of each
+     * parameter, or nullptr for the optional parameters not given. Its size
+     * must be the number of parameters.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto parse(
+            PyObject* const* args,
+            Py_ssize_t num_args,
+            PyObject* keyword_names,
+            gsl::span<PyObject*> parsed_args
+    ) -> bool;
+
+private:
+    /**
+     * Interns the parameter names if they haven't been interned yet.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error set.
+     */
+    [[nodiscard]] auto intern_param_names() -> bool;
+
+    /**
+     * @param keyword_name
+     * @return The index of the parameter with the given name, or the number of
+     * parameters if there is no such parameter.
+     */
+    [[nodiscard]] auto find_param_idx(PyObject* keyword_name) const -> size_t;
+
+    char const* m_func_name;
+    std::vector<char const*> m_param_names;
+    size_t m_num_required_params;
+    std::vector<PyObjectGlobalPtr<PyObject>> m_interned_param_names;
+};
+}  // namespace clp_ffi_py
+#endif  // CLP_FFI_PY_PY_FASTCALL_ARG_PARSER_HPP
@@ -115,16 +115,22 @@ auto py_reinterpret_cast(Src* src) noexcept -> Dst* {
 }
 
 namespace ir::native {
+class PyAsyncClpIrStreamWriter;
+class PyClpIrStreamWriter;
 class PyDecoder;
 class PyDecoderBuffer;
 class PyLogEvent;
+class PyLogEventIterator;
 class PyMetadata;
 class PyQuery;
 }  // namespace ir::native
 
+CLP_FFI_PY_MARK_AS_PYOBJECT(ir::native::PyAsyncClpIrStreamWriter);
+CLP_FFI_PY_MARK_AS_PYOBJECT(ir::native::PyClpIrStreamWriter);
 CLP_FFI_PY_MARK_AS_PYOBJECT(ir::native::PyDecoder);
 CLP_FFI_PY_MARK_AS_PYOBJECT(ir::native::PyDecoderBuffer);
 CLP_FFI_PY_MARK_AS_PYOBJECT(ir::native::PyLogEvent);
+CLP_FFI_PY_MARK_AS_PYOBJECT(ir::native::PyLogEventIterator);
 CLP_FFI_PY_MARK_AS_PYOBJECT(ir::native::PyMetadata);
 CLP_FFI_PY_MARK_AS_PYOBJECT(ir::native::PyQuery);
 CLP_FFI_PY_MARK_AS_PYOBJECT(PyTypeObject);
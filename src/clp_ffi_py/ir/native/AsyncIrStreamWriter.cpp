@@ -0,0 +1,365 @@
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include "AsyncIrStreamWriter.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <exception>
+#include <new>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <clp_ffi_py/ir/native/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+constexpr char const* cClosedWriterError = "I/O operation on a closed AsyncClpIrStreamWriter.";
+
+/**
+ * How long a producer blocked on a full queue waits before checking the queue
+ * again, in case it missed the background thread's notification. This also
+ * bounds how long it takes for a blocked producer to handle signals.
+ */
+constexpr std::chrono::milliseconds cBlockedProducerPollInterval{10};
+
+/**
+ * Wraps an unexpected exception thrown in the background thread, so that it can
+ * be recorded as the writer's error.
+ * @param ex
+ * @return The wrapped exception.
+ */
+auto to_background_error(std::exception const& ex) -> ExceptionFFI {
+    return ExceptionFFI{
+            ErrorCode_Failure,
+            __FILE__,
+            __LINE__,
+            std::string{"Unexpected error in the writer thread: "} + ex.what()
+    };
+}
+}  // namespace
+
+auto AsyncIrStreamWriter::create(
+        int fd,
+        ffi::epoch_time_ms_t ref_timestamp,
+        std::string_view timestamp_format,
+        std::string_view timezone,
+        std::optional<int> compression_level,
+        size_t queue_capacity,
+        std::chrono::milliseconds flush_interval,
+        size_t flush_threshold,
+        OverflowPolicy overflow_policy,
+        size_t logtype_cache_capacity
+) -> std::unique_ptr<AsyncIrStreamWriter> {
+    std::unique_ptr<IrStreamEncoder> encoder;
+    try {
+        encoder = std::make_unique<IrStreamEncoder>(
+                ref_timestamp,
+                timestamp_format,
+                timezone,
+                compression_level,
+                flush_threshold,
+                logtype_cache_capacity,
+                std::vector<ffi::ir_stream::AttributeInfo>{}
+        );
+    } catch (ExceptionFFI const& ex) {
+        set_py_error_from_exception(ex);
+        return nullptr;
+    } catch (std::bad_alloc const&) {
+        PyErr_NoMemory();
+        return nullptr;
+    }
+    std::unique_ptr<AsyncIrStreamWriter> writer{new AsyncIrStreamWriter{
+            fd,
+            std::move(encoder),
+            queue_capacity,
+            flush_interval,
+            flush_threshold,
+            overflow_policy
+    }};
+    try {
+        writer->m_thread = std::thread{[raw_writer = writer.get()]() { raw_writer->run(); }};
+    } catch (std::system_error const& ex) {
+        PyErr_Format(PyExc_RuntimeError, "Failed to start the writer thread: %s", ex.what());
+        return nullptr;
+    }
+    return writer;
+}
+
+AsyncIrStreamWriter::AsyncIrStreamWriter(
+        int fd,
+        std::unique_ptr<IrStreamEncoder> encoder,
+        size_t queue_capacity,
+        std::chrono::milliseconds flush_interval,
+        size_t flush_threshold,
+        OverflowPolicy overflow_policy
+)
+        : m_fd{fd},
+          m_encoder{std::move(encoder)},
+          m_flush_interval{flush_interval},
+          m_flush_threshold{flush_threshold},
+          m_overflow_policy{overflow_policy},
+          m_queue{queue_capacity} {}
+
+AsyncIrStreamWriter::~AsyncIrStreamWriter() {
+    stop();
+}
+
+auto AsyncIrStreamWriter::write_log_event(
+        ffi::epoch_time_ms_t timestamp,
+        std::string_view log_message,
+        bool& is_enqueued
+) -> bool {
+    while (true) {
+        // Both are checked on every attempt since the GIL is released while
+        // blocked, during which another thread may close the writer.
+        if (m_is_closed) {
+            PyErr_SetString(PyExc_ValueError, cClosedWriterError);
+            return false;
+        }
+        if (raise_background_error()) {
+            return false;
+        }
+        if (m_queue.try_push(timestamp, log_message)) {
+            break;
+        }
+        if (OverflowPolicy::Drop == m_overflow_policy) {
+            ++m_num_dropped_log_events;
+            is_enqueued = false;
+            return true;
+        }
+
+        wake_up_consumer();
+        Py_BEGIN_ALLOW_THREADS
+        {
+            std::unique_lock lock{m_mutex};
+            ++m_num_blocked_producers;
+            m_producer_cv.wait_for(lock, cBlockedProducerPollInterval);
+            --m_num_blocked_producers;
+        }
+        Py_END_ALLOW_THREADS
+        if (0 != PyErr_CheckSignals()) {
+            return false;
+        }
+    }
+    ++m_num_log_events;
+    is_enqueued = true;
+    wake_up_consumer();
+    return true;
+}
+
+auto AsyncIrStreamWriter::flush() -> bool {
+    if (m_is_closed) {
+        PyErr_SetString(PyExc_ValueError, cClosedWriterError);
+        return false;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    {
+        std::unique_lock lock{m_mutex};
+        auto const flush_id{++m_num_requested_flushes};
+        m_consumer_cv.notify_one();
+        m_producer_cv.wait(lock, [&]() {
+            return m_num_completed_flushes >= flush_id
+                   || m_has_failed.load(std::memory_order_relaxed);
+        });
+    }
+    Py_END_ALLOW_THREADS
+    return false == raise_background_error();
+}
+
+auto AsyncIrStreamWriter::close() -> bool {
+    if (m_is_closed) {
+        return true;
+    }
+    m_is_closed = true;
+    Py_BEGIN_ALLOW_THREADS
+    stop();
+    Py_END_ALLOW_THREADS
+    return false == raise_background_error();
+}
+
+auto AsyncIrStreamWriter::raise_background_error() -> bool {
+    if (false == m_has_failed.load(std::memory_order_acquire)) {
+        return false;
+    }
+    std::lock_guard const lock{m_mutex};
+    if (ErrorCode_errno == m_error->get_error_code()) {
+        errno = m_error_number;
+        PyErr_SetFromErrno(PyExc_OSError);
+    } else {
+        set_py_error_from_exception(m_error.value());
+    }
+    return true;
+}
+
+auto AsyncIrStreamWriter::wake_up_consumer() -> void {
+    // Pairs with the fence in `run`: either this thread sees the background
+    // thread waiting, or the background thread sees the pushed log event
+    // before it starts waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_is_consumer_waiting.load(std::memory_order_relaxed)) {
+        std::lock_guard const lock{m_mutex};
+        m_consumer_cv.notify_one();
+    }
+}
+
+auto AsyncIrStreamWriter::stop() -> void {
+    if (false == m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard const lock{m_mutex};
+        m_is_stop_requested = true;
+        m_consumer_cv.notify_one();
+    }
+    m_thread.join();
+}
+
+auto AsyncIrStreamWriter::run() -> void {
+    try {
+        auto last_flush_time{std::chrono::steady_clock::now()};
+        bool has_unflushed_log_events{false};
+        std::unique_lock lock{m_mutex, std::defer_lock};
+        while (true) {
+            if (drain_queue()) {
+                has_unflushed_log_events = true;
+            }
+
+            lock.lock();
+            if (m_is_stop_requested) {
+                lock.unlock();
+                // Log events may be published after the last drain by producers
+                // that claimed their slots before the writer was closed.
+                drain_queue();
+                try {
+                    m_encoder->encode_end_of_stream();
+                } catch (ExceptionFFI const& ex) {
+                    record_error(ex, 0);
+                } catch (std::exception const& ex) {
+                    record_error(to_background_error(ex), 0);
+                }
+                write_output(ZSTD_e_end);
+                lock.lock();
+                m_num_completed_flushes = m_num_requested_flushes;
+                m_producer_cv.notify_all();
+                return;
+            }
+
+            auto const now{std::chrono::steady_clock::now()};
+            auto const flush_id{m_num_requested_flushes};
+            bool const is_flush_requested{m_num_completed_flushes != flush_id};
+            if (is_flush_requested
+                || (has_unflushed_log_events && now - last_flush_time >= m_flush_interval))
+            {
+                lock.unlock();
+                // Log events enqueued before the flush request must be written.
+                drain_queue();
+                write_output(ZSTD_e_flush);
+                last_flush_time = now;
+                has_unflushed_log_events = false;
+                lock.lock();
+                m_num_completed_flushes = flush_id;
+                m_producer_cv.notify_all();
+                lock.unlock();
+                continue;
+            }
+
+            m_is_consumer_waiting.store(true, std::memory_order_relaxed);
+            // Pairs with the fence in `wake_up_consumer`.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (nullptr == m_queue.front()) {
+                auto const deadline{
+                        has_unflushed_log_events ? last_flush_time + m_flush_interval
+                                                 : now + m_flush_interval
+                };
+                m_consumer_cv.wait_until(lock, deadline);
+            }
+            m_is_consumer_waiting.store(false, std::memory_order_relaxed);
+            lock.unlock();
+        }
+    } catch (ExceptionFFI const& ex) {
+        record_error(ex, 0);
+    } catch (std::exception const& ex) {
+        record_error(to_background_error(ex), 0);
+    }
+    // The thread has exited early, so wake up any producer waiting on a flush.
+    std::lock_guard const lock{m_mutex};
+    m_producer_cv.notify_all();
+}
+
+auto AsyncIrStreamWriter::drain_queue() -> bool {
+    bool has_dequeued{false};
+    while (auto const* slot{m_queue.front()}) {
+        if (false == m_has_failed.load(std::memory_order_relaxed)) {
+            try {
+                m_encoder->encode_log_event(slot->m_timestamp, slot->m_message);
+            } catch (ExceptionFFI const& ex) {
+                record_error(ex, 0);
+            } catch (std::exception const& ex) {
+                record_error(to_background_error(ex), 0);
+            }
+        }
+        m_queue.pop();
+        has_dequeued = true;
+        if (m_num_blocked_producers.load(std::memory_order_relaxed) > 0) {
+            m_producer_cv.notify_all();
+        }
+        if (m_encoder->get_num_buffered_bytes() >= m_flush_threshold) {
+            write_output(ZSTD_e_continue);
+        }
+    }
+    return has_dequeued;
+}
+
+auto AsyncIrStreamWriter::write_output(ZSTD_EndDirective directive) -> void {
+    if (m_has_failed.load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::string_view output;
+    try {
+        output = m_encoder->prepare_output(directive);
+    } catch (ExceptionFFI const& ex) {
+        record_error(ex, 0);
+        return;
+    } catch (std::exception const& ex) {
+        record_error(to_background_error(ex), 0);
+        return;
+    }
+    size_t num_bytes_written{0};
+    while (num_bytes_written < output.size()) {
+        auto const result{
+                ::write(m_fd, output.data() + num_bytes_written, output.size() - num_bytes_written)
+        };
+        if (result >= 0) {
+            num_bytes_written += static_cast<size_t>(result);
+            continue;
+        }
+        auto const error_number{errno};
+        if (EINTR == error_number) {
+            continue;
+        }
+        record_error(
+                ExceptionFFI{
+                        ErrorCode_errno,
+                        __FILE__,
+                        __LINE__,
+                        "Failed to write the IR stream to the file descriptor."
+                },
+                error_number
+        );
+        return;
+    }
+    m_encoder->clear_output();
+}
+
+auto AsyncIrStreamWriter::record_error(ExceptionFFI const& error, int error_number) -> void {
+    std::lock_guard const lock{m_mutex};
+    if (m_error.has_value()) {
+        return;
+    }
+    m_error.emplace(error);
+    m_error_number = error_number;
+    m_has_failed.store(true, std::memory_order_release);
+}
+}  // namespace clp_ffi_py::ir::native
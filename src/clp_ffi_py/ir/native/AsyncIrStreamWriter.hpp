@@ -0,0 +1,243 @@
+#ifndef CLP_FFI_PY_ASYNC_IR_STREAM_WRITER_HPP
+#define CLP_FFI_PY_ASYNC_IR_STREAM_WRITER_HPP
+
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+
+#include <clp_ffi_py/ExceptionFFI.hpp>
+#include <clp_ffi_py/ir/native/IrStreamEncoder.hpp>
+#include <clp_ffi_py/ir/native/LogEventQueue.hpp>
+#include <clp_ffi_py/ir/native/LogtypeCache.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class writes a CLP IR stream (four-byte encoding) to a file descriptor
+ * from a dedicated native thread. Callers only copy log events into a bounded
+ * lock-free queue; the background thread encodes them, compresses the stream
+ * with zstd (optional), and writes it to the file descriptor. The stream is
+ * flushed whenever the buffered IR bytes reach the flush threshold, and at
+ * least once per flush interval while there are log events to flush, so the
+ * latency of a log event reaching the file descriptor is bounded.
+ * <p>
+ * The background thread never touches any Python object, so it runs without
+ * the GIL. Errors that occur in the background are recorded, and raised by the
+ * next call from Python.
+ * <p>
+ * Except for the constructor and the destructor, public methods must be called
+ * while holding the GIL. Methods that wait for the background thread release
+ * the GIL while waiting.
+ */
+class AsyncIrStreamWriter {
+public:
+    /**
+     * Policy applied when a log event is written while the queue is full.
+     */
+    enum class OverflowPolicy : uint8_t {
+        // Waits until the background thread frees up a slot.
+        Block = 0,
+        // Drops the log event.
+        Drop,
+    };
+
+    static constexpr size_t cDefaultQueueCapacity{64ULL * 1024ULL};
+    static constexpr std::chrono::milliseconds cDefaultFlushInterval{1000};
+
+    /**
+     * Creates a writer, encodes the preamble, and starts the background
+     * thread.
+     * @param fd The file descriptor to write the IR stream to. It isn't closed
+     * by the writer.
+     * @param ref_timestamp
+     * @param timestamp_format
+     * @param timezone
+     * @param compression_level The zstd compression level, or std::nullopt to
+     * write the IR stream uncompressed.
+     * @param queue_capacity The maximum number of log events waiting to be
+     * encoded. Rounded up to the next power of 2.
+     * @param flush_interval The maximum time a log event can stay buffered in
+     * the background thread before it's flushed.
+     * @param flush_threshold The number of buffered IR bytes that triggers a
+     * write to the file descriptor.
+     * @param overflow_policy
+     * @param logtype_cache_capacity The number of slots in the cache of
+     * recently encoded logtypes, or 0 to encode without a cache.
+     * @return The created writer.
+     * @return nullptr on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] static auto create(
+            int fd,
+            ffi::epoch_time_ms_t ref_timestamp,
+            std::string_view timestamp_format,
+            std::string_view timezone,
+            std::optional<int> compression_level,
+            size_t queue_capacity,
+            std::chrono::milliseconds flush_interval,
+            size_t flush_threshold,
+            OverflowPolicy overflow_policy,
+            size_t logtype_cache_capacity
+    ) -> std::unique_ptr<AsyncIrStreamWriter>;
+
+    // Delete copy/move constructors and assignments
+    AsyncIrStreamWriter(AsyncIrStreamWriter const&) = delete;
+    AsyncIrStreamWriter(AsyncIrStreamWriter&&) = delete;
+    auto operator=(AsyncIrStreamWriter const&) -> AsyncIrStreamWriter& = delete;
+    auto operator=(AsyncIrStreamWriter&&) -> AsyncIrStreamWriter& = delete;
+
+    /**
+     * Stops the background thread if the writer hasn't been closed. The
+     * buffered log events are still written.
+     */
+    ~AsyncIrStreamWriter();
+
+    /**
+     * Enqueues the given log event to be written by the background thread.
+     * If the queue is full, the overflow policy decides whether to wait (with
+     * the GIL released) or to drop the log event.
+     * @param timestamp
+     * @param log_message
+     * @param is_enqueued Returns whether the log event was enqueued, i.e.,
+     * false if it was dropped.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto write_log_event(
+            ffi::epoch_time_ms_t timestamp,
+            std::string_view log_message,
+            bool& is_enqueued
+    ) -> bool;
+
+    /**
+     * Waits until all the log events enqueued so far are written to the file
+     * descriptor. If the stream is compressed, the zstd frame is flushed so
+     * that everything written so far can be decompressed.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto flush() -> bool;
+
+    /**
+     * Waits until all the log events enqueued so far are written, terminates
+     * the IR stream, ends the zstd frame if the stream is compressed, and
+     * stops the background thread. Closing a closed writer does nothing.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set. The writer is closed regardless.
+     */
+    [[nodiscard]] auto close() -> bool;
+
+    [[nodiscard]] auto is_closed() const -> bool { return m_is_closed; }
+
+    [[nodiscard]] auto get_num_log_events() const -> size_t { return m_num_log_events; }
+
+    [[nodiscard]] auto get_num_dropped_log_events() const -> size_t {
+        return m_num_dropped_log_events;
+    }
+
+    /**
+     * @return The logtype cache used by the background thread, or nullptr if
+     * the writer doesn't have one. Only its statistics may be read.
+     */
+    [[nodiscard]] auto get_logtype_cache() const -> LogtypeCache const* {
+        return m_encoder->get_logtype_cache();
+    }
+
+private:
+    AsyncIrStreamWriter(
+            int fd,
+            std::unique_ptr<IrStreamEncoder> encoder,
+            size_t queue_capacity,
+            std::chrono::milliseconds flush_interval,
+            size_t flush_threshold,
+            OverflowPolicy overflow_policy
+    );
+
+    /**
+     * Sets the Python exception corresponding to the error that occurred in
+     * the background thread, if any.
+     * @return Whether an error has occurred.
+     */
+    [[nodiscard]] auto raise_background_error() -> bool;
+
+    /**
+     * Wakes up the background thread if it's waiting for log events.
+     */
+    auto wake_up_consumer() -> void;
+
+    /**
+     * Requests the background thread to stop, and waits for it to finish.
+     */
+    auto stop() -> void;
+
+    /**
+     * The main loop of the background thread. Any exception thrown in the
+     * loop is recorded as the writer's error instead of escaping the thread.
+     */
+    auto run() -> void;
+
+    /**
+     * Encodes all the log events in the queue, writing the buffered IR bytes
+     * whenever they reach the flush threshold. Runs in the background thread.
+     * @return Whether any log event was dequeued.
+     */
+    auto drain_queue() -> bool;
+
+    /**
+     * Writes the encoder's output to the file descriptor. Runs in the
+     * background thread.
+     * @param directive
+     */
+    auto write_output(ZSTD_EndDirective directive) -> void;
+
+    /**
+     * Records the first error that occurs in the background thread. Once an
+     * error is recorded, the background thread drops all the log events.
+     * @param error
+     * @param error_number The errno of the error, or 0 if it's not an OS error.
+     */
+    auto record_error(ExceptionFFI const& error, int error_number) -> void;
+
+    // Accessed by the background thread only
+    int m_fd;
+    std::unique_ptr<IrStreamEncoder> m_encoder;
+    std::chrono::milliseconds m_flush_interval;
+    size_t m_flush_threshold;
+
+    // Accessed while holding the GIL only
+    OverflowPolicy m_overflow_policy;
+    size_t m_num_log_events{0};
+    size_t m_num_dropped_log_events{0};
+    bool m_is_closed{false};
+    std::thread m_thread;
+
+    // Shared between the callers and the background thread
+    LogEventQueue m_queue;
+    std::atomic<bool> m_is_consumer_waiting{false};
+    std::atomic<size_t> m_num_blocked_producers{0};
+    std::atomic<bool> m_has_failed{false};
+    std::mutex m_mutex;
+    std::condition_variable m_consumer_cv;
+    std::condition_variable m_producer_cv;
+    // Guarded by `m_mutex`
+    uint64_t m_num_requested_flushes{0};
+    uint64_t m_num_completed_flushes{0};
+    bool m_is_stop_requested{false};
+    std::optional<ExceptionFFI> m_error;
+    int m_error_number{0};
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_ASYNC_IR_STREAM_WRITER_HPP
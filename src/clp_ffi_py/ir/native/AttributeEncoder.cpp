@@ -0,0 +1,228 @@
+#include "AttributeEncoder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/protocol_constants.hpp>
+#include <clp/components/core/src/type_utils.hpp>
+#include <clp/components/core/submodules/json/single_include/nlohmann/json.hpp>
+
+#include <clp_ffi_py/ExceptionFFI.hpp>
+#include <clp_ffi_py/ir/native/encoding_utils.hpp>
+#include <clp_ffi_py/ir/native/error_messages.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+/**
+ * @param attribute_table
+ * @return The names of the attributes in the given table.
+ */
+auto get_attribute_names(std::vector<ffi::ir_stream::AttributeInfo> const& attribute_table)
+        -> std::vector<std::string> {
+    std::vector<std::string> attribute_names;
+    attribute_names.reserve(attribute_table.size());
+    for (auto const& attribute_info : attribute_table) {
+        attribute_names.emplace_back(attribute_info.get_name());
+    }
+    return attribute_names;
+}
+
+/**
+ * @param attribute
+ * @param type_tag
+ * @return Whether the given attribute holds a value of the given type.
+ */
+auto matches_type(
+        ffi::ir_stream::Attribute const& attribute,
+        ffi::ir_stream::AttributeInfo::TypeTag type_tag
+) -> bool {
+    switch (type_tag) {
+        case ffi::ir_stream::AttributeInfo::TypeTag::String:
+            return attribute.is_type<ffi::ir_stream::attr_str_t>();
+        case ffi::ir_stream::AttributeInfo::TypeTag::Int:
+            return attribute.is_type<ffi::ir_stream::attr_int_t>();
+        default:
+            return false;
+    }
+}
+}  // namespace
+
+AttributeEncoder::AttributeEncoder(std::vector<ffi::ir_stream::AttributeInfo> attribute_table)
+        : m_attribute_table{std::move(attribute_table)},
+          m_attribute_schema{get_attribute_names(m_attribute_table)} {}
+
+auto AttributeEncoder::encode_preamble(
+        std::string_view timestamp_format,
+        std::string_view timezone,
+        ffi::epoch_time_ms_t ref_timestamp,
+        std::vector<int8_t>& ir_buf
+) const -> bool {
+    return encode_preamble(timestamp_format, timezone, ref_timestamp, m_attribute_table, ir_buf);
+}
+
+auto AttributeEncoder::encode_attributes(
+        gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes,
+        std::vector<int8_t>& ir_buf
+) const -> void {
+    if (attributes.size() != m_attribute_table.size()) {
+        throw ExceptionFFI(
+                ErrorCode_BadParam,
+                __FILE__,
+                __LINE__,
+                "The number of attributes doesn't match the attribute table."
+        );
+    }
+    for (size_t idx{0}; idx < attributes.size(); ++idx) {
+        auto const& attribute{attributes[idx]};
+        auto const& attribute_info{m_attribute_table[idx]};
+        if (attribute.has_value()
+            && false == matches_type(attribute.value(), attribute_info.get_type_tag()))
+        {
+            throw ExceptionFFI(
+                    ErrorCode_BadParam,
+                    __FILE__,
+                    __LINE__,
+                    "The value of attribute `" + attribute_info.get_name()
+                            + "` doesn't match its type."
+            );
+        }
+    }
+    auto const ir_buf_size{ir_buf.size()};
+    if (false == encode_attribute_values(attributes, ir_buf)) {
+        ir_buf.resize(ir_buf_size);
+        throw ExceptionFFI(ErrorCode_Unsupported, __FILE__, __LINE__, cEncodeAttributesError);
+    }
+}
+
+auto AttributeEncoder::encode_preamble(
+        std::string_view timestamp_format,
+        std::string_view timezone,
+        ffi::epoch_time_ms_t ref_timestamp,
+        gsl::span<ffi::ir_stream::AttributeInfo const> attribute_table,
+        std::vector<int8_t>& ir_buf
+) -> bool {
+    namespace cProtocol = ffi::ir_stream::cProtocol;
+    namespace cMetadata = ffi::ir_stream::cProtocol::Metadata;
+
+    if (attribute_table.empty()) {
+        return ffi::ir_stream::four_byte_encoding::encode_preamble(
+                timestamp_format,
+                {},
+                timezone,
+                ref_timestamp,
+                ir_buf
+        );
+    }
+
+    // The metadata holds the same fields as the one of
+    // `ffi::ir_stream::four_byte_encoding::encode_preamble`, followed by the
+    // attribute table.
+    std::string serialized_metadata;
+    try {
+        nlohmann::json metadata;
+        metadata[static_cast<char const*>(cMetadata::VersionKey)] = cMetadata::VersionValue;
+        metadata[static_cast<char const*>(cMetadata::VariablesSchemaIdKey)]
+                = ffi::cVariablesSchemaVersion;
+        metadata[static_cast<char const*>(cMetadata::VariableEncodingMethodsIdKey)]
+                = ffi::cVariableEncodingMethodsVersion;
+        metadata[static_cast<char const*>(cMetadata::TimestampPatternKey)] = timestamp_format;
+        metadata[static_cast<char const*>(cMetadata::TimestampPatternSyntaxKey)] = "";
+        metadata[static_cast<char const*>(cMetadata::TimeZoneIdKey)] = timezone;
+        metadata[static_cast<char const*>(cMetadata::ReferenceTimestampKey)]
+                = std::to_string(ref_timestamp);
+        nlohmann::json attribute_table_json(nlohmann::json::array());
+        for (auto const& attribute_info : attribute_table) {
+            nlohmann::json attribute_json;
+            attribute_json[ffi::ir_stream::AttributeInfo::cNameKey] = attribute_info.get_name();
+            attribute_json[ffi::ir_stream::AttributeInfo::cTypeTagKey]
+                    = enum_to_underlying_type(attribute_info.get_type_tag());
+            attribute_table_json.push_back(std::move(attribute_json));
+        }
+        metadata[static_cast<char const*>(cMetadata::AttributeTableKey)]
+                = std::move(attribute_table_json);
+        serialized_metadata
+                = metadata.dump(-1, ' ', false, nlohmann::json::error_handler_t::ignore);
+    } catch (nlohmann::json::exception const&) {
+        return false;
+    }
+
+    auto const ir_buf_size{ir_buf.size()};
+    ir_buf.insert(
+            ir_buf.end(),
+            std::cbegin(cProtocol::FourByteEncodingMagicNumber),
+            std::cend(cProtocol::FourByteEncodingMagicNumber)
+    );
+    ir_buf.push_back(cMetadata::EncodingJson);
+    if (serialized_metadata.size() <= UINT8_MAX) {
+        ir_buf.push_back(cMetadata::LengthUByte);
+        ir_buf.push_back(static_cast<int8_t>(static_cast<uint8_t>(serialized_metadata.size())));
+    } else if (serialized_metadata.size() <= UINT16_MAX) {
+        ir_buf.push_back(cMetadata::LengthUShort);
+        append_int(static_cast<uint16_t>(serialized_metadata.size()), ir_buf);
+    } else {
+        ir_buf.resize(ir_buf_size);
+        return false;
+    }
+    ir_buf.insert(ir_buf.end(), serialized_metadata.cbegin(), serialized_metadata.cend());
+    return true;
+}
+
+auto AttributeEncoder::encode_attribute_values(
+        gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes,
+        std::vector<int8_t>& ir_buf
+) -> bool {
+    // The tags are the ones `decode_next_message_with_attributes` reads.
+    namespace cPayload = ffi::ir_stream::cProtocol::Payload;
+
+    for (auto const& attribute : attributes) {
+        if (false == attribute.has_value()) {
+            ir_buf.push_back(cPayload::AttrNull);
+        } else if (attribute->is_type<ffi::ir_stream::attr_int_t>()) {
+            ir_buf.push_back(cPayload::AttrNum);
+            append_int(attribute->get_value<ffi::ir_stream::attr_int_t>(), ir_buf);
+        } else if (false
+                   == append_string(
+                           attribute->get_value<ffi::ir_stream::attr_str_t>(),
+                           cPayload::AttrStrLenUByte,
+                           cPayload::AttrStrLenUShort,
+                           cPayload::AttrStrLenInt,
+                           ir_buf
+                   ))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto AttributeEncoder::get_encoded_attribute_values_size(
+        gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes
+) -> size_t {
+    size_t size{0};
+    for (auto const& attribute : attributes) {
+        size += sizeof(int8_t);
+        if (false == attribute.has_value()) {
+            continue;
+        }
+        if (attribute->is_type<ffi::ir_stream::attr_int_t>()) {
+            size += sizeof(ffi::ir_stream::attr_int_t);
+            continue;
+        }
+        auto const length{attribute->get_value<ffi::ir_stream::attr_str_t>().length()};
+        if (length <= UINT8_MAX) {
+            size += sizeof(uint8_t);
+        } else if (length <= UINT16_MAX) {
+            size += sizeof(uint16_t);
+        } else {
+            size += sizeof(int32_t);
+        }
+        size += length;
+    }
+    return size;
+}
+}  // namespace clp_ffi_py::ir::native
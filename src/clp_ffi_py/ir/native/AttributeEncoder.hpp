@@ -0,0 +1,125 @@
+#ifndef CLP_FFI_PY_ATTRIBUTE_ENCODER_HPP
+#define CLP_FFI_PY_ATTRIBUTE_ENCODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <gsl/span>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
+
+#include <clp_ffi_py/ir/native/AttributeSchema.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class encodes the attributes of log events against a user-defined
+ * attribute table. The table is declared in the preamble of the IR stream, and
+ * each log event is preceded by one value (or null) per attribute, in the
+ * table's order. The decoder reads the values back as typed attributes, so
+ * queries can match them with attribute predicates instead of scanning the
+ * log messages.
+ * <p>
+ * The Android preamble is a preamble with a fixed attribute table, which
+ * additionally marks the stream as an Android log stream.
+ */
+class AttributeEncoder {
+public:
+    /**
+     * @param attribute_table
+     */
+    explicit AttributeEncoder(std::vector<ffi::ir_stream::AttributeInfo> attribute_table);
+
+    [[nodiscard]] auto get_attribute_table() const
+            -> std::vector<ffi::ir_stream::AttributeInfo> const& {
+        return m_attribute_table;
+    }
+
+    [[nodiscard]] auto get_attribute_schema() const -> AttributeSchema const& {
+        return m_attribute_schema;
+    }
+
+    /**
+     * Encodes a four-byte encoding preamble declaring the attribute table,
+     * and appends it to `ir_buf`.
+     * @param timestamp_format
+     * @param timezone
+     * @param ref_timestamp
+     * @param ir_buf
+     * @return Whether the preamble could be encoded.
+     */
+    [[nodiscard]] auto encode_preamble(
+            std::string_view timestamp_format,
+            std::string_view timezone,
+            ffi::epoch_time_ms_t ref_timestamp,
+            std::vector<int8_t>& ir_buf
+    ) const -> bool;
+
+    /**
+     * Encodes the attributes of a log event and appends them to `ir_buf`.
+     * @param attributes The value of each attribute, in the table's order.
+     * @param ir_buf
+     * @throw ExceptionFFI if the number of attributes doesn't match the table,
+     * if an attribute doesn't match its type, or if a string attribute is too
+     * long to be encoded. In this case, `ir_buf` is left as it was before the
+     * call.
+     */
+    auto encode_attributes(
+            gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes,
+            std::vector<int8_t>& ir_buf
+    ) const -> void;
+
+    /**
+     * Encodes a four-byte encoding preamble declaring the given attribute
+     * table, and appends it to `ir_buf`. The metadata holds the fields of
+     * CLP's four-byte encoding preamble, followed by the attribute table, so
+     * the stream isn't marked as an Android stream. Without attributes, the
+     * preamble is CLP's own.
+     * @param timestamp_format
+     * @param timezone
+     * @param ref_timestamp
+     * @param attribute_table
+     * @param ir_buf
+     * @return Whether the preamble could be encoded.
+     */
+    [[nodiscard]] static auto encode_preamble(
+            std::string_view timestamp_format,
+            std::string_view timezone,
+            ffi::epoch_time_ms_t ref_timestamp,
+            gsl::span<ffi::ir_stream::AttributeInfo const> attribute_table,
+            std::vector<int8_t>& ir_buf
+    ) -> bool;
+
+    /**
+     * Encodes the given attribute values and appends them to `ir_buf`,
+     * without checking them against an attribute table.
+     * @param attributes
+     * @param ir_buf
+     * @return true on success.
+     * @return false if a string attribute is too long to be encoded, in which
+     * case `ir_buf` may contain partially encoded attributes.
+     */
+    [[nodiscard]] static auto encode_attribute_values(
+            gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes,
+            std::vector<int8_t>& ir_buf
+    ) -> bool;
+
+    /**
+     * @param attributes
+     * @return The number of bytes `encode_attribute_values` appends for the
+     * given attribute values, i.e., the size of the attributes at the
+     * beginning of an encoded log event.
+     */
+    [[nodiscard]] static auto get_encoded_attribute_values_size(
+            gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes
+    ) -> size_t;
+
+private:
+    std::vector<ffi::ir_stream::AttributeInfo> m_attribute_table;
+    AttributeSchema m_attribute_schema;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_ATTRIBUTE_ENCODER_HPP
@@ -0,0 +1,101 @@
+#include "AttributePredicate.hpp"
+
+#include <string_view>
+#include <utility>
+
+namespace clp_ffi_py::ir::native {
+auto AttributePredicate::create_equals(
+        std::string name,
+        std::optional<ffi::ir_stream::Attribute> value
+) -> AttributePredicate {
+    AttributePredicate predicate{std::move(name), Type::Equals};
+    predicate.m_value = std::move(value);
+    return predicate;
+}
+
+auto AttributePredicate::create_range(
+        std::string name,
+        ffi::ir_stream::attr_int_t lower_bound,
+        ffi::ir_stream::attr_int_t upper_bound
+) -> AttributePredicate {
+    AttributePredicate predicate{std::move(name), Type::Range};
+    predicate.m_lower_bound = lower_bound;
+    predicate.m_upper_bound = upper_bound;
+    return predicate;
+}
+
+auto AttributePredicate::create_in(
+        std::string name,
+        std::vector<std::optional<ffi::ir_stream::Attribute>> const& values
+) -> AttributePredicate {
+    AttributePredicate predicate{std::move(name), Type::In};
+    for (auto const& value : values) {
+        if (false == value.has_value()) {
+            predicate.m_set_contains_null = true;
+        } else if (value->is_type<ffi::ir_stream::attr_int_t>()) {
+            predicate.m_int_set.emplace(value->get_value<ffi::ir_stream::attr_int_t>());
+        } else if (value->is_type<ffi::ir_stream::attr_str_t>()) {
+            predicate.m_str_set.emplace(value->get_value<ffi::ir_stream::attr_str_t>());
+        }
+    }
+    return predicate;
+}
+
+auto AttributePredicate::create_prefix(std::string name, ffi::ir_stream::attr_str_t prefix)
+        -> AttributePredicate {
+    AttributePredicate predicate{std::move(name), Type::Prefix};
+    predicate.m_prefix = std::move(prefix);
+    return predicate;
+}
+
+auto AttributePredicate::create_is_null(std::string name) -> AttributePredicate {
+    return {std::move(name), Type::IsNull};
+}
+
+auto AttributePredicate::matches(std::optional<ffi::ir_stream::Attribute> const& attribute) const
+        -> bool {
+    if (false == attribute.has_value()) {
+        switch (m_type) {
+            case Type::Equals:
+                return false == m_value.has_value();
+            case Type::In:
+                return m_set_contains_null;
+            case Type::IsNull:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    auto const& value{attribute.value()};
+    switch (m_type) {
+        case Type::Equals:
+            return m_value.has_value() && m_value.value() == value;
+        case Type::Range: {
+            if (false == value.is_type<ffi::ir_stream::attr_int_t>()) {
+                return false;
+            }
+            auto const int_value{value.get_value<ffi::ir_stream::attr_int_t>()};
+            return m_lower_bound <= int_value && int_value <= m_upper_bound;
+        }
+        case Type::In:
+            if (value.is_type<ffi::ir_stream::attr_int_t>()) {
+                return 0 != m_int_set.count(value.get_value<ffi::ir_stream::attr_int_t>());
+            }
+            if (value.is_type<ffi::ir_stream::attr_str_t>()) {
+                return 0 != m_str_set.count(value.get_value<ffi::ir_stream::attr_str_t>());
+            }
+            return false;
+        case Type::Prefix: {
+            if (false == value.is_type<ffi::ir_stream::attr_str_t>()) {
+                return false;
+            }
+            std::string_view const str_value{value.get_value<ffi::ir_stream::attr_str_t>()};
+            return str_value.substr(0, m_prefix.size()) == m_prefix;
+        }
+        case Type::IsNull:
+            return false;
+    }
+    return false;
+}
+}  // namespace clp_ffi_py::ir::native
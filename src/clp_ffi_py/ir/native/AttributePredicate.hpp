@@ -0,0 +1,120 @@
+#ifndef CLP_FFI_PY_ATTRIBUTE_PREDICATE_HPP
+#define CLP_FFI_PY_ATTRIBUTE_PREDICATE_HPP
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class defines a typed predicate on a log event attribute. The following
+ * predicate types are supported:
+ * - Equals: the attribute equals to the given value. A null value only matches
+ *   the attributes that are null.
+ * - Range: the attribute is an integer within the given range (inclusive).
+ * - In: the attribute equals to any value of the given set. The set may
+ *   contain null.
+ * - Prefix: the attribute is a string starting with the given prefix.
+ * - IsNull: the attribute is null.
+ */
+class AttributePredicate {
+public:
+    enum class Type : uint8_t {
+        Equals,
+        Range,
+        In,
+        Prefix,
+        IsNull
+    };
+
+    static constexpr ffi::ir_stream::attr_int_t cIntMin{
+            std::numeric_limits<ffi::ir_stream::attr_int_t>::min()
+    };
+    static constexpr ffi::ir_stream::attr_int_t cIntMax{
+            std::numeric_limits<ffi::ir_stream::attr_int_t>::max()
+    };
+
+    /**
+     * @param name
+     * @param value
+     * @return An Equals predicate.
+     */
+    [[nodiscard]] static auto
+    create_equals(std::string name, std::optional<ffi::ir_stream::Attribute> value)
+            -> AttributePredicate;
+
+    /**
+     * @param name
+     * @param lower_bound Start of the range (inclusive).
+     * @param upper_bound End of the range (inclusive).
+     * @return A Range predicate.
+     */
+    [[nodiscard]] static auto create_range(
+            std::string name,
+            ffi::ir_stream::attr_int_t lower_bound,
+            ffi::ir_stream::attr_int_t upper_bound
+    ) -> AttributePredicate;
+
+    /**
+     * @param name
+     * @param values
+     * @return An In predicate. The values are stored in hash sets.
+     */
+    [[nodiscard]] static auto create_in(
+            std::string name,
+            std::vector<std::optional<ffi::ir_stream::Attribute>> const& values
+    ) -> AttributePredicate;
+
+    /**
+     * @param name
+     * @param prefix
+     * @return A Prefix predicate.
+     */
+    [[nodiscard]] static auto create_prefix(std::string name, ffi::ir_stream::attr_str_t prefix)
+            -> AttributePredicate;
+
+    /**
+     * @param name
+     * @return An IsNull predicate.
+     */
+    [[nodiscard]] static auto create_is_null(std::string name) -> AttributePredicate;
+
+    [[nodiscard]] auto get_name() const -> std::string const& { return m_name; }
+
+    [[nodiscard]] auto get_type() const -> Type { return m_type; }
+
+    /**
+     * @param attribute
+     * @return Whether the given attribute matches the predicate.
+     */
+    [[nodiscard]] auto matches(std::optional<ffi::ir_stream::Attribute> const& attribute) const
+            -> bool;
+
+private:
+    AttributePredicate(std::string name, Type type) : m_name{std::move(name)}, m_type{type} {}
+
+    std::string m_name;
+    Type m_type;
+
+    // Equals
+    std::optional<ffi::ir_stream::Attribute> m_value;
+
+    // Range
+    ffi::ir_stream::attr_int_t m_lower_bound{cIntMin};
+    ffi::ir_stream::attr_int_t m_upper_bound{cIntMax};
+
+    // In
+    std::unordered_set<ffi::ir_stream::attr_int_t> m_int_set;
+    std::unordered_set<ffi::ir_stream::attr_str_t> m_str_set;
+    bool m_set_contains_null{false};
+
+    // Prefix
+    ffi::ir_stream::attr_str_t m_prefix;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif
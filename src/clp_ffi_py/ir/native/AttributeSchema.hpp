@@ -0,0 +1,55 @@
+#ifndef CLP_FFI_PY_ATTRIBUTE_SCHEMA_HPP
+#define CLP_FFI_PY_ATTRIBUTE_SCHEMA_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class represents the ordered attribute names of a log event. Log events
+ * decoded from the same IR stream share a single schema from the stream's
+ * metadata, and store their attribute values in a vector indexed by it.
+ */
+class AttributeSchema {
+public:
+    /**
+     * @param names The attribute names in order. If a name is repeated, only
+     * its first index can be looked up.
+     */
+    explicit AttributeSchema(std::vector<std::string> names) : m_names{std::move(names)} {
+        for (size_t idx{0}; idx < m_names.size(); ++idx) {
+            m_idx_map.emplace(m_names[idx], idx);
+        }
+    }
+
+    [[nodiscard]] auto get_num_attributes() const -> size_t { return m_names.size(); }
+
+    [[nodiscard]] auto get_names() const -> std::vector<std::string> const& { return m_names; }
+
+    [[nodiscard]] auto get_idx_map() const -> std::unordered_map<std::string, size_t> const& {
+        return m_idx_map;
+    }
+
+    /**
+     * @param name
+     * @return The index of the attribute with the given name, or std::nullopt
+     * if the schema doesn't contain it.
+     */
+    [[nodiscard]] auto find_idx(std::string const& name) const -> std::optional<size_t> {
+        auto const it{m_idx_map.find(name)};
+        if (m_idx_map.cend() == it) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+private:
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, size_t> m_idx_map;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_ATTRIBUTE_SCHEMA_HPP
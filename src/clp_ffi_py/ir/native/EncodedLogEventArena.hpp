@@ -0,0 +1,86 @@
+#ifndef CLP_FFI_PY_ENCODED_LOG_EVENT_ARENA_HPP
+#define CLP_FFI_PY_ENCODED_LOG_EVENT_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include <gsl/span>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A fixed-capacity slab of bytes that encoded log events are appended to. A
+ * slab is shared by all the log events stored in it, and is released once the
+ * arena has moved on to a new slab and the last of these log events is
+ * destroyed.
+ */
+class EncodedLogEventSlab {
+public:
+    explicit EncodedLogEventSlab(size_t capacity)
+            : m_buf{std::make_unique<int8_t[]>(capacity)},
+              m_capacity{capacity} {}
+
+    [[nodiscard]] auto get_num_available_bytes() const -> size_t { return m_capacity - m_size; }
+
+    /**
+     * Appends the given bytes to the slab. The slab must have enough bytes
+     * available.
+     * @param bytes
+     * @return A view of the appended bytes inside the slab.
+     */
+    [[nodiscard]] auto append(gsl::span<int8_t const> bytes) -> gsl::span<int8_t const> {
+        auto* dst{m_buf.get() + m_size};
+        std::memcpy(dst, bytes.data(), bytes.size());
+        m_size += bytes.size();
+        return {dst, bytes.size()};
+    }
+
+private:
+    std::unique_ptr<int8_t[]> m_buf;
+    size_t m_capacity;
+    size_t m_size{0};
+};
+
+/**
+ * A view of an encoded log event stored in a slab. The view holds a reference
+ * to the slab, so the bytes stay valid for as long as the view exists.
+ */
+struct EncodedLogEventRef {
+    std::shared_ptr<EncodedLogEventSlab const> m_slab;
+    gsl::span<int8_t const> m_bytes;
+};
+
+/**
+ * This class stores the encoded log events cached by the decoding methods.
+ * Instead of allocating a buffer for each log event, consecutive log events
+ * are packed into slabs of `cSlabCapacity` bytes. A log event larger than a
+ * slab is stored in a dedicated slab of its own size.
+ */
+class EncodedLogEventArena {
+public:
+    static constexpr size_t cSlabCapacity{64ULL * 1024};
+
+    /**
+     * Copies an encoded log event into the arena.
+     * @param encoded_log_event
+     * @return A reference to the stored copy.
+     */
+    [[nodiscard]] auto store(gsl::span<int8_t const> encoded_log_event) -> EncodedLogEventRef {
+        if (nullptr == m_current_slab
+            || m_current_slab->get_num_available_bytes() < encoded_log_event.size())
+        {
+            m_current_slab = std::make_shared<EncodedLogEventSlab>(
+                    std::max(cSlabCapacity, encoded_log_event.size())
+            );
+        }
+        auto const bytes{m_current_slab->append(encoded_log_event)};
+        return {m_current_slab, bytes};
+    }
+
+private:
+    std::shared_ptr<EncodedLogEventSlab> m_current_slab;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_ENCODED_LOG_EVENT_ARENA_HPP
@@ -0,0 +1,103 @@
+#include "FourByteMessageEncoder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <gsl/span>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/protocol_constants.hpp>
+#include <clp/components/core/src/ir/parsing.hpp>
+#include <clp/components/core/src/ir/types.hpp>
+#include <clp/components/core/src/type_utils.hpp>
+
+#include <clp_ffi_py/ir/native/encoding_utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+auto FourByteMessageEncoder::encode_message(std::string_view message, std::vector<int8_t>& ir_buf)
+        -> bool {
+    namespace Payload = ffi::ir_stream::cProtocol::Payload;
+
+    m_tokenizer.set_message(message);
+    m_constants.clear();
+    m_placeholders.clear();
+
+    auto append_encoded_var = [&](ffi::four_byte_encoded_variable_t encoded_var) {
+        ir_buf.push_back(Payload::VarFourByteEncoding);
+        append_int(encoded_var, ir_buf);
+    };
+
+    // The variables are encoded right away, while the constants and
+    // placeholders are collected to form the logtype, unless it's cached.
+    size_t var_begin_pos{0};
+    size_t var_end_pos{0};
+    size_t constant_begin_pos{0};
+    while (m_tokenizer.get_bounds_of_next_var(var_begin_pos, var_end_pos)) {
+        m_constants.push_back(
+                message.substr(constant_begin_pos, var_begin_pos - constant_begin_pos)
+        );
+        constant_begin_pos = var_end_pos;
+
+        auto const var{message.substr(var_begin_pos, var_end_pos - var_begin_pos)};
+        ffi::four_byte_encoded_variable_t encoded_var{};
+        if (ffi::encode_float_string(var, encoded_var)) {
+            m_placeholders += enum_to_underlying_type(::ir::VariablePlaceholder::Float);
+            append_encoded_var(encoded_var);
+        } else if (ffi::encode_integer_string(var, encoded_var)) {
+            m_placeholders += enum_to_underlying_type(::ir::VariablePlaceholder::Integer);
+            append_encoded_var(encoded_var);
+        } else {
+            m_placeholders += enum_to_underlying_type(::ir::VariablePlaceholder::Dictionary);
+            if (false
+                == append_string(
+                        var,
+                        Payload::VarStrLenUByte,
+                        Payload::VarStrLenUShort,
+                        Payload::VarStrLenInt,
+                        ir_buf
+                ))
+            {
+                return false;
+            }
+        }
+    }
+    m_constants.push_back(message.substr(constant_begin_pos));
+
+    if (nullptr != m_logtype_cache) {
+        auto const cached_logtype{m_logtype_cache->find(m_constants, m_placeholders)};
+        if (cached_logtype.has_value()) {
+            ir_buf.insert(ir_buf.end(), cached_logtype->begin(), cached_logtype->end());
+            return true;
+        }
+    }
+
+    m_logtype.clear();
+    m_logtype.reserve(message.length());
+    for (size_t idx{0}; idx < m_constants.size(); ++idx) {
+        ::ir::escape_and_append_const_to_logtype(m_constants[idx], m_logtype);
+        if (idx < m_placeholders.size()) {
+            m_logtype += m_placeholders[idx];
+        }
+    }
+    auto const logtype_pos{ir_buf.size()};
+    if (false
+        == append_string(
+                m_logtype,
+                Payload::LogtypeStrLenUByte,
+                Payload::LogtypeStrLenUShort,
+                Payload::LogtypeStrLenInt,
+                ir_buf
+        ))
+    {
+        return false;
+    }
+    if (nullptr != m_logtype_cache) {
+        m_logtype_cache->insert(
+                m_constants,
+                m_placeholders,
+                gsl::span<int8_t const>{ir_buf}.subspan(logtype_pos)
+        );
+    }
+    return true;
+}
+}  // namespace clp_ffi_py::ir::native
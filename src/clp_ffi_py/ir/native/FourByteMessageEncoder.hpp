@@ -0,0 +1,68 @@
+#ifndef CLP_FFI_PY_FOUR_BYTE_MESSAGE_ENCODER_HPP
+#define CLP_FFI_PY_FOUR_BYTE_MESSAGE_ENCODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <clp_ffi_py/ir/native/LogtypeCache.hpp>
+#include <clp_ffi_py/ir/native/MessageTokenizer.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class encodes log messages into the CLP IR four-byte encoding. The
+ * output is byte-identical to CLP's `four_byte_encoding::encode_message`, but
+ * the variables are found by `MessageTokenizer`, which classifies the message
+ * in bulk instead of byte by byte. The variables themselves are encoded by
+ * CLP's variable encoding methods.
+ * <p>
+ * The tokenizer's bitmaps and the logtype are reused across messages, so an
+ * encoder should be kept for as long as there are messages to encode. An
+ * encoder can also memoize the logtypes of recently seen messages in a
+ * `LogtypeCache`, in which case a message that follows a cached template only
+ * needs its variables to be encoded. An encoder isn't thread-safe, and it
+ * doesn't access any Python object.
+ */
+class FourByteMessageEncoder {
+public:
+    /**
+     * @param logtype_cache_capacity The number of slots in the logtype cache,
+     * or 0 to encode without a cache.
+     */
+    explicit FourByteMessageEncoder(size_t logtype_cache_capacity = 0)
+            : m_logtype_cache{
+                    0 == logtype_cache_capacity
+                            ? nullptr
+                            : std::make_unique<LogtypeCache>(logtype_cache_capacity)
+            } {}
+
+    /**
+     * Encodes the given message and appends it to `ir_buf`.
+     * @param message
+     * @param ir_buf
+     * @return true on success.
+     * @return false if a variable or the logtype is too long to be encoded, in
+     * which case `ir_buf` may contain a partially encoded message.
+     */
+    [[nodiscard]] auto encode_message(std::string_view message, std::vector<int8_t>& ir_buf)
+            -> bool;
+
+    /**
+     * @return The logtype cache, or nullptr if the encoder doesn't have one.
+     */
+    [[nodiscard]] auto get_logtype_cache() const -> LogtypeCache const* {
+        return m_logtype_cache.get();
+    }
+
+private:
+    MessageTokenizer m_tokenizer;
+    std::unique_ptr<LogtypeCache> m_logtype_cache;
+    std::vector<std::string_view> m_constants;
+    std::string m_placeholders;
+    std::string m_logtype;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_FOUR_BYTE_MESSAGE_ENCODER_HPP
@@ -0,0 +1,115 @@
+#include "IrStreamEncoder.hpp"
+
+#include <utility>
+
+#include <clp/components/core/src/ffi/ir_stream/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/protocol_constants.hpp>
+#include <clp/components/core/src/type_utils.hpp>
+
+#include <clp_ffi_py/ExceptionFFI.hpp>
+#include <clp_ffi_py/ir/native/error_messages.hpp>
+
+namespace clp_ffi_py::ir::native {
+IrStreamEncoder::IrStreamEncoder(
+        ffi::epoch_time_ms_t ref_timestamp,
+        std::string_view timestamp_format,
+        std::string_view timezone,
+        std::optional<int> compression_level,
+        size_t initial_buffer_capacity,
+        size_t logtype_cache_capacity,
+        std::vector<ffi::ir_stream::AttributeInfo> attribute_table
+)
+        : m_message_encoder{logtype_cache_capacity},
+          m_last_timestamp{ref_timestamp} {
+    if (compression_level.has_value()) {
+        m_compressor = std::make_unique<ZstdCompressor>(compression_level.value());
+    }
+    if (false == attribute_table.empty()) {
+        m_null_attributes.resize(attribute_table.size());
+        m_attribute_encoder.emplace(std::move(attribute_table));
+    }
+    m_ir_buf.reserve(initial_buffer_capacity);
+    bool const is_preamble_encoded{
+            m_attribute_encoder.has_value()
+                    ? m_attribute_encoder->encode_preamble(
+                              timestamp_format,
+                              timezone,
+                              ref_timestamp,
+                              m_ir_buf
+                      )
+                    : ffi::ir_stream::four_byte_encoding::encode_preamble(
+                              timestamp_format,
+                              {},
+                              timezone,
+                              ref_timestamp,
+                              m_ir_buf
+                      )
+    };
+    if (false == is_preamble_encoded) {
+        throw ExceptionFFI(ErrorCode_Unsupported, __FILE__, __LINE__, cEncodePreambleError);
+    }
+}
+
+auto IrStreamEncoder::encode_log_event(
+        ffi::epoch_time_ms_t timestamp,
+        std::string_view log_message,
+        gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes
+) -> void {
+    auto const ir_buf_size{m_ir_buf.size()};
+    // The attributes precede the message, and are only left in the buffer if
+    // the rest of the log event can be encoded.
+    if (m_attribute_encoder.has_value()) {
+        m_attribute_encoder->encode_attributes(
+                attributes.empty() ? m_null_attributes : attributes,
+                m_ir_buf
+        );
+    } else if (false == attributes.empty()) {
+        throw ExceptionFFI(
+                ErrorCode_BadParam,
+                __FILE__,
+                __LINE__,
+                "The IR stream doesn't declare any attribute."
+        );
+    }
+    if (false == m_message_encoder.encode_message(log_message, m_ir_buf)) {
+        m_ir_buf.resize(ir_buf_size);
+        throw ExceptionFFI(ErrorCode_Unsupported, __FILE__, __LINE__, cEncodeMessageError);
+    }
+    if (false
+        == ffi::ir_stream::four_byte_encoding::encode_timestamp(
+                timestamp - m_last_timestamp,
+                m_ir_buf
+        ))
+    {
+        m_ir_buf.resize(ir_buf_size);
+        throw ExceptionFFI(ErrorCode_Unsupported, __FILE__, __LINE__, cEncodeTimestampError);
+    }
+    m_last_timestamp = timestamp;
+}
+
+auto IrStreamEncoder::encode_end_of_stream() -> void {
+    m_ir_buf.push_back(static_cast<int8_t>(ffi::ir_stream::cProtocol::Eof));
+}
+
+auto IrStreamEncoder::prepare_output(ZSTD_EndDirective directive) -> std::string_view {
+    std::string_view const ir_bytes{
+            size_checked_pointer_cast<char const>(m_ir_buf.data()),
+            m_ir_buf.size()
+    };
+    if (nullptr == m_compressor) {
+        return ir_bytes;
+    }
+    m_compressor->compress(ir_bytes, directive, m_compressed_buf);
+    // Once compressed, the IR bytes belong to the zstd stream.
+    m_ir_buf.clear();
+    return m_compressed_buf;
+}
+
+auto IrStreamEncoder::clear_output() -> void {
+    if (nullptr == m_compressor) {
+        m_ir_buf.clear();
+    } else {
+        m_compressed_buf.clear();
+    }
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,135 @@
+#ifndef CLP_FFI_PY_IR_STREAM_ENCODER_HPP
+#define CLP_FFI_PY_IR_STREAM_ENCODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gsl/span>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
+
+#include <clp_ffi_py/ir/native/AttributeEncoder.hpp>
+#include <clp_ffi_py/ir/native/FourByteMessageEncoder.hpp>
+#include <clp_ffi_py/ir/native/LogtypeCache.hpp>
+#include <clp_ffi_py/ir/native/ZstdCompressor.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class encodes log events into a CLP IR stream (four-byte encoding) in
+ * memory, optionally compressing the stream with zstd. It tracks the last
+ * timestamp, so log events are encoded with their absolute timestamps. If the
+ * stream declares an attribute table, each log event is encoded with a value
+ * (or null) for every attribute.
+ * <p>
+ * The encoded log events are buffered until the owner takes them as output,
+ * which is done in two steps so the output is kept if writing it fails:
+ * - `prepare_output` compresses the buffered bytes (if the stream is
+ *   compressed) and returns a view of the bytes to write;
+ * - `clear_output` drops the output once it has been written.
+ * <p>
+ * This class doesn't access any Python object, so it can be used without
+ * holding the GIL.
+ */
+class IrStreamEncoder {
+public:
+    /**
+     * Creates an encoder and encodes the preamble into its buffer.
+     * @param ref_timestamp
+     * @param timestamp_format
+     * @param timezone
+     * @param compression_level The zstd compression level, or std::nullopt to
+     * encode the IR stream uncompressed.
+     * @param initial_buffer_capacity
+     * @param logtype_cache_capacity The number of slots in the cache of
+     * recently encoded logtypes, or 0 to encode without a cache.
+     * @param attribute_table The attributes declared by the stream, or an
+     * empty table to encode log events without attributes.
+     * @throw ExceptionFFI if the preamble can't be encoded, or the compressor
+     * can't be created.
+     */
+    IrStreamEncoder(
+            ffi::epoch_time_ms_t ref_timestamp,
+            std::string_view timestamp_format,
+            std::string_view timezone,
+            std::optional<int> compression_level,
+            size_t initial_buffer_capacity,
+            size_t logtype_cache_capacity,
+            std::vector<ffi::ir_stream::AttributeInfo> attribute_table
+    );
+
+    /**
+     * Encodes the given log event into the buffer.
+     * @param timestamp
+     * @param log_message
+     * @param attributes The value of each attribute, in the order of the
+     * attribute table. If empty, all the attributes are encoded as null.
+     * @throw ExceptionFFI if the log event can't be encoded, or its attributes
+     * don't match the attribute table, in which case the buffer is left as it
+     * was before the call.
+     */
+    auto encode_log_event(
+            ffi::epoch_time_ms_t timestamp,
+            std::string_view log_message,
+            gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes = {}
+    ) -> void;
+
+    /**
+     * Encodes the end of the IR stream into the buffer.
+     */
+    auto encode_end_of_stream() -> void;
+
+    /**
+     * @return The number of encoded bytes buffered since the last call to
+     * `prepare_output`.
+     */
+    [[nodiscard]] auto get_num_buffered_bytes() const -> size_t { return m_ir_buf.size(); }
+
+    /**
+     * @return The logtype cache, or nullptr if the encoder doesn't have one.
+     */
+    [[nodiscard]] auto get_logtype_cache() const -> LogtypeCache const* {
+        return m_message_encoder.get_logtype_cache();
+    }
+
+    /**
+     * @return The attribute encoder, or nullptr if the stream doesn't declare
+     * any attribute.
+     */
+    [[nodiscard]] auto get_attribute_encoder() const -> AttributeEncoder const* {
+        return m_attribute_encoder.has_value() ? &m_attribute_encoder.value() : nullptr;
+    }
+
+    /**
+     * Moves the buffered bytes into the output, compressing them first if the
+     * stream is compressed. Output that hasn't been cleared is kept in front
+     * of the new output.
+     * @param directive The zstd directive used to compress the buffered bytes.
+     * Ignored if the stream isn't compressed.
+     * @return A view of the output, valid until the next call to a non-const
+     * method.
+     * @throw ExceptionFFI if zstd fails to compress.
+     */
+    [[nodiscard]] auto prepare_output(ZSTD_EndDirective directive) -> std::string_view;
+
+    /**
+     * Drops the output returned by `prepare_output`.
+     */
+    auto clear_output() -> void;
+
+private:
+    std::unique_ptr<ZstdCompressor> m_compressor;
+    std::vector<int8_t> m_ir_buf;
+    std::string m_compressed_buf;
+    FourByteMessageEncoder m_message_encoder;
+    std::optional<AttributeEncoder> m_attribute_encoder;
+    std::vector<std::optional<ffi::ir_stream::Attribute>> m_null_attributes;
+    ffi::epoch_time_ms_t m_last_timestamp;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_IR_STREAM_ENCODER_HPP
@@ -0,0 +1,109 @@
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include "IrStreamWriter.hpp"
+
+#include <new>
+
+#include <clp_ffi_py/ExceptionFFI.hpp>
+#include <clp_ffi_py/ir/native/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+constexpr char const* cClosedWriterError = "I/O operation on a closed ClpIrStreamWriter.";
+}  // namespace
+
+auto IrStreamWriter::create(
+        PyObject* sink,
+        ffi::epoch_time_ms_t ref_timestamp,
+        std::string_view timestamp_format,
+        std::string_view timezone,
+        std::optional<int> compression_level,
+        size_t flush_threshold,
+        size_t logtype_cache_capacity,
+        std::vector<ffi::ir_stream::AttributeInfo> attribute_table
+) -> std::unique_ptr<IrStreamWriter> {
+    auto output_sink{OutputSink::create(sink)};
+    if (false == output_sink.has_value()) {
+        return nullptr;
+    }
+    std::unique_ptr<IrStreamEncoder> encoder;
+    try {
+        encoder = std::make_unique<IrStreamEncoder>(
+                ref_timestamp,
+                timestamp_format,
+                timezone,
+                compression_level,
+                flush_threshold,
+                logtype_cache_capacity,
+                std::move(attribute_table)
+        );
+    } catch (ExceptionFFI const& ex) {
+        set_py_error_from_exception(ex);
+        return nullptr;
+    } catch (std::bad_alloc const&) {
+        PyErr_NoMemory();
+        return nullptr;
+    }
+    return std::unique_ptr<IrStreamWriter>{
+            new IrStreamWriter{std::move(output_sink.value()), std::move(encoder), flush_threshold}
+    };
+}
+
+auto IrStreamWriter::write_log_event(
+        ffi::epoch_time_ms_t timestamp,
+        std::string_view log_message,
+        gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes
+) -> bool {
+    if (m_is_closed) {
+        PyErr_SetString(PyExc_ValueError, cClosedWriterError);
+        return false;
+    }
+
+    try {
+        m_encoder->encode_log_event(timestamp, log_message, attributes);
+    } catch (ExceptionFFI const& ex) {
+        set_py_error_from_exception(ex);
+        return false;
+    }
+    ++m_num_log_events;
+
+    if (m_encoder->get_num_buffered_bytes() < m_flush_threshold) {
+        return true;
+    }
+    return write_buffer(ZSTD_e_continue);
+}
+
+auto IrStreamWriter::flush() -> bool {
+    if (m_is_closed) {
+        PyErr_SetString(PyExc_ValueError, cClosedWriterError);
+        return false;
+    }
+    return write_buffer(ZSTD_e_flush);
+}
+
+auto IrStreamWriter::close() -> bool {
+    if (m_is_closed) {
+        return true;
+    }
+    // The writer is closed even if the writing fails, since the end of the
+    // stream may have been consumed by the compressor already.
+    m_is_closed = true;
+    m_encoder->encode_end_of_stream();
+    return write_buffer(ZSTD_e_end);
+}
+
+auto IrStreamWriter::write_buffer(ZSTD_EndDirective directive) -> bool {
+    std::string_view output;
+    try {
+        output = m_encoder->prepare_output(directive);
+    } catch (ExceptionFFI const& ex) {
+        set_py_error_from_exception(ex);
+        return false;
+    }
+    if (false == m_sink.write(output)) {
+        return false;
+    }
+    m_encoder->clear_output();
+    return true;
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,148 @@
+#ifndef CLP_FFI_PY_IR_STREAM_WRITER_HPP
+#define CLP_FFI_PY_IR_STREAM_WRITER_HPP
+
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gsl/span>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
+
+#include <clp_ffi_py/ir/native/AttributeEncoder.hpp>
+#include <clp_ffi_py/ir/native/IrStreamEncoder.hpp>
+#include <clp_ffi_py/ir/native/LogtypeCache.hpp>
+#include <clp_ffi_py/ir/native/OutputSink.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class encodes log events into a CLP IR stream (four-byte encoding) and
+ * writes the stream to an `OutputSink`. Unlike the stateless
+ * `FourByteEncoder` methods, the writer:
+ * - tracks the last timestamp, so log events are written with their absolute
+ *   timestamps;
+ * - appends the encoded log events into a single reused buffer, which is only
+ *   written to the sink (optionally zstd-compressed) once it reaches the flush
+ *   threshold, or when explicitly flushed or closed.
+ * <p>
+ * The writer holds a reference to the sink, so it must only be used and
+ * destroyed while holding the GIL.
+ */
+class IrStreamWriter {
+public:
+    static constexpr size_t cDefaultFlushThreshold{64ULL * 1024ULL};
+    static constexpr int cDefaultCompressionLevel{3};
+
+    /**
+     * Creates a writer and encodes the preamble into its buffer.
+     * @param sink A file descriptor or a Python object with a `write` method.
+     * @param ref_timestamp
+     * @param timestamp_format
+     * @param timezone
+     * @param compression_level The zstd compression level, or std::nullopt to
+     * write the IR stream uncompressed.
+     * @param flush_threshold The number of buffered IR bytes that triggers a
+     * write to the sink.
+     * @param logtype_cache_capacity The number of slots in the cache of
+     * recently encoded logtypes, or 0 to encode without a cache.
+     * @param attribute_table The attributes declared by the stream, or an
+     * empty table to write log events without attributes.
+     * @return The created writer.
+     * @return nullptr on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] static auto create(
+            PyObject* sink,
+            ffi::epoch_time_ms_t ref_timestamp,
+            std::string_view timestamp_format,
+            std::string_view timezone,
+            std::optional<int> compression_level,
+            size_t flush_threshold,
+            size_t logtype_cache_capacity,
+            std::vector<ffi::ir_stream::AttributeInfo> attribute_table
+    ) -> std::unique_ptr<IrStreamWriter>;
+
+    /**
+     * Encodes the given log event into the buffer, and writes the buffer to
+     * the sink once it reaches the flush threshold.
+     * @param timestamp
+     * @param log_message
+     * @param attributes The value of each attribute, in the order of the
+     * attribute table. If empty, all the attributes are written as null.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set. The buffer is left as it was before the call.
+     */
+    [[nodiscard]] auto write_log_event(
+            ffi::epoch_time_ms_t timestamp,
+            std::string_view log_message,
+            gsl::span<std::optional<ffi::ir_stream::Attribute> const> attributes = {}
+    ) -> bool;
+
+    /**
+     * Writes all the buffered data to the sink. If the stream is compressed,
+     * the zstd frame is flushed so that everything written so far can be
+     * decompressed.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto flush() -> bool;
+
+    /**
+     * Terminates the IR stream, ends the zstd frame if the stream is
+     * compressed, and writes all the buffered data to the sink. The sink itself
+     * isn't closed. Closing a closed writer does nothing.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set. The writer is closed regardless.
+     */
+    [[nodiscard]] auto close() -> bool;
+
+    [[nodiscard]] auto is_closed() const -> bool { return m_is_closed; }
+
+    [[nodiscard]] auto get_num_log_events() const -> size_t { return m_num_log_events; }
+
+    [[nodiscard]] auto get_logtype_cache() const -> LogtypeCache const* {
+        return m_encoder->get_logtype_cache();
+    }
+
+    [[nodiscard]] auto get_attribute_encoder() const -> AttributeEncoder const* {
+        return m_encoder->get_attribute_encoder();
+    }
+
+private:
+    IrStreamWriter(
+            OutputSink sink,
+            std::unique_ptr<IrStreamEncoder> encoder,
+            size_t flush_threshold
+    )
+            : m_sink{std::move(sink)},
+              m_encoder{std::move(encoder)},
+              m_flush_threshold{flush_threshold} {}
+
+    /**
+     * Writes the buffered IR bytes to the sink, compressing them first if the
+     * stream is compressed.
+     * @param directive The zstd directive used to compress the buffered bytes.
+     * Ignored if the stream isn't compressed.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto write_buffer(ZSTD_EndDirective directive) -> bool;
+
+    OutputSink m_sink;
+    std::unique_ptr<IrStreamEncoder> m_encoder;
+    size_t m_flush_threshold;
+    size_t m_num_log_events{0};
+    bool m_is_closed{false};
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_IR_STREAM_WRITER_HPP
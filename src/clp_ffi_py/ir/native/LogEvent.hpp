@@ -1,23 +1,45 @@
 #ifndef CLP_FFI_PY_LOG_EVENT_HPP
 #define CLP_FFI_PY_LOG_EVENT_HPP
 
+#include <cstddef>
+#include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <clp/components/core/src/ffi/encoding_methods.hpp>
 #include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
 #include <gsl/span>
 
+#include <clp_ffi_py/ir/native/AttributeSchema.hpp>
+#include <clp_ffi_py/ir/native/EncodedLogEventArena.hpp>
+
 namespace clp_ffi_py::ir::native {
 /**
  * A class that represents a decoded IR log event. Contains ways to access (get
  * or set) the log message, the timestamp, and the log event index.
+ * <p>
+ * The attributes are stored as a vector of values indexed by an attribute
+ * schema. Log events decoded from the same IR stream share the schema of the
+ * stream's metadata, so the attribute names are not copied into each event.
+ * <p>
+ * The members are ordered by how often they are accessed: the timestamp and
+ * the index are followed by the log message, so that the fields read by the
+ * getters and by query matching share the leading cache line.
  */
 class LogEvent {
 public:
+    /**
+     * The largest log message buffer a recycled log event keeps (see
+     * `recycle`).
+     */
+    static constexpr size_t cMaxRetainedMessageCapacity{64ULL * 1024ULL};
+
     using attribute_table_t
             = std::unordered_map<std::string, std::optional<ffi::ir_stream::Attribute>>;
+    using attribute_values_t = std::vector<std::optional<ffi::ir_stream::Attribute>>;
 
     LogEvent() = delete;
 
@@ -27,59 +49,88 @@ public:
      * @param log_message
      * @param timestamp
      * @param index
+     * @param attribute_schema The schema of the attribute values. Can be
+     * nullptr if there are no attribute values.
+     * @param attribute_values The attribute values, indexed by
+     * `attribute_schema`.
      * @param formatted_timestamp
-     * @param encoded_log_event_view
+     * @param cached_encoded_log_event The encoded log event stored in an
+     * arena. The log event shares the arena's slab instead of copying it.
      */
     explicit LogEvent(
-            std::string_view log_message,
+            std::string log_message,
             ffi::epoch_time_ms_t timestamp,
             size_t index,
-            attribute_table_t attributes,
+            std::shared_ptr<AttributeSchema const> attribute_schema,
+            attribute_values_t attribute_values,
             std::optional<std::string_view> formatted_timestamp = std::nullopt,
-            std::optional<gsl::span<int8_t>> encoded_log_event_view = std::nullopt
+            std::optional<EncodedLogEventRef> cached_encoded_log_event = std::nullopt
     )
-            : m_log_message{log_message},
-              m_timestamp{timestamp},
+            : m_timestamp{timestamp},
               m_index{index},
-              m_attributes(std::move(attributes)),
-              m_cached_encoded_log_event_size{0} {
+              m_log_message{std::move(log_message)},
+              m_attribute_schema{std::move(attribute_schema)},
+              m_attribute_values{std::move(attribute_values)} {
         if (formatted_timestamp.has_value()) {
             m_formatted_timestamp = std::string(formatted_timestamp.value());
         }
-        if (encoded_log_event_view.has_value()) {
-            m_cached_encoded_log_event_size = encoded_log_event_view->size();
-            m_cached_encoded_log_event
-                    = std::make_unique<int8_t[]>(m_cached_encoded_log_event_size);
-            memcpy(m_cached_encoded_log_event.get(),
-                   encoded_log_event_view->data(),
-                   m_cached_encoded_log_event_size);
+        if (cached_encoded_log_event.has_value()) {
+            m_cached_encoded_log_event = std::move(cached_encoded_log_event.value());
         }
     }
 
-    [[nodiscard]] auto get_log_message() const -> std::string { return m_log_message; }
+    [[nodiscard]] auto get_log_message() const -> std::string const& {
+        return nullptr != m_shared_log_message ? *m_shared_log_message : m_log_message;
+    }
 
     [[nodiscard]] auto get_log_message_view() const -> std::string_view {
-        return std::string_view{m_log_message};
+        return std::string_view{get_log_message()};
     }
 
     [[nodiscard]] auto get_timestamp() const -> ffi::epoch_time_ms_t { return m_timestamp; }
 
-    [[nodiscard]] auto get_formatted_timestamp() const -> std::string {
+    [[nodiscard]] auto get_formatted_timestamp() const -> std::string const& {
         return m_formatted_timestamp;
     }
 
     [[nodiscard]] auto get_index() const -> size_t { return m_index; }
 
-    [[nodiscard]] auto get_attributes() const -> attribute_table_t const& { return m_attributes; }
+    [[nodiscard]] auto get_attribute_schema() const
+            -> std::shared_ptr<AttributeSchema const> const& {
+        return m_attribute_schema;
+    }
 
-    [[nodiscard]] auto has_attributes() const -> bool { return false == m_attributes.empty(); }
+    [[nodiscard]] auto get_attribute_values() const -> attribute_values_t const& {
+        return m_attribute_values;
+    }
+
+    [[nodiscard]] auto has_attributes() const -> bool {
+        return false == m_attribute_values.empty();
+    }
+
+    /**
+     * @param name
+     * @return A pointer to the value of the attribute with the given name.
+     * @return nullptr if the log event doesn't have the attribute.
+     */
+    [[nodiscard]] auto find_attribute(std::string const& name) const
+            -> std::optional<ffi::ir_stream::Attribute> const* {
+        if (nullptr == m_attribute_schema) {
+            return nullptr;
+        }
+        auto const idx{m_attribute_schema->find_idx(name)};
+        if (false == idx.has_value() || idx.value() >= m_attribute_values.size()) {
+            return nullptr;
+        }
+        return &m_attribute_values[idx.value()];
+    }
 
     [[nodiscard]] auto has_cached_encoded_log_event() const -> bool {
-        return nullptr != m_cached_encoded_log_event.get();
+        return nullptr != m_cached_encoded_log_event.m_slab;
     }
 
-    [[nodiscard]] auto get_cached_encoded_log_event() const -> gsl::span<int8_t> {
-        return gsl::span<int8_t>{m_cached_encoded_log_event.get(), m_cached_encoded_log_event_size};
+    [[nodiscard]] auto get_cached_encoded_log_event() const -> gsl::span<int8_t const> {
+        return m_cached_encoded_log_event.m_bytes;
     }
 
     /**
@@ -89,7 +140,20 @@ public:
         return (false == m_formatted_timestamp.empty());
     }
 
-    auto set_log_message(std::string_view log_message) -> void { m_log_message = log_message; }
+    auto set_log_message(std::string_view log_message) -> void {
+        m_shared_log_message.reset();
+        m_log_message = log_message;
+    }
+
+    /**
+     * Replaces the log message with an immutable log message shared with other
+     * log events (see `LogMessageInternCache`).
+     * @param log_message
+     */
+    auto set_shared_log_message(std::shared_ptr<std::string const> log_message) -> void {
+        m_shared_log_message = std::move(log_message);
+        m_log_message.clear();
+    }
 
     auto set_timestamp(ffi::epoch_time_ms_t timestamp) -> void { m_timestamp = timestamp; }
 
@@ -99,14 +163,67 @@ public:
 
     auto set_index(size_t index) -> void { m_index = index; }
 
+    /**
+     * Releases everything the log event shares with other objects (the
+     * attribute schema, the interned log message, and the cached encoded log
+     * event) and clears its values, but keeps the capacity of its buffers so
+     * that `reset` can reuse them. A log message buffer larger than
+     * `cMaxRetainedMessageCapacity` is released.
+     */
+    auto recycle() -> void {
+        if (m_log_message.capacity() > cMaxRetainedMessageCapacity) {
+            std::string{}.swap(m_log_message);
+        } else {
+            m_log_message.clear();
+        }
+        m_shared_log_message.reset();
+        m_formatted_timestamp.clear();
+        m_attribute_schema.reset();
+        m_attribute_values.clear();
+        m_cached_encoded_log_event = {};
+    }
+
+    /**
+     * Reinitializes a recycled log event with the same values as the
+     * constructor. The log message and the attribute values are swapped with
+     * the log event's own buffers, so the caller gets the recycled buffers
+     * back, cleared, and neither side allocates in the steady state.
+     * @param log_message
+     * @param timestamp
+     * @param index
+     * @param attribute_schema
+     * @param attribute_values
+     * @param cached_encoded_log_event
+     */
+    auto reset(
+            std::string& log_message,
+            ffi::epoch_time_ms_t timestamp,
+            size_t index,
+            std::shared_ptr<AttributeSchema const> attribute_schema,
+            attribute_values_t& attribute_values,
+            std::optional<EncodedLogEventRef> cached_encoded_log_event
+    ) -> void {
+        m_timestamp = timestamp;
+        m_index = index;
+        m_log_message.swap(log_message);
+        log_message.clear();
+        m_attribute_schema = std::move(attribute_schema);
+        m_attribute_values.swap(attribute_values);
+        attribute_values.clear();
+        if (cached_encoded_log_event.has_value()) {
+            m_cached_encoded_log_event = std::move(cached_encoded_log_event.value());
+        }
+    }
+
 private:
-    std::string m_log_message;
     ffi::epoch_time_ms_t m_timestamp;
     size_t m_index;
+    std::string m_log_message;
+    std::shared_ptr<std::string const> m_shared_log_message;
     std::string m_formatted_timestamp;
-    attribute_table_t m_attributes;
-    std::unique_ptr<int8_t[]> m_cached_encoded_log_event;
-    size_t m_cached_encoded_log_event_size;
+    std::shared_ptr<AttributeSchema const> m_attribute_schema;
+    attribute_values_t m_attribute_values;
+    EncodedLogEventRef m_cached_encoded_log_event;
 };
 }  // namespace clp_ffi_py::ir::native
 
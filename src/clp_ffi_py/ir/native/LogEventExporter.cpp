@@ -0,0 +1,294 @@
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include "LogEventExporter.hpp"
+
+#include <array>
+#include <charconv>
+#include <utility>
+
+#include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
+
+#include <clp_ffi_py/ir/native/utils.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+constexpr std::string_view cFormatText{"text"};
+constexpr std::string_view cFormatJsonLines{"jsonl"};
+
+/**
+ * Appends the given integer to the string.
+ * @param value
+ * @param str
+ */
+auto append_integer(int64_t value, std::string& str) -> void {
+    // Large enough for any 64-bit integer with its sign.
+    std::array<char, 20> digits{};
+    auto const result{std::to_chars(digits.data(), digits.data() + digits.size(), value)};
+    str.append(digits.data(), result.ptr);
+}
+
+/**
+ * Scans the UTF-8 sequence starting with a non-ASCII byte.
+ * @param value
+ * @param pos The position of the non-ASCII byte in `value`.
+ * @param is_valid Returns whether the sequence is a valid UTF-8 encoded code
+ * point.
+ * @return The length of the code point if it's valid, or else the length of its
+ * longest valid prefix (at least 1), which is replaced by a single U+FFFD, the
+ * same as in Python's `bytes.decode("utf-8", "replace")`.
+ */
+auto scan_utf8_sequence(std::string_view value, size_t pos, bool& is_valid) -> size_t {
+    constexpr uint8_t cMinContinuationByte{0x80};
+    constexpr uint8_t cMaxContinuationByte{0xBF};
+    auto const lead{static_cast<uint8_t>(value[pos])};
+    size_t num_continuation_bytes{0};
+    // Restricting the second byte rejects overlong encodings, surrogates, and
+    // code points above U+10FFFF.
+    uint8_t second_min{cMinContinuationByte};
+    uint8_t second_max{cMaxContinuationByte};
+    if (0xC2 <= lead && lead <= 0xDF) {
+        num_continuation_bytes = 1;
+    } else if (0xE0 <= lead && lead <= 0xEF) {
+        num_continuation_bytes = 2;
+        if (0xE0 == lead) {
+            second_min = 0xA0;
+        } else if (0xED == lead) {
+            second_max = 0x9F;
+        }
+    } else if (0xF0 <= lead && lead <= 0xF4) {
+        num_continuation_bytes = 3;
+        if (0xF0 == lead) {
+            second_min = 0x90;
+        } else if (0xF4 == lead) {
+            second_max = 0x8F;
+        }
+    } else {
+        is_valid = false;
+        return 1;
+    }
+    for (size_t i{1}; i <= num_continuation_bytes; ++i) {
+        if (pos + i >= value.size()) {
+            is_valid = false;
+            return i;
+        }
+        auto const c{static_cast<uint8_t>(value[pos + i])};
+        if (c < (1 == i ? second_min : cMinContinuationByte)
+            || c > (1 == i ? second_max : cMaxContinuationByte))
+        {
+            is_valid = false;
+            return i;
+        }
+    }
+    is_valid = true;
+    return num_continuation_bytes + 1;
+}
+
+/**
+ * Appends the given string to `str` as a JSON string, escaping the quotation
+ * mark, the reverse solidus, and the control characters. Valid non-ASCII UTF-8
+ * sequences are copied as-is, and invalid ones are replaced by `\ufffd` (see
+ * `scan_utf8_sequence`), so that the output is always valid JSON.
+ * @param value
+ * @param str
+ */
+auto append_json_string(std::string_view value, std::string& str) -> void {
+    constexpr std::string_view cHexDigits{"0123456789abcdef"};
+    constexpr unsigned char cMaxAsciiChar{0x7F};
+    str += '"';
+    size_t unescaped_begin{0};
+    size_t i{0};
+    while (i < value.size()) {
+        auto const c{static_cast<unsigned char>(value[i])};
+        if (c > cMaxAsciiChar) {
+            bool is_valid{false};
+            auto const sequence_length{scan_utf8_sequence(value, i, is_valid)};
+            if (false == is_valid) {
+                str.append(value.substr(unescaped_begin, i - unescaped_begin));
+                str += "\\ufffd";
+                unescaped_begin = i + sequence_length;
+            }
+            i += sequence_length;
+            continue;
+        }
+        if ('"' != c && '\\' != c && c >= 0x20) {
+            ++i;
+            continue;
+        }
+        str.append(value.substr(unescaped_begin, i - unescaped_begin));
+        unescaped_begin = i + 1;
+        ++i;
+        switch (c) {
+            case '"':
+                str += "\\\"";
+                break;
+            case '\\':
+                str += "\\\\";
+                break;
+            case '\n':
+                str += "\\n";
+                break;
+            case '\r':
+                str += "\\r";
+                break;
+            case '\t':
+                str += "\\t";
+                break;
+            default:
+                str += "\\u00";
+                str += cHexDigits[c >> 4U];
+                str += cHexDigits[c & 0xFU];
+                break;
+        }
+    }
+    str.append(value.substr(unescaped_begin));
+    str += '"';
+}
+}  // namespace
+
+auto LogEventExporter::create(PyMetadata* py_metadata, PyObject* sink, PyObject* py_format)
+        -> std::optional<LogEventExporter> {
+    std::string_view format_name{cFormatText};
+    if (nullptr != py_format && false == parse_py_string_as_string_view(py_format, format_name)) {
+        return std::nullopt;
+    }
+    Format format{Format::Text};
+    if (cFormatJsonLines == format_name) {
+        format = Format::JsonLines;
+    } else if (cFormatText != format_name) {
+        PyErr_Format(
+                PyExc_ValueError,
+                "Unsupported export format: %U. Expected \"text\" or \"jsonl\".",
+                py_format
+        );
+        return std::nullopt;
+    }
+
+    auto output_sink{OutputSink::create(sink)};
+    if (false == output_sink.has_value()) {
+        return std::nullopt;
+    }
+    LogEventExporter exporter{py_metadata, format, std::move(output_sink.value())};
+    exporter.m_batch.reserve(cBatchSize);
+    return exporter;
+}
+
+auto LogEventExporter::export_log_event(
+        std::string_view log_message,
+        ffi::epoch_time_ms_t timestamp,
+        size_t index,
+        LogEvent::attribute_values_t const& attribute_values
+) -> bool {
+    auto const batch_size{m_batch.size()};
+    bool const success{
+            Format::Text == m_format
+                    ? append_text(log_message, timestamp, attribute_values)
+                    : append_json_line(log_message, timestamp, index, attribute_values)
+    };
+    if (false == success) {
+        // Drops the partially formatted log event.
+        m_batch.resize(batch_size);
+        return false;
+    }
+    ++m_num_exported_log_events;
+    if (m_batch.size() >= cBatchSize) {
+        return flush();
+    }
+    return true;
+}
+
+auto LogEventExporter::flush() -> bool {
+    if (false == m_sink.write(m_batch)) {
+        return false;
+    }
+    m_batch.clear();
+    return true;
+}
+
+auto LogEventExporter::append_text(
+        std::string_view log_message,
+        ffi::epoch_time_ms_t timestamp,
+        LogEvent::attribute_values_t const& attribute_values
+) -> bool {
+    if (false
+        == append_formatted_timestamp(
+                timestamp,
+                m_py_metadata,
+                m_py_metadata->get_py_timezone(),
+                m_batch
+        ))
+    {
+        return false;
+    }
+    auto const* metadata{m_py_metadata->get_metadata()};
+    if (metadata->is_android_log() && false == attribute_values.empty()) {
+        if (false
+            == append_formatted_android_attributes(
+                    metadata->get_attribute_schema().get(),
+                    attribute_values,
+                    m_batch
+            ))
+        {
+            return false;
+        }
+    }
+    m_batch.append(log_message);
+    return true;
+}
+
+auto LogEventExporter::append_json_line(
+        std::string_view log_message,
+        ffi::epoch_time_ms_t timestamp,
+        size_t index,
+        LogEvent::attribute_values_t const& attribute_values
+) -> bool {
+    m_batch += R"({"log_message":)";
+    append_json_string(log_message, m_batch);
+    m_batch += R"(,"timestamp":)";
+    append_integer(timestamp, m_batch);
+    m_batch += R"(,"formatted_timestamp":)";
+    // The timestamp format comes from the stream's metadata, so the formatted
+    // timestamp is escaped the same as the message.
+    m_formatted_timestamp.clear();
+    if (false
+        == append_formatted_timestamp(
+                timestamp,
+                m_py_metadata,
+                m_py_metadata->get_py_timezone(),
+                m_formatted_timestamp
+        ))
+    {
+        return false;
+    }
+    append_json_string(m_formatted_timestamp, m_batch);
+    m_batch += R"(,"index":)";
+    append_integer(static_cast<int64_t>(index), m_batch);
+    m_batch += R"(,"attributes":)";
+    if (attribute_values.empty()) {
+        m_batch += "null";
+    } else {
+        auto const& attribute_names{
+                m_py_metadata->get_metadata()->get_attribute_schema()->get_names()
+        };
+        m_batch += '{';
+        for (size_t i{0}; i < attribute_values.size(); ++i) {
+            if (0 != i) {
+                m_batch += ',';
+            }
+            append_json_string(attribute_names[i], m_batch);
+            m_batch += ':';
+            auto const& attribute{attribute_values[i]};
+            if (false == attribute.has_value()) {
+                m_batch += "null";
+            } else if (attribute->is_type<ffi::ir_stream::attr_int_t>()) {
+                append_integer(attribute->get_value<ffi::ir_stream::attr_int_t>(), m_batch);
+            } else {
+                append_json_string(attribute->get_value<ffi::ir_stream::attr_str_t>(), m_batch);
+            }
+        }
+        m_batch += '}';
+    }
+    m_batch += "}\n";
+    return true;
+}
+}  // namespace clp_ffi_py::ir::native
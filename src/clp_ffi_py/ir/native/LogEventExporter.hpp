@@ -0,0 +1,119 @@
+#ifndef CLP_FFI_PY_LOG_EVENT_EXPORTER_HPP
+#define CLP_FFI_PY_LOG_EVENT_EXPORTER_HPP
+
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+
+#include <clp_ffi_py/ir/native/LogEvent.hpp>
+#include <clp_ffi_py/ir/native/OutputSink.hpp>
+#include <clp_ffi_py/ir/native/PyMetadata.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class formats decoded log events and writes them to an `OutputSink` in
+ * large batches, so that exporting an IR stream doesn't create any Python
+ * object per log event. The log events are formatted either as text, the same
+ * as `LogEvent.get_formatted_message`, or as JSON Lines, with the same fields
+ * as a pickled LogEvent.
+ * <p>
+ * The exporter holds a reference to the sink, so it must only be used and
+ * destroyed while holding the GIL.
+ */
+class LogEventExporter {
+public:
+    enum class Format : uint8_t {
+        Text,
+        JsonLines
+    };
+
+    static constexpr size_t cBatchSize{1024ULL * 1024ULL};
+
+    /**
+     * Creates an exporter.
+     * @param py_metadata The metadata of the exported IR stream. It must
+     * outlive the exporter.
+     * @param sink A file descriptor or a Python object with a `write` method.
+     * @param py_format The format name, either "text" or "jsonl", or nullptr
+     * for "text".
+     * @return The created exporter.
+     * @return std::nullopt on failure with the relevant Python exception and
+     * error set.
+     */
+    [[nodiscard]] static auto create(PyMetadata* py_metadata, PyObject* sink, PyObject* py_format)
+            -> std::optional<LogEventExporter>;
+
+    /**
+     * Formats the given log event into the current batch, and writes the batch
+     * to the sink once it reaches `cBatchSize`.
+     * @param log_message
+     * @param timestamp
+     * @param index
+     * @param attribute_values The attribute values indexed by the metadata's
+     * attribute schema.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto export_log_event(
+            std::string_view log_message,
+            ffi::epoch_time_ms_t timestamp,
+            size_t index,
+            LogEvent::attribute_values_t const& attribute_values
+    ) -> bool;
+
+    /**
+     * Writes the current batch to the sink.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto flush() -> bool;
+
+    [[nodiscard]] auto get_num_exported_log_events() const -> size_t {
+        return m_num_exported_log_events;
+    }
+
+private:
+    LogEventExporter(PyMetadata* py_metadata, Format format, OutputSink sink)
+            : m_py_metadata{py_metadata},
+              m_format{format},
+              m_sink{std::move(sink)} {}
+
+    /**
+     * Formats the given log event as text, i.e., its formatted message.
+     * @return Same as `export_log_event`.
+     */
+    [[nodiscard]] auto append_text(
+            std::string_view log_message,
+            ffi::epoch_time_ms_t timestamp,
+            LogEvent::attribute_values_t const& attribute_values
+    ) -> bool;
+
+    /**
+     * Formats the given log event as a JSON object on its own line.
+     * @return Same as `export_log_event`.
+     */
+    [[nodiscard]] auto append_json_line(
+            std::string_view log_message,
+            ffi::epoch_time_ms_t timestamp,
+            size_t index,
+            LogEvent::attribute_values_t const& attribute_values
+    ) -> bool;
+
+    PyMetadata* m_py_metadata;
+    Format m_format;
+    OutputSink m_sink;
+    std::string m_batch;
+    std::string m_formatted_timestamp;
+    size_t m_num_exported_log_events{0};
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_LOG_EVENT_EXPORTER_HPP
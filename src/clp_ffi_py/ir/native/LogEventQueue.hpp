@@ -0,0 +1,131 @@
+#ifndef CLP_FFI_PY_LOG_EVENT_QUEUE_HPP
+#define CLP_FFI_PY_LOG_EVENT_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A bounded lock-free multi-producer single-consumer queue of log events. Each
+ * slot carries a sequence number that tells producers and the consumer whether
+ * the slot is free or holds a published log event (Vyukov's bounded queue), so
+ * pushing is one CAS on the enqueue position plus a copy of the message into
+ * the slot, and popping doesn't touch any shared position at all.
+ * <p>
+ * Slots keep their message buffers across uses, so in the steady state pushing
+ * a log event doesn't allocate, unless the message is longer than any message
+ * previously stored in the slot. Buffers that grew past
+ * `cMaxRetainedMessageCapacity` are released on pop.
+ */
+class LogEventQueue {
+public:
+    static constexpr size_t cMaxRetainedMessageCapacity{64ULL * 1024ULL};
+
+    struct Slot {
+        std::atomic<size_t> m_sequence{0};
+        ffi::epoch_time_ms_t m_timestamp{0};
+        std::string m_message;
+    };
+
+    /**
+     * @param capacity The maximum number of queued log events, rounded up to
+     * the next power of 2. Must be positive.
+     */
+    explicit LogEventQueue(size_t capacity)
+            : m_capacity{round_up_to_power_of_2(capacity)},
+              m_slots{std::make_unique<Slot[]>(m_capacity)} {
+        for (size_t i{0}; i < m_capacity; ++i) {
+            m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] auto get_capacity() const -> size_t { return m_capacity; }
+
+    /**
+     * Copies the given log event into the queue. Thread-safe.
+     * @param timestamp
+     * @param log_message
+     * @return Whether the log event was pushed, i.e., false if the queue is
+     * full.
+     */
+    [[nodiscard]] auto try_push(ffi::epoch_time_ms_t timestamp, std::string_view log_message)
+            -> bool {
+        auto pos{m_enqueue_pos.load(std::memory_order_relaxed)};
+        Slot* slot{nullptr};
+        while (true) {
+            slot = &m_slots[pos & (m_capacity - 1)];
+            auto const sequence{slot->m_sequence.load(std::memory_order_acquire)};
+            auto const diff{static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos)};
+            if (0 == diff) {
+                if (m_enqueue_pos
+                            .compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The slot still holds the log event pushed one lap earlier.
+                return false;
+            } else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->m_timestamp = timestamp;
+        slot->m_message.assign(log_message);
+        slot->m_sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Gets the oldest log event without removing it. Must only be called by
+     * the consumer.
+     * @return The slot holding the oldest log event.
+     * @return nullptr if the queue is empty, or the oldest log event is still
+     * being pushed.
+     */
+    [[nodiscard]] auto front() -> Slot const* {
+        auto const& slot{m_slots[m_dequeue_pos & (m_capacity - 1)]};
+        if (slot.m_sequence.load(std::memory_order_acquire) != m_dequeue_pos + 1) {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    /**
+     * Removes the oldest log event, which must have been returned by `front`.
+     * Must only be called by the consumer.
+     */
+    auto pop() -> void {
+        auto& slot{m_slots[m_dequeue_pos & (m_capacity - 1)]};
+        if (slot.m_message.capacity() > cMaxRetainedMessageCapacity) {
+            std::string{}.swap(slot.m_message);
+        }
+        slot.m_sequence.store(m_dequeue_pos + m_capacity, std::memory_order_release);
+        ++m_dequeue_pos;
+    }
+
+private:
+    static constexpr size_t cCacheLineSize{64};
+
+    [[nodiscard]] static auto round_up_to_power_of_2(size_t value) -> size_t {
+        size_t result{1};
+        while (result < value) {
+            result <<= 1U;
+        }
+        return result;
+    }
+
+    size_t m_capacity;
+    std::unique_ptr<Slot[]> m_slots;
+    // Producers and the consumer update their positions on separate cache
+    // lines, so they don't invalidate each other's cache.
+    alignas(cCacheLineSize) std::atomic<size_t> m_enqueue_pos{0};
+    alignas(cCacheLineSize) size_t m_dequeue_pos{0};
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_LOG_EVENT_QUEUE_HPP
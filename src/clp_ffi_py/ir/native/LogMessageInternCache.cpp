@@ -0,0 +1,41 @@
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include "LogMessageInternCache.hpp"
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+auto InternedLogMessage::get_py_log_message() -> PyObject* {
+    if (nullptr == m_py_log_message) {
+        m_py_log_message.reset(py_string_from_utf8(m_log_message));
+        if (nullptr == m_py_log_message) {
+            return nullptr;
+        }
+    }
+    auto* py_log_message{m_py_log_message.get()};
+    Py_INCREF(py_log_message);
+    return py_log_message;
+}
+
+auto LogMessageInternCache::intern(
+        gsl::span<int8_t const> encoded_message,
+        std::string& log_message
+) -> std::shared_ptr<InternedLogMessage> const& {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    std::string_view const key{reinterpret_cast<char const*>(encoded_message.data()),
+                               encoded_message.size()};
+    auto& entry{m_entries[std::hash<std::string_view>{}(key) % m_entries.size()]};
+    if (nullptr != entry.m_log_message && key == entry.m_encoded_message) {
+        ++m_num_hits;
+        return entry.m_log_message;
+    }
+    ++m_num_misses;
+    entry.m_encoded_message.assign(key);
+    entry.m_log_message = std::make_shared<InternedLogMessage>(std::move(log_message));
+    return entry.m_log_message;
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,106 @@
+#ifndef CLP_FFI_PY_LOG_MESSAGE_INTERN_CACHE_HPP
+#define CLP_FFI_PY_LOG_MESSAGE_INTERN_CACHE_HPP
+
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gsl/span>
+
+#include <clp_ffi_py/PyObjectUtils.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * An immutable decoded log message shared by all the log events interned to
+ * it. Its Python string is only built when first requested, so that invalid
+ * UTF-8 is reported by the same call with or without the intern cache.
+ * <p>
+ * It holds a reference to a Python object, so it must only be used and
+ * destroyed while holding the GIL.
+ */
+class InternedLogMessage {
+public:
+    explicit InternedLogMessage(std::string log_message) : m_log_message{std::move(log_message)} {}
+
+    [[nodiscard]] auto get_log_message() const -> std::string const& { return m_log_message; }
+
+    /**
+     * Gets the log message as a Python string. The string is created on the
+     * first call and shared by the subsequent calls.
+     * @return A new reference to the shared string.
+     * @return nullptr on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto get_py_log_message() -> PyObject*;
+
+private:
+    std::string m_log_message;
+    PyObjectPtr<PyObject> m_py_log_message;
+};
+
+/**
+ * A bounded cache that lets log events with identical messages share a single
+ * immutable message buffer and a single Python string. Entries are keyed by
+ * the encoded logtype and variables of the log event, without its attributes
+ * and timestamp delta, so log events that only differ in their attributes
+ * (e.g., the thread ID) still share their message, and two log events that
+ * hit the same entry are guaranteed to decode to the same message.
+ * <p>
+ * The cache is direct-mapped: each encoded message can only be stored in the
+ * slot selected by its hash, and replaces the previous entry of that slot on a
+ * miss. This keeps lookups and insertions O(1) without any bookkeeping, and is
+ * sufficient to capture the long runs of repeated messages (heartbeats, retry
+ * loops) that the cache targets.
+ * <p>
+ * The cache holds references to Python objects, so it must only be used and
+ * destroyed while holding the GIL.
+ */
+class LogMessageInternCache {
+public:
+    /**
+     * The maximum capacity accepted from users, which keeps the slots
+     * allocatable.
+     */
+    static constexpr size_t cMaxCapacity{1ULL << 30};
+
+    /**
+     * @param capacity The number of slots in the cache. Must be positive.
+     */
+    explicit LogMessageInternCache(size_t capacity) : m_entries(capacity) {}
+
+    /**
+     * Interns a decoded log message.
+     * @param encoded_message The encoded logtype and variables of the log
+     * event, without its attributes and timestamp delta.
+     * @param log_message The decoded log message. It is moved into the cache
+     * on a miss, and left untouched on a hit.
+     * @return The interned log message shared by all the log events with the
+     * same encoded message.
+     */
+    [[nodiscard]] auto intern(gsl::span<int8_t const> encoded_message, std::string& log_message)
+            -> std::shared_ptr<InternedLogMessage> const&;
+
+    [[nodiscard]] auto get_capacity() const -> size_t { return m_entries.size(); }
+
+    [[nodiscard]] auto get_num_hits() const -> size_t { return m_num_hits; }
+
+    [[nodiscard]] auto get_num_misses() const -> size_t { return m_num_misses; }
+
+private:
+    struct Entry {
+        std::string m_encoded_message;
+        std::shared_ptr<InternedLogMessage> m_log_message;
+    };
+
+    std::vector<Entry> m_entries;
+    size_t m_num_hits{0};
+    size_t m_num_misses{0};
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_LOG_MESSAGE_INTERN_CACHE_HPP
@@ -0,0 +1,65 @@
+#include "LogtypeCache.hpp"
+
+#include <functional>
+
+namespace clp_ffi_py::ir::native {
+auto LogtypeCache::find(gsl::span<std::string_view const> constants, std::string_view placeholders)
+        -> std::optional<gsl::span<int8_t const>> {
+    auto const& entry{get_entry(constants, placeholders)};
+    auto is_hit = [&]() -> bool {
+        if (false == entry.m_is_valid || placeholders != entry.m_placeholders
+            || constants.size() != entry.m_constant_lengths.size())
+        {
+            return false;
+        }
+        std::string_view const cached_constants{entry.m_constants};
+        size_t offset{0};
+        for (size_t idx{0}; idx < constants.size(); ++idx) {
+            auto const constant{constants[idx]};
+            if (constant.size() != entry.m_constant_lengths[idx]
+                || constant != cached_constants.substr(offset, constant.size()))
+            {
+                return false;
+            }
+            offset += constant.size();
+        }
+        return true;
+    };
+    if (false == is_hit()) {
+        increment(m_num_misses);
+        return std::nullopt;
+    }
+    increment(m_num_hits);
+    return gsl::span<int8_t const>{entry.m_encoded_logtype};
+}
+
+auto LogtypeCache::insert(
+        gsl::span<std::string_view const> constants,
+        std::string_view placeholders,
+        gsl::span<int8_t const> encoded_logtype
+) -> void {
+    auto& entry{get_entry(constants, placeholders)};
+    entry.m_is_valid = true;
+    entry.m_placeholders.assign(placeholders);
+    entry.m_constant_lengths.clear();
+    entry.m_constants.clear();
+    for (auto const constant : constants) {
+        entry.m_constant_lengths.push_back(constant.size());
+        entry.m_constants.append(constant);
+    }
+    entry.m_encoded_logtype.assign(encoded_logtype.begin(), encoded_logtype.end());
+}
+
+auto LogtypeCache::get_entry(
+        gsl::span<std::string_view const> constants,
+        std::string_view placeholders
+) -> Entry& {
+    auto hash{std::hash<std::string_view>{}(placeholders)};
+    for (auto const constant : constants) {
+        // Combines the hashes the same way as `boost::hash_combine`.
+        constexpr size_t cGoldenRatio{0x9e3779b9};
+        hash ^= constant.size() + cGoldenRatio + (hash << 6U) + (hash >> 2U);
+    }
+    return m_entries[hash % m_entries.size()];
+}
+}  // namespace clp_ffi_py::ir::native
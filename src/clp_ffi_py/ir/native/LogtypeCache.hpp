@@ -0,0 +1,116 @@
+#ifndef CLP_FFI_PY_LOGTYPE_CACHE_HPP
+#define CLP_FFI_PY_LOGTYPE_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gsl/span>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A bounded cache of encoded logtypes, which lets an encoder skip escaping the
+ * constants of a message and building its logtype when the message follows a
+ * recently seen template.
+ * <p>
+ * A message is described by its skeleton: the constant text between its
+ * variables, and the placeholder of each variable. Entries are selected by a
+ * hash of the lengths of the constants and the placeholders, which is cheap to
+ * compute, and a lookup only hits if the constants and placeholders are
+ * identical to the ones of the entry, so a hit always yields the logtype the
+ * message would have been encoded with.
+ * <p>
+ * Like `LogMessageInternCache`, the cache is direct-mapped: each skeleton can
+ * only be stored in the slot selected by its hash, and replaces the previous
+ * entry of that slot on a miss.
+ * <p>
+ * The cache must only be used by one thread at a time, but its statistics can
+ * be read from any thread.
+ */
+class LogtypeCache {
+public:
+    /**
+     * The maximum capacity accepted from users, which keeps the slots
+     * allocatable.
+     */
+    static constexpr size_t cMaxCapacity{1ULL << 30};
+
+    /**
+     * @param capacity The number of slots in the cache. Must be positive.
+     */
+    explicit LogtypeCache(size_t capacity) : m_entries(capacity) {}
+
+    /**
+     * Finds the encoded logtype of a message.
+     * @param constants The constant text before each variable of the message,
+     * followed by the constant text after the last variable.
+     * @param placeholders The placeholder of each variable of the message.
+     * @return The encoded logtype (including its length tag and length) if the
+     * message's skeleton is cached, which remains valid until the next
+     * insertion.
+     * @return std::nullopt otherwise.
+     */
+    [[nodiscard]] auto
+    find(gsl::span<std::string_view const> constants, std::string_view placeholders)
+            -> std::optional<gsl::span<int8_t const>>;
+
+    /**
+     * Caches the encoded logtype of a message, replacing the entry in its
+     * slot.
+     * @param constants
+     * @param placeholders
+     * @param encoded_logtype
+     */
+    auto insert(
+            gsl::span<std::string_view const> constants,
+            std::string_view placeholders,
+            gsl::span<int8_t const> encoded_logtype
+    ) -> void;
+
+    [[nodiscard]] auto get_capacity() const -> size_t { return m_entries.size(); }
+
+    [[nodiscard]] auto get_num_hits() const -> size_t {
+        return m_num_hits.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto get_num_misses() const -> size_t {
+        return m_num_misses.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Entry {
+        bool m_is_valid{false};
+        std::string m_placeholders;
+        std::vector<size_t> m_constant_lengths;
+        std::string m_constants;
+        std::vector<int8_t> m_encoded_logtype;
+    };
+
+    /**
+     * @param constants
+     * @param placeholders
+     * @return The entry selected by the hash of the given skeleton.
+     */
+    [[nodiscard]] auto
+    get_entry(gsl::span<std::string_view const> constants, std::string_view placeholders)
+            -> Entry&;
+
+    /**
+     * Increments a statistic. Since only the thread using the cache writes the
+     * statistics, this doesn't need an atomic read-modify-write.
+     * @param statistic
+     */
+    static auto increment(std::atomic<size_t>& statistic) -> void {
+        statistic.store(statistic.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::vector<Entry> m_entries;
+    std::atomic<size_t> m_num_hits{0};
+    std::atomic<size_t> m_num_misses{0};
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_LOGTYPE_CACHE_HPP
@@ -0,0 +1,307 @@
+#include "MessageTokenizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#include <clp/components/core/src/ir/parsing.hpp>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define CLP_FFI_PY_HAS_AVX2_TOKENIZER
+#endif
+
+namespace clp_ffi_py::ir::native {
+namespace {
+constexpr size_t cNumBytesPerWord{64};
+
+/**
+ * The classes of a byte, as bit flags.
+ */
+constexpr uint8_t cDelimFlag{0x1};
+constexpr uint8_t cDigitFlag{0x2};
+constexpr uint8_t cAlphabetFlag{0x4};
+
+/**
+ * The bitmap words of 64 consecutive bytes of a message: bit i of each word
+ * describes byte i.
+ */
+struct ClassifiedWord {
+    uint64_t m_delims;
+    uint64_t m_digits;
+    uint64_t m_alphabets;
+};
+
+/**
+ * @param c
+ * @return The classes of the given byte. Matches the delimiter definition of
+ * CLP's `ir::is_delim`, under which all the non-ASCII bytes are delimiters.
+ */
+constexpr auto classify_byte(uint8_t c) -> uint8_t {
+    if ('0' <= c && c <= '9') {
+        return cDigitFlag;
+    }
+    if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z')) {
+        return cAlphabetFlag;
+    }
+    if ('+' == c || ('-' <= c && c <= '/') || '\\' == c || '_' == c) {
+        return 0;
+    }
+    return cDelimFlag;
+}
+
+constexpr auto create_byte_class_table() -> std::array<uint8_t, 256> {
+    std::array<uint8_t, 256> table{};
+    for (size_t c{0}; c < table.size(); ++c) {
+        table[c] = classify_byte(static_cast<uint8_t>(c));
+    }
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> cByteClassTable{create_byte_class_table()};
+
+/**
+ * Classifies 64 bytes with a lookup table.
+ * @param bytes
+ * @return The classified word.
+ */
+auto classify_word_scalar(char const* bytes) -> ClassifiedWord {
+    ClassifiedWord word{0, 0, 0};
+    for (size_t idx{0}; idx < cNumBytesPerWord; ++idx) {
+        auto const byte_class{cByteClassTable[static_cast<uint8_t>(bytes[idx])]};
+        word.m_delims |= static_cast<uint64_t>(byte_class & cDelimFlag) << idx;
+        word.m_digits |= static_cast<uint64_t>((byte_class & cDigitFlag) >> 1U) << idx;
+        word.m_alphabets |= static_cast<uint64_t>((byte_class & cAlphabetFlag) >> 2U) << idx;
+    }
+    return word;
+}
+
+#ifdef CLP_FFI_PY_HAS_AVX2_TOKENIZER
+/**
+ * @param bytes
+ * @param lower
+ * @param upper
+ * @return A mask of the bytes in [lower, upper]. Since the comparisons are
+ * signed, non-ASCII bytes are never in an ASCII range.
+ */
+__attribute__((target("avx2"))) auto is_in_range_avx2(__m256i bytes, char lower, char upper)
+        -> __m256i {
+    return _mm256_and_si256(
+            _mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(static_cast<char>(lower - 1))),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(upper + 1)), bytes)
+    );
+}
+
+/**
+ * Classifies 32 bytes with AVX2.
+ * @param bytes
+ * @param non_delims Returns the mask of the non-delimiters.
+ * @param digits Returns the mask of the decimal digits.
+ * @param alphabets Returns the mask of the alphabets.
+ */
+__attribute__((target("avx2"))) auto classify_half_word_avx2(
+        char const* bytes,
+        uint32_t& non_delims,
+        uint32_t& digits,
+        uint32_t& alphabets
+) -> void {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto const chars{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(bytes))};
+    auto const digit_mask{is_in_range_avx2(chars, '0', '9')};
+    // Setting bit 5 maps upper-case letters to lower-case ones, without
+    // mapping any other byte into [a, z].
+    auto const alphabet_mask{
+            is_in_range_avx2(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), 'a', 'z')
+    };
+    auto non_delim_mask{_mm256_or_si256(is_in_range_avx2(chars, '-', '9'), alphabet_mask)};
+    for (char const c : {'+', '\\', '_'}) {
+        non_delim_mask
+                = _mm256_or_si256(non_delim_mask, _mm256_cmpeq_epi8(chars, _mm256_set1_epi8(c)));
+    }
+    non_delims = static_cast<uint32_t>(_mm256_movemask_epi8(non_delim_mask));
+    digits = static_cast<uint32_t>(_mm256_movemask_epi8(digit_mask));
+    alphabets = static_cast<uint32_t>(_mm256_movemask_epi8(alphabet_mask));
+}
+
+/**
+ * Classifies 64 bytes with AVX2.
+ * @param bytes
+ * @return The classified word.
+ */
+__attribute__((target("avx2"))) auto classify_word_avx2(char const* bytes) -> ClassifiedWord {
+    constexpr size_t cNumBytesPerHalfWord{cNumBytesPerWord / 2};
+    std::array<uint32_t, 2> non_delims{};
+    std::array<uint32_t, 2> digits{};
+    std::array<uint32_t, 2> alphabets{};
+    classify_half_word_avx2(bytes, non_delims[0], digits[0], alphabets[0]);
+    classify_half_word_avx2(
+            bytes + cNumBytesPerHalfWord,
+            non_delims[1],
+            digits[1],
+            alphabets[1]
+    );
+    auto combine = [](std::array<uint32_t, 2> const& halves) -> uint64_t {
+        return static_cast<uint64_t>(halves[0]) | (static_cast<uint64_t>(halves[1]) << 32U);
+    };
+    return {~combine(non_delims), combine(digits), combine(alphabets)};
+}
+#endif
+
+using classify_word_t = auto (*)(char const*) -> ClassifiedWord;
+
+/**
+ * @return The fastest word classifier supported by the CPU.
+ */
+auto select_word_classifier() -> classify_word_t {
+#ifdef CLP_FFI_PY_HAS_AVX2_TOKENIZER
+    if (0 != __builtin_cpu_supports("avx2")) {
+        return classify_word_avx2;
+    }
+#endif
+    return classify_word_scalar;
+}
+
+/**
+ * @return The word classifier used by all the tokenizers.
+ */
+auto get_word_classifier() -> std::atomic<classify_word_t>& {
+    static std::atomic<classify_word_t> classify_word{select_word_classifier()};
+    return classify_word;
+}
+
+/**
+ * @param word
+ * @return The index of the least significant set bit. The word must not be 0.
+ */
+auto get_first_set_bit(uint64_t word) -> size_t {
+    return static_cast<size_t>(__builtin_ctzll(word));
+}
+}  // namespace
+
+auto MessageTokenizer::set_message(std::string_view message) -> void {
+    auto const classify_word{get_word_classifier().load(std::memory_order_relaxed)};
+
+    m_message = message;
+    auto const num_words{(message.size() + cNumBytesPerWord - 1) / cNumBytesPerWord};
+    m_delim_bitmap.resize(num_words);
+    m_digit_bitmap.resize(num_words);
+    m_alphabet_bitmap.resize(num_words);
+    auto store_word = [&](size_t word_idx, ClassifiedWord const& word) {
+        m_delim_bitmap[word_idx] = word.m_delims;
+        m_digit_bitmap[word_idx] = word.m_digits;
+        m_alphabet_bitmap[word_idx] = word.m_alphabets;
+    };
+
+    auto const num_full_words{message.size() / cNumBytesPerWord};
+    for (size_t word_idx{0}; word_idx < num_full_words; ++word_idx) {
+        store_word(word_idx, classify_word(message.data() + word_idx * cNumBytesPerWord));
+    }
+    if (num_full_words < num_words) {
+        // The tail is padded with null bytes, which are delimiters, so tokens
+        // never extend past the end of the message.
+        std::array<char, cNumBytesPerWord> tail{};
+        auto const tail_offset{num_full_words * cNumBytesPerWord};
+        std::memcpy(tail.data(), message.data() + tail_offset, message.size() - tail_offset);
+        store_word(num_full_words, classify_word(tail.data()));
+    }
+}
+
+auto MessageTokenizer::set_vectorized_classifier_enabled(bool enabled) -> void {
+    get_word_classifier().store(
+            enabled ? select_word_classifier() : classify_word_scalar,
+            std::memory_order_relaxed
+    );
+}
+
+auto MessageTokenizer::get_bounds_of_next_var(size_t& begin_pos, size_t& end_pos) const -> bool {
+    auto const msg_length{m_message.size()};
+    if (end_pos >= msg_length) {
+        return false;
+    }
+
+    while (true) {
+        begin_pos = find_next_non_delim(end_pos);
+        if (msg_length == begin_pos) {
+            return false;
+        }
+        end_pos = find_next_delim(begin_pos);
+
+        // Treat token as variable if:
+        // - it contains a decimal digit, or
+        // - it's directly preceded by an equals sign and contains an alphabet,
+        //   or
+        // - it could be a multi-digit hex value
+        if (contains_any(m_digit_bitmap, begin_pos, end_pos)
+            || (begin_pos > 0 && '=' == m_message[begin_pos - 1]
+                && contains_any(m_alphabet_bitmap, begin_pos, end_pos))
+            || ::ir::could_be_multi_digit_hex_value(
+                    m_message.substr(begin_pos, end_pos - begin_pos)
+            ))
+        {
+            return true;
+        }
+    }
+}
+
+auto MessageTokenizer::find_next_delim(size_t pos) const -> size_t {
+    auto word_idx{pos / cNumBytesPerWord};
+    if (word_idx >= m_delim_bitmap.size()) {
+        return m_message.size();
+    }
+    auto word{m_delim_bitmap[word_idx] & (~uint64_t{0} << (pos % cNumBytesPerWord))};
+    while (0 == word) {
+        ++word_idx;
+        if (word_idx == m_delim_bitmap.size()) {
+            return m_message.size();
+        }
+        word = m_delim_bitmap[word_idx];
+    }
+    return std::min(word_idx * cNumBytesPerWord + get_first_set_bit(word), m_message.size());
+}
+
+auto MessageTokenizer::find_next_non_delim(size_t pos) const -> size_t {
+    auto word_idx{pos / cNumBytesPerWord};
+    if (word_idx >= m_delim_bitmap.size()) {
+        return m_message.size();
+    }
+    auto word{~m_delim_bitmap[word_idx] & (~uint64_t{0} << (pos % cNumBytesPerWord))};
+    while (0 == word) {
+        ++word_idx;
+        if (word_idx == m_delim_bitmap.size()) {
+            return m_message.size();
+        }
+        word = ~m_delim_bitmap[word_idx];
+    }
+    // The padding bits are delimiters, so the position is within the message.
+    return word_idx * cNumBytesPerWord + get_first_set_bit(word);
+}
+
+auto MessageTokenizer::contains_any(
+        std::vector<uint64_t> const& bitmap,
+        size_t begin_pos,
+        size_t end_pos
+) -> bool {
+    if (begin_pos >= end_pos) {
+        return false;
+    }
+    auto const first_word_idx{begin_pos / cNumBytesPerWord};
+    auto const last_word_idx{(end_pos - 1) / cNumBytesPerWord};
+    auto const first_word_mask{~uint64_t{0} << (begin_pos % cNumBytesPerWord)};
+    auto const last_word_mask{
+            ~uint64_t{0} >> (cNumBytesPerWord - 1 - (end_pos - 1) % cNumBytesPerWord)
+    };
+    if (first_word_idx == last_word_idx) {
+        return 0 != (bitmap[first_word_idx] & first_word_mask & last_word_mask);
+    }
+    if (0 != (bitmap[first_word_idx] & first_word_mask)) {
+        return true;
+    }
+    for (auto word_idx{first_word_idx + 1}; word_idx < last_word_idx; ++word_idx) {
+        if (0 != bitmap[word_idx]) {
+            return true;
+        }
+    }
+    return 0 != (bitmap[last_word_idx] & last_word_mask);
+}
+}  // namespace clp_ffi_py::ir::native
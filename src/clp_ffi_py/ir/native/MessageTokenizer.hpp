@@ -0,0 +1,81 @@
+#ifndef CLP_FFI_PY_MESSAGE_TOKENIZER_HPP
+#define CLP_FFI_PY_MESSAGE_TOKENIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A tokenizer that finds the variables of a log message the same way as CLP's
+ * `ir::get_bounds_of_next_var`, but without classifying the message byte by
+ * byte while scanning it.
+ * <p>
+ * When a message is set, all its bytes are classified up front into three
+ * bitmaps (delimiters, decimal digits, and alphabets), 64 bytes at a time
+ * using AVX2 when the CPU supports it, or a lookup table otherwise. Finding
+ * the next token then comes down to bit scans over the delimiter bitmap, and
+ * checking whether a token contains a digit or an alphabet comes down to
+ * masking a bitmap word or two.
+ */
+class MessageTokenizer {
+public:
+    /**
+     * Sets the message to tokenize, and classifies its bytes. The bitmaps are
+     * reused across messages, so the tokenizer only allocates when a message
+     * is longer than all the previous ones.
+     * @param message The message, which must outlive its tokenization.
+     */
+    auto set_message(std::string_view message) -> void;
+
+    /**
+     * Finds the bounds of the next variable in the message, with the same
+     * semantics as CLP's `ir::get_bounds_of_next_var`.
+     * @param begin_pos Returns the beginning position of the variable.
+     * @param end_pos The position to start searching from, and returns the end
+     * position of the variable.
+     * @return Whether a variable was found.
+     */
+    [[nodiscard]] auto get_bounds_of_next_var(size_t& begin_pos, size_t& end_pos) const -> bool;
+
+    /**
+     * Sets whether the bytes are classified with AVX2 when the CPU supports
+     * it. Disabling it forces the lookup table, which is only meant for
+     * testing the fallback on CPUs that support AVX2. It affects all the
+     * tokenizers, including the ones currently used by other threads.
+     * @param enabled
+     */
+    static auto set_vectorized_classifier_enabled(bool enabled) -> void;
+
+private:
+    /**
+     * @param pos
+     * @return The position of the first delimiter at or after `pos`, or the
+     * length of the message if there's none.
+     */
+    [[nodiscard]] auto find_next_delim(size_t pos) const -> size_t;
+
+    /**
+     * @param pos
+     * @return The position of the first non-delimiter at or after `pos`, or the
+     * length of the message if there's none.
+     */
+    [[nodiscard]] auto find_next_non_delim(size_t pos) const -> size_t;
+
+    /**
+     * @param bitmap
+     * @param begin_pos
+     * @param end_pos
+     * @return Whether any bit in [begin_pos, end_pos) is set in the bitmap.
+     */
+    [[nodiscard]] static auto
+    contains_any(std::vector<uint64_t> const& bitmap, size_t begin_pos, size_t end_pos) -> bool;
+
+    std::string_view m_message;
+    std::vector<uint64_t> m_delim_bitmap;
+    std::vector<uint64_t> m_digit_bitmap;
+    std::vector<uint64_t> m_alphabet_bitmap;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_MESSAGE_TOKENIZER_HPP
@@ -78,26 +78,29 @@ Metadata::Metadata(nlohmann::json const& metadata, bool is_four_byte_encoding) {
     auto const* android_build_version_key{
             static_cast<char const*>(ffi::ir_stream::cProtocol::Metadata::AndroidBuildVersionKey)
     };
-    if (false == is_valid_json_string_data(metadata, android_build_version_key)) {
-        return;
+    if (is_valid_json_string_data(metadata, android_build_version_key)) {
+        m_android_build_version = std::string{metadata.at(android_build_version_key)};
     }
-    m_android_build_version = std::string{metadata.at(android_build_version_key)};
 
+    // The attribute table is declared independently of the Android build
+    // version, so streams can carry user-defined attributes.
     auto const* attribute_table_key{
             static_cast<char const*>(ffi::ir_stream::cProtocol::Metadata::AttributeTableKey)
     };
-    if (false == is_valid_json_string_data(metadata, android_build_version_key)) {
+    if (false == metadata.contains(attribute_table_key)) {
         return;
     }
     try {
+        std::vector<std::string> attribute_names;
         for (auto const& attribute_json : metadata.at(attribute_table_key)) {
             std::string const& name{attribute_json.at(ffi::ir_stream::AttributeInfo::cNameKey)};
             m_attribute_table.emplace_back(
                     name,
                     attribute_json.at(ffi::ir_stream::AttributeInfo::cTypeTagKey)
             );
-            m_attribute_idx_map.emplace(name, m_attribute_idx_map.size());
+            attribute_names.emplace_back(name);
         }
+        m_attribute_schema = std::make_shared<AttributeSchema const>(std::move(attribute_names));
     } catch (std::exception const& e) {
         throw ExceptionFFI(
                 ErrorCode_MetadataCorrupted,
@@ -109,10 +112,8 @@ Metadata::Metadata(nlohmann::json const& metadata, bool is_four_byte_encoding) {
 }
 
 auto Metadata::get_attribute_idx(std::string const& attr_name) const -> size_t {
-    size_t idx{};
-    try {
-        idx = m_attribute_idx_map.at(attr_name);
-    } catch (std::exception const& e) {
+    auto const idx{m_attribute_schema->find_idx(attr_name)};
+    if (false == idx.has_value()) {
         throw ExceptionFFI(
                 ErrorCode_MetadataCorrupted,
                 __FILE__,
@@ -120,6 +121,6 @@ auto Metadata::get_attribute_idx(std::string const& attr_name) const -> size_t {
                 "Invalid attribute name: " + attr_name
         );
     }
-    return idx;
+    return idx.value();
 }
 }  // namespace clp_ffi_py::ir::native
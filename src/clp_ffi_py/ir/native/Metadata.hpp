@@ -1,6 +1,7 @@
 #ifndef CLP_FFI_PY_METADATA_HPP
 #define CLP_FFI_PY_METADATA_HPP
 
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -9,6 +10,8 @@
 #include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
 #include <clp/components/core/submodules/json/single_include/nlohmann/json.hpp>
 
+#include <clp_ffi_py/ir/native/AttributeSchema.hpp>
+
 namespace clp_ffi_py::ir::native {
 /**
  * A class that represents a decoded IR preamble. Contains ways to access (get)
@@ -67,7 +70,16 @@ public:
 
     [[nodiscard]] auto get_attribute_idx_map() const
             -> std::unordered_map<std::string, size_t> const& {
-        return m_attribute_idx_map;
+        return m_attribute_schema->get_idx_map();
+    }
+
+    /**
+     * @return The schema of the attribute table, shared by all the log events
+     * decoded with this metadata.
+     */
+    [[nodiscard]] auto get_attribute_schema() const
+            -> std::shared_ptr<AttributeSchema const> const& {
+        return m_attribute_schema;
     }
 
     [[nodiscard]] auto get_attribute_idx(std::string const& attr_name) const -> size_t;
@@ -82,7 +94,9 @@ private:
     std::string m_timestamp_format;
     std::string m_timezone_id;
     std::vector<ffi::ir_stream::AttributeInfo> m_attribute_table;
-    std::unordered_map<std::string, size_t> m_attribute_idx_map;
+    std::shared_ptr<AttributeSchema const> m_attribute_schema{
+            std::make_shared<AttributeSchema const>(std::vector<std::string>{})
+    };
     std::optional<std::string> m_android_build_version;
 };
 }  // namespace clp_ffi_py::ir::native
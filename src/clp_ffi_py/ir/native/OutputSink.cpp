@@ -0,0 +1,79 @@
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include "OutputSink.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+
+namespace clp_ffi_py::ir::native {
+auto OutputSink::create(PyObject* sink) -> std::optional<OutputSink> {
+    OutputSink output_sink;
+    if (static_cast<bool>(PyLong_Check(sink))) {
+        auto const fd{PyLong_AsLong(sink)};
+        if (-1 == fd && nullptr != PyErr_Occurred()) {
+            return std::nullopt;
+        }
+        if (fd < 0 || fd > INT_MAX) {
+            PyErr_Format(PyExc_ValueError, "Invalid file descriptor: %ld", fd);
+            return std::nullopt;
+        }
+        output_sink.m_fd = static_cast<int>(fd);
+        return output_sink;
+    }
+    output_sink.m_py_write_method.reset(PyObject_GetAttrString(sink, "write"));
+    if (nullptr == output_sink.m_py_write_method) {
+        PyErr_SetString(
+                PyExc_TypeError,
+                "The sink must be a file descriptor or an object with a `write` method."
+        );
+        return std::nullopt;
+    }
+    return output_sink;
+}
+
+auto OutputSink::write(std::string_view data) -> bool {
+    if (data.empty()) {
+        return true;
+    }
+    if (-1 != m_fd) {
+        return write_to_fd(data);
+    }
+    PyObjectPtr<PyObject> const result{PyObject_CallFunction(
+            m_py_write_method.get(),
+            "y#",
+            data.data(),
+            static_cast<Py_ssize_t>(data.size())
+    )};
+    return nullptr != result;
+}
+
+auto OutputSink::write_to_fd(std::string_view data) const -> bool {
+    size_t num_bytes_written{0};
+    int error_number{0};
+    while (num_bytes_written < data.size()) {
+        ssize_t result{0};
+        Py_BEGIN_ALLOW_THREADS
+        result = ::write(m_fd, data.data() + num_bytes_written, data.size() - num_bytes_written);
+        error_number = errno;
+        Py_END_ALLOW_THREADS
+        if (result >= 0) {
+            num_bytes_written += static_cast<size_t>(result);
+            continue;
+        }
+        if (EINTR == error_number) {
+            // Gives the signal handlers a chance to raise, e.g., on Ctrl-C.
+            if (0 != PyErr_CheckSignals()) {
+                return false;
+            }
+            continue;
+        }
+        errno = error_number;
+        PyErr_SetFromErrno(PyExc_OSError);
+        return false;
+    }
+    return true;
+}
+}  // namespace clp_ffi_py::ir::native
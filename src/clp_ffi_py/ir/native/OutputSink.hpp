@@ -0,0 +1,55 @@
+#ifndef CLP_FFI_PY_OUTPUT_SINK_HPP
+#define CLP_FFI_PY_OUTPUT_SINK_HPP
+
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include <optional>
+#include <string_view>
+
+#include <clp_ffi_py/PyObjectUtils.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class represents the destination of the bytes written natively. The
+ * sink is either:
+ * - a file descriptor, which is written with the GIL released;
+ * - a Python object with a `write` method that accepts bytes.
+ * <p>
+ * The sink holds a reference to the Python object, so it must only be used and
+ * destroyed while holding the GIL.
+ */
+class OutputSink {
+public:
+    /**
+     * Creates a sink.
+     * @param sink A file descriptor or a Python object with a `write` method.
+     * @return The created sink.
+     * @return std::nullopt on failure with the relevant Python exception and
+     * error set.
+     */
+    [[nodiscard]] static auto create(PyObject* sink) -> std::optional<OutputSink>;
+
+    /**
+     * Writes all the given bytes to the sink.
+     * @param data
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto write(std::string_view data) -> bool;
+
+private:
+    OutputSink() = default;
+
+    /**
+     * Writes all the given bytes to the file descriptor with the GIL released.
+     * @param data
+     * @return Same as `write`.
+     */
+    [[nodiscard]] auto write_to_fd(std::string_view data) const -> bool;
+
+    int m_fd{-1};
+    PyObjectPtr<PyObject> m_py_write_method;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_OUTPUT_SINK_HPP
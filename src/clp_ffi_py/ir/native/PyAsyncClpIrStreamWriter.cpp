@@ -0,0 +1,569 @@
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include "PyAsyncClpIrStreamWriter.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+
+#include <clp_ffi_py/ir/native/IrStreamWriter.hpp>
+#include <clp_ffi_py/ir/native/LogtypeCache.hpp>
+#include <clp_ffi_py/ir/native/utils.hpp>
+#include <clp_ffi_py/PyFastcallArgParser.hpp>
+#include <clp_ffi_py/PyObjectCast.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+/**
+ * The maximum queue capacity accepted, which keeps the slots of the queue
+ * (rounded up to a power of 2) allocatable.
+ */
+constexpr Py_ssize_t cMaxQueueCapacity{1LL << 30};
+
+/**
+ * Parses the name of an overflow policy.
+ * @param policy_name
+ * @param policy Returns the parsed policy.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto parse_overflow_policy(char const* policy_name, AsyncIrStreamWriter::OverflowPolicy& policy)
+        -> bool {
+    if (0 == std::strcmp(policy_name, "block")) {
+        policy = AsyncIrStreamWriter::OverflowPolicy::Block;
+        return true;
+    }
+    if (0 == std::strcmp(policy_name, "drop")) {
+        policy = AsyncIrStreamWriter::OverflowPolicy::Drop;
+        return true;
+    }
+    PyErr_Format(
+            PyExc_ValueError,
+            "Unknown overflow policy: %s. Expected \"block\" or \"drop\".",
+            policy_name
+    );
+    return false;
+}
+
+extern "C" {
+/**
+ * Callback of PyAsyncClpIrStreamWriter `__init__` method:
+ * __init__(self, sink, ref_timestamp, timestamp_format, timezone,
+ *          enable_compression=True, compression_level=3,
+ *          queue_capacity=65536, flush_interval_ms=1000,
+ *          flush_threshold=65536, overflow_policy="block",
+ *          logtype_cache_capacity=0)
+ * Keyword argument parsing is supported.
+ * Assumes `self` is uninitialized and will allocate the underlying memory. If
+ * `self` is already initialized this will result in memory leaks.
+ * @param self
+ * @param args
+ * @param keywords
+ * @return 0 on success.
+ * @return -1 on failure with the relevant Python exception and error set.
+ */
+auto PyAsyncClpIrStreamWriter_init(
+        PyAsyncClpIrStreamWriter* self,
+        PyObject* args,
+        PyObject* keywords
+) -> int {
+    static char keyword_sink[]{"sink"};
+    static char keyword_ref_timestamp[]{"ref_timestamp"};
+    static char keyword_timestamp_format[]{"timestamp_format"};
+    static char keyword_timezone[]{"timezone"};
+    static char keyword_enable_compression[]{"enable_compression"};
+    static char keyword_compression_level[]{"compression_level"};
+    static char keyword_queue_capacity[]{"queue_capacity"};
+    static char keyword_flush_interval_ms[]{"flush_interval_ms"};
+    static char keyword_flush_threshold[]{"flush_threshold"};
+    static char keyword_overflow_policy[]{"overflow_policy"};
+    static char keyword_logtype_cache_capacity[]{"logtype_cache_capacity"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_sink),
+            static_cast<char*>(keyword_ref_timestamp),
+            static_cast<char*>(keyword_timestamp_format),
+            static_cast<char*>(keyword_timezone),
+            static_cast<char*>(keyword_enable_compression),
+            static_cast<char*>(keyword_compression_level),
+            static_cast<char*>(keyword_queue_capacity),
+            static_cast<char*>(keyword_flush_interval_ms),
+            static_cast<char*>(keyword_flush_threshold),
+            static_cast<char*>(keyword_overflow_policy),
+            static_cast<char*>(keyword_logtype_cache_capacity),
+            nullptr
+    };
+
+    // If the argument parsing fails, `self` will be deallocated. We must reset
+    // all pointers to nullptr in advance, otherwise the deallocator might
+    // trigger a segmentation fault.
+    self->default_init();
+
+    PyObject* sink{nullptr};
+    PyObject* py_ref_timestamp{nullptr};
+    PyObject* py_timestamp_format{nullptr};
+    PyObject* py_timezone{nullptr};
+    int enable_compression{1};
+    int compression_level{IrStreamWriter::cDefaultCompressionLevel};
+    Py_ssize_t queue_capacity{AsyncIrStreamWriter::cDefaultQueueCapacity};
+    Py_ssize_t flush_interval_ms{AsyncIrStreamWriter::cDefaultFlushInterval.count()};
+    Py_ssize_t flush_threshold{IrStreamWriter::cDefaultFlushThreshold};
+    char const* overflow_policy_name{"block"};
+    Py_ssize_t logtype_cache_capacity{0};
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "OOUU|pinnnsn",
+                static_cast<char**>(keyword_table),
+                &sink,
+                &py_ref_timestamp,
+                &py_timestamp_format,
+                &py_timezone,
+                &enable_compression,
+                &compression_level,
+                &queue_capacity,
+                &flush_interval_ms,
+                &flush_threshold,
+                &overflow_policy_name,
+                &logtype_cache_capacity
+        )))
+    {
+        return -1;
+    }
+
+    ffi::epoch_time_ms_t ref_timestamp{};
+    std::string_view timestamp_format;
+    std::string_view timezone;
+    AsyncIrStreamWriter::OverflowPolicy overflow_policy{};
+    if (false == parse_py_int(py_ref_timestamp, ref_timestamp)
+        || false == parse_py_string_as_string_view(py_timestamp_format, timestamp_format)
+        || false == parse_py_string_as_string_view(py_timezone, timezone)
+        || false == parse_overflow_policy(overflow_policy_name, overflow_policy))
+    {
+        return -1;
+    }
+    if (queue_capacity <= 0 || queue_capacity > cMaxQueueCapacity) {
+        PyErr_Format(
+                PyExc_ValueError,
+                "The queue capacity must be in the range [1, %zd].",
+                cMaxQueueCapacity
+        );
+        return -1;
+    }
+    if (flush_interval_ms <= 0) {
+        PyErr_SetString(PyExc_ValueError, "The flush interval must be positive.");
+        return -1;
+    }
+    if (flush_threshold < 0) {
+        PyErr_SetString(PyExc_ValueError, "The flush threshold must be non-negative.");
+        return -1;
+    }
+    if (0 > logtype_cache_capacity
+        || static_cast<size_t>(logtype_cache_capacity) > LogtypeCache::cMaxCapacity)
+    {
+        PyErr_Format(
+                PyExc_ValueError,
+                "The logtype cache capacity must be in the range [0, %zu].",
+                LogtypeCache::cMaxCapacity
+        );
+        return -1;
+    }
+    // The background thread writes to the file descriptor without the GIL, so
+    // file objects are only accepted for their file descriptors.
+    auto const fd{PyObject_AsFileDescriptor(sink)};
+    if (-1 == fd) {
+        return -1;
+    }
+
+    auto writer{AsyncIrStreamWriter::create(
+            fd,
+            ref_timestamp,
+            timestamp_format,
+            timezone,
+            static_cast<bool>(enable_compression) ? std::optional<int>{compression_level}
+                                                  : std::nullopt,
+            static_cast<size_t>(queue_capacity),
+            std::chrono::milliseconds{flush_interval_ms},
+            static_cast<size_t>(flush_threshold),
+            overflow_policy,
+            static_cast<size_t>(logtype_cache_capacity)
+    )};
+    if (nullptr == writer) {
+        return -1;
+    }
+    self->init(std::move(writer), sink);
+    return 0;
+}
+
+/**
+ * Callback of PyAsyncClpIrStreamWriter deallocator.
+ * @param self
+ */
+auto PyAsyncClpIrStreamWriter_dealloc(PyAsyncClpIrStreamWriter* self) -> void {
+    PyObject_GC_UnTrack(self);
+    self->clean();
+    PyObject_GC_Del(self);
+}
+
+/**
+ * Callback of PyAsyncClpIrStreamWriter `tp_traverse`.
+ * @param self
+ * @param visit
+ * @param arg
+ * @return The result of visiting the sink.
+ */
+auto PyAsyncClpIrStreamWriter_traverse(PyAsyncClpIrStreamWriter* self, visitproc visit, void* arg)
+        -> int {
+    return self->traverse(visit, arg);
+}
+
+/**
+ * Callback of PyAsyncClpIrStreamWriter `tp_clear`, which breaks reference
+ * cycles through the sink. The writer is closed before the sink is released,
+ * so the background thread never writes to a file descriptor whose owner is
+ * gone.
+ * @param self
+ * @return 0.
+ */
+auto PyAsyncClpIrStreamWriter_clear(PyAsyncClpIrStreamWriter* self) -> int {
+    self->clean();
+    return 0;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyAsyncClpIrStreamWriterWriteLogEventDoc,
+        "write_log_event(self, timestamp, log_message)\n"
+        "--\n\n"
+        "Enqueues a log event to be encoded and written by the background thread. The log "
+        "message is copied, and no other work is done on the calling thread. If the queue is "
+        "full, the log event is either dropped or the call blocks (with the GIL released) until "
+        "the background thread catches up, depending on the overflow policy.\n\n"
+        ":param timestamp: The Unix epoch timestamp in milliseconds of the log event.\n"
+        ":param log_message: The log message, either as bytes or as a str encoded in UTF-8.\n"
+        ":return: True if the log event was enqueued, False if it was dropped.\n"
+        ":raises ValueError: If the writer has been closed.\n"
+        ":raises OSError: If the background thread failed to write to the file descriptor.\n"
+);
+
+auto PyAsyncClpIrStreamWriter_write_log_event(
+        PyAsyncClpIrStreamWriter* self,
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{"write_log_event", {"timestamp", "log_message"}, 2};
+    std::array<PyObject*, 2> parsed_args{};
+    ffi::epoch_time_ms_t timestamp{};
+    std::string_view log_message;
+    if (false == arg_parser.parse(args, num_args, keyword_names, parsed_args)
+        || false == parse_py_int(parsed_args[0], timestamp)
+        || false == parse_py_string_or_bytes_as_string_view(parsed_args[1], log_message))
+    {
+        return nullptr;
+    }
+    auto* writer{self->get_writer()};
+    bool is_enqueued{false};
+    if (nullptr == writer || false == writer->write_log_event(timestamp, log_message, is_enqueued))
+    {
+        return nullptr;
+    }
+    return get_py_bool(is_enqueued);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyAsyncClpIrStreamWriterFlushDoc,
+        "flush(self)\n"
+        "--\n\n"
+        "Waits until the background thread has written all the log events enqueued so far. If "
+        "the IR stream is compressed, the zstd frame is flushed so that these log events can be "
+        "decompressed from the sink.\n\n"
+        ":raises ValueError: If the writer has been closed.\n"
+);
+
+auto PyAsyncClpIrStreamWriter_flush(PyAsyncClpIrStreamWriter* self) -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer || false == writer->flush()) {
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyAsyncClpIrStreamWriterCloseDoc,
+        "close(self)\n"
+        "--\n\n"
+        "Waits until the background thread has written all the log events enqueued so far, "
+        "terminates the IR stream, and stops the background thread. If the IR stream is "
+        "compressed, the zstd frame is ended. The sink itself is not closed. Closing a closed "
+        "writer has no effect.\n"
+);
+
+auto PyAsyncClpIrStreamWriter_close(PyAsyncClpIrStreamWriter* self) -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer || false == writer->close()) {
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyAsyncClpIrStreamWriterGetNumLogEventsDoc,
+        "get_num_log_events(self)\n"
+        "--\n\n"
+        ":return: The number of log events enqueued so far.\n"
+);
+
+auto PyAsyncClpIrStreamWriter_get_num_log_events(PyAsyncClpIrStreamWriter* self) -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer) {
+        return nullptr;
+    }
+    return PyLong_FromSize_t(writer->get_num_log_events());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyAsyncClpIrStreamWriterGetNumDroppedLogEventsDoc,
+        "get_num_dropped_log_events(self)\n"
+        "--\n\n"
+        ":return: The number of log events dropped so far because the queue was full.\n"
+);
+
+auto PyAsyncClpIrStreamWriter_get_num_dropped_log_events(PyAsyncClpIrStreamWriter* self)
+        -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer) {
+        return nullptr;
+    }
+    return PyLong_FromSize_t(writer->get_num_dropped_log_events());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyAsyncClpIrStreamWriterGetLogtypeCacheStatsDoc,
+        "get_logtype_cache_stats(self)\n"
+        "--\n\n"
+        "Gets the statistics of the logtype cache.\n\n"
+        ":return: A dictionary with the capacity of the cache (`capacity`, 0 if the cache is "
+        "disabled), the number of log messages whose logtype was found in the cache (`hits`), "
+        "and the number of log messages whose logtype was built (`misses`).\n"
+);
+
+auto PyAsyncClpIrStreamWriter_get_logtype_cache_stats(PyAsyncClpIrStreamWriter* self) -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer) {
+        return nullptr;
+    }
+    return serialize_logtype_cache_stats_to_python_dict(writer->get_logtype_cache());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyAsyncClpIrStreamWriterEnterDoc,
+        "__enter__(self)\n"
+        "--\n\n"
+        ":return: The writer itself.\n"
+);
+
+auto PyAsyncClpIrStreamWriter_enter(PyAsyncClpIrStreamWriter* self) -> PyObject* {
+    auto* py_self{py_reinterpret_cast<PyObject>(self)};
+    Py_INCREF(py_self);
+    return py_self;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyAsyncClpIrStreamWriterExitDoc,
+        "__exit__(self, exc_type, exc_value, traceback)\n"
+        "--\n\n"
+        "Closes the writer.\n"
+);
+
+auto PyAsyncClpIrStreamWriter_exit(PyAsyncClpIrStreamWriter* self, PyObject* Py_UNUSED(args))
+        -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer || false == writer->close()) {
+        return nullptr;
+    }
+    Py_RETURN_FALSE;
+}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyMethodDef PyAsyncClpIrStreamWriter_method_table[]{
+        {"write_log_event",
+         py_c_function_cast(PyAsyncClpIrStreamWriter_write_log_event),
+         METH_FASTCALL | METH_KEYWORDS,
+         static_cast<char const*>(cPyAsyncClpIrStreamWriterWriteLogEventDoc)},
+
+        {"flush",
+         py_c_function_cast(PyAsyncClpIrStreamWriter_flush),
+         METH_NOARGS,
+         static_cast<char const*>(cPyAsyncClpIrStreamWriterFlushDoc)},
+
+        {"close",
+         py_c_function_cast(PyAsyncClpIrStreamWriter_close),
+         METH_NOARGS,
+         static_cast<char const*>(cPyAsyncClpIrStreamWriterCloseDoc)},
+
+        {"get_num_log_events",
+         py_c_function_cast(PyAsyncClpIrStreamWriter_get_num_log_events),
+         METH_NOARGS,
+         static_cast<char const*>(cPyAsyncClpIrStreamWriterGetNumLogEventsDoc)},
+
+        {"get_num_dropped_log_events",
+         py_c_function_cast(PyAsyncClpIrStreamWriter_get_num_dropped_log_events),
+         METH_NOARGS,
+         static_cast<char const*>(cPyAsyncClpIrStreamWriterGetNumDroppedLogEventsDoc)},
+
+        {"get_logtype_cache_stats",
+         py_c_function_cast(PyAsyncClpIrStreamWriter_get_logtype_cache_stats),
+         METH_NOARGS,
+         static_cast<char const*>(cPyAsyncClpIrStreamWriterGetLogtypeCacheStatsDoc)},
+
+        {"__enter__",
+         py_c_function_cast(PyAsyncClpIrStreamWriter_enter),
+         METH_NOARGS,
+         static_cast<char const*>(cPyAsyncClpIrStreamWriterEnterDoc)},
+
+        {"__exit__",
+         py_c_function_cast(PyAsyncClpIrStreamWriter_exit),
+         METH_VARARGS,
+         static_cast<char const*>(cPyAsyncClpIrStreamWriterExitDoc)},
+
+        {nullptr}
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyAsyncClpIrStreamWriterDoc,
+        "This class writes a CLP IR stream (four-byte encoding) to a file descriptor from a "
+        "native background thread, for logging with minimal latency on the calling thread. "
+        "`write_log_event` only copies the log event into a bounded lock-free queue; the "
+        "background thread encodes the queued log events, optionally compresses them with "
+        "zstd, and writes them to the file descriptor without holding the GIL.\n\n"
+        "The background thread writes the buffered IR stream once it reaches the flush "
+        "threshold, and flushes it at least once per flush interval while log events are "
+        "pending. Errors that occur in the background thread are raised by the next call to "
+        "the writer.\n\n"
+        "The writer should be closed, either explicitly or by using it as a context manager, to "
+        "terminate the IR stream. A writer that is garbage collected without being closed is "
+        "closed on deallocation.\n\n"
+        "The signature of `__init__` method is shown as following:\n\n"
+        "__init__(self, sink, ref_timestamp, timestamp_format, timezone, "
+        "enable_compression=True, compression_level=3, queue_capacity=65536, "
+        "flush_interval_ms=1000, flush_threshold=65536, overflow_policy=\"block\", "
+        "logtype_cache_capacity=0)\n\n"
+        "Initializes an AsyncClpIrStreamWriter object.\n\n"
+        ":param sink: A file descriptor, or an object with a `fileno` method. The file "
+        "descriptor is written directly, bypassing any buffering of the object. The writer keeps "
+        "a reference to `sink` until it's deallocated, so a file object isn't garbage collected "
+        "(closing its file descriptor) while the writer is alive, but the file descriptor must "
+        "not be closed explicitly until the writer is closed.\n"
+        ":param ref_timestamp: The reference Unix epoch timestamp in milliseconds of the IR "
+        "stream.\n"
+        ":param timestamp_format: The timestamp format stored in the preamble.\n"
+        ":param timezone: The timezone ID stored in the preamble.\n"
+        ":param enable_compression: If set to True, the IR stream is compressed with zstd.\n"
+        ":param compression_level: The zstd compression level.\n"
+        ":param queue_capacity: The maximum number of log events waiting to be encoded, rounded "
+        "up to the next power of 2.\n"
+        ":param flush_interval_ms: The maximum time in milliseconds an enqueued log event can "
+        "wait before it's written to the sink.\n"
+        ":param flush_threshold: The number of buffered IR bytes that triggers a write to the "
+        "sink.\n"
+        ":param overflow_policy: What `write_log_event` does when the queue is full: \"block\" "
+        "to wait for the background thread, or \"drop\" to drop the log event.\n"
+        ":param logtype_cache_capacity: If positive, the logtypes of recently encoded log "
+        "messages are cached in this many slots, at most 2^30, so that a log message following a "
+        "cached template only needs its variables to be encoded. The cache's hit rate is returned "
+        "by `get_logtype_cache_stats`.\n"
+);
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-c-arrays, cppcoreguidelines-pro-type-*-cast)
+PyType_Slot PyAsyncClpIrStreamWriter_slots[]{
+        {Py_tp_alloc, reinterpret_cast<void*>(PyType_GenericAlloc)},
+        {Py_tp_dealloc, reinterpret_cast<void*>(PyAsyncClpIrStreamWriter_dealloc)},
+        {Py_tp_traverse, reinterpret_cast<void*>(PyAsyncClpIrStreamWriter_traverse)},
+        {Py_tp_clear, reinterpret_cast<void*>(PyAsyncClpIrStreamWriter_clear)},
+        {Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew)},
+        {Py_tp_init, reinterpret_cast<void*>(PyAsyncClpIrStreamWriter_init)},
+        {Py_tp_methods, static_cast<void*>(PyAsyncClpIrStreamWriter_method_table)},
+        {Py_tp_doc, const_cast<void*>(static_cast<void const*>(cPyAsyncClpIrStreamWriterDoc))},
+        {0, nullptr}
+};
+// NOLINTEND(cppcoreguidelines-avoid-c-arrays, cppcoreguidelines-pro-type-*-cast)
+
+/**
+ * PyAsyncClpIrStreamWriter Python type specifications.
+ */
+PyType_Spec PyAsyncClpIrStreamWriter_type_spec{
+        "clp_ffi_py.ir.native.AsyncClpIrStreamWriter",
+        sizeof(PyAsyncClpIrStreamWriter),
+        0,
+        Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+        static_cast<PyType_Slot*>(PyAsyncClpIrStreamWriter_slots)
+};
+}  // namespace
+
+auto PyAsyncClpIrStreamWriter::clean() -> void {
+    if (nullptr == m_writer) {
+        Py_CLEAR(m_sink);
+        return;
+    }
+    if (false == m_writer->is_closed()) {
+        // The deallocator may be called while an exception is being raised,
+        // so the exception is saved and restored around closing the writer.
+        PyObject* error_type{nullptr};
+        PyObject* error_value{nullptr};
+        PyObject* error_traceback{nullptr};
+        PyErr_Fetch(&error_type, &error_value, &error_traceback);
+        if (false == m_writer->close()) {
+            PyErr_WriteUnraisable(py_reinterpret_cast<PyObject>(this));
+        }
+        PyErr_Restore(error_type, error_value, error_traceback);
+    }
+    delete m_writer;
+    m_writer = nullptr;
+    Py_CLEAR(m_sink);
+}
+
+auto PyAsyncClpIrStreamWriter::get_writer() -> AsyncIrStreamWriter* {
+    if (nullptr == m_writer) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                "The AsyncClpIrStreamWriter has not been initialized."
+        );
+    }
+    return m_writer;
+}
+
+PyObjectGlobalPtr<PyTypeObject> PyAsyncClpIrStreamWriter::m_py_type{nullptr};
+
+auto PyAsyncClpIrStreamWriter::get_py_type() -> PyTypeObject* {
+    return m_py_type.get();
+}
+
+auto PyAsyncClpIrStreamWriter::module_level_init(PyObject* py_module) -> bool {
+    static_assert(std::is_trivially_destructible<PyAsyncClpIrStreamWriter>());
+    auto* type{py_reinterpret_cast<PyTypeObject>(
+            PyType_FromSpec(&PyAsyncClpIrStreamWriter_type_spec)
+    )};
+    m_py_type.reset(type);
+    if (nullptr == type) {
+        return false;
+    }
+    return add_python_type(get_py_type(), "AsyncClpIrStreamWriter", py_module);
+}
+}  // namespace clp_ffi_py::ir::native
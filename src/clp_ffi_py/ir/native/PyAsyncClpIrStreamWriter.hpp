@@ -0,0 +1,101 @@
+#ifndef CLP_FFI_PY_PY_ASYNC_CLP_IR_STREAM_WRITER_HPP
+#define CLP_FFI_PY_PY_ASYNC_CLP_IR_STREAM_WRITER_HPP
+
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include <memory>
+
+#include <clp_ffi_py/ir/native/AsyncIrStreamWriter.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A PyObject structure that enqueues log events to be encoded into a CLP IR
+ * stream and written to a file descriptor by a native background thread. It
+ * is a wrapper of `AsyncIrStreamWriter`.
+ */
+class PyAsyncClpIrStreamWriter {
+public:
+    /**
+     * Initializes the underlying data with the given writer. Since the memory
+     * allocation of PyAsyncClpIrStreamWriter is handled by CPython's
+     * allocator, cpp constructors will not be explicitly called. This function
+     * serves as the default constructor. It has to be manually called whenever
+     * creating a new PyAsyncClpIrStreamWriter object through CPython APIs.
+     * @param writer The writer, whose ownership is transferred.
+     * @param sink The object that owns the file descriptor written by
+     * `writer`. A new reference is held until the object is cleaned, so that
+     * the file descriptor isn't closed (and possibly reused) while the
+     * background thread writes to it.
+     */
+    auto init(std::unique_ptr<AsyncIrStreamWriter> writer, PyObject* sink) -> void {
+        m_writer = writer.release();
+        Py_INCREF(sink);
+        m_sink = sink;
+    }
+
+    /**
+     * Zero-initializes all the data members in PyAsyncClpIrStreamWriter.
+     * Should be called once the object is allocated.
+     */
+    auto default_init() -> void {
+        m_writer = nullptr;
+        m_sink = nullptr;
+    }
+
+    /**
+     * Closes the writer if it hasn't been closed, which waits for the
+     * background thread to write all the enqueued log events, releases the
+     * memory allocated for the underlying writer, and then releases the
+     * reference to the sink. Since the object is being destroyed, a failure to
+     * close the writer is reported as unraisable.
+     */
+    auto clean() -> void;
+
+    /**
+     * Visits the sink for the garbage collector.
+     * @param visit
+     * @param arg
+     * @return The result of `visit` if it's non-zero, 0 otherwise.
+     */
+    [[nodiscard]] auto traverse(visitproc visit, void* arg) -> int {
+        Py_VISIT(m_sink);
+        return 0;
+    }
+
+    /**
+     * @return The underlying writer.
+     * @return nullptr if the object hasn't been initialized, with the relevant
+     * Python exception and error set.
+     */
+    [[nodiscard]] auto get_writer() -> AsyncIrStreamWriter*;
+
+    /**
+     * Gets the PyTypeObject that represents PyAsyncClpIrStreamWriter's Python
+     * type. This type is dynamically created and initialized during the
+     * execution of `PyAsyncClpIrStreamWriter::module_level_init`.
+     * @return Python type object associated with PyAsyncClpIrStreamWriter.
+     */
+    [[nodiscard]] static auto get_py_type() -> PyTypeObject*;
+
+    /**
+     * Creates and initializes PyAsyncClpIrStreamWriter as a Python type, and
+     * then incorporates this type as a Python object into the py_module
+     * module.
+     * @param py_module This is the Python module where the initialized
+     * PyAsyncClpIrStreamWriter will be incorporated.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] static auto module_level_init(PyObject* py_module) -> bool;
+
+private:
+    PyObject_HEAD;
+    AsyncIrStreamWriter* m_writer;
+    PyObject* m_sink;
+
+    static PyObjectGlobalPtr<PyTypeObject> m_py_type;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_PY_ASYNC_CLP_IR_STREAM_WRITER_HPP
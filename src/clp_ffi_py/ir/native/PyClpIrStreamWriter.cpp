@@ -0,0 +1,465 @@
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include "PyClpIrStreamWriter.hpp"
+
+#include <array>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
+
+#include <clp_ffi_py/ir/native/LogtypeCache.hpp>
+#include <clp_ffi_py/ir/native/utils.hpp>
+#include <clp_ffi_py/PyFastcallArgParser.hpp>
+#include <clp_ffi_py/PyObjectCast.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+extern "C" {
+/**
+ * Callback of PyClpIrStreamWriter `__init__` method:
+ * __init__(self, sink, ref_timestamp, timestamp_format, timezone,
+ *          enable_compression=True, compression_level=3,
+ *          flush_threshold=65536, logtype_cache_capacity=0, attribute_table=None)
+ * Keyword argument parsing is supported.
+ * Assumes `self` is uninitialized and will allocate the underlying memory. If
+ * `self` is already initialized this will result in memory leaks.
+ * @param self
+ * @param args
+ * @param keywords
+ * @return 0 on success.
+ * @return -1 on failure with the relevant Python exception and error set.
+ */
+auto PyClpIrStreamWriter_init(PyClpIrStreamWriter* self, PyObject* args, PyObject* keywords)
+        -> int {
+    static char keyword_sink[]{"sink"};
+    static char keyword_ref_timestamp[]{"ref_timestamp"};
+    static char keyword_timestamp_format[]{"timestamp_format"};
+    static char keyword_timezone[]{"timezone"};
+    static char keyword_enable_compression[]{"enable_compression"};
+    static char keyword_compression_level[]{"compression_level"};
+    static char keyword_flush_threshold[]{"flush_threshold"};
+    static char keyword_logtype_cache_capacity[]{"logtype_cache_capacity"};
+    static char keyword_attribute_table[]{"attribute_table"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_sink),
+            static_cast<char*>(keyword_ref_timestamp),
+            static_cast<char*>(keyword_timestamp_format),
+            static_cast<char*>(keyword_timezone),
+            static_cast<char*>(keyword_enable_compression),
+            static_cast<char*>(keyword_compression_level),
+            static_cast<char*>(keyword_flush_threshold),
+            static_cast<char*>(keyword_logtype_cache_capacity),
+            static_cast<char*>(keyword_attribute_table),
+            nullptr
+    };
+
+    // If the argument parsing fails, `self` will be deallocated. We must reset
+    // all pointers to nullptr in advance, otherwise the deallocator might
+    // trigger a segmentation fault.
+    self->default_init();
+
+    PyObject* sink{nullptr};
+    PyObject* py_ref_timestamp{nullptr};
+    PyObject* py_timestamp_format{nullptr};
+    PyObject* py_timezone{nullptr};
+    int enable_compression{1};
+    int compression_level{IrStreamWriter::cDefaultCompressionLevel};
+    Py_ssize_t flush_threshold{IrStreamWriter::cDefaultFlushThreshold};
+    Py_ssize_t logtype_cache_capacity{0};
+    PyObject* py_attribute_table{Py_None};
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "OOUU|pinnO",
+                static_cast<char**>(keyword_table),
+                &sink,
+                &py_ref_timestamp,
+                &py_timestamp_format,
+                &py_timezone,
+                &enable_compression,
+                &compression_level,
+                &flush_threshold,
+                &logtype_cache_capacity,
+                &py_attribute_table
+        )))
+    {
+        return -1;
+    }
+
+    ffi::epoch_time_ms_t ref_timestamp{};
+    std::string_view timestamp_format;
+    std::string_view timezone;
+    std::vector<ffi::ir_stream::AttributeInfo> attribute_table;
+    if (false == parse_py_int(py_ref_timestamp, ref_timestamp)
+        || false == parse_py_string_as_string_view(py_timestamp_format, timestamp_format)
+        || false == parse_py_string_as_string_view(py_timezone, timezone)
+        || false == deserialize_attribute_table(py_attribute_table, attribute_table))
+    {
+        return -1;
+    }
+    if (flush_threshold < 0) {
+        PyErr_SetString(PyExc_ValueError, "The flush threshold must be non-negative.");
+        return -1;
+    }
+    if (0 > logtype_cache_capacity
+        || static_cast<size_t>(logtype_cache_capacity) > LogtypeCache::cMaxCapacity)
+    {
+        PyErr_Format(
+                PyExc_ValueError,
+                "The logtype cache capacity must be in the range [0, %zu].",
+                LogtypeCache::cMaxCapacity
+        );
+        return -1;
+    }
+
+    auto writer{IrStreamWriter::create(
+            sink,
+            ref_timestamp,
+            timestamp_format,
+            timezone,
+            static_cast<bool>(enable_compression) ? std::optional<int>{compression_level}
+                                                  : std::nullopt,
+            static_cast<size_t>(flush_threshold),
+            static_cast<size_t>(logtype_cache_capacity),
+            std::move(attribute_table)
+    )};
+    if (nullptr == writer) {
+        return -1;
+    }
+    self->init(std::move(writer));
+    return 0;
+}
+
+/**
+ * Callback of PyClpIrStreamWriter deallocator.
+ * @param self
+ */
+auto PyClpIrStreamWriter_dealloc(PyClpIrStreamWriter* self) -> void {
+    self->clean();
+    PyObject_Del(self);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyClpIrStreamWriterWriteLogEventDoc,
+        "write_log_event(self, timestamp, log_message, attributes=None)\n"
+        "--\n\n"
+        "Encodes a log event into the IR stream. The encoded log event is buffered, and the "
+        "buffer is written to the sink once it reaches the flush threshold.\n\n"
+        ":param timestamp: The Unix epoch timestamp in milliseconds of the log event.\n"
+        ":param log_message: The log message, either as bytes or as a str encoded in UTF-8.\n"
+        ":param attributes: A dictionary mapping attribute names of the writer's attribute table "
+        "to values (str, int, or None). Attributes that are not given are encoded as None.\n"
+        ":raises ValueError: If the writer has been closed, or an attribute is not declared in "
+        "the attribute table or does not match its declared type.\n"
+        ":raises TypeError: If an attribute value is neither a str, an int, nor None.\n"
+);
+
+auto PyClpIrStreamWriter_write_log_event(
+        PyClpIrStreamWriter* self,
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "write_log_event",
+            {"timestamp", "log_message", "attributes"},
+            2
+    };
+    std::array<PyObject*, 3> parsed_args{};
+    ffi::epoch_time_ms_t timestamp{};
+    std::string_view log_message;
+    if (false == arg_parser.parse(args, num_args, keyword_names, parsed_args)
+        || false == parse_py_int(parsed_args[0], timestamp)
+        || false == parse_py_string_or_bytes_as_string_view(parsed_args[1], log_message))
+    {
+        return nullptr;
+    }
+    auto* writer{self->get_writer()};
+    if (nullptr == writer) {
+        return nullptr;
+    }
+    auto* py_attributes{parsed_args[2]};
+    if (nullptr == py_attributes || Py_None == py_attributes) {
+        if (false == writer->write_log_event(timestamp, log_message)) {
+            return nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+    auto const* attribute_encoder{writer->get_attribute_encoder()};
+    if (nullptr == attribute_encoder) {
+        PyErr_SetString(PyExc_ValueError, "The writer doesn't declare any attribute.");
+        return nullptr;
+    }
+    std::vector<std::optional<ffi::ir_stream::Attribute>> attributes;
+    if (false
+        == deserialize_attribute_values_from_python_dict(
+                py_attributes,
+                attribute_encoder->get_attribute_schema(),
+                attributes
+        ))
+    {
+        return nullptr;
+    }
+    if (false == writer->write_log_event(timestamp, log_message, attributes)) {
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyClpIrStreamWriterFlushDoc,
+        "flush(self)\n"
+        "--\n\n"
+        "Writes all the buffered data to the sink. If the IR stream is compressed, the zstd "
+        "frame is flushed so that all the log events written so far can be decompressed from "
+        "the sink.\n\n"
+        ":raises ValueError: If the writer has been closed.\n"
+);
+
+auto PyClpIrStreamWriter_flush(PyClpIrStreamWriter* self) -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer || false == writer->flush()) {
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyClpIrStreamWriterCloseDoc,
+        "close(self)\n"
+        "--\n\n"
+        "Terminates the IR stream and writes all the buffered data to the sink. If the IR stream "
+        "is compressed, the zstd frame is ended. The sink itself is not closed. Closing a closed "
+        "writer has no effect.\n"
+);
+
+auto PyClpIrStreamWriter_close(PyClpIrStreamWriter* self) -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer || false == writer->close()) {
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyClpIrStreamWriterGetNumLogEventsDoc,
+        "get_num_log_events(self)\n"
+        "--\n\n"
+        ":return: The number of log events written so far.\n"
+);
+
+auto PyClpIrStreamWriter_get_num_log_events(PyClpIrStreamWriter* self) -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer) {
+        return nullptr;
+    }
+    return PyLong_FromSize_t(writer->get_num_log_events());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyClpIrStreamWriterGetLogtypeCacheStatsDoc,
+        "get_logtype_cache_stats(self)\n"
+        "--\n\n"
+        "Gets the statistics of the logtype cache.\n\n"
+        ":return: A dictionary with the capacity of the cache (`capacity`, 0 if the cache is "
+        "disabled), the number of log messages whose logtype was found in the cache (`hits`), "
+        "and the number of log messages whose logtype was built (`misses`).\n"
+);
+
+auto PyClpIrStreamWriter_get_logtype_cache_stats(PyClpIrStreamWriter* self) -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer) {
+        return nullptr;
+    }
+    return serialize_logtype_cache_stats_to_python_dict(writer->get_logtype_cache());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyClpIrStreamWriterEnterDoc,
+        "__enter__(self)\n"
+        "--\n\n"
+        ":return: The writer itself.\n"
+);
+
+auto PyClpIrStreamWriter_enter(PyClpIrStreamWriter* self) -> PyObject* {
+    auto* py_self{py_reinterpret_cast<PyObject>(self)};
+    Py_INCREF(py_self);
+    return py_self;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyClpIrStreamWriterExitDoc,
+        "__exit__(self, exc_type, exc_value, traceback)\n"
+        "--\n\n"
+        "Closes the writer.\n"
+);
+
+auto PyClpIrStreamWriter_exit(PyClpIrStreamWriter* self, PyObject* Py_UNUSED(args))
+        -> PyObject* {
+    auto* writer{self->get_writer()};
+    if (nullptr == writer || false == writer->close()) {
+        return nullptr;
+    }
+    Py_RETURN_FALSE;
+}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyMethodDef PyClpIrStreamWriter_method_table[]{
+        {"write_log_event",
+         py_c_function_cast(PyClpIrStreamWriter_write_log_event),
+         METH_FASTCALL | METH_KEYWORDS,
+         static_cast<char const*>(cPyClpIrStreamWriterWriteLogEventDoc)},
+
+        {"flush",
+         py_c_function_cast(PyClpIrStreamWriter_flush),
+         METH_NOARGS,
+         static_cast<char const*>(cPyClpIrStreamWriterFlushDoc)},
+
+        {"close",
+         py_c_function_cast(PyClpIrStreamWriter_close),
+         METH_NOARGS,
+         static_cast<char const*>(cPyClpIrStreamWriterCloseDoc)},
+
+        {"get_num_log_events",
+         py_c_function_cast(PyClpIrStreamWriter_get_num_log_events),
+         METH_NOARGS,
+         static_cast<char const*>(cPyClpIrStreamWriterGetNumLogEventsDoc)},
+
+        {"get_logtype_cache_stats",
+         py_c_function_cast(PyClpIrStreamWriter_get_logtype_cache_stats),
+         METH_NOARGS,
+         static_cast<char const*>(cPyClpIrStreamWriterGetLogtypeCacheStatsDoc)},
+
+        {"__enter__",
+         py_c_function_cast(PyClpIrStreamWriter_enter),
+         METH_NOARGS,
+         static_cast<char const*>(cPyClpIrStreamWriterEnterDoc)},
+
+        {"__exit__",
+         py_c_function_cast(PyClpIrStreamWriter_exit),
+         METH_VARARGS,
+         static_cast<char const*>(cPyClpIrStreamWriterExitDoc)},
+
+        {nullptr}
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyClpIrStreamWriterDoc,
+        "This class encodes log events into a CLP IR stream (four-byte encoding) and writes the "
+        "stream to a sink. Compared with the static methods of `FourByteEncoder`, the writer "
+        "encodes the preamble, computes the timestamp deltas from absolute timestamps, and "
+        "buffers the encoded log events natively, optionally compressing them with zstd, so "
+        "that no Python object is created per log event.\n\n"
+        "The writer should be closed, either explicitly or by using it as a context manager, to "
+        "terminate the IR stream. A writer that is garbage collected without being closed is "
+        "closed on deallocation.\n\n"
+        "The signature of `__init__` method is shown as following:\n\n"
+        "__init__(self, sink, ref_timestamp, timestamp_format, timezone, "
+        "enable_compression=True, compression_level=3, flush_threshold=65536, "
+        "logtype_cache_capacity=0, attribute_table=None)\n\n"
+        "Initializes a ClpIrStreamWriter object.\n\n"
+        ":param sink: A file descriptor, or an object with a `write` method that accepts bytes. "
+        "A file descriptor is written with the GIL released.\n"
+        ":param ref_timestamp: The reference Unix epoch timestamp in milliseconds of the IR "
+        "stream.\n"
+        ":param timestamp_format: The timestamp format stored in the preamble.\n"
+        ":param timezone: The timezone ID stored in the preamble.\n"
+        ":param enable_compression: If set to True, the IR stream is compressed with zstd.\n"
+        ":param compression_level: The zstd compression level.\n"
+        ":param flush_threshold: The number of buffered IR bytes that triggers a write to the "
+        "sink.\n"
+        ":param logtype_cache_capacity: If positive, the logtypes of recently encoded log "
+        "messages are cached in this many slots, at most 2^30, so that a log message following a "
+        "cached template only needs its variables to be encoded. The cache's hit rate is returned "
+        "by `get_logtype_cache_stats`.\n"
+        ":param attribute_table: A dictionary mapping attribute names to their types, either "
+        "`str` or `int`, declared in the preamble. If given, each log event is written with a "
+        "value (or None) for every attribute, which the decoder returns as the log event's "
+        "attributes and queries can match with attribute predicates.\n"
+);
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-c-arrays, cppcoreguidelines-pro-type-*-cast)
+PyType_Slot PyClpIrStreamWriter_slots[]{
+        {Py_tp_alloc, reinterpret_cast<void*>(PyType_GenericAlloc)},
+        {Py_tp_dealloc, reinterpret_cast<void*>(PyClpIrStreamWriter_dealloc)},
+        {Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew)},
+        {Py_tp_init, reinterpret_cast<void*>(PyClpIrStreamWriter_init)},
+        {Py_tp_methods, static_cast<void*>(PyClpIrStreamWriter_method_table)},
+        {Py_tp_doc, const_cast<void*>(static_cast<void const*>(cPyClpIrStreamWriterDoc))},
+        {0, nullptr}
+};
+// NOLINTEND(cppcoreguidelines-avoid-c-arrays, cppcoreguidelines-pro-type-*-cast)
+
+/**
+ * PyClpIrStreamWriter Python type specifications.
+ */
+PyType_Spec PyClpIrStreamWriter_type_spec{
+        "clp_ffi_py.ir.native.ClpIrStreamWriter",
+        sizeof(PyClpIrStreamWriter),
+        0,
+        Py_TPFLAGS_DEFAULT,
+        static_cast<PyType_Slot*>(PyClpIrStreamWriter_slots)
+};
+}  // namespace
+
+auto PyClpIrStreamWriter::clean() -> void {
+    if (nullptr == m_writer) {
+        return;
+    }
+    if (false == m_writer->is_closed()) {
+        // The deallocator may be called while an exception is being raised,
+        // so the exception is saved and restored around closing the writer.
+        PyObject* error_type{nullptr};
+        PyObject* error_value{nullptr};
+        PyObject* error_traceback{nullptr};
+        PyErr_Fetch(&error_type, &error_value, &error_traceback);
+        if (false == m_writer->close()) {
+            PyErr_WriteUnraisable(py_reinterpret_cast<PyObject>(this));
+        }
+        PyErr_Restore(error_type, error_value, error_traceback);
+    }
+    delete m_writer;
+    m_writer = nullptr;
+}
+
+auto PyClpIrStreamWriter::get_writer() -> IrStreamWriter* {
+    if (nullptr == m_writer) {
+        PyErr_SetString(PyExc_RuntimeError, "The ClpIrStreamWriter has not been initialized.");
+    }
+    return m_writer;
+}
+
+PyObjectGlobalPtr<PyTypeObject> PyClpIrStreamWriter::m_py_type{nullptr};
+
+auto PyClpIrStreamWriter::get_py_type() -> PyTypeObject* {
+    return m_py_type.get();
+}
+
+auto PyClpIrStreamWriter::module_level_init(PyObject* py_module) -> bool {
+    static_assert(std::is_trivially_destructible<PyClpIrStreamWriter>());
+    auto* type{
+            py_reinterpret_cast<PyTypeObject>(PyType_FromSpec(&PyClpIrStreamWriter_type_spec))
+    };
+    m_py_type.reset(type);
+    if (nullptr == type) {
+        return false;
+    }
+    return add_python_type(get_py_type(), "ClpIrStreamWriter", py_module);
+}
+}  // namespace clp_ffi_py::ir::native
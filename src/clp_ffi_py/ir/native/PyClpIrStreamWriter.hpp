@@ -0,0 +1,74 @@
+#ifndef CLP_FFI_PY_PY_CLP_IR_STREAM_WRITER_HPP
+#define CLP_FFI_PY_PY_CLP_IR_STREAM_WRITER_HPP
+
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include <memory>
+
+#include <clp_ffi_py/ir/native/IrStreamWriter.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A PyObject structure that encodes log events into a CLP IR stream and writes
+ * the stream to a sink natively. It is a wrapper of `IrStreamWriter`.
+ */
+class PyClpIrStreamWriter {
+public:
+    /**
+     * Initializes the underlying data with the given writer. Since the memory
+     * allocation of PyClpIrStreamWriter is handled by CPython's allocator, cpp
+     * constructors will not be explicitly called. This function serves as the
+     * default constructor. It has to be manually called whenever creating a
+     * new PyClpIrStreamWriter object through CPython APIs.
+     * @param writer The writer, whose ownership is transferred.
+     */
+    auto init(std::unique_ptr<IrStreamWriter> writer) -> void { m_writer = writer.release(); }
+
+    /**
+     * Zero-initializes all the data members in PyClpIrStreamWriter. Should be
+     * called once the object is allocated.
+     */
+    auto default_init() -> void { m_writer = nullptr; }
+
+    /**
+     * Closes the writer if it hasn't been closed, and releases the memory
+     * allocated for the underlying writer. Since the object is being
+     * destroyed, a failure to close the writer is reported as unraisable.
+     */
+    auto clean() -> void;
+
+    /**
+     * @return The underlying writer.
+     * @return nullptr if the object hasn't been initialized, with the relevant
+     * Python exception and error set.
+     */
+    [[nodiscard]] auto get_writer() -> IrStreamWriter*;
+
+    /**
+     * Gets the PyTypeObject that represents PyClpIrStreamWriter's Python type.
+     * This type is dynamically created and initialized during the execution of
+     * `PyClpIrStreamWriter::module_level_init`.
+     * @return Python type object associated with PyClpIrStreamWriter.
+     */
+    [[nodiscard]] static auto get_py_type() -> PyTypeObject*;
+
+    /**
+     * Creates and initializes PyClpIrStreamWriter as a Python type, and then
+     * incorporates this type as a Python object into the py_module module.
+     * @param py_module This is the Python module where the initialized
+     * PyClpIrStreamWriter will be incorporated.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] static auto module_level_init(PyObject* py_module) -> bool;
+
+private:
+    PyObject_HEAD;
+    IrStreamWriter* m_writer;
+
+    static PyObjectGlobalPtr<PyTypeObject> m_py_type;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_PY_CLP_IR_STREAM_WRITER_HPP
@@ -49,6 +49,35 @@ PyDoc_STRVAR(
         "     - None when the end of IR stream is reached or the query search terminates.\n"
 );
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cExportLogEventsDoc,
+        "export_log_events(decoder_buffer, sink, format=\"text\", query=None, "
+        "allow_incomplete_stream=False)\n"
+        "--\n\n"
+        "Decodes all the remaining log events (matching the query if given) from the IR stream "
+        "buffered in the given decoder buffer, and writes them to `sink` in large batches. The log "
+        "events are decoded and formatted natively without creating any LogEvent object. "
+        "`decoder_buffer` must have been returned by a successfully invocation of "
+        "`decode_preamble`.\n\n"
+        ":param decoder_buffer: The decoder buffer of the encoded CLP IR stream.\n"
+        ":param sink: Either a file descriptor, which is written with the GIL released, or an "
+        "object with a `write` method that accepts bytes, such as a binary file.\n"
+        ":param format: The output format:\n"
+        "     - \"text\": Each log event is written as its formatted message, the same as "
+        "       `LogEvent.get_formatted_message`.\n"
+        "     - \"jsonl\": Each log event is written as a JSON object on its own line, with the "
+        "       fields `log_message`, `timestamp`, `formatted_timestamp`, `index`, and "
+        "       `attributes`. Invalid UTF-8 sequences in the strings are replaced by U+FFFD.\n"
+        "     The output is encoded in UTF-8.\n"
+        ":param query: A Query object that filters log events. See `Query` documents for more "
+        "details.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":raises: Appropriate exceptions with detailed information on any encountered failure.\n"
+        ":return: The number of exported log events.\n"
+);
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyMethodDef PyDecoder_method_table[]{
         {"decode_preamble",
@@ -58,9 +87,14 @@ PyMethodDef PyDecoder_method_table[]{
 
         {"decode_next_log_event",
          py_c_function_cast(decode_next_log_event),
-         METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+         METH_FASTCALL | METH_KEYWORDS | METH_STATIC,
          static_cast<char const*>(cDecodeNextLogEventDoc)},
 
+        {"export_log_events",
+         py_c_function_cast(export_log_events),
+         METH_FASTCALL | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cExportLogEventsDoc)},
+
         {nullptr, nullptr, 0, nullptr}
 };
 
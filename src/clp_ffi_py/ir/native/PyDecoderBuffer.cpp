@@ -3,6 +3,7 @@
 #include "PyDecoderBuffer.hpp"
 
 #include <algorithm>
+#include <new>
 #include <random>
 
 #include <clp_ffi_py/error_messages.hpp>
@@ -16,7 +17,8 @@ namespace {
 extern "C" {
 /**
  * Callback of PyDecoderBuffer `__init__` method:
- * __init__(self, input_stream: IO[bytes], initial_buffer_capacity: int = 4096)
+ * __init__(self, input_stream: IO[bytes], initial_buffer_capacity: int = 4096,
+ *          trusted_stream: bool = False, message_intern_cache_capacity: int = 0)
  * Keyword argument parsing is supported.
  * Assumes `self` is uninitialized and will allocate the underlying memory. If
  * `self` is already initialized this will result in memory leaks.
@@ -29,9 +31,13 @@ extern "C" {
 auto PyDecoderBuffer_init(PyDecoderBuffer* self, PyObject* args, PyObject* keywords) -> int {
     static char keyword_input_stream[]{"input_stream"};
     static char keyword_initial_buffer_capacity[]{"initial_buffer_capacity"};
+    static char keyword_trusted_stream[]{"trusted_stream"};
+    static char keyword_message_intern_cache_capacity[]{"message_intern_cache_capacity"};
     static char* keyword_table[]{
             static_cast<char*>(keyword_input_stream),
             static_cast<char*>(keyword_initial_buffer_capacity),
+            static_cast<char*>(keyword_trusted_stream),
+            static_cast<char*>(keyword_message_intern_cache_capacity),
             nullptr
     };
 
@@ -42,19 +48,35 @@ auto PyDecoderBuffer_init(PyDecoderBuffer* self, PyObject* args, PyObject* keywo
 
     PyObject* input_stream{nullptr};
     Py_ssize_t initial_buffer_capacity{PyDecoderBuffer::cDefaultInitialCapacity};
+    int trusted_stream{0};
+    Py_ssize_t message_intern_cache_capacity{0};
     if (false
         == static_cast<bool>(PyArg_ParseTupleAndKeywords(
                 args,
                 keywords,
-                "O|L",
+                "O|Lpn",
                 static_cast<char**>(keyword_table),
                 &input_stream,
-                &initial_buffer_capacity
+                &initial_buffer_capacity,
+                &trusted_stream,
+                &message_intern_cache_capacity
         )))
     {
         return -1;
     }
 
+    if (0 > message_intern_cache_capacity
+        || static_cast<size_t>(message_intern_cache_capacity)
+                   > LogMessageInternCache::cMaxCapacity)
+    {
+        PyErr_Format(
+                PyExc_ValueError,
+                "The message intern cache capacity must be in the range [0, %zu].",
+                LogMessageInternCache::cMaxCapacity
+        );
+        return -1;
+    }
+
     PyObjectPtr<PyObject> const readinto_method_obj{PyObject_GetAttrString(input_stream, "readinto")
     };
     auto* readinto_method{readinto_method_obj.get()};
@@ -70,7 +92,14 @@ auto PyDecoderBuffer_init(PyDecoderBuffer* self, PyObject* args, PyObject* keywo
         return -1;
     }
 
-    if (false == self->init(input_stream, initial_buffer_capacity)) {
+    if (false
+        == self->init(
+                input_stream,
+                initial_buffer_capacity,
+                static_cast<bool>(trusted_stream),
+                static_cast<size_t>(message_intern_cache_capacity)
+        ))
+    {
         return -1;
     }
 
@@ -120,6 +149,33 @@ auto PyDecoderBuffer_get_num_decoded_log_messages(PyDecoderBuffer* self) -> PyOb
     return PyLong_FromLongLong(static_cast<long long>(self->get_num_decoded_message()));
 }
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyDecoderBufferGetMessageInternCacheStatsDoc,
+        "get_message_intern_cache_stats(self)\n"
+        "--\n\n"
+        "Gets the statistics of the log message intern cache.\n\n"
+        ":return: A dictionary with the capacity of the cache (`capacity`, 0 if the cache is "
+        "disabled), the number of decoded log messages shared with a previous log event "
+        "(`hits`), and the number of decoded log messages that were newly created (`misses`).\n"
+);
+
+auto PyDecoderBuffer_get_message_intern_cache_stats(PyDecoderBuffer* self) -> PyObject* {
+    auto const* log_message_intern_cache{self->get_log_message_intern_cache()};
+    if (nullptr == log_message_intern_cache) {
+        return Py_BuildValue("{sKsKsK}", "capacity", 0ULL, "hits", 0ULL, "misses", 0ULL);
+    }
+    return Py_BuildValue(
+            "{sKsKsK}",
+            "capacity",
+            static_cast<unsigned long long>(log_message_intern_cache->get_capacity()),
+            "hits",
+            static_cast<unsigned long long>(log_message_intern_cache->get_num_hits()),
+            "misses",
+            static_cast<unsigned long long>(log_message_intern_cache->get_num_misses())
+    );
+}
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
         cPyDecoderBufferTestStreamingDoc,
@@ -149,6 +205,11 @@ PyMethodDef PyDecoderBuffer_method_table[]{
          METH_NOARGS,
          static_cast<char const*>(cPyDecoderBufferGetNumDecodedLogMessages)},
 
+        {"get_message_intern_cache_stats",
+         py_c_function_cast(PyDecoderBuffer_get_message_intern_cache_stats),
+         METH_NOARGS,
+         static_cast<char const*>(cPyDecoderBufferGetMessageInternCacheStatsDoc)},
+
         {"_test_streaming",
          py_c_function_cast(PyDecoderBuffer_test_streaming),
          METH_O,
@@ -175,11 +236,20 @@ PyDoc_STRVAR(
         "expected to be passed across different calls of CLP IR decoding methods when decoding "
         "from the same IR stream.\n\n"
         "The signature of `__init__` method is shown as following:\n\n"
-        "__init__(self, input_stream, initial_buffer_capacity=4096)\n\n"
+        "__init__(self, input_stream, initial_buffer_capacity=4096, trusted_stream=False, "
+        "message_intern_cache_capacity=0)\n\n"
         "Initializes a DecoderBuffer object for the given input IR stream.\n\n"
         ":param input_stream: Input stream that contains encoded CLP IR. It should be an instance "
         "of type `IO[bytes]` with the method `readinto` supported.\n"
         ":param initial_buffer_capacity: The initial capacity of the underlying byte buffer.\n"
+        ":param trusted_stream: If set to True, the input stream is trusted to be produced by a "
+        "valid CLP IR encoder, and the decoded attributes of each log event are not validated "
+        "against the attributes declared in the metadata.\n"
+        ":param message_intern_cache_capacity: If positive, the decoded log events with "
+        "identical messages share the same message and the same Python string, as long as they "
+        "are found in a cache with the given number of entries, at most 2^30. It is set to 0 "
+        "(disabled) by default. The cache's hit rate is returned by "
+        "`get_message_intern_cache_stats`.\n"
 );
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-c-arrays, cppcoreguidelines-pro-type-*-cast)
@@ -214,12 +284,29 @@ PyDoc_STRVAR(
 );
 }  // namespace
 
-auto PyDecoderBuffer::init(PyObject* input_stream, Py_ssize_t buf_capacity) -> bool {
+auto PyDecoderBuffer::init(
+        PyObject* input_stream,
+        Py_ssize_t buf_capacity,
+        bool trusted_stream,
+        size_t message_intern_cache_capacity
+) -> bool {
     m_read_buffer_mem_owner = static_cast<int8_t*>(PyMem_Malloc(buf_capacity));
     if (nullptr == m_read_buffer_mem_owner) {
         PyErr_NoMemory();
         return false;
     }
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    m_decoded_log_event_buffers = new DecodedLogEventBuffers{};
+    if (0 < message_intern_cache_capacity) {
+        try {
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+            m_log_message_intern_cache = new LogMessageInternCache(message_intern_cache_capacity);
+        } catch (std::bad_alloc const&) {
+            PyErr_NoMemory();
+            return false;
+        }
+    }
+    m_trusted_stream = trusted_stream;
     m_read_buffer = gsl::span<int8_t>(m_read_buffer_mem_owner, buf_capacity);
     m_input_ir_stream = input_stream;
     Py_INCREF(m_input_ir_stream);
@@ -244,8 +331,9 @@ auto PyDecoderBuffer::populate_read_buffer(Py_ssize_t& num_bytes_read) -> bool {
         PyMem_Free(m_read_buffer_mem_owner);
         m_read_buffer_mem_owner = new_buf;
         m_read_buffer = new_read_buffer;
-    } else if (0 < num_unconsumed_bytes) {
-        memcpy(m_read_buffer.data(), unconsumed_bytes.data(), num_unconsumed_bytes);
+    } else if (0 < num_unconsumed_bytes && 0 < m_num_current_bytes_consumed) {
+        // The unconsumed bytes may overlap with the beginning of the buffer
+        memmove(m_read_buffer.data(), unconsumed_bytes.data(), num_unconsumed_bytes);
     }
     m_num_current_bytes_consumed = 0;
     m_buffer_size = num_unconsumed_bytes;
@@ -334,6 +422,26 @@ auto PyDecoderBuffer::try_read() -> bool {
     return true;
 }
 
+auto PyDecoderBuffer::try_read_for_incomplete_data() -> bool {
+    auto const num_bytes_required{std::max(2 * get_num_unconsumed_bytes(), Py_ssize_t{1})};
+    bool has_read{false};
+    while (get_num_unconsumed_bytes() < num_bytes_required) {
+        Py_ssize_t num_bytes_read{0};
+        if (false == populate_read_buffer(num_bytes_read)) {
+            return false;
+        }
+        if (0 == num_bytes_read) {
+            break;
+        }
+        has_read = true;
+    }
+    if (false == has_read) {
+        PyErr_SetString(get_py_incomplete_stream_error(), cDecoderIncompleteIRError);
+        return false;
+    }
+    return true;
+}
+
 auto PyDecoderBuffer::test_streaming(uint32_t seed) -> PyObject* {
     std::default_random_engine rand_generator(seed);
     std::vector<uint8_t> read_bytes;
@@ -3,13 +3,33 @@
 
 #include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
 
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
 #include <clp/components/core/src/ffi/ir_stream/decoding_methods.hpp>
 #include <gsl/span>
 
+#include <clp_ffi_py/ir/native/EncodedLogEventArena.hpp>
+#include <clp_ffi_py/ir/native/LogMessageInternCache.hpp>
 #include <clp_ffi_py/ir/native/PyMetadata.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 
 namespace clp_ffi_py::ir::native {
+/**
+ * Buffers that the decoding methods decode log events into. They are owned by
+ * the decoder buffer and reused across log events, so decoding a log event
+ * that doesn't match the query doesn't allocate once their capacity is large
+ * enough. The encoded log events cached by the decoding methods are stored in
+ * `m_encoded_log_event_arena`.
+ */
+struct DecodedLogEventBuffers {
+    std::string m_log_message;
+    std::vector<std::optional<ffi::ir_stream::Attribute>> m_attributes;
+    EncodedLogEventArena m_encoded_log_event_arena;
+};
+
 /**
  * This Python class is designed to buffer encoded CLP IR bytes that are read
  * from an input stream. This object serves a dual purpose:
@@ -21,6 +41,12 @@ namespace clp_ffi_py::ir::native {
  * This class encompasses all essential attributes to hold the buffered bytes
  * and monitor the state of the buffer. It's meant to be utilized across various
  * CLP IR decoding method calls when decoding from the same IR stream.
+ *
+ * A decoder buffer can be marked as reading a trusted stream, in which case
+ * the decoding methods skip validating the decoded attributes against the
+ * attributes declared in the metadata. It can also own a log message intern
+ * cache, in which case the log events decoded with identical messages share
+ * the same message (see `LogMessageInternCache`).
  */
 class PyDecoderBuffer {
 public:
@@ -33,13 +59,22 @@ public:
      * stream and read buffer. Other data members are assumed to be
      * zero-initialized by `default-init` method. It has to be manually called
      * whenever creating a new PyDecoderBuffer object through CPython APIs.
+     * @param input_stream
+     * @param buf_capacity
+     * @param trusted_stream Whether the input stream is trusted, in which case
+     * the decoded attributes are not validated.
+     * @param message_intern_cache_capacity The capacity of the log message
+     * intern cache. The cache is disabled if it is 0.
      * @return true on success.
      * @return false on failure with the relevant Python exception and error
      * set.
      */
-    [[nodiscard]] auto
-    init(PyObject* input_stream, Py_ssize_t buf_capacity = PyDecoderBuffer::cDefaultInitialCapacity)
-            -> bool;
+    [[nodiscard]] auto init(
+            PyObject* input_stream,
+            Py_ssize_t buf_capacity = PyDecoderBuffer::cDefaultInitialCapacity,
+            bool trusted_stream = false,
+            size_t message_intern_cache_capacity = 0
+    ) -> bool;
 
     /**
      * Zero-initializes all the data members in PyDecoderBuffer. Should be
@@ -52,8 +87,11 @@ public:
         m_ref_timestamp = 0;
         m_num_decoded_message = 0;
         m_py_buffer_protocol_enabled = false;
+        m_trusted_stream = false;
         m_input_ir_stream = nullptr;
         m_metadata = nullptr;
+        m_decoded_log_event_buffers = nullptr;
+        m_log_message_intern_cache = nullptr;
     }
 
     /**
@@ -64,6 +102,8 @@ public:
         Py_XDECREF(m_input_ir_stream);
         Py_XDECREF(m_metadata);
         PyMem_Free(m_read_buffer_mem_owner);
+        delete m_decoded_log_event_buffers;
+        delete m_log_message_intern_cache;
     }
 
     /**
@@ -137,6 +177,19 @@ public:
 
     [[nodiscard]] auto get_metadata() const -> PyMetadata* { return m_metadata; }
 
+    [[nodiscard]] auto is_trusted_stream() const -> bool { return m_trusted_stream; }
+
+    [[nodiscard]] auto get_decoded_log_event_buffers() -> DecodedLogEventBuffers& {
+        return *m_decoded_log_event_buffers;
+    }
+
+    /**
+     * @return The log message intern cache, or nullptr if it is disabled.
+     */
+    [[nodiscard]] auto get_log_message_intern_cache() -> LogMessageInternCache* {
+        return m_log_message_intern_cache;
+    }
+
     /**
      * Handles the Python buffer protocol's `getbuffer` operation.
      * This function should fail unless the buffer protocol is enabled.
@@ -163,6 +216,20 @@ public:
      */
     [[nodiscard]] auto try_read() -> bool;
 
+    /**
+     * Attempts to populate the decoder buffer until the number of unconsumed
+     * bytes is at least doubled, or the input stream is exhausted. It should
+     * be called when the unconsumed bytes hold an incomplete log event (or
+     * preamble) that must be decoded again from its beginning once more bytes
+     * are available. Growing the unconsumed bytes geometrically bounds the
+     * number of times an n-byte log event is decoded to O(log n), even if the
+     * input stream only returns a few bytes per read.
+     * @return true on success.
+     * @return false on failure. The Python exception and error will be properly
+     * set if the error
+     */
+    [[nodiscard]] auto try_read_for_incomplete_data() -> bool;
+
     /**
      * Tests the functionality of the DecoderBuffer by sequentially reading
      * through the input stream with randomly sized reads. It will grow the read
@@ -235,6 +302,9 @@ private:
     Py_ssize_t m_num_current_bytes_consumed;
     size_t m_num_decoded_message;
     bool m_py_buffer_protocol_enabled;
+    bool m_trusted_stream;
+    DecodedLogEventBuffers* m_decoded_log_event_buffers;
+    LogMessageInternCache* m_log_message_intern_cache;
 
     static PyObjectGlobalPtr<PyTypeObject> m_py_type;
     static PyObjectGlobalPtr<PyObject> m_py_incomplete_stream_error;
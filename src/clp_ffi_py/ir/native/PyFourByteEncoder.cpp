@@ -42,6 +42,43 @@ PyDoc_STRVAR(
         ":return: The encoded preamble.\n"
 );
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cEncodePreambleWithAttributesDoc,
+        "encode_preamble_with_attributes(ref_timestamp, timestamp_format, timezone, "
+        "attribute_table)\n"
+        "--\n\n"
+        "Creates the encoded CLP preamble for a stream of encoded log messages with user-defined "
+        "attributes using the 4-byte encoding. Each log event of the stream must be preceded by "
+        "its attributes encoded by `encode_attributes`.\n\n"
+        ":param ref_timestamp: Reference timestamp used to calculate deltas emitted with each "
+        "message.\n"
+        ":param timestamp_format: Timestamp format to be use when generating the logs with a "
+        "reader.\n"
+        ":param timezone: Timezone in TZID format to be use when generating the timestamp "
+        "from Unix epoch time.\n"
+        ":param attribute_table: A dictionary mapping attribute names to their types, either "
+        "`str` or `int`, in the order the attributes are encoded.\n"
+        ":raises TypeError: If an attribute type is neither `str` nor `int`.\n"
+        ":raises NotImplementedError: If metadata length too large.\n"
+        ":return: The encoded preamble.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cEncodeAttributesDoc,
+        "encode_attributes(attributes)\n"
+        "--\n\n"
+        "Encodes the attributes of a log event using the 4-byte encoding. The encoded attributes "
+        "must be followed by the encoded message and timestamp delta of the log event.\n\n"
+        ":param attributes: A sequence with the value (str, int, or None) of every attribute "
+        "declared by the preamble, in the declared order. The values are checked against their "
+        "declared types when the stream is decoded.\n"
+        ":raises TypeError: If an attribute value is neither a str, an int, nor None.\n"
+        ":raises NotImplementedError: If a str attribute is too long to be encoded.\n"
+        ":return: The encoded attributes.\n"
+);
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
         cEncodeMessageAndTimestampDeltaDoc,
@@ -67,6 +104,33 @@ PyDoc_STRVAR(
         ":return: The encoded message.\n"
 );
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cEncodeMessageWithClpTokenizerDoc,
+        "_encode_message_with_clp_tokenizer(msg)\n"
+        "--\n\n"
+        "Encodes the log `msg` using the 4-byte encoding, with CLP's own message encoding method "
+        "instead of the vectorized tokenizer used by `encode_message`. The results of both "
+        "methods are expected to be identical.\n\n"
+        "Note: this function should only be used for testing purpose.\n\n"
+        ":param msg: Log message to encode.\n"
+        ":raises NotImplementedError: If the log message failed to encode.\n"
+        ":return: The encoded message.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cSetVectorizedTokenizerEnabledDoc,
+        "_set_vectorized_tokenizer_enabled(enabled)\n"
+        "--\n\n"
+        "Sets whether the tokenizer used by `encode_message` (and the other encoding methods) "
+        "classifies the bytes of log messages with AVX2 when the CPU supports it. Disabling it "
+        "forces the scalar fallback, so that both can be compared against "
+        "`_encode_message_with_clp_tokenizer` on the same machine. It applies to all threads.\n\n"
+        "Note: this function should only be used for testing purpose.\n\n"
+        ":param enabled: Whether AVX2 may be used.\n"
+);
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
         cEncodeTimestampDeltaDoc,
@@ -79,6 +143,81 @@ PyDoc_STRVAR(
         ":return: The encoded timestamp.\n"
 );
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cEncodeBatchDoc,
+        "encode_batch(timestamps, messages, ref_timestamp, offsets=None, num_threads=1)\n"
+        "--\n\n"
+        "Encodes a batch of log events using the 4-byte encoding, which is equivalent to "
+        "concatenating the results of `encode_message_and_timestamp_delta` for each log event. "
+        "The log events are encoded with the GIL released.\n\n"
+        ":param timestamps: A sequence of the absolute timestamps of the log events, in "
+        "milliseconds since the Unix epoch.\n"
+        ":param messages: The log messages to encode: either a sequence of bytes, or a bytes-like "
+        "object that contains all the log messages if `offsets` is given.\n"
+        ":param ref_timestamp: The timestamp that the timestamp delta of the first log event is "
+        "computed from, i.e., the reference timestamp of the preamble or the timestamp of the "
+        "last encoded log event.\n"
+        ":param offsets: A sequence of `len(timestamps) + 1` non-decreasing offsets into "
+        "`messages`, where the i-th log message is `messages[offsets[i]:offsets[i + 1]]`.\n"
+        ":param num_threads: The number of threads to encode the log events with, or 0 to use "
+        "one thread per CPU. The log events are split into contiguous chunks encoded in "
+        "parallel, so the result is the same regardless of the number of threads. Small batches "
+        "are encoded with fewer threads.\n"
+        ":raises ValueError: If the number of log messages or offsets doesn't match the number "
+        "of timestamps, or an offset is invalid.\n"
+        ":raises NotImplementedError: If a log message failed to encode, or a timestamp delta "
+        "exceeds the supported size.\n"
+        ":return: The encoded log events.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cEncodeIntoDoc,
+        "encode_into(buffer, offset, msg, timestamp_delta=None)\n"
+        "--\n\n"
+        "Encodes the log `msg`, followed by the timestamp delta if given, using the 4-byte "
+        "encoding, and writes the result into `buffer` starting at `offset`. The written bytes "
+        "are the same as the ones returned by `encode_message_and_timestamp_delta` (or "
+        "`encode_message` if no timestamp delta is given).\n\n"
+        ":param buffer: A writable bytes-like object, e.g., a bytearray, a writable memoryview or "
+        "an mmap.\n"
+        ":param offset: The position in `buffer` to write the encoded bytes to.\n"
+        ":param msg: Log message to encode.\n"
+        ":param timestamp_delta: Timestamp difference in milliseconds between the current log "
+        "message and the previous log message.\n"
+        ":raises TypeError: If `buffer` isn't a writable bytes-like object.\n"
+        ":raises ValueError: If `offset` is out of the bounds of `buffer`.\n"
+        ":raises NotImplementedError: If the log message failed to encode, or the timestamp delta "
+        "exceeds the supported size.\n"
+        ":return: The number of bytes written. If the space left in `buffer` is too small, "
+        "nothing is written and the negated number of missing bytes is returned instead.\n"
+);
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cEncodeBatchIntoDoc,
+        "encode_batch_into(buffer, offset, timestamps, messages, ref_timestamp, offsets=None, "
+        "num_threads=1)\n"
+        "--\n\n"
+        "Encodes a batch of log events the same way as `encode_batch`, and writes the result into "
+        "`buffer` starting at `offset`.\n\n"
+        ":param buffer: A writable bytes-like object, e.g., a bytearray, a writable memoryview or "
+        "an mmap.\n"
+        ":param offset: The position in `buffer` to write the encoded bytes to.\n"
+        ":param timestamps: See `encode_batch`.\n"
+        ":param messages: See `encode_batch`.\n"
+        ":param ref_timestamp: See `encode_batch`.\n"
+        ":param offsets: See `encode_batch`.\n"
+        ":param num_threads: See `encode_batch`.\n"
+        ":raises TypeError: If `buffer` isn't a writable bytes-like object.\n"
+        ":raises ValueError: If `offset` is out of the bounds of `buffer`, or the batch is "
+        "invalid as described in `encode_batch`.\n"
+        ":raises NotImplementedError: See `encode_batch`.\n"
+        ":return: The number of bytes written. If the space left in `buffer` is too small, "
+        "nothing is written and the negated number of missing bytes is returned instead.\n"
+);
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
         cEncodeEndOfIrDoc,
@@ -91,30 +230,65 @@ PyDoc_STRVAR(
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyMethodDef PyFourByteEncoder_method_table[]{
         {"encode_preamble",
-         clp_ffi_py::ir::native::encode_four_byte_preamble,
-         METH_VARARGS | METH_STATIC,
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_preamble),
+         METH_FASTCALL | METH_STATIC,
          static_cast<char const*>(cEncodePreambleDoc)},
 
         {"encode_android_preamble",
-         clp_ffi_py::ir::native::encode_four_byte_android_preamble,
-         METH_VARARGS | METH_STATIC,
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_android_preamble),
+         METH_FASTCALL | METH_STATIC,
          static_cast<char const*>(cEncodeAndroidPreambleDoc)},
 
+        {"encode_preamble_with_attributes",
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_preamble_with_attributes),
+         METH_FASTCALL | METH_STATIC,
+         static_cast<char const*>(cEncodePreambleWithAttributesDoc)},
+
+        {"encode_attributes",
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_attributes),
+         METH_FASTCALL | METH_STATIC,
+         static_cast<char const*>(cEncodeAttributesDoc)},
+
         {"encode_message_and_timestamp_delta",
-         clp_ffi_py::ir::native::encode_four_byte_message_and_timestamp_delta,
-         METH_VARARGS | METH_STATIC,
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_message_and_timestamp_delta),
+         METH_FASTCALL | METH_STATIC,
          static_cast<char const*>(cEncodeMessageAndTimestampDeltaDoc)},
 
         {"encode_message",
-         clp_ffi_py::ir::native::encode_four_byte_message,
-         METH_VARARGS | METH_STATIC,
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_message),
+         METH_FASTCALL | METH_STATIC,
          static_cast<char const*>(cEncodeMessageDoc)},
 
+        {"_encode_message_with_clp_tokenizer",
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_message_with_clp_tokenizer),
+         METH_FASTCALL | METH_STATIC,
+         static_cast<char const*>(cEncodeMessageWithClpTokenizerDoc)},
+
+        {"_set_vectorized_tokenizer_enabled",
+         py_c_function_cast(clp_ffi_py::ir::native::set_four_byte_vectorized_tokenizer_enabled),
+         METH_FASTCALL | METH_STATIC,
+         static_cast<char const*>(cSetVectorizedTokenizerEnabledDoc)},
+
         {"encode_timestamp_delta",
-         clp_ffi_py::ir::native::encode_four_byte_timestamp_delta,
-         METH_VARARGS | METH_STATIC,
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_timestamp_delta),
+         METH_FASTCALL | METH_STATIC,
          static_cast<char const*>(cEncodeTimestampDeltaDoc)},
 
+        {"encode_batch",
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_batch),
+         METH_FASTCALL | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cEncodeBatchDoc)},
+
+        {"encode_into",
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_into),
+         METH_FASTCALL | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cEncodeIntoDoc)},
+
+        {"encode_batch_into",
+         py_c_function_cast(clp_ffi_py::ir::native::encode_four_byte_batch_into),
+         METH_FASTCALL | METH_KEYWORDS | METH_STATIC,
+         static_cast<char const*>(cEncodeBatchIntoDoc)},
+
         {"encode_end_of_ir",
          py_c_function_cast(clp_ffi_py::ir::native::encode_end_of_ir),
          METH_NOARGS | METH_STATIC,
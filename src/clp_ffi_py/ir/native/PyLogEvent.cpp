@@ -2,67 +2,80 @@
 
 #include "PyLogEvent.hpp"
 
-#include <iomanip>
-#include <sstream>
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <clp_ffi_py/error_messages.hpp>
 #include <clp_ffi_py/ir/native/LogEvent.hpp>
 #include <clp_ffi_py/ir/native/PyQuery.hpp>
 #include <clp_ffi_py/ir/native/utils.hpp>
-#include <clp_ffi_py/Py_utils.hpp>
+#include <clp_ffi_py/PyFastcallArgParser.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
 #include <clp_ffi_py/utils.hpp>
 
 namespace clp_ffi_py::ir::native {
 namespace {
 /**
- * Formats the android attributes.
- * @param attributes
- * @param formatted_attributes
+ * The free list of deallocated PyLogEvent objects. It is only accessed while
+ * holding the GIL.
+ */
+struct PyLogEventFreeList {
+    std::vector<PyLogEvent*> m_objects;
+    size_t m_capacity{PyLogEvent::cDefaultFreeListCapacity};
+    size_t m_num_hits{0};
+    size_t m_num_misses{0};
+};
+
+auto get_free_list() -> PyLogEventFreeList& {
+    static PyLogEventFreeList free_list;
+    return free_list;
+}
+
+/**
+ * Parses the arguments of the LogEvent constructor:
+ * (log_message, timestamp, index=0, metadata=None)
+ * It is shared by `__init__` and the vectorcall constructor so that both accept
+ * the same arguments. In particular, embedded NULs in `log_message` are kept.
+ * @param py_log_message
+ * @param py_timestamp
+ * @param py_index nullptr if not given.
+ * @param py_metadata nullptr if not given.
+ * @param log_message Returns the parsed log message.
+ * @param timestamp Returns the parsed timestamp.
+ * @param index Returns the parsed index, or 0 if not given.
+ * @param metadata Returns a borrowed reference to the metadata, or nullptr if
+ * not given or None.
  * @return true on success.
  * @return false on failure with the relevant Python exception and error set.
  */
-auto format_android_log(
-        LogEvent::attribute_table_t const& attributes,
-        std::string& formatted_attributes
+auto parse_log_event_args(
+        PyObject* py_log_message,
+        PyObject* py_timestamp,
+        PyObject* py_index,
+        PyObject* py_metadata,
+        std::string& log_message,
+        ffi::epoch_time_ms_t& timestamp,
+        size_t& index,
+        PyMetadata*& metadata
 ) -> bool {
-    auto get_priority_char = [](ffi::ir_stream::attr_int_t priority) -> char {
-        switch (priority) {
-                /* clang-format off */
-            case 2: return 'V';
-            case 3: return 'D';
-            case 4: return 'I';
-            case 5: return 'W';
-            case 6: return 'E';
-            case 7: return 'F';
-            case 8: return 'S';
-
-            default:                  return '?';
-                /* clang-format on */
-        }
-    };
-    try {
-        std::ostringstream attribute_formatter;
-        attribute_formatter << " " << std::setw(5)
-                            << attributes.at("pid").value().get_value<ffi::ir_stream::attr_int_t>();
-        attribute_formatter << " " << std::setw(5)
-                            << attributes.at("tid").value().get_value<ffi::ir_stream::attr_int_t>();
-        auto const priority_val{
-                attributes.at("priority").value().get_value<ffi::ir_stream::attr_int_t>()
-        };
-        attribute_formatter << " " << get_priority_char(priority_val);
-        attribute_formatter << " " << std::left << std::setw(8) << std::setfill(' ')
-                            << attributes.at("tag").value().get_value<ffi::ir_stream::attr_str_t>();
-        attribute_formatter << ": ";
-        formatted_attributes = attribute_formatter.str();
-    } catch (std::exception const& ex) {
-        PyErr_Format(
-                PyExc_RuntimeError,
-                "Failed to format android logs with attributes. std::exception: %s",
-                ex.what()
-        );
+    if (false == parse_py_string(py_log_message, log_message)
+        || false == parse_py_int(py_timestamp, timestamp)
+        || (nullptr != py_index && false == parse_py_int(py_index, index)))
+    {
+        return false;
+    }
+    if (nullptr == py_metadata || Py_None == py_metadata) {
+        metadata = nullptr;
+        return true;
+    }
+    if (false == static_cast<bool>(PyObject_TypeCheck(py_metadata, PyMetadata::get_py_type()))) {
+        PyErr_SetString(PyExc_TypeError, clp_ffi_py::cPyTypeError);
         return false;
     }
+    metadata = py_reinterpret_cast<PyMetadata>(py_metadata);
     return true;
 }
 
@@ -97,54 +110,127 @@ auto PyLogEvent_init(PyLogEvent* self, PyObject* args, PyObject* keywords) -> in
     // trigger segmentation fault
     self->default_init();
 
-    char const* log_message{nullptr};
-    ffi::epoch_time_ms_t timestamp{0};
-    size_t index{0};
-    PyObject* metadata{Py_None};
+    PyObject* py_log_message{nullptr};
+    PyObject* py_timestamp{nullptr};
+    PyObject* py_index{nullptr};
+    PyObject* py_metadata{nullptr};
     if (false
         == static_cast<bool>(PyArg_ParseTupleAndKeywords(
                 args,
                 keywords,
-                "sL|KO",
+                "OO|OO",
                 static_cast<char**>(keyword_table),
-                &log_message,
-                &timestamp,
-                &index,
-                &metadata
+                &py_log_message,
+                &py_timestamp,
+                &py_index,
+                &py_metadata
         )))
     {
         return -1;
     }
 
-    auto const has_metadata{Py_None != metadata};
-    if (has_metadata
-        && false == static_cast<bool>(PyObject_TypeCheck(metadata, PyMetadata::get_py_type())))
+    std::string log_message;
+    ffi::epoch_time_ms_t timestamp{0};
+    size_t index{0};
+    PyMetadata* metadata{nullptr};
+    if (false
+        == parse_log_event_args(
+                py_log_message,
+                py_timestamp,
+                py_index,
+                py_metadata,
+                log_message,
+                timestamp,
+                index,
+                metadata
+        ))
     {
-        PyErr_SetString(PyExc_TypeError, clp_ffi_py::cPyTypeError);
         return -1;
     }
 
+    if (false == self->init(std::move(log_message), timestamp, index, metadata, nullptr, {})) {
+        return -1;
+    }
+    return 0;
+}
+
+#if PY_VERSION_HEX >= 0x03090000
+/**
+ * Vectorcall constructor of PyLogEvent:
+ * LogEvent(log_message, timestamp, index=0, metadata=None)
+ * It skips the tuple and dictionary packing of `tp_new` and `tp_init`, and
+ * allocates the object from the free list. The arguments are parsed the same
+ * way as in `PyLogEvent_init`.
+ * @param type
+ * @param args
+ * @param num_args_flags
+ * @param keyword_names
+ * @return a new reference of the created PyLogEvent object.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+auto PyLogEvent_vectorcall(
+        PyObject* Py_UNUSED(type),
+        PyObject* const* args,
+        size_t num_args_flags,
+        PyObject* keyword_names
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "LogEvent",
+            {"log_message", "timestamp", "index", "metadata"},
+            2
+    };
+    std::array<PyObject*, 4> parsed_args{};
     if (false
-        == self->init(
+        == arg_parser.parse(args, PyVectorcall_NARGS(num_args_flags), keyword_names, parsed_args))
+    {
+        return nullptr;
+    }
+
+    std::string log_message;
+    ffi::epoch_time_ms_t timestamp{0};
+    size_t index{0};
+    PyMetadata* metadata{nullptr};
+    if (false
+        == parse_log_event_args(
+                parsed_args[0],
+                parsed_args[1],
+                parsed_args[2],
+                parsed_args[3],
                 log_message,
                 timestamp,
                 index,
-                has_metadata ? py_reinterpret_cast<PyMetadata>(metadata) : nullptr,
-                {}
+                metadata
         ))
     {
-        return -1;
+        return nullptr;
     }
-    return 0;
+
+    LogEvent::attribute_values_t attribute_values;
+    return py_reinterpret_cast<PyObject>(PyLogEvent::create_new_log_event(
+            log_message,
+            timestamp,
+            index,
+            metadata,
+            nullptr,
+            attribute_values
+    ));
 }
+#endif
 
 /**
  * Callback of PyLogEvent deallocator.
  * @param self
  */
 auto PyLogEvent_dealloc(PyLogEvent* self) -> void {
-    self->clean();
-    PyObject_Del(self);
+    // Instances of a heap type hold a reference to it since Python 3.8, which
+    // is taken again when a pooled object is reused.
+    auto* type{Py_TYPE(self)};
+    PyLogEvent::release(self);
+#if PY_VERSION_HEX >= 0x03080000
+    Py_DECREF(type);
+#else
+    static_cast<void>(type);
+#endif
 }
 
 /**
@@ -175,47 +261,48 @@ PyDoc_STRVAR(
 auto PyLogEvent_getstate(PyLogEvent* self) -> PyObject* {
     auto* log_event{self->get_log_event()};
     if (false == log_event->has_formatted_timestamp()) {
-        PyObjectPtr<PyObject> const formatted_timestamp_object{
-                clp_ffi_py::py_utils_get_formatted_timestamp(
-                        log_event->get_timestamp(),
-                        self->has_metadata() ? self->get_py_metadata()->get_py_timezone() : Py_None
-                )
-        };
-        auto* formatted_timestamp_ptr{formatted_timestamp_object.get()};
-        if (nullptr == formatted_timestamp_ptr) {
-            return nullptr;
-        }
+        auto* py_metadata{self->get_py_metadata()};
         std::string formatted_timestamp;
-        if (false == clp_ffi_py::parse_py_string(formatted_timestamp_ptr, formatted_timestamp)) {
+        if (false
+            == append_formatted_timestamp(
+                    log_event->get_timestamp(),
+                    py_metadata,
+                    nullptr != py_metadata ? py_metadata->get_py_timezone() : Py_None,
+                    formatted_timestamp
+            ))
+        {
             return nullptr;
         }
-        if (self->has_metadata() && self->get_py_metadata()->get_metadata()->is_android_log()
-            && self->get_log_event()->has_attributes())
+        if (nullptr != py_metadata && py_metadata->get_metadata()->is_android_log()
+            && log_event->has_attributes())
         {
-            std::string formatted_attributes;
             if (false
-                == format_android_log(
-                        self->get_log_event()->get_attributes(),
-                        formatted_attributes
+                == append_formatted_android_attributes(
+                        log_event->get_attribute_schema().get(),
+                        log_event->get_attribute_values(),
+                        formatted_timestamp
                 ))
             {
                 return nullptr;
             }
-            formatted_timestamp += formatted_attributes;
         }
         log_event->set_formatted_timestamp(formatted_timestamp);
     }
 
-    auto const& attributes{self->get_log_event()->get_attributes()};
-    auto* py_attributes{serialize_attributes_to_python_dict(attributes)};
-    if (nullptr == py_attributes) {
+    PyObjectPtr<PyObject> const py_attributes{self->get_py_attributes()};
+    if (nullptr == py_attributes.get()) {
+        return nullptr;
+    }
+
+    PyObjectPtr<PyObject> const py_log_message{self->get_py_log_message()};
+    if (nullptr == py_log_message.get()) {
         return nullptr;
     }
 
     return Py_BuildValue(
-            "{sssssLsKsO}",
+            "{sOssssLsKsO}",
             cStateLogMessage,
-            log_event->get_log_message().c_str(),
+            py_log_message.get(),
             static_cast<char const*>(cStateFormattedTimestamp),
             log_event->get_formatted_timestamp().c_str(),
             static_cast<char const*>(cStateTimestamp),
@@ -223,7 +310,7 @@ auto PyLogEvent_getstate(PyLogEvent* self) -> PyObject* {
             cStateIndex,
             log_event->get_index(),
             cStateAttributes,
-            py_attributes
+            py_attributes.get()
     );
 }
 
@@ -303,16 +390,30 @@ auto PyLogEvent_setstate(PyLogEvent* self, PyObject* state) -> PyObject* {
         return nullptr;
     }
 
-    LogEvent::attribute_table_t attributes;
+    std::shared_ptr<AttributeSchema const> attribute_schema;
+    LogEvent::attribute_values_t attribute_values;
     auto* attributes_obj{PyDict_GetItemString(state, cStateAttributes)};
     if (nullptr != attributes_obj
-        && false == deserialize_attributes_from_python_dict(attributes_obj, attributes))
+        && false
+                   == deserialize_attributes_from_python_dict(
+                           attributes_obj,
+                           attribute_schema,
+                           attribute_values
+                   ))
     {
         return nullptr;
     }
 
     if (false
-        == self->init(log_message, timestamp, index, nullptr, attributes, formatted_timestamp))
+        == self->init(
+                std::move(log_message),
+                timestamp,
+                index,
+                nullptr,
+                std::move(attribute_schema),
+                std::move(attribute_values),
+                formatted_timestamp
+        ))
     {
         return nullptr;
     }
@@ -348,7 +449,7 @@ PyDoc_STRVAR(
 );
 
 auto PyLogEvent_get_log_message(PyLogEvent* self) -> PyObject* {
-    return PyUnicode_FromString(self->get_log_event()->get_log_message().c_str());
+    return self->get_py_log_message();
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
@@ -411,25 +512,18 @@ PyDoc_STRVAR(
         ":return: The formatted message.\n"
 );
 
-auto PyLogEvent_get_formatted_message(PyLogEvent* self, PyObject* args, PyObject* keywords)
-        -> PyObject* {
-    static char keyword_timezone[]{"timezone"};
-    static char* key_table[]{static_cast<char*>(keyword_timezone), nullptr};
-
-    PyObject* timezone{Py_None};
-    if (false
-        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
-                args,
-                keywords,
-                "|O",
-                static_cast<char**>(key_table),
-                &timezone
-        )))
-    {
+auto PyLogEvent_get_formatted_message(
+        PyLogEvent* self,
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{"get_formatted_message", {"timezone"}, 0};
+    std::array<PyObject*, 1> parsed_args{};
+    if (false == arg_parser.parse(args, num_args, keyword_names, parsed_args)) {
         return nullptr;
     }
-
-    return self->get_formatted_message(timezone);
+    return self->get_formatted_message(nullptr == parsed_args[0] ? Py_None : parsed_args[0]);
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
@@ -442,7 +536,36 @@ PyDoc_STRVAR(
 );
 
 auto PyLogEvent_get_attributes(PyLogEvent* self) -> PyObject* {
-    return serialize_attributes_to_python_dict(self->get_log_event()->get_attributes());
+    return self->get_py_attributes();
+}
+
+/**
+ * Callback of Python buffer protocol's `getbuffer` operation. Exposes the
+ * cached encoded log event as a read-only buffer without copying it.
+ * @param self
+ * @param view
+ * @param flags
+ * @return 0 on success.
+ * @return -1 on failure with the relevant Python exception and error set.
+ */
+auto PyLogEvent_getbuffer(PyLogEvent* self, Py_buffer* view, int flags) -> int {
+    auto const* log_event{self->get_log_event()};
+    if (false == log_event->has_cached_encoded_log_event()) {
+        view->obj = nullptr;
+        PyErr_SetString(PyExc_BufferError, "The encoded log event is not cached.");
+        return -1;
+    }
+    auto const encoded_log_event_view{log_event->get_cached_encoded_log_event()};
+    return PyBuffer_FillInfo(
+            view,
+            py_reinterpret_cast<PyObject>(self),
+            // The buffer is exported as read-only
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            const_cast<int8_t*>(encoded_log_event_view.data()),
+            static_cast<Py_ssize_t>(encoded_log_event_view.size()),
+            1,
+            flags
+    );
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
@@ -450,19 +573,64 @@ PyDoc_STRVAR(
         cPyLogEventGetCachedEncodedLogEventDoc,
         "get_cached_encoded_log_event()\n"
         "--\n\n"
-        ":return: A bytearray that contains the encoded log event.\n"
+        ":return: A read-only memoryview of the encoded log event. The encoded log event is "
+        "stored in a slab shared with the other log events decoded from the same stream, and the "
+        "memoryview refers to it without copying.\n"
         ":return: None if the encoded log event is not cached.\n"
 );
 
 auto PyLogEvent_get_cached_encoded_log_event(PyLogEvent* self) -> PyObject* {
-    auto const* log_event{self->get_log_event()};
-    if (false == log_event->has_cached_encoded_log_event()) {
+    if (false == self->get_log_event()->has_cached_encoded_log_event()) {
         Py_RETURN_NONE;
     }
-    auto encoded_log_event_view{log_event->get_cached_encoded_log_event()};
-    return PyByteArray_FromStringAndSize(
-            size_checked_pointer_cast<char const>(encoded_log_event_view.data()),
-            static_cast<Py_ssize_t>(encoded_log_event_view.size())
+    return PyMemoryView_FromObject(py_reinterpret_cast<PyObject>(self));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyLogEventSetFreeListCapacityDoc,
+        "set_free_list_capacity(capacity)\n"
+        "--\n\n"
+        "Sets the maximum number of deallocated log events kept for reuse by the decoding "
+        "methods. Setting it to 0 disables the reuse.\n\n"
+        ":param capacity: The maximum number of log events in the free list.\n"
+        ":return: None\n"
+);
+
+auto PyLogEvent_set_free_list_capacity(PyObject* Py_UNUSED(self), PyObject* py_capacity)
+        -> PyObject* {
+    size_t capacity{0};
+    if (false == parse_py_int<size_t>(py_capacity, capacity)) {
+        return nullptr;
+    }
+    PyLogEvent::set_free_list_capacity(capacity);
+    Py_RETURN_NONE;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyLogEventGetFreeListStatsDoc,
+        "get_free_list_stats()\n"
+        "--\n\n"
+        "Gets the statistics of the free list of deallocated log events.\n\n"
+        ":return: A dictionary with the capacity of the free list (`capacity`), the number of log "
+        "events currently in it (`size`), the number of log events created by reusing a "
+        "deallocated one (`hits`), and the number of log events created by allocating a new one "
+        "(`misses`).\n"
+);
+
+auto PyLogEvent_get_free_list_stats(PyObject* Py_UNUSED(self)) -> PyObject* {
+    auto const stats{PyLogEvent::get_free_list_stats()};
+    return Py_BuildValue(
+            "{sKsKsKsK}",
+            "capacity",
+            static_cast<unsigned long long>(stats.m_capacity),
+            "size",
+            static_cast<unsigned long long>(stats.m_size),
+            "hits",
+            static_cast<unsigned long long>(stats.m_num_hits),
+            "misses",
+            static_cast<unsigned long long>(stats.m_num_misses)
     );
 }
 }
@@ -491,7 +659,7 @@ PyMethodDef PyLogEvent_method_table[]{
 
         {"get_formatted_message",
          py_c_function_cast(PyLogEvent_get_formatted_message),
-         METH_KEYWORDS | METH_VARARGS,
+         METH_FASTCALL | METH_KEYWORDS,
          static_cast<char const*>(cPyLogEventGetFormattedMessageDoc)},
 
         {"get_cached_encoded_log_event",
@@ -504,6 +672,16 @@ PyMethodDef PyLogEvent_method_table[]{
          METH_O,
          static_cast<char const*>(cPyLogEventMatchQueryDoc)},
 
+        {"set_free_list_capacity",
+         py_c_function_cast(PyLogEvent_set_free_list_capacity),
+         METH_O | METH_STATIC,
+         static_cast<char const*>(cPyLogEventSetFreeListCapacityDoc)},
+
+        {"get_free_list_stats",
+         py_c_function_cast(PyLogEvent_get_free_list_stats),
+         METH_NOARGS | METH_STATIC,
+         static_cast<char const*>(cPyLogEventGetFreeListStatsDoc)},
+
         {"__getstate__",
          py_c_function_cast(PyLogEvent_getstate),
          METH_NOARGS,
@@ -517,6 +695,14 @@ PyMethodDef PyLogEvent_method_table[]{
         {nullptr}
 };
 
+/**
+ * Declaration of Python buffer protocol.
+ */
+PyBufferProcs PyLogEvent_as_buffer{
+        .bf_getbuffer = py_getbufferproc_cast(PyLogEvent_getbuffer),
+        .bf_releasebuffer = nullptr,
+};
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
         cPyLogEventDoc,
@@ -563,15 +749,15 @@ PyType_Spec PyLogEvent_type_spec{
 }  // namespace
 
 auto PyLogEvent::get_formatted_message(PyObject* timezone) -> PyObject* {
+    auto* log_event{get_log_event()};
     auto cache_formatted_timestamp{false};
     if (Py_None == timezone) {
-        if (m_log_event->has_formatted_timestamp()) {
+        if (log_event->has_formatted_timestamp()) {
             // If the formatted timestamp exists, it constructs the raw message
             // without calling python level format function
-            return PyUnicode_FromFormat(
-                    "%s%s",
-                    m_log_event->get_formatted_timestamp().c_str(),
-                    m_log_event->get_log_message().c_str()
+            return py_string_from_utf8(
+                    log_event->get_formatted_timestamp(),
+                    log_event->get_log_message_view()
             );
         }
         if (has_metadata()) {
@@ -580,59 +766,91 @@ auto PyLogEvent::get_formatted_message(PyObject* timezone) -> PyObject* {
         }
     }
 
-    PyObjectPtr<PyObject> const formatted_timestamp_object{
-            py_utils_get_formatted_timestamp(m_log_event->get_timestamp(), timezone)
-    };
-    auto* formatted_timestamp_ptr{formatted_timestamp_object.get()};
-    if (nullptr == formatted_timestamp_ptr) {
-        return nullptr;
-    }
     std::string formatted_timestamp;
-    if (false == parse_py_string(formatted_timestamp_ptr, formatted_timestamp)) {
+    if (false
+        == append_formatted_timestamp(
+                log_event->get_timestamp(),
+                m_py_metadata,
+                timezone,
+                formatted_timestamp
+        ))
+    {
         return nullptr;
     }
     if (has_metadata() && m_py_metadata->get_metadata()->is_android_log()
-        && m_log_event->has_attributes())
+        && log_event->has_attributes())
     {
-        std::string formatted_attributes;
-        if (false == format_android_log(m_log_event->get_attributes(), formatted_attributes)) {
+        if (false
+            == append_formatted_android_attributes(
+                    log_event->get_attribute_schema().get(),
+                    log_event->get_attribute_values(),
+                    formatted_timestamp
+            ))
+        {
             return nullptr;
         }
-        formatted_timestamp += formatted_attributes;
     }
 
     if (cache_formatted_timestamp) {
-        m_log_event->set_formatted_timestamp(formatted_timestamp);
+        log_event->set_formatted_timestamp(formatted_timestamp);
     }
-    return PyUnicode_FromFormat(
-            "%s%s",
-            formatted_timestamp.c_str(),
-            m_log_event->get_log_message().c_str()
-    );
+    return py_string_from_utf8(formatted_timestamp, log_event->get_log_message_view());
+}
+
+auto PyLogEvent::get_py_log_message() -> PyObject* {
+    if (nullptr == m_py_log_message) {
+        m_py_log_message = nullptr == m_interned_log_message
+                                   ? py_string_from_utf8(get_log_event()->get_log_message_view())
+                                   : m_interned_log_message->get_py_log_message();
+        if (nullptr == m_py_log_message) {
+            return nullptr;
+        }
+    }
+    Py_INCREF(m_py_log_message);
+    return m_py_log_message;
+}
+
+auto PyLogEvent::get_py_attributes() -> PyObject* {
+    auto const* log_event{get_log_event()};
+    if (false == log_event->has_attributes()) {
+        Py_RETURN_NONE;
+    }
+    if (nullptr == m_py_attributes) {
+        m_py_attributes = serialize_attributes_to_python_dict(
+                *log_event->get_attribute_schema(),
+                log_event->get_attribute_values()
+        );
+        if (nullptr == m_py_attributes) {
+            return nullptr;
+        }
+    }
+    return PyDict_Copy(m_py_attributes);
 }
 
 auto PyLogEvent::init(
-        std::string_view log_message,
+        std::string log_message,
         ffi::epoch_time_ms_t timestamp,
         size_t index,
         PyMetadata* metadata,
-        LogEvent::attribute_table_t const& attributes,
+        std::shared_ptr<AttributeSchema const> attribute_schema,
+        LogEvent::attribute_values_t attribute_values,
         std::optional<std::string_view> formatted_timestamp,
-        std::optional<gsl::span<int8_t>> encoded_log_event_view
+        std::optional<EncodedLogEventRef> cached_encoded_log_event
 ) -> bool {
-    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
-    m_log_event = new LogEvent(
-            log_message,
+    if (m_has_log_event) {
+        get_log_event()->~LogEvent();
+        m_has_log_event = false;
+    }
+    new (m_log_event_storage) LogEvent(
+            std::move(log_message),
             timestamp,
             index,
-            attributes,
+            std::move(attribute_schema),
+            std::move(attribute_values),
             formatted_timestamp,
-            encoded_log_event_view
+            std::move(cached_encoded_log_event)
     );
-    if (nullptr == m_log_event) {
-        PyErr_SetString(PyExc_RuntimeError, clp_ffi_py::cOutofMemoryError);
-        return false;
-    }
+    m_has_log_event = true;
     set_metadata(metadata);
     return true;
 }
@@ -645,42 +863,105 @@ auto PyLogEvent::get_py_type() -> PyTypeObject* {
 
 auto PyLogEvent::module_level_init(PyObject* py_module) -> bool {
     static_assert(std::is_trivially_destructible<PyLogEvent>());
+    static_assert(alignof(LogEvent) <= alignof(std::max_align_t));
     auto* type{py_reinterpret_cast<PyTypeObject>(PyType_FromSpec(&PyLogEvent_type_spec))};
     m_py_type.reset(type);
     if (nullptr == type) {
         return false;
     }
+    type->tp_as_buffer = &PyLogEvent_as_buffer;
+#if PY_VERSION_HEX >= 0x03090000
+    type->tp_vectorcall = PyLogEvent_vectorcall;
+#endif
     return add_python_type(get_py_type(), "LogEvent", py_module);
 }
 
+auto PyLogEvent::release(PyLogEvent* self) -> void {
+    auto& free_list{get_free_list()};
+    if (free_list.m_objects.size() < free_list.m_capacity) {
+        self->recycle();
+        free_list.m_objects.push_back(self);
+        return;
+    }
+    self->clean();
+    PyObject_Del(self);
+}
+
+auto PyLogEvent::set_free_list_capacity(size_t capacity) -> void {
+    auto& free_list{get_free_list()};
+    free_list.m_capacity = capacity;
+    while (free_list.m_objects.size() > capacity) {
+        auto* self{free_list.m_objects.back()};
+        free_list.m_objects.pop_back();
+        self->clean();
+        PyObject_Del(self);
+    }
+}
+
+auto PyLogEvent::get_free_list_stats() -> FreeListStats {
+    auto const& free_list{get_free_list()};
+    return {free_list.m_capacity,
+            free_list.m_objects.size(),
+            free_list.m_num_hits,
+            free_list.m_num_misses};
+}
+
 auto PyLogEvent::create_new_log_event(
-        std::string const& log_message,
+        std::string& log_message,
         ffi::epoch_time_ms_t timestamp,
         size_t index,
         PyMetadata* metadata,
-        LogEvent::attribute_table_t const& attributes,
-        std::optional<gsl::span<int8_t>> encoded_log_event_view
+        std::shared_ptr<AttributeSchema const> attribute_schema,
+        LogEvent::attribute_values_t& attribute_values,
+        std::optional<EncodedLogEventRef> cached_encoded_log_event
 ) -> PyLogEvent* {
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-    PyLogEvent* self{PyObject_New(PyLogEvent, get_py_type())};
-    if (nullptr == self) {
-        PyErr_SetString(PyExc_MemoryError, clp_ffi_py::cOutofMemoryError);
-        return nullptr;
+    PyLogEvent* self{nullptr};
+    auto& free_list{get_free_list()};
+    if (false == free_list.m_objects.empty()) {
+        self = free_list.m_objects.back();
+        free_list.m_objects.pop_back();
+        ++free_list.m_num_hits;
+        PyObject_Init(py_reinterpret_cast<PyObject>(self), get_py_type());
+        // A recycled object only holds its recycled log event, which is reset
+        // in place to reuse its buffers.
+        if (self->m_has_log_event) {
+            self->get_log_event()->reset(
+                    log_message,
+                    timestamp,
+                    index,
+                    std::move(attribute_schema),
+                    attribute_values,
+                    std::move(cached_encoded_log_event)
+            );
+            self->set_metadata(metadata);
+            return self;
+        }
+    } else {
+        ++free_list.m_num_misses;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+        self = PyObject_New(PyLogEvent, get_py_type());
+        if (nullptr == self) {
+            PyErr_SetString(PyExc_MemoryError, clp_ffi_py::cOutofMemoryError);
+            return nullptr;
+        }
+        self->default_init();
     }
-    self->default_init();
     if (false
         == self->init(
-                log_message,
+                std::move(log_message),
                 timestamp,
                 index,
                 metadata,
-                attributes,
+                std::move(attribute_schema),
+                std::move(attribute_values),
                 std::nullopt,
-                encoded_log_event_view
+                std::move(cached_encoded_log_event)
         ))
     {
         return nullptr;
     }
+    log_message.clear();
+    attribute_values.clear();
     return self;
 }
 }  // namespace clp_ffi_py::ir::native
@@ -3,52 +3,85 @@
 
 #include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
 
+#include <cstddef>
+#include <memory>
+#include <new>
 #include <optional>
 
-#include <gsl/span>
-
+#include <clp_ffi_py/ir/native/AttributeSchema.hpp>
+#include <clp_ffi_py/ir/native/EncodedLogEventArena.hpp>
 #include <clp_ffi_py/ir/native/LogEvent.hpp>
+#include <clp_ffi_py/ir/native/LogMessageInternCache.hpp>
 #include <clp_ffi_py/ir/native/PyMetadata.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 
 namespace clp_ffi_py::ir::native {
 /**
  * A PyObject structure functioning as a Python-compatible interface to retrieve
- * a log event. The underlying data is pointed to by `m_log_event`. The object
+ * a log event. The underlying log event is constructed in place inside the
+ * object's own allocation (`m_log_event_storage`), so creating a PyLogEvent
+ * only requires a single allocation from CPython's allocator. The object
  * may reference a PyMetadata object pointed to by `m_py_metadata` that
  * specifies the event's metadata, such as timestamp format, from the preamble.
+ * The Python string of the log message and the Python dict of the attributes
+ * are only built when first requested, and are then cached in
+ * `m_py_log_message` and `m_py_attributes`.
+ * <p>
+ * Deallocated objects are kept in a bounded free list and reused by
+ * `create_new_log_event`, in the same way CPython pools floats and tuples, so
+ * that decoding loops which create and discard log events in lockstep don't go
+ * through the allocator for every event. A pooled object keeps its log event
+ * constructed, with the buffers of its log message and attribute values, which
+ * the next log event created from it swaps with the decoder's buffers.
  */
 class PyLogEvent {
 public:
+    static constexpr size_t cDefaultFreeListCapacity{256};
+
+    /**
+     * Statistics of the free list.
+     */
+    struct FreeListStats {
+        size_t m_capacity;
+        size_t m_size;
+        size_t m_num_hits;
+        size_t m_num_misses;
+    };
+
     /**
      * Initializes the underlying data with the given inputs.
      * Since the memory allocation of PyLogEvent is handled by CPython's
      * allocator, cpp constructors will not be explicitly called. This function
-     * serves as the default constructor to initialize the underlying metadata.
-     * It has to be manually called whenever creating a new PyLogEvent object
-     * through CPython APIs.
+     * serves as the default constructor to construct the underlying log event
+     * in place. It has to be manually called whenever creating a new
+     * PyLogEvent object through CPython APIs.
      * @param log_message
      * @param timestamp
      * @param index
      * @param metadata A PyMetadata instance to bind with the log event (can be
      * nullptr).
-     * @param attributes Attributes associated with the log event.
+     * @param attribute_schema The schema of the attribute values (can be
+     * nullptr if there are no attribute values).
+     * @param attribute_values Attribute values associated with the log event,
+     * indexed by `attribute_schema`.
      * @param formatted_timestamp Formatted timestamp. This argument is not
      * given by default. It should be given when deserializing the object from
      * a saved state.
-     * @param encoded_log_event_view The view of the encoded log event.
+     * @param cached_encoded_log_event The encoded log event stored in an
+     * arena.
      * @return true on success.
      * @return false on failure with the relevant Python exception and error
      * set.
      */
     [[nodiscard]] auto init(
-            std::string_view log_message,
+            std::string log_message,
             ffi::epoch_time_ms_t timestamp,
             size_t index,
             PyMetadata* metadata,
-            LogEvent::attribute_table_t const& attributes,
+            std::shared_ptr<AttributeSchema const> attribute_schema,
+            LogEvent::attribute_values_t attribute_values,
             std::optional<std::string_view> formatted_timestamp = std::nullopt,
-            std::optional<gsl::span<int8_t>> encoded_log_event_view = std::nullopt
+            std::optional<EncodedLogEventRef> cached_encoded_log_event = std::nullopt
     ) -> bool;
 
     /**
@@ -58,21 +91,45 @@ public:
     [[nodiscard]] auto has_metadata() -> bool { return nullptr != m_py_metadata; }
 
     /**
-     * Initializes the pointers to nullptr by default. Should be called once
-     * the object is allocated.
+     * Initializes the pointers to nullptr and marks the log event as not
+     * constructed by default. Should be called once the object is allocated.
      */
     auto default_init() -> void {
-        m_log_event = nullptr;
+        m_has_log_event = false;
         m_py_metadata = nullptr;
+        m_py_log_message = nullptr;
+        m_py_attributes = nullptr;
+        m_interned_log_message = nullptr;
     }
 
     /**
-     * Releases the memory allocated for underlying metadata field and the
-     * reference hold for the Python object(s).
+     * Destroys the underlying log event and releases the reference hold for
+     * the Python object(s).
      */
     auto clean() -> void {
         Py_XDECREF(m_py_metadata);
-        delete m_log_event;
+        Py_XDECREF(m_py_log_message);
+        Py_XDECREF(m_py_attributes);
+        m_interned_log_message = nullptr;
+        if (m_has_log_event) {
+            get_log_event()->~LogEvent();
+            m_has_log_event = false;
+        }
+    }
+
+    /**
+     * Releases the references held for the Python object(s), and recycles the
+     * underlying log event (see `LogEvent::recycle`) instead of destroying it,
+     * so that the object can be pooled.
+     */
+    auto recycle() -> void {
+        Py_CLEAR(m_py_metadata);
+        Py_CLEAR(m_py_log_message);
+        Py_CLEAR(m_py_attributes);
+        m_interned_log_message = nullptr;
+        if (m_has_log_event) {
+            get_log_event()->recycle();
+        }
     }
 
     /**
@@ -103,7 +160,50 @@ public:
      */
     [[nodiscard]] auto get_formatted_message(PyObject* timezone = Py_None) -> PyObject*;
 
-    [[nodiscard]] auto get_log_event() -> LogEvent* { return m_log_event; }
+    /**
+     * Gets the log message of the underlying log event as a Python string. The
+     * string is created on the first call and cached for the subsequent calls.
+     * @return A new reference to the cached string.
+     * @return nullptr on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto get_py_log_message() -> PyObject*;
+
+    /**
+     * Replaces the log message with an interned log message, shared with other
+     * log events together with its Python string once built.
+     * @param log_message
+     */
+    auto set_interned_log_message(std::shared_ptr<InternedLogMessage> const& log_message)
+            -> void {
+        // The log event keeps the interned log message alive through the
+        // aliasing pointer, which `m_interned_log_message` relies on.
+        get_log_event()->set_shared_log_message(
+                std::shared_ptr<std::string const>{log_message, &log_message->get_log_message()}
+        );
+        Py_CLEAR(m_py_log_message);
+        m_interned_log_message = log_message.get();
+    }
+
+    /**
+     * Gets the attributes of the underlying log event as a Python dict. The
+     * dict is built on the first call and cached for the subsequent calls.
+     * @return A new reference to a copy of the cached dict, so that callers
+     * can't modify the cache.
+     * @return Py_None if the log event has no attributes.
+     * @return nullptr on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto get_py_attributes() -> PyObject*;
+
+    /**
+     * @return A pointer to the underlying log event. The log event must have
+     * been constructed by `init`.
+     */
+    [[nodiscard]] auto get_log_event() -> LogEvent* {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return std::launder(reinterpret_cast<LogEvent*>(m_log_event_storage));
+    }
 
     [[nodiscard]] auto get_py_metadata() -> PyMetadata* { return m_py_metadata; }
 
@@ -127,32 +227,63 @@ public:
     [[nodiscard]] static auto module_level_init(PyObject* py_module) -> bool;
 
     /**
-     * Creates and initializes a new PyLogEvent using the given inputs.
-     * @param log_message
+     * Releases a deallocated PyLogEvent. It is recycled and kept in the free
+     * list if the free list isn't full, or cleaned and freed otherwise.
+     * @param self
+     */
+    static auto release(PyLogEvent* self) -> void;
+
+    /**
+     * Sets the maximum number of objects kept in the free list. Objects beyond
+     * the new capacity are released immediately.
+     * @param capacity
+     */
+    static auto set_free_list_capacity(size_t capacity) -> void;
+
+    [[nodiscard]] static auto get_free_list_stats() -> FreeListStats;
+
+    /**
+     * Creates and initializes a new PyLogEvent using the given inputs. The log
+     * message and the attribute values are taken by the new log event. If the
+     * object is taken from the free list, they are swapped with its recycled
+     * buffers, so that a caller decoding into the same buffers doesn't
+     * allocate in the steady state.
+     * @param log_message Returns a cleared buffer, possibly with capacity.
      * @param timestamp
      * @param index
      * @param metadata A PyMetadata instance to bind with the log event (can be
      * nullptr).
-     * @param attributes Attributes associated with the log event.
-     * @param encoded_log_event_view The view of the encoded log event.
+     * @param attribute_schema The schema of the attribute values, normally
+     * shared with the metadata (can be nullptr if there are no attribute
+     * values).
+     * @param attribute_values Attribute values associated with the log event.
+     * Returns a cleared buffer, possibly with capacity.
+     * @param cached_encoded_log_event The encoded log event stored in an
+     * arena.
      * @return a new reference of a PyLogEvent object that is initialized with
-     * the given inputs.
+     * the given inputs. The object is taken from the free list if available.
      * @return nullptr on failure with the relevant Python exception and error
      * set.
      */
     [[nodiscard]] static auto create_new_log_event(
-            std::string const& log_message,
+            std::string& log_message,
             ffi::epoch_time_ms_t timestamp,
             size_t index,
             PyMetadata* metadata,
-            LogEvent::attribute_table_t const& attributes,
-            std::optional<gsl::span<int8_t>> encoded_log_event_view = std::nullopt
+            std::shared_ptr<AttributeSchema const> attribute_schema,
+            LogEvent::attribute_values_t& attribute_values,
+            std::optional<EncodedLogEventRef> cached_encoded_log_event = std::nullopt
     ) -> PyLogEvent*;
 
 private:
     PyObject_HEAD;
-    LogEvent* m_log_event;
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays, modernize-avoid-c-arrays)
+    alignas(LogEvent) std::byte m_log_event_storage[sizeof(LogEvent)];
+    bool m_has_log_event;
     PyMetadata* m_py_metadata;
+    PyObject* m_py_log_message;
+    PyObject* m_py_attributes;
+    InternedLogMessage* m_interned_log_message;
 
     static PyObjectGlobalPtr<PyTypeObject> m_py_type;
 };
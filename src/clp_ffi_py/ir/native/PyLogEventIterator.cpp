@@ -0,0 +1,205 @@
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include "PyLogEventIterator.hpp"
+
+#include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/decoding_methods.hpp>
+#include <clp_ffi_py/PyObjectCast.hpp>
+#include <clp_ffi_py/utils.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+extern "C" {
+/**
+ * Callback of PyLogEventIterator `__init__` method:
+ * __init__(self, decoder_buffer, query=None, allow_incomplete_stream=False,
+ *          cache_encoded_log_event=False)
+ * Keyword argument parsing is supported.
+ * Assumes `self` is uninitialized and will allocate the underlying memory. If
+ * `self` is already initialized this will result in memory leaks.
+ * @param self
+ * @param args
+ * @param keywords
+ * @return 0 on success.
+ * @return -1 on failure with the relevant Python exception and error set.
+ */
+auto PyLogEventIterator_init(PyLogEventIterator* self, PyObject* args, PyObject* keywords)
+        -> int {
+    static char keyword_decoder_buffer[]{"decoder_buffer"};
+    static char keyword_query[]{"query"};
+    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
+    static char keyword_cache_encoded_log_event[]{"cache_encoded_log_event"};
+    static char* keyword_table[]{
+            static_cast<char*>(keyword_decoder_buffer),
+            static_cast<char*>(keyword_query),
+            static_cast<char*>(keyword_allow_incomplete_stream),
+            static_cast<char*>(keyword_cache_encoded_log_event),
+            nullptr
+    };
+
+    // If the argument parsing fails, `self` will be deallocated. We must reset
+    // all pointers to nullptr in advance, otherwise the deallocator might
+    // trigger a segmentation fault.
+    self->default_init();
+
+    PyDecoderBuffer* decoder_buffer{nullptr};
+    PyObject* query{Py_None};
+    int allow_incomplete_stream{0};
+    int cache_encoded_log_event{0};
+    if (false
+        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
+                args,
+                keywords,
+                "O!|Opp",
+                static_cast<char**>(keyword_table),
+                PyDecoderBuffer::get_py_type(),
+                &decoder_buffer,
+                &query,
+                &allow_incomplete_stream,
+                &cache_encoded_log_event
+        )))
+    {
+        return -1;
+    }
+
+    bool const is_query_given{Py_None != query};
+    if (is_query_given
+        && false == static_cast<bool>(PyObject_TypeCheck(query, PyQuery::get_py_type())))
+    {
+        PyErr_SetString(PyExc_TypeError, cPyTypeError);
+        return -1;
+    }
+
+    if (false == decoder_buffer->has_metadata()) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                "The given DecoderBuffer does not have a valid CLP IR metadata decoded."
+        );
+        return -1;
+    }
+
+    self->init(
+            decoder_buffer,
+            is_query_given ? py_reinterpret_cast<PyQuery>(query) : nullptr,
+            static_cast<bool>(allow_incomplete_stream),
+            static_cast<bool>(cache_encoded_log_event)
+    );
+    return 0;
+}
+
+/**
+ * Callback of PyLogEventIterator deallocator.
+ * @param self
+ */
+auto PyLogEventIterator_dealloc(PyLogEventIterator* self) -> void {
+    self->clean();
+    PyObject_Del(self);
+}
+
+/**
+ * Callback of PyLogEventIterator `__next__` method.
+ * @param self
+ * @return Forwards `PyLogEventIterator::next`'s return values.
+ */
+auto PyLogEventIterator_iternext(PyLogEventIterator* self) -> PyObject* {
+    return self->next();
+}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyLogEventIteratorDoc,
+        "This class represents an iterator of the log events decoded from a CLP IR stream. "
+        "Each iteration decodes the next log event (matching the query if given) from the given "
+        "decoder buffer natively, which is equivalent to calling "
+        "`Decoder.decode_next_log_event` with the same arguments but without the overhead of "
+        "calling it from Python. The iteration stops when the end of the IR stream is reached or "
+        "the query search terminates.\n\n"
+        "The signature of `__init__` method is shown as following:\n\n"
+        "__init__(self, decoder_buffer, query=None, allow_incomplete_stream=False, "
+        "cache_encoded_log_event=False)\n\n"
+        "Initializes a LogEventIterator object.\n\n"
+        ":param decoder_buffer: The decoder buffer of the encoded CLP IR stream. The preamble "
+        "must have been decoded by `Decoder.decode_preamble`.\n"
+        ":param query: A Query object that filters log events. See `Query` documents for more "
+        "details.\n"
+        ":param allow_incomplete_stream: If set to `True`, an incomplete CLP IR stream is not "
+        "treated as an error. Instead, encountering such a stream is seen as reaching its end.\n"
+        ":param cache_encoded_log_event: If set to `True`, the encoded log event will be cached. "
+        "See `Decoder.decode_next_log_event` for more details.\n"
+);
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-c-arrays, cppcoreguidelines-pro-type-*-cast)
+PyType_Slot PyLogEventIterator_slots[]{
+        {Py_tp_alloc, reinterpret_cast<void*>(PyType_GenericAlloc)},
+        {Py_tp_dealloc, reinterpret_cast<void*>(PyLogEventIterator_dealloc)},
+        {Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew)},
+        {Py_tp_init, reinterpret_cast<void*>(PyLogEventIterator_init)},
+        {Py_tp_iter, reinterpret_cast<void*>(PyObject_SelfIter)},
+        {Py_tp_iternext, reinterpret_cast<void*>(PyLogEventIterator_iternext)},
+        {Py_tp_doc, const_cast<void*>(static_cast<void const*>(cPyLogEventIteratorDoc))},
+        {0, nullptr}
+};
+// NOLINTEND(cppcoreguidelines-avoid-c-arrays, cppcoreguidelines-pro-type-*-cast)
+
+/**
+ * PyLogEventIterator Python type specifications.
+ */
+PyType_Spec PyLogEventIterator_type_spec{
+        "clp_ffi_py.ir.native.LogEventIterator",
+        sizeof(PyLogEventIterator),
+        0,
+        Py_TPFLAGS_DEFAULT,
+        static_cast<PyType_Slot*>(PyLogEventIterator_slots)
+};
+}  // namespace
+
+auto PyLogEventIterator::init(
+        PyDecoderBuffer* decoder_buffer,
+        PyQuery* query,
+        bool allow_incomplete_stream,
+        bool cache_encoded_log_event
+) -> void {
+    m_decoder_buffer = decoder_buffer;
+    Py_INCREF(m_decoder_buffer);
+    m_query = query;
+    Py_XINCREF(m_query);
+    m_allow_incomplete_stream = allow_incomplete_stream;
+    m_cache_encoded_log_event = cache_encoded_log_event;
+    m_is_exhausted = false;
+}
+
+auto PyLogEventIterator::next() -> PyObject* {
+    if (m_is_exhausted) {
+        return nullptr;
+    }
+    auto* log_event{decode_next_log_event_from_buffer(
+            m_decoder_buffer,
+            m_query,
+            m_allow_incomplete_stream,
+            m_cache_encoded_log_event
+    )};
+    if (Py_None == log_event) {
+        Py_DECREF(log_event);
+        m_is_exhausted = true;
+        return nullptr;
+    }
+    return log_event;
+}
+
+PyObjectGlobalPtr<PyTypeObject> PyLogEventIterator::m_py_type{nullptr};
+
+auto PyLogEventIterator::get_py_type() -> PyTypeObject* {
+    return m_py_type.get();
+}
+
+auto PyLogEventIterator::module_level_init(PyObject* py_module) -> bool {
+    static_assert(std::is_trivially_destructible<PyLogEventIterator>());
+    auto* type{py_reinterpret_cast<PyTypeObject>(PyType_FromSpec(&PyLogEventIterator_type_spec))};
+    m_py_type.reset(type);
+    if (nullptr == type) {
+        return false;
+    }
+    return add_python_type(get_py_type(), "LogEventIterator", py_module);
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,102 @@
+#ifndef CLP_FFI_PY_PY_LOG_EVENT_ITERATOR_HPP
+#define CLP_FFI_PY_PY_LOG_EVENT_ITERATOR_HPP
+
+#include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
+
+#include <clp_ffi_py/ir/native/PyDecoderBuffer.hpp>
+#include <clp_ffi_py/ir/native/PyQuery.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * A PyObject structure that iterates through the log events decoded from a
+ * decoder buffer, optionally filtered by a query. Each iteration calls the
+ * decoding methods directly from `tp_iternext`, so iterating through an IR
+ * stream doesn't execute any Python code per log event.
+ * <p>
+ * The iterator holds references to its decoder buffer and query, and it is
+ * exhausted once the end of the IR stream is reached or the query search
+ * terminates.
+ */
+class PyLogEventIterator {
+public:
+    /**
+     * Initializes the underlying data with the given inputs. Since the memory
+     * allocation of PyLogEventIterator is handled by CPython's allocator, cpp
+     * constructors will not be explicitly called. This function serves as the
+     * default constructor. It has to be manually called whenever creating a
+     * new PyLogEventIterator object through CPython APIs.
+     * @param decoder_buffer A decoder buffer whose metadata has been decoded.
+     * @param query Search query to filter log events, or nullptr if no query
+     * is given.
+     * @param allow_incomplete_stream
+     * @param cache_encoded_log_event
+     */
+    auto init(
+            PyDecoderBuffer* decoder_buffer,
+            PyQuery* query,
+            bool allow_incomplete_stream,
+            bool cache_encoded_log_event
+    ) -> void;
+
+    /**
+     * Zero-initializes all the data members in PyLogEventIterator. Should be
+     * called once the object is allocated.
+     */
+    auto default_init() -> void {
+        m_decoder_buffer = nullptr;
+        m_query = nullptr;
+        m_allow_incomplete_stream = false;
+        m_cache_encoded_log_event = false;
+        m_is_exhausted = false;
+    }
+
+    /**
+     * Releases the references held for the Python object(s).
+     */
+    auto clean() -> void {
+        Py_XDECREF(m_decoder_buffer);
+        Py_XDECREF(m_query);
+    }
+
+    /**
+     * Decodes the next log event.
+     * @return a new reference of the next decoded log event.
+     * @return nullptr without any Python exception set if the iterator is
+     * exhausted.
+     * @return nullptr on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto next() -> PyObject*;
+
+    /**
+     * Gets the PyTypeObject that represents PyLogEventIterator's Python type.
+     * This type is dynamically created and initialized during the execution of
+     * `PyLogEventIterator::module_level_init`.
+     * @return Python type object associated with PyLogEventIterator.
+     */
+    [[nodiscard]] static auto get_py_type() -> PyTypeObject*;
+
+    /**
+     * Creates and initializes PyLogEventIterator as a Python type, and then
+     * incorporates this type as a Python object into the py_module module.
+     * @param py_module This is the Python module where the initialized
+     * PyLogEventIterator will be incorporated.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] static auto module_level_init(PyObject* py_module) -> bool;
+
+private:
+    PyObject_HEAD;
+    PyDecoderBuffer* m_decoder_buffer;
+    PyQuery* m_query;
+    bool m_allow_incomplete_stream;
+    bool m_cache_encoded_log_event;
+    bool m_is_exhausted;
+
+    static PyObjectGlobalPtr<PyTypeObject> m_py_type;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_PY_LOG_EVENT_ITERATOR_HPP
@@ -2,9 +2,12 @@
 
 #include "PyMetadata.hpp"
 
+#include <utility>
+
 #include <clp_ffi_py/error_messages.hpp>
 #include <clp_ffi_py/ExceptionFFI.hpp>
 #include <clp_ffi_py/ir/native/Metadata.hpp>
+#include <clp_ffi_py/ir/native/TimestampFormatter.hpp>
 #include <clp_ffi_py/Py_utils.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
 #include <clp_ffi_py/utils.hpp>
@@ -260,6 +263,12 @@ auto PyMetadata::init_py_timezone() -> bool {
         return false;
     }
     Py_INCREF(m_py_timezone);
+    if (auto transitions{TimezoneTransitions::load(m_metadata->get_timezone_id())};
+        transitions.has_value())
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        m_timestamp_formatter = new TimestampFormatter(std::move(transitions.value()));
+    }
     return true;
 }
 
@@ -6,6 +6,7 @@
 #include <json/single_include/nlohmann/json.hpp>
 
 #include <clp_ffi_py/ir/native/Metadata.hpp>
+#include <clp_ffi_py/ir/native/TimestampFormatter.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 
 namespace clp_ffi_py::ir::native {
@@ -13,7 +14,8 @@ namespace clp_ffi_py::ir::native {
  * A PyObject structure functioning as a Python-compatible interface to retrieve
  * CLP IR metadata. The underlying data is pointed to by `m_metadata`.
  * Additionally, it retains a tzinfo object at the Python level that signifies
- * the corresponding timezone.
+ * the corresponding timezone, and a native timestamp formatter of the same
+ * timezone if it can be loaded from the system tz database.
  */
 class PyMetadata {
 public:
@@ -54,6 +56,7 @@ public:
      */
     auto clean() -> void {
         delete m_metadata;
+        delete m_timestamp_formatter;
         Py_XDECREF(m_py_timezone);
     }
 
@@ -64,12 +67,23 @@ public:
     auto default_init() -> void {
         m_metadata = nullptr;
         m_py_timezone = nullptr;
+        m_timestamp_formatter = nullptr;
     }
 
     [[nodiscard]] auto get_metadata() -> Metadata* { return m_metadata; }
 
     [[nodiscard]] auto get_py_timezone() -> PyObject* { return m_py_timezone; }
 
+    /**
+     * @return The native formatter of the timestamps in the metadata's
+     * timezone, or nullptr if the timezone can't be loaded from the system tz
+     * database, in which case timestamps must be formatted with the Python
+     * tzinfo.
+     */
+    [[nodiscard]] auto get_timestamp_formatter() -> TimestampFormatter* {
+        return m_timestamp_formatter;
+    }
+
     /**
      * Gets the PyTypeObject that represents PyMetadata's Python type. This type
      * is dynamically created and initialized during the execution of
@@ -106,7 +120,8 @@ public:
 private:
     /**
      * Initializes py_timezone by setting the corresponded tzinfo object from
-     * the timezone id. Should be called by `init` methods.
+     * the timezone id, along with the native timestamp formatter of the same
+     * timezone. Should be called by `init` methods.
      * @return true on success.
      * @return false on failure with the relevant Python exception and error
      * set.
@@ -116,6 +131,7 @@ private:
     PyObject_HEAD;
     Metadata* m_metadata;
     PyObject* m_py_timezone;
+    TimestampFormatter* m_timestamp_formatter;
 
     static PyObjectGlobalPtr<PyTypeObject> m_py_type;
 };
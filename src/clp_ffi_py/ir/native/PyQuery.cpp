@@ -3,18 +3,65 @@
 
 #include "PyQuery.hpp"
 
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <clp/components/core/src/string_utils.hpp>
 
 #include <clp_ffi_py/error_messages.hpp>
 #include <clp_ffi_py/ir/native/LogEvent.hpp>
 #include <clp_ffi_py/ir/native/PyLogEvent.hpp>
 #include <clp_ffi_py/ir/native/Query.hpp>
+#include <clp_ffi_py/ir/native/QueryExpression.hpp>
 #include <clp_ffi_py/ir/native/utils.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
 #include <clp_ffi_py/utils.hpp>
 
 namespace clp_ffi_py::ir::native {
 namespace {
+/**
+ * Deserializes a Python wildcard query into a WildcardQuery. The wildcard
+ * string is cleaned up during the deserialization.
+ * @param py_wildcard_query An instance of WildcardQuery defined in clp_ffi_py
+ * Python module.
+ * @return The deserialized wildcard query on success.
+ * @return std::nullopt on failure with the relevant Python exception and error
+ * set.
+ */
+auto deserialize_wildcard_query(PyObject* py_wildcard_query) -> std::optional<WildcardQuery> {
+    if (1 != PyObject_IsInstance(py_wildcard_query, PyQuery::get_py_wildcard_query_type())) {
+        PyErr_SetString(PyExc_TypeError, clp_ffi_py::cPyTypeError);
+        return std::nullopt;
+    }
+    PyObjectPtr<PyObject> const wildcard_query_py_str{
+            PyObject_GetAttrString(py_wildcard_query, "wildcard_query")
+    };
+    if (nullptr == wildcard_query_py_str.get()) {
+        return std::nullopt;
+    }
+    PyObjectPtr<PyObject> const case_sensitive_py_bool{
+            PyObject_GetAttrString(py_wildcard_query, "case_sensitive")
+    };
+    if (nullptr == case_sensitive_py_bool.get()) {
+        return std::nullopt;
+    }
+    std::string_view wildcard_query_view;
+    if (false == parse_py_string_as_string_view(wildcard_query_py_str.get(), wildcard_query_view))
+    {
+        return std::nullopt;
+    }
+    int const is_case_sensitive{PyObject_IsTrue(case_sensitive_py_bool.get())};
+    if (-1 == is_case_sensitive && nullptr != PyErr_Occurred()) {
+        return std::nullopt;
+    }
+    return WildcardQuery{
+            clean_up_wildcard_search_string(wildcard_query_view),
+            static_cast<bool>(is_case_sensitive)
+    };
+}
+
 /**
  * Deserializes the wildcard queries from a list of Python wildcard queries into
  * a WildcardQuery std::vector.
@@ -46,32 +93,471 @@ auto deserialize_wildcard_queries(
     auto const wildcard_queries_size{PyList_Size(py_wildcard_queries)};
     wildcard_queries.reserve(wildcard_queries_size);
     for (Py_ssize_t idx{0}; idx < wildcard_queries_size; ++idx) {
-        auto* wildcard_query{PyList_GetItem(py_wildcard_queries, idx)};
-        if (1 != PyObject_IsInstance(wildcard_query, PyQuery::get_py_wildcard_query_type())) {
-            PyErr_SetString(PyExc_TypeError, clp_ffi_py::cPyTypeError);
+        auto wildcard_query{deserialize_wildcard_query(PyList_GetItem(py_wildcard_queries, idx))};
+        if (false == wildcard_query.has_value()) {
             return false;
         }
-        auto* wildcard_query_py_str{PyObject_GetAttrString(wildcard_query, "wildcard_query")};
-        if (nullptr == wildcard_query_py_str) {
+        wildcard_queries.emplace_back(std::move(wildcard_query.value()));
+    }
+    return true;
+}
+
+/**
+ * Deserializes a Python regex query into a RegexQuery. The regular expression
+ * is compiled during the deserialization.
+ * @param py_regex_query An instance of RegexQuery defined in clp_ffi_py Python
+ * module.
+ * @return The compiled regex query on success.
+ * @return std::nullopt on failure with the relevant Python exception and error
+ * set.
+ */
+auto deserialize_regex_query(PyObject* py_regex_query) -> std::optional<RegexQuery> {
+    if (1 != PyObject_IsInstance(py_regex_query, PyQuery::get_py_regex_query_type())) {
+        PyErr_SetString(PyExc_TypeError, clp_ffi_py::cPyTypeError);
+        return std::nullopt;
+    }
+    PyObjectPtr<PyObject> const regex_query_py_str{
+            PyObject_GetAttrString(py_regex_query, "regex_query")
+    };
+    if (nullptr == regex_query_py_str.get()) {
+        return std::nullopt;
+    }
+    PyObjectPtr<PyObject> const case_sensitive_py_bool{
+            PyObject_GetAttrString(py_regex_query, "case_sensitive")
+    };
+    if (nullptr == case_sensitive_py_bool.get()) {
+        return std::nullopt;
+    }
+    std::string regex_query_str;
+    if (false == parse_py_string(regex_query_py_str.get(), regex_query_str)) {
+        return std::nullopt;
+    }
+    int const is_case_sensitive{PyObject_IsTrue(case_sensitive_py_bool.get())};
+    if (-1 == is_case_sensitive && nullptr != PyErr_Occurred()) {
+        return std::nullopt;
+    }
+    try {
+        return RegexQuery{std::move(regex_query_str), static_cast<bool>(is_case_sensitive)};
+    } catch (ExceptionFFI const& ex) {
+        PyErr_Format(PyExc_RuntimeError, "Failed to compile regex query: %s", ex.what());
+        return std::nullopt;
+    }
+}
+
+/**
+ * Deserializes the regex queries from a list of Python regex queries into a
+ * RegexQuery std::vector. Each regex query is compiled during the
+ * deserialization.
+ * @param py_regex_queries A Python list that contains Python regex queries.
+ * Each element inside this list should be an instance of RegexQuery defined in
+ * clp_ffi_py Python module. Py_None is considered as an empty list.
+ * @param regex_queries The output std::vector that contains the compiled regex
+ * queries from the input.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto deserialize_regex_queries(PyObject* py_regex_queries, std::vector<RegexQuery>& regex_queries)
+        -> bool {
+    regex_queries.clear();
+    if (Py_None == py_regex_queries) {
+        return true;
+    }
+
+    if (false == static_cast<bool>(PyObject_TypeCheck(py_regex_queries, &PyList_Type))) {
+        PyErr_SetString(PyExc_TypeError, clp_ffi_py::cPyTypeError);
+        return false;
+    }
+
+    auto const regex_queries_size{PyList_Size(py_regex_queries)};
+    regex_queries.reserve(regex_queries_size);
+    for (Py_ssize_t idx{0}; idx < regex_queries_size; ++idx) {
+        auto regex_query{deserialize_regex_query(PyList_GetItem(py_regex_queries, idx))};
+        if (false == regex_query.has_value()) {
             return false;
         }
-        auto* case_sensitive_py_bool{PyObject_GetAttrString(wildcard_query, "case_sensitive")};
-        if (nullptr == case_sensitive_py_bool) {
+        regex_queries.emplace_back(std::move(regex_query.value()));
+    }
+    return true;
+}
+
+/**
+ * Parses an optional Python int into a timestamp. Py_None is parsed as the
+ * given default value.
+ * @param py_ts
+ * @param default_ts
+ * @param ts Returns the parsed timestamp.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto parse_optional_py_timestamp(
+        PyObject* py_ts,
+        ffi::epoch_time_ms_t default_ts,
+        ffi::epoch_time_ms_t& ts
+) -> bool {
+    if (Py_None == py_ts) {
+        ts = default_ts;
+        return true;
+    }
+    return parse_py_int<ffi::epoch_time_ms_t>(py_ts, ts);
+}
+
+/**
+ * @param predicate
+ * @return The name of the given query predicate exposed to Python.
+ */
+auto get_predicate_name(Query::Predicate predicate) -> char const* {
+    switch (predicate) {
+        case Query::Predicate::TimeRange:
+            return "time_range";
+        case Query::Predicate::LogMessage:
+            return "log_message";
+        case Query::Predicate::Attributes:
+            return "attributes";
+        case Query::Predicate::Expression:
+            return "expression";
+    }
+    return "unknown";
+}
+
+/**
+ * Parses an optional Python int into an integer attribute value. Py_None is
+ * parsed as the given default value.
+ * @param py_int
+ * @param default_value
+ * @param value Returns the parsed value.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto parse_optional_py_attr_int(
+        PyObject* py_int,
+        ffi::ir_stream::attr_int_t default_value,
+        ffi::ir_stream::attr_int_t& value
+) -> bool {
+    if (Py_None == py_int) {
+        value = default_value;
+        return true;
+    }
+    return parse_py_int<ffi::ir_stream::attr_int_t>(py_int, value);
+}
+
+/**
+ * Deserializes a Python attribute predicate into an AttributePredicate.
+ * @param py_attribute_predicate An instance of one of the AttributePredicate
+ * subclasses defined in clp_ffi_py Python module.
+ * @return The deserialized attribute predicate on success.
+ * @return std::nullopt on failure with the relevant Python exception and error
+ * set.
+ */
+auto deserialize_attribute_predicate(PyObject* py_attribute_predicate)
+        -> std::optional<AttributePredicate> {
+    PyObjectPtr<PyObject> const py_name{PyObject_GetAttrString(py_attribute_predicate, "name")};
+    if (nullptr == py_name.get()) {
+        return std::nullopt;
+    }
+    std::string name;
+    if (false == parse_py_string(py_name.get(), name)) {
+        return std::nullopt;
+    }
+
+    if (1 == PyObject_IsInstance(py_attribute_predicate, PyQuery::get_py_attribute_equals_type()))
+    {
+        PyObjectPtr<PyObject> const py_value{
+                PyObject_GetAttrString(py_attribute_predicate, "value")
+        };
+        if (nullptr == py_value.get()) {
+            return std::nullopt;
+        }
+        std::optional<ffi::ir_stream::Attribute> value;
+        if (false == deserialize_attribute(py_value.get(), value)) {
+            return std::nullopt;
+        }
+        return AttributePredicate::create_equals(std::move(name), std::move(value));
+    }
+
+    if (1 == PyObject_IsInstance(py_attribute_predicate, PyQuery::get_py_attribute_range_type())) {
+        PyObjectPtr<PyObject> const py_lower_bound{
+                PyObject_GetAttrString(py_attribute_predicate, "lower_bound")
+        };
+        if (nullptr == py_lower_bound.get()) {
+            return std::nullopt;
+        }
+        PyObjectPtr<PyObject> const py_upper_bound{
+                PyObject_GetAttrString(py_attribute_predicate, "upper_bound")
+        };
+        if (nullptr == py_upper_bound.get()) {
+            return std::nullopt;
+        }
+        ffi::ir_stream::attr_int_t lower_bound{AttributePredicate::cIntMin};
+        if (false
+            == parse_optional_py_attr_int(
+                    py_lower_bound.get(),
+                    AttributePredicate::cIntMin,
+                    lower_bound
+            ))
+        {
+            return std::nullopt;
+        }
+        ffi::ir_stream::attr_int_t upper_bound{AttributePredicate::cIntMax};
+        if (false
+            == parse_optional_py_attr_int(
+                    py_upper_bound.get(),
+                    AttributePredicate::cIntMax,
+                    upper_bound
+            ))
+        {
+            return std::nullopt;
+        }
+        return AttributePredicate::create_range(std::move(name), lower_bound, upper_bound);
+    }
+
+    if (1 == PyObject_IsInstance(py_attribute_predicate, PyQuery::get_py_attribute_in_type())) {
+        PyObjectPtr<PyObject> const py_values{
+                PyObject_GetAttrString(py_attribute_predicate, "values")
+        };
+        if (nullptr == py_values.get()) {
+            return std::nullopt;
+        }
+        PyObjectPtr<PyObject> const py_values_seq{
+                PySequence_Fast(py_values.get(), "AttributeIn values must be iterable.")
+        };
+        if (nullptr == py_values_seq.get()) {
+            return std::nullopt;
+        }
+        auto const num_values{PySequence_Fast_GET_SIZE(py_values_seq.get())};
+        std::vector<std::optional<ffi::ir_stream::Attribute>> values(
+                static_cast<size_t>(num_values)
+        );
+        for (Py_ssize_t idx{0}; idx < num_values; ++idx) {
+            if (false
+                == deserialize_attribute(
+                        PySequence_Fast_GET_ITEM(py_values_seq.get(), idx),
+                        values[static_cast<size_t>(idx)]
+                ))
+            {
+                return std::nullopt;
+            }
+        }
+        return AttributePredicate::create_in(std::move(name), values);
+    }
+
+    if (1 == PyObject_IsInstance(py_attribute_predicate, PyQuery::get_py_attribute_prefix_type()))
+    {
+        PyObjectPtr<PyObject> const py_prefix{
+                PyObject_GetAttrString(py_attribute_predicate, "prefix")
+        };
+        if (nullptr == py_prefix.get()) {
+            return std::nullopt;
+        }
+        ffi::ir_stream::attr_str_t prefix;
+        if (false == parse_py_string(py_prefix.get(), prefix)) {
+            return std::nullopt;
+        }
+        return AttributePredicate::create_prefix(std::move(name), std::move(prefix));
+    }
+
+    if (1 == PyObject_IsInstance(py_attribute_predicate, PyQuery::get_py_attribute_is_null_type()))
+    {
+        return AttributePredicate::create_is_null(std::move(name));
+    }
+
+    if (nullptr == PyErr_Occurred()) {
+        PyErr_SetString(PyExc_TypeError, "Unsupported attribute predicate type.");
+    }
+    return std::nullopt;
+}
+
+/**
+ * Deserializes the operands of a Python And/Or expression into the children of
+ * the given node.
+ * @param py_expression
+ * @param expression
+ * @param node
+ * @param depth
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto deserialize_expression_operands(
+        PyObject* py_expression,
+        QueryExpression& expression,
+        QueryExpression::Node& node,
+        size_t depth
+) -> bool;
+
+/**
+ * Deserializes a Python query expression recursively into an expression tree.
+ * The predicates are added to the given expression.
+ * @param py_expression A WildcardQuery, a RegexQuery, or an instance of one of
+ * the QueryExpression subclasses defined in clp_ffi_py Python module.
+ * @param expression
+ * @param node Returns the root of the deserialized tree.
+ * @param depth Depth of `py_expression` in the expression tree.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto deserialize_expression_node(
+        PyObject* py_expression,
+        QueryExpression& expression,
+        QueryExpression::Node& node,
+        size_t depth
+) -> bool {
+    if (depth > QueryExpression::cMaxDepth) {
+        PyErr_SetString(PyExc_RecursionError, "The query expression is nested too deeply.");
+        return false;
+    }
+
+    if (1 == PyObject_IsInstance(py_expression, PyQuery::get_py_wildcard_query_type())) {
+        auto wildcard_query{deserialize_wildcard_query(py_expression)};
+        if (false == wildcard_query.has_value()) {
             return false;
         }
-        std::string_view wildcard_query_view;
-        if (false == parse_py_string_as_string_view(wildcard_query_py_str, wildcard_query_view)) {
+        node = expression.add_wildcard_query(std::move(wildcard_query.value()));
+        return true;
+    }
+
+    if (1 == PyObject_IsInstance(py_expression, PyQuery::get_py_regex_query_type())) {
+        auto regex_query{deserialize_regex_query(py_expression)};
+        if (false == regex_query.has_value()) {
             return false;
         }
-        int const is_case_sensitive{PyObject_IsTrue(case_sensitive_py_bool)};
-        if (-1 == is_case_sensitive && nullptr != PyErr_Occurred()) {
+        node = expression.add_regex_query(std::move(regex_query.value()));
+        return true;
+    }
+
+    if (1 == PyObject_IsInstance(py_expression, PyQuery::get_py_and_expression_type())) {
+        node.m_type = QueryExpression::NodeType::And;
+        return deserialize_expression_operands(py_expression, expression, node, depth);
+    }
+
+    if (1 == PyObject_IsInstance(py_expression, PyQuery::get_py_or_expression_type())) {
+        node.m_type = QueryExpression::NodeType::Or;
+        return deserialize_expression_operands(py_expression, expression, node, depth);
+    }
+
+    if (1 == PyObject_IsInstance(py_expression, PyQuery::get_py_not_expression_type())) {
+        PyObjectPtr<PyObject> const py_operand{PyObject_GetAttrString(py_expression, "operand")};
+        if (nullptr == py_operand.get()) {
             return false;
         }
-        wildcard_queries.emplace_back(
-                clean_up_wildcard_search_string(wildcard_query_view),
-                static_cast<bool>(is_case_sensitive)
+        node.m_type = QueryExpression::NodeType::Not;
+        node.m_children.resize(1);
+        return deserialize_expression_node(
+                py_operand.get(),
+                expression,
+                node.m_children.front(),
+                depth + 1
         );
     }
+
+    if (1 == PyObject_IsInstance(py_expression, PyQuery::get_py_attribute_predicate_type())) {
+        auto attribute_predicate{deserialize_attribute_predicate(py_expression)};
+        if (false == attribute_predicate.has_value()) {
+            return false;
+        }
+        node = expression.add_attribute_predicate(std::move(attribute_predicate.value()));
+        return true;
+    }
+
+    if (1 == PyObject_IsInstance(py_expression, PyQuery::get_py_time_range_type())) {
+        PyObjectPtr<PyObject> const py_lower_bound{
+                PyObject_GetAttrString(py_expression, "lower_bound")
+        };
+        if (nullptr == py_lower_bound.get()) {
+            return false;
+        }
+        PyObjectPtr<PyObject> const py_upper_bound{
+                PyObject_GetAttrString(py_expression, "upper_bound")
+        };
+        if (nullptr == py_upper_bound.get()) {
+            return false;
+        }
+        ffi::epoch_time_ms_t lower_bound_ts{Query::cTimestampMin};
+        ffi::epoch_time_ms_t upper_bound_ts{Query::cTimestampMax};
+        if (false
+            == parse_optional_py_timestamp(
+                    py_lower_bound.get(),
+                    Query::cTimestampMin,
+                    lower_bound_ts
+            ))
+        {
+            return false;
+        }
+        if (false
+            == parse_optional_py_timestamp(
+                    py_upper_bound.get(),
+                    Query::cTimestampMax,
+                    upper_bound_ts
+            ))
+        {
+            return false;
+        }
+        node = expression.add_time_range(lower_bound_ts, upper_bound_ts);
+        return true;
+    }
+
+    if (nullptr == PyErr_Occurred()) {
+        PyErr_SetString(PyExc_TypeError, "Unsupported query expression operand type.");
+    }
+    return false;
+}
+
+auto deserialize_expression_operands(
+        PyObject* py_expression,
+        QueryExpression& expression,
+        QueryExpression::Node& node,
+        size_t depth
+) -> bool {
+    PyObjectPtr<PyObject> const py_operands{PyObject_GetAttrString(py_expression, "operands")};
+    if (nullptr == py_operands.get()) {
+        return false;
+    }
+    if (false == static_cast<bool>(PyList_Check(py_operands.get()))) {
+        PyErr_SetString(PyExc_TypeError, clp_ffi_py::cPyTypeError);
+        return false;
+    }
+    auto const num_operands{PyList_Size(py_operands.get())};
+    if (0 == num_operands) {
+        PyErr_SetString(PyExc_ValueError, "AND/OR expressions require at least one operand.");
+        return false;
+    }
+    node.m_children.resize(static_cast<size_t>(num_operands));
+    for (Py_ssize_t idx{0}; idx < num_operands; ++idx) {
+        if (false
+            == deserialize_expression_node(
+                    PyList_GetItem(py_operands.get(), idx),
+                    expression,
+                    node.m_children[static_cast<size_t>(idx)],
+                    depth + 1
+            ))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Deserializes a Python query expression and compiles it.
+ * @param py_expression A Python query expression, or Py_None for an empty
+ * expression.
+ * @param expression Returns the compiled expression.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto deserialize_query_expression(PyObject* py_expression, QueryExpression& expression) -> bool {
+    expression = QueryExpression{};
+    if (Py_None == py_expression) {
+        return true;
+    }
+    QueryExpression::Node root;
+    if (false == deserialize_expression_node(py_expression, expression, root, 0)) {
+        return false;
+    }
+    try {
+        expression.compile(root);
+    } catch (ExceptionFFI const& ex) {
+        PyErr_Format(PyExc_RuntimeError, "Failed to compile query expression: %s", ex.what());
+        return false;
+    }
     return true;
 }
 
@@ -126,6 +612,55 @@ auto serialize_wildcard_queries(std::vector<WildcardQuery> const& wildcard_queri
     return py_wildcard_queries;
 }
 
+/**
+ * Serializes the std::vector of RegexQuery into a Python list. Serves as a
+ * helper function to serialize the underlying regex queries of the PyQuery
+ * object.
+ * @param regex_queries A std::vector of RegexQuery.
+ * @return The Python list that consists of Python regex query objects.
+ * @return Py_None if the regex_queries are empty.
+ */
+auto serialize_regex_queries(std::vector<RegexQuery> const& regex_queries) -> PyObject* {
+    Py_ssize_t const regex_queries_size{static_cast<Py_ssize_t>(regex_queries.size())};
+    if (0 == regex_queries_size) {
+        Py_RETURN_NONE;
+    }
+
+    auto* py_regex_queries{PyList_New(regex_queries_size)};
+    if (nullptr == py_regex_queries) {
+        return nullptr;
+    }
+
+    Py_ssize_t idx{0};
+    for (auto const& regex_query : regex_queries) {
+        auto const& regex_query_str{regex_query.get_regex_query()};
+        PyObjectPtr<PyObject> const regex_py_str{PyUnicode_FromStringAndSize(
+                regex_query_str.data(),
+                static_cast<Py_ssize_t>(regex_query_str.size())
+        )};
+        if (nullptr == regex_py_str.get()) {
+            Py_DECREF(py_regex_queries);
+            return nullptr;
+        }
+        PyObjectPtr<PyObject> const is_case_sensitive{get_py_bool(regex_query.is_case_sensitive())
+        };
+        PyObject* py_regex_query{PyObject_CallFunction(
+                PyQuery::get_py_regex_query_type(),
+                "OO",
+                regex_py_str.get(),
+                is_case_sensitive.get()
+        )};
+        if (nullptr == py_regex_query) {
+            Py_DECREF(py_regex_queries);
+            return nullptr;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        PyList_SET_ITEM(py_regex_queries, idx, py_regex_query);
+        ++idx;
+    }
+    return py_regex_queries;
+}
+
 extern "C" {
 /**
  * Callback of PyQuery `__init__` method:
@@ -134,8 +669,11 @@ extern "C" {
  *      search_time_lower_bound=Query.default_search_time_lower_bound(),
  *      search_time_upper_bound=Query.default_search_time_upper_bound(),
  *      wildcard_queries=None,
+ *      attribute_queries=None,
  *      search_time_termination_margin=
- *              Query.default_search_time_termination_margin()
+ *              Query.default_search_time_termination_margin(),
+ *      regex_queries=None,
+ *      expression=None
  * )
  * Keyword argument parsing is supported.
  * Assumes `self` is uninitialized and will allocate the underlying memory. If
@@ -152,12 +690,16 @@ auto PyQuery_init(PyQuery* self, PyObject* args, PyObject* keywords) -> int {
     static char keyword_wildcard_queries[]{"wildcard_queries"};
     static char keyword_attribute_queries[]{"attribute_queries"};
     static char keyword_search_time_termination_margin[]{"search_time_termination_margin"};
+    static char keyword_regex_queries[]{"regex_queries"};
+    static char keyword_expression[]{"expression"};
     static char* keyword_table[]{
             static_cast<char*>(keyword_search_time_lower_bound),
             static_cast<char*>(keyword_search_time_upper_bound),
             static_cast<char*>(keyword_wildcard_queries),
             static_cast<char*>(keyword_attribute_queries),
             static_cast<char*>(keyword_search_time_termination_margin),
+            static_cast<char*>(keyword_regex_queries),
+            static_cast<char*>(keyword_expression),
             nullptr
     };
 
@@ -171,18 +713,22 @@ auto PyQuery_init(PyQuery* self, PyObject* args, PyObject* keywords) -> int {
     auto* py_wildcard_queries{Py_None};
     auto* py_attribute_queries{Py_None};
     auto search_time_termination_margin{Query::cDefaultSearchTimeTerminationMargin};
+    auto* py_regex_queries{Py_None};
+    auto* py_expression{Py_None};
 
     if (false
         == static_cast<bool>(PyArg_ParseTupleAndKeywords(
                 args,
                 keywords,
-                "|LLOOL",
+                "|LLOOLOO",
                 static_cast<char**>(keyword_table),
                 &search_time_lower_bound,
                 &search_time_upper_bound,
                 &py_wildcard_queries,
                 &py_attribute_queries,
-                &search_time_termination_margin
+                &search_time_termination_margin,
+                &py_regex_queries,
+                &py_expression
         )))
     {
         return -1;
@@ -198,17 +744,29 @@ auto PyQuery_init(PyQuery* self, PyObject* args, PyObject* keywords) -> int {
         return -1;
     }
 
+    std::vector<RegexQuery> regex_queries;
+    if (false == deserialize_regex_queries(py_regex_queries, regex_queries)) {
+        return -1;
+    }
+
+    QueryExpression expression;
+    if (false == deserialize_query_expression(py_expression, expression)) {
+        return -1;
+    }
+
     if (false
         == self->init(
                 search_time_lower_bound,
                 search_time_upper_bound,
                 wildcard_queries,
                 attribute_queries,
+                regex_queries,
                 search_time_termination_margin
         ))
     {
         return -1;
     }
+    self->set_expression(py_expression, std::move(expression));
     return 0;
 }
 
@@ -230,6 +788,8 @@ constexpr char const* const cStateSearchTimeUpperBound = "search_time_upper_boun
 constexpr char const* const cStateWildcardQueries = "wildcard_queries";
 constexpr char const* const cStateAttributeQueries = "attribute_queries";
 constexpr char const* const cStateSearchTimeTerminationMargin = "search_time_termination_margin";
+constexpr char const* const cStateRegexQueries = "regex_queries";
+constexpr char const* const cStateExpression = "expression";
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
@@ -256,8 +816,12 @@ auto PyQuery_getstate(PyQuery* self) -> PyObject* {
     if (nullptr == py_attribute_queries) {
         return nullptr;
     }
+    auto* py_regex_queries{serialize_regex_queries(query->get_regex_queries())};
+    if (nullptr == py_regex_queries) {
+        return nullptr;
+    }
     return Py_BuildValue(
-            "{sLsLsOsOsL}",
+            "{sLsLsOsOsLsOsN}",
             cStateSearchTimeLowerBound,
             query->get_lower_bound_ts(),
             cStateSearchTimeUpperBound,
@@ -267,7 +831,11 @@ auto PyQuery_getstate(PyQuery* self) -> PyObject* {
             cStateAttributeQueries,
             py_attribute_queries,
             cStateSearchTimeTerminationMargin,
-            query->get_search_time_termination_margin()
+            query->get_search_time_termination_margin(),
+            cStateRegexQueries,
+            py_regex_queries,
+            cStateExpression,
+            self->get_py_expression()
     );
 }
 
@@ -376,17 +944,39 @@ auto PyQuery_setstate(PyQuery* self, PyObject* state) -> PyObject* {
         return nullptr;
     }
 
+    // Regex queries are optional in the state to stay compatible with the
+    // states serialized before regex queries were supported.
+    std::vector<RegexQuery> regex_queries;
+    auto* py_regex_queries{PyDict_GetItemString(state, cStateRegexQueries)};
+    if (nullptr != py_regex_queries
+        && false == deserialize_regex_queries(py_regex_queries, regex_queries))
+    {
+        return nullptr;
+    }
+
+    // The expression is optional in the state for the same reason.
+    auto* py_expression{PyDict_GetItemString(state, cStateExpression)};
+    if (nullptr == py_expression) {
+        py_expression = Py_None;
+    }
+    QueryExpression expression;
+    if (false == deserialize_query_expression(py_expression, expression)) {
+        return nullptr;
+    }
+
     if (false
         == self->init(
                 search_time_lower_bound,
                 search_time_upper_bound,
                 wildcard_queries,
                 attribute_queries,
+                regex_queries,
                 search_time_termination_margin
         ))
     {
         return nullptr;
     }
+    self->set_expression(py_expression, std::move(expression));
 
     Py_RETURN_NONE;
 }
@@ -470,6 +1060,103 @@ auto PyQuery_get_attribute_queries(PyQuery* self) -> PyObject* {
     return serialize_attributes_to_python_dict(self->get_query()->get_attribute_queries());
 }
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyQueryGetRegexQueriesDoc,
+        "get_regex_queries(self)\n"
+        "--\n\n"
+        ":return: A new Python list of stored regex queries, presented as RegexQuery objects.\n"
+        ":return: None if the regex queries are empty.\n"
+);
+
+auto PyQuery_get_regex_queries(PyQuery* self) -> PyObject* {
+    return serialize_regex_queries(self->get_query()->get_regex_queries());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyQueryGetExpressionDoc,
+        "get_expression(self)\n"
+        "--\n\n"
+        ":return: The query expression given on initialization.\n"
+        ":return: None if the query has no expression.\n"
+);
+
+auto PyQuery_get_expression(PyQuery* self) -> PyObject* {
+    return self->get_py_expression();
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyQueryGetPredicateStatsDoc,
+        "get_predicate_stats(self)\n"
+        "--\n\n"
+        "Gets the runtime statistics of the query's predicates observed while decoding log "
+        "events with this query. The predicates are reordered during decoding so that the "
+        "cheapest and most selective ones are evaluated first. Statistics are only collected "
+        "for queries that combine log message queries with attribute queries, or that have a "
+        "query expression; simpler queries are decoded with a specialized loop instead.\n\n"
+        ":return: A new Python list of dicts, one per predicate, in the order the predicates "
+        "are currently evaluated. Each dict contains the following keys:\n"
+        "   - \"predicate\": The name of the predicate: \"time_range\", \"log_message\", "
+        "\"attributes\", or \"expression\".\n"
+        "   - \"evaluations\": The number of times the predicate was evaluated.\n"
+        "   - \"matches\": The number of times the predicate matched.\n"
+        "   - \"average_cost_ns\": The average sampled evaluation cost in nanoseconds.\n"
+);
+
+auto PyQuery_get_predicate_stats(PyQuery* self) -> PyObject* {
+    auto const* query{self->get_query()};
+    auto const& predicate_order{query->get_predicate_order()};
+    PyObjectPtr<PyObject> py_predicate_stats{
+            PyList_New(static_cast<Py_ssize_t>(predicate_order.size()))
+    };
+    if (nullptr == py_predicate_stats.get()) {
+        return nullptr;
+    }
+    Py_ssize_t idx{0};
+    for (auto const predicate : predicate_order) {
+        auto const& stats{query->get_predicate_stats(predicate)};
+        auto const average_cost_ns{
+                0 == stats.m_num_sampled_evaluations
+                        ? 0.0
+                        : static_cast<double>(stats.m_total_sampled_cost_ns)
+                                  / static_cast<double>(stats.m_num_sampled_evaluations)
+        };
+        PyObject* py_stats{Py_BuildValue(
+                "{sssKsKsd}",
+                "predicate",
+                get_predicate_name(predicate),
+                "evaluations",
+                static_cast<unsigned long long>(stats.m_num_evaluations),
+                "matches",
+                static_cast<unsigned long long>(stats.m_num_matches),
+                "average_cost_ns",
+                average_cost_ns
+        )};
+        if (nullptr == py_stats) {
+            return nullptr;
+        }
+        PyList_SET_ITEM(py_predicate_stats.get(), idx, py_stats);
+        ++idx;
+    }
+    return py_predicate_stats.release();
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+PyDoc_STRVAR(
+        cPyQueryResetPredicateStatsDoc,
+        "reset_predicate_stats(self)\n"
+        "--\n\n"
+        "Resets the runtime statistics of the query's predicates and restores the default "
+        "predicate evaluation order.\n"
+);
+
+auto PyQuery_reset_predicate_stats(PyQuery* self) -> PyObject* {
+    self->get_query()->reset_predicate_stats();
+    Py_RETURN_NONE;
+}
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
 PyDoc_STRVAR(
         cPyQueryGetSearchTimeTerminationMarginDoc,
@@ -574,6 +1261,26 @@ PyMethodDef PyQuery_method_table[]{
          METH_NOARGS,
          static_cast<char const*>(cPyQueryGetAttributeQueriesDoc)},
 
+        {"get_regex_queries",
+         py_c_function_cast(PyQuery_get_regex_queries),
+         METH_NOARGS,
+         static_cast<char const*>(cPyQueryGetRegexQueriesDoc)},
+
+        {"get_expression",
+         py_c_function_cast(PyQuery_get_expression),
+         METH_NOARGS,
+         static_cast<char const*>(cPyQueryGetExpressionDoc)},
+
+        {"get_predicate_stats",
+         py_c_function_cast(PyQuery_get_predicate_stats),
+         METH_NOARGS,
+         static_cast<char const*>(cPyQueryGetPredicateStatsDoc)},
+
+        {"reset_predicate_stats",
+         py_c_function_cast(PyQuery_reset_predicate_stats),
+         METH_NOARGS,
+         static_cast<char const*>(cPyQueryResetPredicateStatsDoc)},
+
         {"get_search_time_termination_margin",
          py_c_function_cast(PyQuery_get_search_time_termination_margin),
          METH_NOARGS,
@@ -601,15 +1308,20 @@ PyMethodDef PyQuery_method_table[]{
 PyDoc_STRVAR(
         cPyQueryDoc,
         "This class represents a search query, utilized for filtering log events in a CLP IR "
-        "stream. The query could include a list of wildcard queries aimed at identifying certain "
-        "log messages, and a timestamp range with a lower and upper bound. This class provides an "
-        "interface to set up a search query, as well as methods to validate whether the query can "
-        "be matched by a log event. Note that an empty wildcard query list will match any log "
-        "within the range.\n\n"
+        "stream. The query could include a list of wildcard queries and a list of regex queries "
+        "aimed at identifying certain log messages, and a timestamp range with a lower and upper "
+        "bound. This class provides an interface to set up a search query, as well as methods to "
+        "validate whether the query can be matched by a log event. A log message matches if it "
+        "matches any one of the wildcard or regex queries. Note that empty wildcard and regex "
+        "query lists will match any log within the range. In addition, a boolean expression of "
+        "AND, OR and NOT over message, attribute and timestamp predicates can be given (see "
+        "`clp_ffi_py.query_expression`); it is compiled natively and evaluated with "
+        "short-circuiting while decoding.\n\n"
         "By default, the wildcard query list is empty and the timestamp range is set to include "
         "all the valid Unix epoch timestamps. To filter certain log messages, use customized "
         "wildcard queries to initialize the wildcard query list. For more details, check the "
-        "documentation of the class `WildcardQuery`.\n\n"
+        "documentation of the class `WildcardQuery`. Regular expressions are supported through "
+        "the class `RegexQuery`, and are compiled once when the query is initialized.\n\n"
         "NOTE: When searching an IR stream with a query, ideally, the search would terminate once "
         "the current log event's timestamp exceeds the upper bound of the query's time range. "
         "However, the timestamps in the IR stream might not be monotonically increasing; they can "
@@ -624,7 +1336,8 @@ PyDoc_STRVAR(
         "__init__(self, search_time_lower_bound=Query.default_search_time_lower_bound(), "
         "search_time_upper_bound=Query.default_search_time_upper_bound(), "
         "wildcard_queries=None,attribute_queries=None,"
-        "search_time_termination_margin=Query.default_search_time_termination_margin())\n\n"
+        "search_time_termination_margin=Query.default_search_time_termination_margin(),"
+        "regex_queries=None,expression=None)\n\n"
         "Initializes a Query object using the given inputs.\n\n"
         ":param search_time_lower_bound: Start of search time range (inclusive).\n"
         ":param search_time_upper_bound: End of search time range (inclusive).\n"
@@ -632,6 +1345,10 @@ PyDoc_STRVAR(
         ":param attribute_queries: A str dictionary of key-value pairs on the query attributes.\n"
         ":param search_time_termination_margin: The margin used to determine the search "
         "termination timestamp.\n"
+        ":param regex_queries: A list of regex queries.\n"
+        ":param expression: A boolean query expression built from the classes in "
+        "`clp_ffi_py.query_expression`. A log event must match the expression in addition to the "
+        "other criteria.\n"
 );
 
 // NOLINTBEGIN(cppcoreguidelines-avoid-c-arrays, cppcoreguidelines-pro-type-*-cast)
@@ -665,6 +1382,7 @@ auto PyQuery::init(
         ffi::epoch_time_ms_t search_time_upper_bound,
         std::vector<WildcardQuery> const& wildcard_queries,
         LogEvent::attribute_table_t const& attribute_queries,
+        std::vector<RegexQuery> const& regex_queries,
         ffi::epoch_time_ms_t search_time_termination_margin
 ) -> bool {
     try {
@@ -674,6 +1392,7 @@ auto PyQuery::init(
                 search_time_upper_bound,
                 wildcard_queries,
                 attribute_queries,
+                regex_queries,
                 search_time_termination_margin
         );
     } catch (ExceptionFFI const& ex) {
@@ -694,6 +1413,17 @@ auto PyQuery::init(
 
 PyObjectGlobalPtr<PyTypeObject> PyQuery::m_py_type{nullptr};
 PyObjectGlobalPtr<PyObject> PyQuery::m_py_wildcard_query_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_regex_query_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_and_expression_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_or_expression_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_not_expression_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_attribute_predicate_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_attribute_equals_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_attribute_range_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_attribute_in_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_attribute_prefix_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_attribute_is_null_type{nullptr};
+PyObjectGlobalPtr<PyObject> PyQuery::m_py_time_range_type{nullptr};
 
 auto PyQuery::get_py_type() -> PyTypeObject* {
     return m_py_type.get();
@@ -703,6 +1433,50 @@ auto PyQuery::get_py_wildcard_query_type() -> PyObject* {
     return m_py_wildcard_query_type.get();
 }
 
+auto PyQuery::get_py_regex_query_type() -> PyObject* {
+    return m_py_regex_query_type.get();
+}
+
+auto PyQuery::get_py_and_expression_type() -> PyObject* {
+    return m_py_and_expression_type.get();
+}
+
+auto PyQuery::get_py_or_expression_type() -> PyObject* {
+    return m_py_or_expression_type.get();
+}
+
+auto PyQuery::get_py_not_expression_type() -> PyObject* {
+    return m_py_not_expression_type.get();
+}
+
+auto PyQuery::get_py_attribute_predicate_type() -> PyObject* {
+    return m_py_attribute_predicate_type.get();
+}
+
+auto PyQuery::get_py_attribute_equals_type() -> PyObject* {
+    return m_py_attribute_equals_type.get();
+}
+
+auto PyQuery::get_py_attribute_range_type() -> PyObject* {
+    return m_py_attribute_range_type.get();
+}
+
+auto PyQuery::get_py_attribute_in_type() -> PyObject* {
+    return m_py_attribute_in_type.get();
+}
+
+auto PyQuery::get_py_attribute_prefix_type() -> PyObject* {
+    return m_py_attribute_prefix_type.get();
+}
+
+auto PyQuery::get_py_attribute_is_null_type() -> PyObject* {
+    return m_py_attribute_is_null_type.get();
+}
+
+auto PyQuery::get_py_time_range_type() -> PyObject* {
+    return m_py_time_range_type.get();
+}
+
 auto PyQuery::module_level_init(PyObject* py_module) -> bool {
     static_assert(std::is_trivially_destructible<PyQuery>());
     auto* type{py_reinterpret_cast<PyTypeObject>(PyType_FromSpec(&PyQuery_type_spec))};
@@ -724,6 +1498,45 @@ auto PyQuery::module_level_init(PyObject* py_module) -> bool {
         return false;
     }
     m_py_wildcard_query_type.reset(py_wildcard_query_type);
+
+    PyObjectPtr<PyObject> const regex_query_module(PyImport_ImportModule("clp_ffi_py.regex_query"));
+    if (nullptr == regex_query_module.get()) {
+        return false;
+    }
+    auto* py_regex_query_type = PyObject_GetAttrString(regex_query_module.get(), "RegexQuery");
+    if (nullptr == py_regex_query_type) {
+        return false;
+    }
+    m_py_regex_query_type.reset(py_regex_query_type);
+
+    PyObjectPtr<PyObject> const query_expression_module(
+            PyImport_ImportModule("clp_ffi_py.query_expression")
+    );
+    if (nullptr == query_expression_module.get()) {
+        return false;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+    std::pair<char const*, PyObjectGlobalPtr<PyObject>*> const query_expression_types[]{
+            {"AndExpression", &m_py_and_expression_type},
+            {"OrExpression", &m_py_or_expression_type},
+            {"NotExpression", &m_py_not_expression_type},
+            {"AttributePredicate", &m_py_attribute_predicate_type},
+            {"AttributeEquals", &m_py_attribute_equals_type},
+            {"AttributeRange", &m_py_attribute_range_type},
+            {"AttributeIn", &m_py_attribute_in_type},
+            {"AttributePrefix", &m_py_attribute_prefix_type},
+            {"AttributeIsNull", &m_py_attribute_is_null_type},
+            {"TimeRange", &m_py_time_range_type}
+    };
+    for (auto const& [type_name, py_type] : query_expression_types) {
+        auto* py_query_expression_type{
+                PyObject_GetAttrString(query_expression_module.get(), type_name)
+        };
+        if (nullptr == py_query_expression_type) {
+            return false;
+        }
+        py_type->reset(py_query_expression_type);
+    }
     return true;
 }
 }  // namespace clp_ffi_py::ir::native
@@ -4,6 +4,7 @@
 #include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
 
 #include <clp_ffi_py/ir/native/Query.hpp>
+#include <clp_ffi_py/ir/native/QueryExpression.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 
 namespace clp_ffi_py::ir::native {
@@ -27,6 +28,7 @@ public:
      * @param wildcard_queries A list of wildcard queries. Each wildcard query
      * must be valid (see `wildcard_match_unsafe`).
      * @param attribute_queries Queries on log event attributes.
+     * @param regex_queries A list of compiled regex queries.
      * @param search_time_termination_margin The margin used to determine the
      * search termination timestamp (see note in the Query class' docstring).
      * @return true on success.
@@ -38,6 +40,7 @@ public:
             ffi::epoch_time_ms_t search_time_upper_bound,
             std::vector<WildcardQuery> const& wildcard_queries,
             LogEvent::attribute_table_t const& attribute_queries,
+            std::vector<RegexQuery> const& regex_queries,
             ffi::epoch_time_ms_t search_time_termination_margin
     ) -> bool;
 
@@ -45,15 +48,46 @@ public:
      * Initializes the pointers to nullptr by default. Should be called once
      * the object is allocated.
      */
-    auto default_init() -> void { m_query = nullptr; }
+    auto default_init() -> void {
+        m_query = nullptr;
+        m_py_expression = nullptr;
+    }
 
     /*
      * Releases the memory allocated for underlying query object.
      */
-    auto clean() -> void { delete m_query; }
+    auto clean() -> void {
+        delete m_query;
+        Py_XDECREF(m_py_expression);
+    }
 
     [[nodiscard]] auto get_query() -> Query* { return m_query; }
 
+    /**
+     * Sets the query expression of the underlying query. A reference to the
+     * Python expression is kept so that it can be returned to the user and
+     * serialized.
+     * @param py_expression The Python expression, or Py_None.
+     * @param expression The expression compiled from `py_expression`.
+     */
+    auto set_expression(PyObject* py_expression, QueryExpression expression) -> void {
+        m_query->set_expression(std::move(expression));
+        Py_INCREF(py_expression);
+        Py_XSETREF(m_py_expression, py_expression);
+    }
+
+    /**
+     * @return A new reference to the Python query expression, or Py_None if
+     * there is no expression.
+     */
+    [[nodiscard]] auto get_py_expression() -> PyObject* {
+        if (nullptr == m_py_expression) {
+            Py_RETURN_NONE;
+        }
+        Py_INCREF(m_py_expression);
+        return m_py_expression;
+    }
+
     /**
      * Gets the PyTypeObject that represents PyQuery's Python type. This type
      * is dynamically created and initialized during the execution of
@@ -78,12 +112,83 @@ public:
      */
     [[nodiscard]] static auto get_py_wildcard_query_type() -> PyObject*;
 
+    /**
+     * @return PyObject that represents the Python level class `RegexQuery`.
+     */
+    [[nodiscard]] static auto get_py_regex_query_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class `AndExpression`.
+     */
+    [[nodiscard]] static auto get_py_and_expression_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class `OrExpression`.
+     */
+    [[nodiscard]] static auto get_py_or_expression_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class `NotExpression`.
+     */
+    [[nodiscard]] static auto get_py_not_expression_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class
+     * `AttributePredicate`.
+     */
+    [[nodiscard]] static auto get_py_attribute_predicate_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class
+     * `AttributeEquals`.
+     */
+    [[nodiscard]] static auto get_py_attribute_equals_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class `AttributeRange`.
+     */
+    [[nodiscard]] static auto get_py_attribute_range_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class `AttributeIn`.
+     */
+    [[nodiscard]] static auto get_py_attribute_in_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class
+     * `AttributePrefix`.
+     */
+    [[nodiscard]] static auto get_py_attribute_prefix_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class
+     * `AttributeIsNull`.
+     */
+    [[nodiscard]] static auto get_py_attribute_is_null_type() -> PyObject*;
+
+    /**
+     * @return PyObject that represents the Python level class `TimeRange`.
+     */
+    [[nodiscard]] static auto get_py_time_range_type() -> PyObject*;
+
 private:
     PyObject_HEAD;
     Query* m_query;
+    PyObject* m_py_expression;
 
     static PyObjectGlobalPtr<PyTypeObject> m_py_type;
     static PyObjectGlobalPtr<PyObject> m_py_wildcard_query_type;
+    static PyObjectGlobalPtr<PyObject> m_py_regex_query_type;
+    static PyObjectGlobalPtr<PyObject> m_py_and_expression_type;
+    static PyObjectGlobalPtr<PyObject> m_py_or_expression_type;
+    static PyObjectGlobalPtr<PyObject> m_py_not_expression_type;
+    static PyObjectGlobalPtr<PyObject> m_py_attribute_predicate_type;
+    static PyObjectGlobalPtr<PyObject> m_py_attribute_equals_type;
+    static PyObjectGlobalPtr<PyObject> m_py_attribute_range_type;
+    static PyObjectGlobalPtr<PyObject> m_py_attribute_in_type;
+    static PyObjectGlobalPtr<PyObject> m_py_attribute_prefix_type;
+    static PyObjectGlobalPtr<PyObject> m_py_attribute_is_null_type;
+    static PyObjectGlobalPtr<PyObject> m_py_time_range_type;
 };
 }  // namespace clp_ffi_py::ir::native
 #endif
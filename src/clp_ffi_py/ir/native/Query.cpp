@@ -1,6 +1,10 @@
 #include "Query.hpp"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 #include <clp/components/core/src/string_utils.hpp>
@@ -27,6 +31,45 @@ auto compare_attr_val(
     }
     return true;
 }
+
+/**
+ * Throws an exception for an attribute name in the query that doesn't belong
+ * to the log event.
+ * @param attr_name
+ */
+[[noreturn]] auto throw_attribute_not_found(std::string const& attr_name) -> void {
+    throw ExceptionFFI(
+            ErrorCode_OutOfBounds,
+            __FILE__,
+            __LINE__,
+            "Attribute name in the query not found: " + attr_name
+    );
+}
+
+/**
+ * @param stats
+ * @return The rank of a predicate in a conjunction: its expected cost divided
+ * by the probability that it rejects a log event. Predicates with a lower rank
+ * should be evaluated first.
+ */
+auto get_predicate_rank(Query::PredicateStats const& stats) -> double {
+    if (0 == stats.m_num_evaluations) {
+        return 0.0;
+    }
+    constexpr double cMinRejectRate{1e-6};
+    auto const avg_cost{
+            0 == stats.m_num_sampled_evaluations
+                    ? 0.0
+                    : static_cast<double>(stats.m_total_sampled_cost_ns)
+                              / static_cast<double>(stats.m_num_sampled_evaluations)
+    };
+    auto const reject_rate{
+            1.0
+            - static_cast<double>(stats.m_num_matches)
+                      / static_cast<double>(stats.m_num_evaluations)
+    };
+    return avg_cost / std::max(reject_rate, cMinRejectRate);
+}
 }  // namespace
 
 auto Query::matches_wildcard_queries(std::string_view log_message) const -> bool {
@@ -46,23 +89,38 @@ auto Query::matches_wildcard_queries(std::string_view log_message) const -> bool
     );
 }
 
-auto Query::matches_attributes(LogEvent::attribute_table_t const& attributes) const -> bool {
+auto Query::matches_log_message(std::string_view log_message) const -> bool {
+    if (m_wildcard_queries.empty() && m_regex_queries.empty()) {
+        return true;
+    }
+    return std::any_of(
+                   m_wildcard_queries.begin(),
+                   m_wildcard_queries.end(),
+                   [&](auto const& wildcard_query) {
+                       return wildcard_match_unsafe(
+                               log_message,
+                               wildcard_query.get_wildcard_query(),
+                               wildcard_query.is_case_sensitive()
+                       );
+                   }
+           )
+           || std::any_of(
+                   m_regex_queries.begin(),
+                   m_regex_queries.end(),
+                   [&](auto const& regex_query) { return regex_query.matches(log_message); }
+           );
+}
+
+auto Query::matches_attributes(LogEvent const& log_event) const -> bool {
     if (m_attribute_queries.empty()) {
         return true;
     }
-    auto const attr_end_it{attributes.cend()};
     for (auto const& [query_attr_name, query_attr_val] : m_attribute_queries) {
-        auto const it{attributes.find(query_attr_name)};
-        if (attr_end_it == it) {
-            throw ExceptionFFI(
-                    ErrorCode_OutOfBounds,
-                    __FILE__,
-                    __LINE__,
-                    "Attribute name in the query not found: " + query_attr_name
-            );
+        auto const* attr_val{log_event.find_attribute(query_attr_name)};
+        if (nullptr == attr_val) {
+            throw_attribute_not_found(query_attr_name);
         }
-        auto const& attr_val{it->second};
-        if (false == compare_attr_val(query_attr_val, attr_val)) {
+        if (false == compare_attr_val(query_attr_val, *attr_val)) {
             return false;
         }
     }
@@ -80,18 +138,162 @@ auto Query::matches_decoded_attributes(
     for (auto const& [query_attr_name, query_attr_val] : m_attribute_queries) {
         auto const it{attribute_idx_map.find(query_attr_name)};
         if (attr_idx_map_end == it) {
-            throw ExceptionFFI(
-                    ErrorCode_OutOfBounds,
-                    __FILE__,
-                    __LINE__,
-                    "Attribute name in the query not found: " + query_attr_name
-            );
+            throw_attribute_not_found(query_attr_name);
         }
-        auto const& attr_val{decoded_attributes.at(it->second)};
+        auto const& attr_val{decoded_attributes[it->second]};
         if (false == compare_attr_val(query_attr_val, attr_val)) {
             return false;
         }
     }
     return true;
 }
+
+auto Query::matches_expression(LogEvent const& log_event) const -> bool {
+    if (m_expression.empty()) {
+        return true;
+    }
+    return m_expression.evaluate(
+            log_event.get_timestamp(),
+            log_event.get_log_message_view(),
+            [&](std::string const& attr_name) -> std::optional<ffi::ir_stream::Attribute> const& {
+                auto const* attr_val{log_event.find_attribute(attr_name)};
+                if (nullptr == attr_val) {
+                    throw_attribute_not_found(attr_name);
+                }
+                return *attr_val;
+            }
+    );
+}
+
+auto Query::matches_decoded_expression(
+        ffi::epoch_time_ms_t ts,
+        std::string_view log_message,
+        std::vector<std::optional<ffi::ir_stream::Attribute>> const& decoded_attributes,
+        std::unordered_map<std::string, size_t> const& attribute_idx_map
+) const -> bool {
+    if (m_expression.empty()) {
+        return true;
+    }
+    return m_expression.evaluate(
+            ts,
+            log_message,
+            [&](std::string const& attr_name) -> std::optional<ffi::ir_stream::Attribute> const& {
+                auto const it{attribute_idx_map.find(attr_name)};
+                if (attribute_idx_map.cend() == it) {
+                    throw_attribute_not_found(attr_name);
+                }
+                return decoded_attributes[it->second];
+            }
+    );
+}
+
+auto Query::validate_decoded_attribute_names(
+        std::unordered_map<std::string, size_t> const& attribute_idx_map
+) const -> void {
+    auto const attr_idx_map_end{attribute_idx_map.cend()};
+    for (auto const& [query_attr_name, query_attr_val] : m_attribute_queries) {
+        if (attr_idx_map_end == attribute_idx_map.find(query_attr_name)) {
+            throw_attribute_not_found(query_attr_name);
+        }
+    }
+    for (auto const& attribute_predicate : m_expression.get_attribute_predicates()) {
+        if (attr_idx_map_end == attribute_idx_map.find(attribute_predicate.get_name())) {
+            throw_attribute_not_found(attribute_predicate.get_name());
+        }
+    }
+}
+
+auto Query::matches_decoded(
+        ffi::epoch_time_ms_t ts,
+        std::string_view log_message,
+        std::vector<std::optional<ffi::ir_stream::Attribute>> const& decoded_attributes,
+        std::unordered_map<std::string, size_t> const& attribute_idx_map
+) -> bool {
+    // Checked before evaluating any predicate, so that whether a missing
+    // attribute raises doesn't depend on the predicate order.
+    validate_decoded_attribute_names(attribute_idx_map);
+    bool const sample_cost{0 == m_num_decoded_matches % cCostSamplingInterval};
+    ++m_num_decoded_matches;
+    if (0 == m_num_decoded_matches % cReorderInterval) {
+        reorder_predicates();
+    }
+    for (auto const predicate : m_predicate_order) {
+        auto& stats{m_predicate_stats[static_cast<size_t>(predicate)]};
+        bool matches{false};
+        if (sample_cost) {
+            auto const begin{std::chrono::steady_clock::now()};
+            matches = evaluate_decoded_predicate(
+                    predicate,
+                    ts,
+                    log_message,
+                    decoded_attributes,
+                    attribute_idx_map
+            );
+            auto const end{std::chrono::steady_clock::now()};
+            ++stats.m_num_sampled_evaluations;
+            stats.m_total_sampled_cost_ns += static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()
+            );
+        } else {
+            matches = evaluate_decoded_predicate(
+                    predicate,
+                    ts,
+                    log_message,
+                    decoded_attributes,
+                    attribute_idx_map
+            );
+        }
+        ++stats.m_num_evaluations;
+        if (false == matches) {
+            return false;
+        }
+        ++stats.m_num_matches;
+    }
+    return true;
+}
+
+auto Query::reset_predicate_stats() -> void {
+    m_predicate_order = cDefaultPredicateOrder;
+    m_predicate_stats = {};
+    m_num_decoded_matches = 0;
+}
+
+auto Query::evaluate_decoded_predicate(
+        Predicate predicate,
+        ffi::epoch_time_ms_t ts,
+        std::string_view log_message,
+        std::vector<std::optional<ffi::ir_stream::Attribute>> const& decoded_attributes,
+        std::unordered_map<std::string, size_t> const& attribute_idx_map
+) -> bool {
+    switch (predicate) {
+        case Predicate::TimeRange:
+            return matches_time_range(ts);
+        case Predicate::LogMessage:
+            return matches_log_message(log_message);
+        case Predicate::Attributes:
+            return matches_decoded_attributes(decoded_attributes, attribute_idx_map);
+        case Predicate::Expression:
+            return matches_decoded_expression(
+                    ts,
+                    log_message,
+                    decoded_attributes,
+                    attribute_idx_map
+            );
+    }
+    return true;
+}
+
+auto Query::reorder_predicates() -> void {
+    std::array<double, cNumPredicates> ranks{};
+    for (size_t i{0}; i < cNumPredicates; ++i) {
+        ranks.at(i) = get_predicate_rank(m_predicate_stats.at(i));
+    }
+    std::stable_sort(
+            m_predicate_order.begin(),
+            m_predicate_order.end(),
+            [&](Predicate lhs, Predicate rhs) {
+                return ranks.at(static_cast<size_t>(lhs)) < ranks.at(static_cast<size_t>(rhs));
+            }
+    );
+}
 }  // namespace clp_ffi_py::ir::native
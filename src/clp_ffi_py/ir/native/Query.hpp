@@ -1,6 +1,9 @@
 #ifndef CLP_FFI_PY_QUERY_HPP
 #define CLP_FFI_PY_QUERY_HPP
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <string>
 #include <string_view>
@@ -13,39 +16,21 @@
 
 #include <clp_ffi_py/ExceptionFFI.hpp>
 #include <clp_ffi_py/ir/native/LogEvent.hpp>
+#include <clp_ffi_py/ir/native/QueryExpression.hpp>
+#include <clp_ffi_py/ir/native/RegexQuery.hpp>
+#include <clp_ffi_py/ir/native/WildcardQuery.hpp>
 
 namespace clp_ffi_py::ir::native {
-/**
- * This class defines a wildcard query, which includes a wildcard string and a
- * boolean value to indicate if the match is case-sensitive.
- */
-class WildcardQuery {
-public:
-    /**
-     * Initializes the wildcard query.
-     * @param wildcard_query Wildcard query.
-     * @param case_sensitive Case sensitive indicator.
-     */
-    WildcardQuery(std::string wildcard_query, bool case_sensitive)
-            : m_wildcard_query(std::move(wildcard_query)),
-              m_case_sensitive(case_sensitive){};
-
-    [[nodiscard]] auto get_wildcard_query() const -> std::string const& { return m_wildcard_query; }
-
-    [[nodiscard]] auto is_case_sensitive() const -> bool { return m_case_sensitive; }
-
-private:
-    std::string m_wildcard_query;
-    bool m_case_sensitive;
-};
-
 /**
  * This class represents a search query, utilized for filtering log events in a
- * CLP IR stream. The query could include a list of wildcard queries aimed at
- * identifying certain log messages, and a timestamp range with a lower and
- * upper bound. This class provides an interface to set up a search query, as
- * well as methods to validate whether the query can be matched by a log event.
- * Note that an empty wildcard query list will match any log within the range.
+ * CLP IR stream. The query could include a list of wildcard queries and a list
+ * of regex queries aimed at identifying certain log messages, and a timestamp
+ * range with a lower and upper bound. This class provides an interface to set
+ * up a search query, as well as methods to validate whether the query can be
+ * matched by a log event. A log message matches if it matches any one of the
+ * wildcard or regex queries. Note that empty wildcard and regex query lists
+ * will match any log within the range. On top of these, an optional boolean
+ * query expression (see `QueryExpression`) must be matched as well.
  * <p>
  * NOTE: When searching an IR stream with a query, ideally, the search
  * would terminate once the current log event's timestamp exceeds the upper
@@ -55,6 +40,16 @@ private:
  * current timestamp in the IR stream exceeds the query's upper bound timestamp
  * by a reasonable margin. This margin can be specified by the user or it
  * will default to `cDefaultSearchTimeTerminationMargin`.
+ * <p>
+ * When matching decoded log events (see `matches_decoded`), the query's
+ * predicates (time range, log message, attributes, and expression) are
+ * evaluated in an adaptive order. The pass rate of each predicate is counted
+ * on every evaluation and its cost is sampled every
+ * `cCostSamplingInterval` evaluations. Every `cReorderInterval` log events,
+ * the predicates are reordered by ascending cost / (1 - pass rate), so that
+ * the cheapest and most selective predicates run first. Queries with a single
+ * kind of predicate on top of the time range are matched by specialized
+ * decoding loops instead, which don't collect statistics.
  */
 class Query {
 public:
@@ -65,6 +60,32 @@ public:
     static constexpr ffi::epoch_time_ms_t const cDefaultSearchTimeTerminationMargin{
             static_cast<ffi::epoch_time_ms_t>(60 * 1000)
     };
+    static constexpr uint64_t cReorderInterval{1024};
+    static constexpr uint64_t cCostSamplingInterval{16};
+
+    enum class Predicate : uint8_t {
+        TimeRange = 0,
+        LogMessage,
+        Attributes,
+        Expression
+    };
+    static constexpr size_t cNumPredicates{4};
+    static constexpr std::array<Predicate, cNumPredicates> cDefaultPredicateOrder{
+            Predicate::TimeRange,
+            Predicate::LogMessage,
+            Predicate::Attributes,
+            Predicate::Expression
+    };
+
+    /**
+     * Runtime statistics of a predicate observed by `matches_decoded`.
+     */
+    struct PredicateStats {
+        uint64_t m_num_evaluations{0};
+        uint64_t m_num_matches{0};
+        uint64_t m_num_sampled_evaluations{0};
+        uint64_t m_total_sampled_cost_ns{0};
+    };
 
     /**
      * Constructs an empty query object that will match all logs. The wildcard
@@ -108,6 +129,7 @@ public:
      * @param wildcard_queries A list of wildcard queries. Each wildcard query
      * must be valid (see `wildcard_match_unsafe`).
      * @param attribute_queries Query on log event's attributes.
+     * @param regex_queries A list of compiled regex queries.
      * @param search_time_termination_margin The margin used to determine the
      * search termination timestamp (see note in the class' docstring).
      */
@@ -115,6 +137,7 @@ public:
           ffi::epoch_time_ms_t search_time_upper_bound,
           std::vector<WildcardQuery> wildcard_queries,
           LogEvent::attribute_table_t attribute_queries,
+          std::vector<RegexQuery> regex_queries,
           ffi::epoch_time_ms_t search_time_termination_margin = cDefaultSearchTimeTerminationMargin)
             : m_lower_bound_ts{search_time_lower_bound},
               m_upper_bound_ts{search_time_upper_bound},
@@ -124,7 +147,8 @@ public:
                               : cTimestampMax
               },
               m_wildcard_queries{std::move(wildcard_queries)},
-              m_attribute_queries(std::move(attribute_queries)) {
+              m_attribute_queries(std::move(attribute_queries)),
+              m_regex_queries{std::move(regex_queries)} {
         throw_if_ts_range_invalid();
     }
 
@@ -132,6 +156,10 @@ public:
         m_attribute_queries = std::move(attribute_queries);
     }
 
+    auto set_expression(QueryExpression expression) -> void {
+        m_expression = std::move(expression);
+    }
+
     [[nodiscard]] auto get_lower_bound_ts() const -> ffi::epoch_time_ms_t {
         return m_lower_bound_ts;
     }
@@ -148,6 +176,12 @@ public:
         return m_attribute_queries;
     }
 
+    [[nodiscard]] auto get_regex_queries() const -> std::vector<RegexQuery> const& {
+        return m_regex_queries;
+    }
+
+    [[nodiscard]] auto get_expression() const -> QueryExpression const& { return m_expression; }
+
     /**
      * @return The search time termination margin by calculating the difference
      * between m_search_termination_ts and m_upper_bound_ts.
@@ -185,21 +219,31 @@ public:
     [[nodiscard]] auto matches_wildcard_queries(std::string_view log_message) const -> bool;
 
     /**
-     * @param attributes
+     * Validates whether the input log message matches any of the wildcard
+     * queries or any of the regex queries in the query.
+     * @param log_message Input log message.
+     * @return true if both the wildcard query list and the regex query list
+     * are empty, or at least one wildcard or regex query matches.
+     * @return false otherwise.
+     */
+    [[nodiscard]] auto matches_log_message(std::string_view log_message) const -> bool;
+
+    /**
+     * @param log_event
      * @return Whether the attributes associated with a log event matches the
      * underlying query.
      * @throw ExceptionFFI if the query contains attribute names that doesn't
      * belong to the log event.
      */
-    [[nodiscard]] auto matches_attributes(LogEvent::attribute_table_t const& attributes) const
-            -> bool;
+    [[nodiscard]] auto matches_attributes(LogEvent const& log_event) const -> bool;
 
     /**
      * Matches with the decoded attributes indexed by the provided index map.
      * For the performance concern, it is assumed that the decoded attributes
-     * have been already validated. It does not execute any bound check on the
-     * attribute indexing.
-     * @param attributes
+     * have been already validated: they must hold a value for every index in
+     * the map, which isn't bound-checked.
+     * @param decoded_attributes
+     * @param attribute_idx_map
      * @return Whether the decoded attributes (stored as a vector) matches the
      * underlying queries.
      * @throw ExceptionFFI if the query contains attribute names that doesn't
@@ -210,17 +254,98 @@ public:
             std::unordered_map<std::string, size_t> const& attribute_idx_map
     ) -> bool;
 
+    /**
+     * Evaluates the query expression against a log event.
+     * @param log_event
+     * @return true if the expression is empty or the log event matches it.
+     * @return false otherwise.
+     * @throw ExceptionFFI if the expression contains attribute names that
+     * doesn't belong to the log event.
+     */
+    [[nodiscard]] auto matches_expression(LogEvent const& log_event) const -> bool;
+
+    /**
+     * Evaluates the query expression against a decoded log event, whose
+     * attributes are indexed by the provided index map. The indices aren't
+     * bound-checked (see `matches_decoded_attributes`).
+     * @param ts
+     * @param log_message
+     * @param decoded_attributes
+     * @param attribute_idx_map
+     * @return true if the expression is empty or the log event matches it.
+     * @return false otherwise.
+     * @throw ExceptionFFI if the expression contains attribute names that
+     * doesn't belong to the log event.
+     */
+    [[nodiscard]] auto matches_decoded_expression(
+            ffi::epoch_time_ms_t ts,
+            std::string_view log_message,
+            std::vector<std::optional<ffi::ir_stream::Attribute>> const& decoded_attributes,
+            std::unordered_map<std::string, size_t> const& attribute_idx_map
+    ) const -> bool;
+
+    /**
+     * Checks that every attribute name used by the query's attribute queries
+     * and expression is in the given index map.
+     * @param attribute_idx_map
+     * @throw ExceptionFFI if the query contains attribute names that doesn't
+     * belong to the log event.
+     */
+    auto validate_decoded_attribute_names(
+            std::unordered_map<std::string, size_t> const& attribute_idx_map
+    ) const -> void;
+
+    /**
+     * Validates whether a decoded log event matches the query, evaluating the
+     * predicates in the adaptive order and updating their statistics. The
+     * attribute names are validated before any predicate is evaluated, so
+     * whether a missing attribute throws doesn't depend on the order. The
+     * indices aren't bound-checked (see `matches_decoded_attributes`).
+     * @param ts
+     * @param log_message
+     * @param decoded_attributes
+     * @param attribute_idx_map
+     * @return Whether the log event matches all the predicates of the query.
+     * @throw ExceptionFFI if the query contains attribute names that doesn't
+     * belong to the log event.
+     */
+    [[nodiscard]] auto matches_decoded(
+            ffi::epoch_time_ms_t ts,
+            std::string_view log_message,
+            std::vector<std::optional<ffi::ir_stream::Attribute>> const& decoded_attributes,
+            std::unordered_map<std::string, size_t> const& attribute_idx_map
+    ) -> bool;
+
+    /**
+     * @return The predicates in the order `matches_decoded` currently
+     * evaluates them.
+     */
+    [[nodiscard]] auto get_predicate_order() const -> std::array<Predicate, cNumPredicates> const& {
+        return m_predicate_order;
+    }
+
+    [[nodiscard]] auto get_predicate_stats(Predicate predicate) const -> PredicateStats const& {
+        return m_predicate_stats[static_cast<size_t>(predicate)];
+    }
+
+    /**
+     * Resets the predicate statistics and the predicate order.
+     */
+    auto reset_predicate_stats() -> void;
+
     /**
      * Validates whether the input log event matches the query.
      * @param log_event Input log event.
-     * @return true if the timestamp is in range, the wildcard list is empty
-     * or has at least one match, and all the attributes match.
+     * @return true if the timestamp is in range, the log message matches (see
+     * `matches_log_message`), all the attributes match, and the query
+     * expression matches.
      * @return false otherwise.
      */
     [[nodiscard]] auto matches(LogEvent const& log_event) const -> bool {
         return matches_time_range(log_event.get_timestamp())
-               && matches_wildcard_queries(log_event.get_log_message_view())
-               && matches_attributes(log_event.get_attributes());
+               && matches_log_message(log_event.get_log_message_view())
+               && matches_attributes(log_event)
+               && matches_expression(log_event);
     }
 
 private:
@@ -238,11 +363,41 @@ private:
         }
     }
 
+    /**
+     * Evaluates a single predicate against a decoded log event.
+     * @param predicate
+     * @param ts
+     * @param log_message
+     * @param decoded_attributes
+     * @param attribute_idx_map
+     * @return Whether the log event matches the predicate.
+     * @throw ExceptionFFI if the query contains attribute names that doesn't
+     * belong to the log event.
+     */
+    [[nodiscard]] auto evaluate_decoded_predicate(
+            Predicate predicate,
+            ffi::epoch_time_ms_t ts,
+            std::string_view log_message,
+            std::vector<std::optional<ffi::ir_stream::Attribute>> const& decoded_attributes,
+            std::unordered_map<std::string, size_t> const& attribute_idx_map
+    ) -> bool;
+
+    /**
+     * Reorders the predicates by their observed cost and pass rate.
+     */
+    auto reorder_predicates() -> void;
+
     ffi::epoch_time_ms_t m_lower_bound_ts;
     ffi::epoch_time_ms_t m_upper_bound_ts;
     ffi::epoch_time_ms_t m_search_termination_ts;
     std::vector<WildcardQuery> m_wildcard_queries;
     LogEvent::attribute_table_t m_attribute_queries;
+    std::vector<RegexQuery> m_regex_queries;
+    QueryExpression m_expression;
+
+    std::array<Predicate, cNumPredicates> m_predicate_order{cDefaultPredicateOrder};
+    std::array<PredicateStats, cNumPredicates> m_predicate_stats{};
+    uint64_t m_num_decoded_matches{0};
 };
 }  // namespace clp_ffi_py::ir::native
 #endif
@@ -0,0 +1,129 @@
+#include "QueryExpression.hpp"
+
+#include <string>
+#include <vector>
+
+#include <clp/components/core/src/ErrorCode.hpp>
+
+#include <clp_ffi_py/ExceptionFFI.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+/**
+ * Throws an exception for a malformed expression tree.
+ * @param message
+ */
+[[noreturn]] auto throw_invalid_expression(std::string const& message) -> void {
+    throw ExceptionFFI(
+            ErrorCode_BadParam,
+            __FILE__,
+            __LINE__,
+            "Invalid query expression: " + message
+    );
+}
+
+/**
+ * Collects the operands of an And (Or) node. The operands of nested And (Or)
+ * children are collected in place of the children, in order. An explicit stack
+ * is used so that arbitrarily long chains of nested nodes can't overflow the
+ * call stack.
+ * @param node
+ * @param operands Returns the collected operands.
+ */
+auto collect_operands(
+        QueryExpression::Node const& node,
+        std::vector<QueryExpression::Node const*>& operands
+) -> void {
+    std::vector<QueryExpression::Node const*> pending;
+    for (auto it{node.m_children.crbegin()}; it != node.m_children.crend(); ++it) {
+        pending.push_back(&*it);
+    }
+    while (false == pending.empty()) {
+        auto const* child{pending.back()};
+        pending.pop_back();
+        if (child->m_type == node.m_type && false == child->m_children.empty()) {
+            for (auto it{child->m_children.crbegin()}; it != child->m_children.crend(); ++it) {
+                pending.push_back(&*it);
+            }
+            continue;
+        }
+        operands.push_back(child);
+    }
+}
+}  // namespace
+
+auto QueryExpression::compile(Node const& root) -> void {
+    m_program.clear();
+    compile_node(root, 0);
+}
+
+auto QueryExpression::compile_node(Node const& node, size_t depth) -> void {
+    if (depth > cMaxDepth) {
+        throw_invalid_expression("the expression is nested too deeply");
+    }
+    switch (node.m_type) {
+        case NodeType::Predicate: {
+            size_t num_predicates{0};
+            switch (node.m_predicate_type) {
+                case PredicateType::Wildcard:
+                    num_predicates = m_wildcard_queries.size();
+                    break;
+                case PredicateType::Regex:
+                    num_predicates = m_regex_queries.size();
+                    break;
+                case PredicateType::Attribute:
+                    num_predicates = m_attribute_predicates.size();
+                    break;
+                case PredicateType::TimeRange:
+                    num_predicates = m_time_ranges.size();
+                    break;
+            }
+            if (node.m_predicate_idx >= num_predicates) {
+                throw_invalid_expression("unknown predicate");
+            }
+            m_program.push_back({OpCode::Evaluate, node.m_predicate_type, node.m_predicate_idx});
+            break;
+        }
+        case NodeType::Not: {
+            if (1 != node.m_children.size()) {
+                throw_invalid_expression("NOT must have exactly one operand");
+            }
+            auto const& child{node.m_children.front()};
+            if (NodeType::Not == child.m_type && 1 == child.m_children.size()) {
+                compile_node(child.m_children.front(), depth + 2);
+                break;
+            }
+            compile_node(child, depth + 1);
+            m_program.push_back({OpCode::Negate, PredicateType::Wildcard, 0});
+            break;
+        }
+        case NodeType::And:
+        case NodeType::Or: {
+            if (node.m_children.empty()) {
+                throw_invalid_expression("AND/OR must have at least one operand");
+            }
+            std::vector<Node const*> operands;
+            collect_operands(node, operands);
+            auto const jump_op{
+                    NodeType::And == node.m_type ? OpCode::JumpIfFalse : OpCode::JumpIfTrue
+            };
+            std::vector<size_t> jumps_to_patch;
+            jumps_to_patch.reserve(operands.size());
+            for (size_t i{0}; i < operands.size(); ++i) {
+                compile_node(*operands[i], depth + 1);
+                if (i + 1 < operands.size()) {
+                    jumps_to_patch.push_back(m_program.size());
+                    m_program.push_back({jump_op, PredicateType::Wildcard, 0});
+                }
+            }
+            auto const end_pc{m_program.size()};
+            for (auto const jump_pc : jumps_to_patch) {
+                m_program[jump_pc].m_operand = end_pc;
+            }
+            break;
+        }
+        default:
+            throw_invalid_expression("unknown node type");
+    }
+}
+}  // namespace clp_ffi_py::ir::native
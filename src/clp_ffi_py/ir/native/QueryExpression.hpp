@@ -0,0 +1,236 @@
+#ifndef CLP_FFI_PY_QUERY_EXPRESSION_HPP
+#define CLP_FFI_PY_QUERY_EXPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
+#include <clp/components/core/src/string_utils.hpp>
+
+#include <clp_ffi_py/ir/native/AttributePredicate.hpp>
+#include <clp_ffi_py/ir/native/RegexQuery.hpp>
+#include <clp_ffi_py/ir/native/WildcardQuery.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class represents a boolean expression of AND, OR and NOT over
+ * predicates on a log event: wildcard queries and regex queries on the log
+ * message, typed attribute predicates (see `AttributePredicate`), and
+ * timestamp ranges.
+ * <p>
+ * The expression is built as a tree of `Node`s and then compiled into a flat
+ * program. Each instruction either evaluates a predicate into a single result
+ * register, negates the register, or conditionally jumps forward. An AND jumps
+ * to its end as soon as one operand evaluates to false, and an OR as soon as
+ * one operand evaluates to true, so the remaining predicates are never
+ * evaluated. An empty expression matches every log event.
+ */
+class QueryExpression {
+public:
+    static constexpr size_t cMaxDepth{256};
+
+    enum class NodeType : uint8_t {
+        And,
+        Or,
+        Not,
+        Predicate
+    };
+
+    enum class PredicateType : uint8_t {
+        Wildcard,
+        Regex,
+        Attribute,
+        TimeRange
+    };
+
+    /**
+     * A node of the expression tree. And/Or nodes have one or more children,
+     * a Not node has exactly one child, and a Predicate node refers to a
+     * predicate added to the expression (see `add_*` methods).
+     */
+    struct Node {
+        NodeType m_type{NodeType::Predicate};
+        std::vector<Node> m_children{};
+        PredicateType m_predicate_type{PredicateType::Wildcard};
+        size_t m_predicate_idx{0};
+    };
+
+    /**
+     * Adds a wildcard query as a predicate of the expression.
+     * @param wildcard_query A valid wildcard query (see `wildcard_match_unsafe`).
+     * @return A leaf node that refers to the predicate.
+     */
+    [[nodiscard]] auto add_wildcard_query(WildcardQuery wildcard_query) -> Node {
+        m_wildcard_queries.emplace_back(std::move(wildcard_query));
+        return {NodeType::Predicate, {}, PredicateType::Wildcard, m_wildcard_queries.size() - 1};
+    }
+
+    /**
+     * Adds a compiled regex query as a predicate of the expression.
+     * @param regex_query
+     * @return A leaf node that refers to the predicate.
+     */
+    [[nodiscard]] auto add_regex_query(RegexQuery regex_query) -> Node {
+        m_regex_queries.emplace_back(std::move(regex_query));
+        return {NodeType::Predicate, {}, PredicateType::Regex, m_regex_queries.size() - 1};
+    }
+
+    /**
+     * Adds an attribute predicate as a predicate of the expression.
+     * @param attribute_predicate
+     * @return A leaf node that refers to the predicate.
+     */
+    [[nodiscard]] auto add_attribute_predicate(AttributePredicate attribute_predicate) -> Node {
+        m_attribute_predicates.emplace_back(std::move(attribute_predicate));
+        return {NodeType::Predicate,
+                {},
+                PredicateType::Attribute,
+                m_attribute_predicates.size() - 1};
+    }
+
+    /**
+     * Adds a timestamp range as a predicate of the expression.
+     * @param lower_bound_ts Start of the time range (inclusive).
+     * @param upper_bound_ts End of the time range (inclusive).
+     * @return A leaf node that refers to the predicate.
+     */
+    [[nodiscard]] auto
+    add_time_range(ffi::epoch_time_ms_t lower_bound_ts, ffi::epoch_time_ms_t upper_bound_ts)
+            -> Node {
+        m_time_ranges.emplace_back(lower_bound_ts, upper_bound_ts);
+        return {NodeType::Predicate, {}, PredicateType::TimeRange, m_time_ranges.size() - 1};
+    }
+
+    /**
+     * Compiles the expression tree into the program evaluated by `evaluate`.
+     * Nested And (Or) nodes are flattened into their And (Or) parent and a
+     * double negation is removed.
+     * @param root Root of the expression tree. All the predicates it refers to
+     * must have been added to this expression.
+     * @throw ExceptionFFI if the tree is malformed or too deep.
+     */
+    auto compile(Node const& root) -> void;
+
+    /**
+     * @return Whether the expression is empty, in which case it matches every
+     * log event.
+     */
+    [[nodiscard]] auto empty() const -> bool { return m_program.empty(); }
+
+    [[nodiscard]] auto get_program_size() const -> size_t { return m_program.size(); }
+
+    [[nodiscard]] auto get_attribute_predicates() const -> std::vector<AttributePredicate> const& {
+        return m_attribute_predicates;
+    }
+
+    /**
+     * Evaluates the expression against a log event.
+     * @tparam AttributeLookup Callable that takes an attribute name and returns
+     * a const reference to the log event's `std::optional<Attribute>` of that
+     * name.
+     * @param ts The log event's timestamp.
+     * @param log_message The log event's message.
+     * @param lookup_attribute
+     * @return Whether the log event matches the expression.
+     * @throw Any exception thrown by `lookup_attribute`.
+     */
+    template <typename AttributeLookup>
+    [[nodiscard]] auto evaluate(
+            ffi::epoch_time_ms_t ts,
+            std::string_view log_message,
+            AttributeLookup const& lookup_attribute
+    ) const -> bool;
+
+private:
+    enum class OpCode : uint8_t {
+        Evaluate,
+        JumpIfFalse,
+        JumpIfTrue,
+        Negate
+    };
+
+    struct Instruction {
+        OpCode m_op;
+        PredicateType m_predicate_type;
+        // Predicate index for `Evaluate`, jump target for the jumps
+        size_t m_operand;
+    };
+
+    /**
+     * Emits the instructions of the given node.
+     * @param node
+     * @param depth
+     * @throw ExceptionFFI if the node is malformed or too deep.
+     */
+    auto compile_node(Node const& node, size_t depth) -> void;
+
+    std::vector<Instruction> m_program;
+    std::vector<WildcardQuery> m_wildcard_queries;
+    std::vector<RegexQuery> m_regex_queries;
+    std::vector<AttributePredicate> m_attribute_predicates;
+    std::vector<std::pair<ffi::epoch_time_ms_t, ffi::epoch_time_ms_t>> m_time_ranges;
+};
+
+template <typename AttributeLookup>
+auto QueryExpression::evaluate(
+        ffi::epoch_time_ms_t ts,
+        std::string_view log_message,
+        AttributeLookup const& lookup_attribute
+) const -> bool {
+    bool result{true};
+    size_t pc{0};
+    auto const program_size{m_program.size()};
+    while (pc < program_size) {
+        auto const& instruction{m_program[pc]};
+        switch (instruction.m_op) {
+            case OpCode::Evaluate:
+                switch (instruction.m_predicate_type) {
+                    case PredicateType::Wildcard: {
+                        auto const& wildcard_query{m_wildcard_queries[instruction.m_operand]};
+                        result = wildcard_match_unsafe(
+                                log_message,
+                                wildcard_query.get_wildcard_query(),
+                                wildcard_query.is_case_sensitive()
+                        );
+                        break;
+                    }
+                    case PredicateType::Regex:
+                        result = m_regex_queries[instruction.m_operand].matches(log_message);
+                        break;
+                    case PredicateType::Attribute: {
+                        auto const& predicate{m_attribute_predicates[instruction.m_operand]};
+                        result = predicate.matches(lookup_attribute(predicate.get_name()));
+                        break;
+                    }
+                    case PredicateType::TimeRange: {
+                        auto const& [lower_bound_ts, upper_bound_ts]{
+                                m_time_ranges[instruction.m_operand]
+                        };
+                        result = lower_bound_ts <= ts && ts <= upper_bound_ts;
+                        break;
+                    }
+                }
+                ++pc;
+                break;
+            case OpCode::JumpIfFalse:
+                pc = result ? pc + 1 : instruction.m_operand;
+                break;
+            case OpCode::JumpIfTrue:
+                pc = result ? instruction.m_operand : pc + 1;
+                break;
+            case OpCode::Negate:
+                result = false == result;
+                ++pc;
+                break;
+        }
+    }
+    return result;
+}
+}  // namespace clp_ffi_py::ir::native
+#endif
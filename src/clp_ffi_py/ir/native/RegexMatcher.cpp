@@ -0,0 +1,806 @@
+#include "RegexMatcher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <memory>
+#include <optional>
+
+#include <clp/components/core/src/ErrorCode.hpp>
+
+#include <clp_ffi_py/ExceptionFFI.hpp>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+/**
+ * The types of the nodes in a parsed regular expression.
+ */
+enum class NodeType : uint8_t {
+    Empty,
+    Literal,
+    CharClass,
+    Concat,
+    Alternate,
+    Repeat,
+    AssertBegin,
+    AssertEnd
+};
+
+/**
+ * A node of the syntax tree of a parsed regular expression.
+ */
+struct Node {
+    explicit Node(NodeType type) : m_type{type} {}
+
+    NodeType m_type;
+    uint8_t m_char{0};
+    // The class only holds ASCII bytes. If `m_matches_non_ascii` is set, the
+    // node also matches any UTF-8 encoded non-ASCII code point.
+    size_t m_char_class_idx{0};
+    bool m_matches_non_ascii{false};
+    size_t m_min{0};
+    std::optional<size_t> m_max;
+    std::vector<std::unique_ptr<Node>> m_children;
+};
+
+/**
+ * @param message
+ * @throw ExceptionFFI with the given message, prefixed by the common
+ * description of regex compilation errors.
+ */
+[[noreturn]] auto throw_invalid_regex(std::string const& message) -> void {
+    throw ExceptionFFI(ErrorCode_BadParam, __FILE__, __LINE__, "Invalid regex: " + message);
+}
+
+/**
+ * @param c
+ * @return The value of the hexadecimal digit `c`, or std::nullopt if `c` is not
+ * a hexadecimal digit.
+ */
+auto parse_hex_digit(char c) -> std::optional<uint8_t> {
+    if ('0' <= c && c <= '9') {
+        return static_cast<uint8_t>(c - '0');
+    }
+    if ('a' <= c && c <= 'f') {
+        return static_cast<uint8_t>(c - 'a' + 10);
+    }
+    if ('A' <= c && c <= 'F') {
+        return static_cast<uint8_t>(c - 'A' + 10);
+    }
+    return std::nullopt;
+}
+
+constexpr uint8_t cMaxAsciiChar{0x7F};
+}  // namespace
+
+/**
+ * Parses a regular expression into a syntax tree and emits the NFA program of
+ * the tree into a RegexMatcher.
+ */
+class RegexCompiler {
+public:
+    RegexCompiler(std::string_view pattern, RegexMatcher& matcher)
+            : m_pattern{pattern},
+              m_matcher{matcher} {}
+
+    /**
+     * Compiles the pattern into the matcher.
+     * @throw ExceptionFFI if the pattern is invalid or too large.
+     */
+    auto compile() -> void {
+        auto const non_ascii_pos{std::find_if(m_pattern.begin(), m_pattern.end(), [](char c) {
+            return static_cast<uint8_t>(c) > cMaxAsciiChar;
+        })};
+        if (m_pattern.end() != non_ascii_pos) {
+            throw_invalid_regex(
+                    "non-ASCII characters are not supported at position "
+                    + std::to_string(non_ascii_pos - m_pattern.begin())
+            );
+        }
+        auto root{parse_alternation()};
+        if (m_pos != m_pattern.size()) {
+            throw_invalid_regex("unbalanced parenthesis at position " + std::to_string(m_pos));
+        }
+        emit(*root);
+        append({RegexMatcher::OpCode::Match, 0, 0, 0});
+        m_matcher.m_required_literal = find_required_literal(*root, m_matcher.m_is_literal);
+        m_matcher.m_anchored_begin = starts_with_begin_assertion(*root);
+    }
+
+private:
+    using OpCode = RegexMatcher::OpCode;
+    using Instruction = RegexMatcher::Instruction;
+
+    [[nodiscard]] auto at_end() const -> bool { return m_pos >= m_pattern.size(); }
+
+    [[nodiscard]] auto peek() const -> char { return m_pattern[m_pos]; }
+
+    auto parse_alternation() -> std::unique_ptr<Node> {
+        auto first{parse_concat()};
+        if (at_end() || '|' != peek()) {
+            return first;
+        }
+        auto alternate{std::make_unique<Node>(NodeType::Alternate)};
+        alternate->m_children.emplace_back(std::move(first));
+        while (false == at_end() && '|' == peek()) {
+            ++m_pos;
+            alternate->m_children.emplace_back(parse_concat());
+        }
+        return alternate;
+    }
+
+    auto parse_concat() -> std::unique_ptr<Node> {
+        auto concat{std::make_unique<Node>(NodeType::Concat)};
+        while (false == at_end() && '|' != peek() && ')' != peek()) {
+            concat->m_children.emplace_back(parse_repeat());
+        }
+        if (concat->m_children.empty()) {
+            return std::make_unique<Node>(NodeType::Empty);
+        }
+        if (1 == concat->m_children.size()) {
+            return std::move(concat->m_children.front());
+        }
+        return concat;
+    }
+
+    auto parse_repeat() -> std::unique_ptr<Node> {
+        // As in Python, a group can be repeated even if it's empty or only
+        // holds an anchor, but a bare anchor can't.
+        auto const is_group{'(' == peek()};
+        auto atom{parse_atom()};
+        bool is_repeated{false};
+        while (false == at_end()) {
+            size_t min{0};
+            std::optional<size_t> max;
+            auto const quantifier_pos{m_pos};
+            auto const c{peek()};
+            if ('*' == c) {
+                ++m_pos;
+            } else if ('+' == c) {
+                min = 1;
+                ++m_pos;
+            } else if ('?' == c) {
+                max = 1;
+                ++m_pos;
+            } else if ('{' != c || false == try_parse_counted_repeat(min, max)) {
+                break;
+            }
+            if (is_repeated) {
+                throw_invalid_regex(
+                        "multiple repeat at position " + std::to_string(quantifier_pos)
+                );
+            }
+            if (false == is_group
+                && (NodeType::AssertBegin == atom->m_type || NodeType::AssertEnd == atom->m_type))
+            {
+                throw_invalid_regex(
+                        "nothing to repeat at position " + std::to_string(quantifier_pos)
+                );
+            }
+            // Lazy quantifiers accept the same inputs as greedy ones
+            if (false == at_end() && '?' == peek()) {
+                ++m_pos;
+            }
+            auto repeat{std::make_unique<Node>(NodeType::Repeat)};
+            repeat->m_min = min;
+            repeat->m_max = max;
+            repeat->m_children.emplace_back(std::move(atom));
+            atom = std::move(repeat);
+            is_repeated = true;
+        }
+        return atom;
+    }
+
+    /**
+     * Tries to parse `{m}`, `{m,}` or `{m,n}` at the current position. As in
+     * Python, a `{` that doesn't start a valid counted repeat is treated as a
+     * literal.
+     * @param min Returns the minimum repeat count.
+     * @param max Returns the maximum repeat count, or std::nullopt if unbounded.
+     * @return Whether a counted repeat was parsed.
+     */
+    auto try_parse_counted_repeat(size_t& min, std::optional<size_t>& max) -> bool {
+        auto const close_pos{m_pattern.find('}', m_pos)};
+        if (std::string_view::npos == close_pos) {
+            return false;
+        }
+        auto const body{m_pattern.substr(m_pos + 1, close_pos - m_pos - 1)};
+        auto const comma_pos{body.find(',')};
+        auto parse_count = [](std::string_view digits, size_t& count) -> bool {
+            if (digits.empty()
+                || false == std::all_of(digits.begin(), digits.end(), [](char c) {
+                       return 0 != std::isdigit(static_cast<unsigned char>(c));
+                   }))
+            {
+                return false;
+            }
+            count = 0;
+            for (auto const c : digits) {
+                count = count * 10 + static_cast<size_t>(c - '0');
+                if (count > RegexMatcher::cMaxRepeatCount) {
+                    throw_invalid_regex("repeat count exceeds the supported maximum");
+                }
+            }
+            return true;
+        };
+        if (std::string_view::npos == comma_pos) {
+            size_t count{0};
+            if (false == parse_count(body, count)) {
+                return false;
+            }
+            min = count;
+            max = count;
+        } else {
+            auto const min_digits{body.substr(0, comma_pos)};
+            auto const max_digits{body.substr(comma_pos + 1)};
+            if (min_digits.empty()) {
+                min = 0;
+            } else if (false == parse_count(min_digits, min)) {
+                return false;
+            }
+            if (max_digits.empty()) {
+                max = std::nullopt;
+            } else {
+                size_t max_count{0};
+                if (false == parse_count(max_digits, max_count)) {
+                    return false;
+                }
+                if (max_count < min) {
+                    throw_invalid_regex("min repeat greater than max repeat");
+                }
+                max = max_count;
+            }
+        }
+        m_pos = close_pos + 1;
+        return true;
+    }
+
+    auto parse_atom() -> std::unique_ptr<Node> {
+        auto const c{peek()};
+        ++m_pos;
+        switch (c) {
+            case '(': {
+                if (m_pattern.substr(m_pos, 2) == "?:") {
+                    m_pos += 2;
+                } else if (false == at_end() && '?' == peek()) {
+                    throw_invalid_regex(
+                            "unsupported group extension at position " + std::to_string(m_pos)
+                    );
+                }
+                auto group{parse_alternation()};
+                if (at_end() || ')' != peek()) {
+                    throw_invalid_regex("missing ), unterminated subpattern");
+                }
+                ++m_pos;
+                return group;
+            }
+            case '[':
+                return parse_char_class();
+            case '.': {
+                RegexMatcher::char_class_t char_class;
+                char_class.set();
+                char_class.reset('\n');
+                return make_char_class(char_class);
+            }
+            case '^':
+                return std::make_unique<Node>(NodeType::AssertBegin);
+            case '$':
+                return std::make_unique<Node>(NodeType::AssertEnd);
+            case '*':
+            case '+':
+            case '?':
+                throw_invalid_regex("nothing to repeat at position " + std::to_string(m_pos - 1));
+            case '\\': {
+                RegexMatcher::char_class_t char_class;
+                uint8_t literal{0};
+                if (parse_escape(char_class, literal)) {
+                    return make_char_class(char_class);
+                }
+                return make_literal(literal);
+            }
+            default:
+                return make_literal(static_cast<uint8_t>(c));
+        }
+    }
+
+    /**
+     * Parses an escape sequence. The leading `\` must have been consumed.
+     * @param char_class Returns the class of the escape if it's a class escape.
+     * @param literal Returns the escaped byte if it's a literal escape.
+     * @return Whether the escape is a class escape.
+     */
+    auto parse_escape(RegexMatcher::char_class_t& char_class, uint8_t& literal) -> bool {
+        if (at_end()) {
+            throw_invalid_regex("bad escape (end of pattern)");
+        }
+        auto const c{peek()};
+        ++m_pos;
+        auto set_matching = [&](auto predicate, bool negate) {
+            char_class.reset();
+            for (size_t i{0}; i < char_class.size(); ++i) {
+                char_class[i] = negate != static_cast<bool>(predicate(static_cast<int>(i)));
+            }
+        };
+        auto is_word = [](int i) { return 0 != std::isalnum(i) || '_' == i; };
+        auto is_space = [](int i) {
+            return ' ' == i || '\t' == i || '\n' == i || '\r' == i || '\f' == i || '\v' == i;
+        };
+        auto is_digit = [](int i) { return '0' <= i && i <= '9'; };
+        switch (c) {
+            case 'd':
+                set_matching(is_digit, false);
+                return true;
+            case 'D':
+                set_matching(is_digit, true);
+                return true;
+            case 'w':
+                set_matching(is_word, false);
+                return true;
+            case 'W':
+                set_matching(is_word, true);
+                return true;
+            case 's':
+                set_matching(is_space, false);
+                return true;
+            case 'S':
+                set_matching(is_space, true);
+                return true;
+            case 'n':
+                literal = '\n';
+                return false;
+            case 'r':
+                literal = '\r';
+                return false;
+            case 't':
+                literal = '\t';
+                return false;
+            case 'f':
+                literal = '\f';
+                return false;
+            case 'v':
+                literal = '\v';
+                return false;
+            case 'x': {
+                if (m_pos + 2 > m_pattern.size()) {
+                    throw_invalid_regex("incomplete escape \\x");
+                }
+                auto const high{parse_hex_digit(m_pattern[m_pos])};
+                auto const low{parse_hex_digit(m_pattern[m_pos + 1])};
+                if (false == high.has_value() || false == low.has_value()) {
+                    throw_invalid_regex("incomplete escape \\x");
+                }
+                literal = static_cast<uint8_t>((high.value() << 4U) | low.value());
+                if (literal > cMaxAsciiChar) {
+                    throw_invalid_regex(
+                            "non-ASCII characters are not supported at position "
+                            + std::to_string(m_pos - 2)
+                    );
+                }
+                m_pos += 2;
+                return false;
+            }
+            default:
+                if (0 != std::isalnum(static_cast<unsigned char>(c))) {
+                    throw_invalid_regex(std::string{"bad escape \\"} + c);
+                }
+                literal = static_cast<uint8_t>(c);
+                return false;
+        }
+    }
+
+    /**
+     * Parses a character class. The leading `[` must have been consumed.
+     */
+    auto parse_char_class() -> std::unique_ptr<Node> {
+        RegexMatcher::char_class_t char_class;
+        bool negate{false};
+        if (false == at_end() && '^' == peek()) {
+            negate = true;
+            ++m_pos;
+        }
+        bool first{true};
+        while (true) {
+            if (at_end()) {
+                throw_invalid_regex("unterminated character set");
+            }
+            auto c{peek()};
+            if (']' == c && false == first) {
+                ++m_pos;
+                break;
+            }
+            first = false;
+            ++m_pos;
+            uint8_t range_begin{static_cast<uint8_t>(c)};
+            if ('\\' == c) {
+                RegexMatcher::char_class_t escaped_class;
+                if (parse_escape(escaped_class, range_begin)) {
+                    // As in Python, a class escape can't start a range
+                    if (m_pos + 1 < m_pattern.size() && '-' == peek()
+                        && ']' != m_pattern[m_pos + 1])
+                    {
+                        throw_invalid_regex("bad character range");
+                    }
+                    char_class |= escaped_class;
+                    continue;
+                }
+            }
+            // A `-` at the end of the class is a literal
+            if (m_pos + 1 < m_pattern.size() && '-' == peek() && ']' != m_pattern[m_pos + 1]) {
+                ++m_pos;
+                c = peek();
+                ++m_pos;
+                uint8_t range_end{static_cast<uint8_t>(c)};
+                if ('\\' == c) {
+                    RegexMatcher::char_class_t escaped_class;
+                    if (parse_escape(escaped_class, range_end)) {
+                        throw_invalid_regex("bad character range");
+                    }
+                }
+                if (range_end < range_begin) {
+                    throw_invalid_regex("bad character range");
+                }
+                for (size_t i{range_begin}; i <= range_end; ++i) {
+                    char_class.set(i);
+                }
+                continue;
+            }
+            char_class.set(range_begin);
+        }
+        return make_char_class(char_class, negate);
+    }
+
+    auto make_literal(uint8_t c) -> std::unique_ptr<Node> {
+        auto node{std::make_unique<Node>(NodeType::Literal)};
+        node->m_char = m_matcher.m_fold_table[c];
+        return node;
+    }
+
+    auto make_char_class(RegexMatcher::char_class_t const& char_class, bool negate = false)
+            -> std::unique_ptr<Node> {
+        auto folded_class{char_class};
+        if (false == m_matcher.m_case_sensitive) {
+            // Input bytes are folded to lowercase before being tested against
+            // the class, so the class must contain the folded form of every
+            // byte it contains. A negated class is negated after folding, the
+            // same as Python's `re`.
+            for (size_t i{0}; i < char_class.size(); ++i) {
+                if (char_class[i]) {
+                    folded_class.set(m_matcher.m_fold_table[i]);
+                }
+            }
+        }
+        if (negate) {
+            folded_class.flip();
+        }
+        // Since patterns are ASCII, a class either contains all the non-ASCII
+        // bytes (e.g., `.`, `\D` or `[^a]`) or none of them. The former match
+        // a whole non-ASCII code point instead of one of its bytes (see
+        // `emit_non_ascii_code_point`).
+        auto node{std::make_unique<Node>(NodeType::CharClass)};
+        node->m_matches_non_ascii = folded_class[cMaxAsciiChar + 1];
+        for (size_t i{cMaxAsciiChar + 1}; i < folded_class.size(); ++i) {
+            folded_class.reset(i);
+        }
+        node->m_char_class_idx = add_char_class(folded_class);
+        return node;
+    }
+
+    auto add_char_class(RegexMatcher::char_class_t const& char_class) -> size_t {
+        m_matcher.m_char_classes.emplace_back(char_class);
+        return m_matcher.m_char_classes.size() - 1;
+    }
+
+    /**
+     * @param first
+     * @param last
+     * @return The index of a class holding the bytes in [first, last].
+     */
+    auto add_byte_range_class(uint8_t first, uint8_t last) -> size_t {
+        RegexMatcher::char_class_t char_class;
+        for (size_t i{first}; i <= last; ++i) {
+            char_class.set(i);
+        }
+        return add_char_class(char_class);
+    }
+
+    auto append(Instruction const& instruction) -> size_t {
+        if (m_matcher.m_program.size() >= RegexMatcher::cMaxProgramSize) {
+            throw_invalid_regex("pattern is too large to compile");
+        }
+        m_matcher.m_program.emplace_back(instruction);
+        return m_matcher.m_program.size() - 1;
+    }
+
+    [[nodiscard]] auto next_pc() const -> size_t { return m_matcher.m_program.size(); }
+
+    auto instruction_at(size_t pc) -> Instruction& { return m_matcher.m_program[pc]; }
+
+    auto emit(Node const& node) -> void {
+        switch (node.m_type) {
+            case NodeType::Empty:
+                break;
+            case NodeType::Literal:
+                append({OpCode::Char, node.m_char, 0, 0});
+                break;
+            case NodeType::CharClass:
+                if (false == node.m_matches_non_ascii) {
+                    append({OpCode::CharClass, 0, node.m_char_class_idx, 0});
+                    break;
+                }
+                // split L1, L2; L1: class; jump L_end; L2: non-ASCII; L_end:
+                {
+                    auto const split{append({OpCode::Split, 0, 0, 0})};
+                    instruction_at(split).m_x = next_pc();
+                    append({OpCode::CharClass, 0, node.m_char_class_idx, 0});
+                    auto const jump{append({OpCode::Jump, 0, 0, 0})};
+                    instruction_at(split).m_y = next_pc();
+                    emit_non_ascii_code_point();
+                    instruction_at(jump).m_x = next_pc();
+                }
+                break;
+            case NodeType::AssertBegin:
+                append({OpCode::AssertBegin, 0, 0, 0});
+                break;
+            case NodeType::AssertEnd:
+                append({OpCode::AssertEnd, 0, 0, 0});
+                break;
+            case NodeType::Concat:
+                for (auto const& child : node.m_children) {
+                    emit(*child);
+                }
+                break;
+            case NodeType::Alternate: {
+                std::vector<size_t> jumps_to_end;
+                for (size_t i{0}; i + 1 < node.m_children.size(); ++i) {
+                    auto const split{append({OpCode::Split, 0, 0, 0})};
+                    instruction_at(split).m_x = next_pc();
+                    emit(*node.m_children[i]);
+                    jumps_to_end.emplace_back(append({OpCode::Jump, 0, 0, 0}));
+                    instruction_at(split).m_y = next_pc();
+                }
+                emit(*node.m_children.back());
+                for (auto const jump : jumps_to_end) {
+                    instruction_at(jump).m_x = next_pc();
+                }
+                break;
+            }
+            case NodeType::Repeat:
+                emit_repeat(*node.m_children.front(), node.m_min, node.m_max);
+                break;
+        }
+    }
+
+    /**
+     * Emits a program matching any UTF-8 encoded non-ASCII code point, which
+     * is a lead byte followed by 1 to 3 continuation bytes.
+     */
+    auto emit_non_ascii_code_point() -> void {
+        if (false == m_utf8_class_indices.has_value()) {
+            m_utf8_class_indices = std::array<size_t, 4>{
+                    add_byte_range_class(0x80, 0xBF),
+                    add_byte_range_class(0xC2, 0xDF),
+                    add_byte_range_class(0xE0, 0xEF),
+                    add_byte_range_class(0xF0, 0xF4)
+            };
+        }
+        auto const& class_indices{m_utf8_class_indices.value()};
+        auto const continuation_class_idx{class_indices[0]};
+        std::vector<size_t> jumps_to_end;
+        for (size_t num_continuation_bytes{1}; num_continuation_bytes <= 3;
+             ++num_continuation_bytes)
+        {
+            std::optional<size_t> split;
+            if (num_continuation_bytes < 3) {
+                split = append({OpCode::Split, 0, 0, 0});
+                instruction_at(split.value()).m_x = next_pc();
+            }
+            append({OpCode::CharClass, 0, class_indices[num_continuation_bytes], 0});
+            for (size_t i{0}; i < num_continuation_bytes; ++i) {
+                append({OpCode::CharClass, 0, continuation_class_idx, 0});
+            }
+            if (split.has_value()) {
+                jumps_to_end.emplace_back(append({OpCode::Jump, 0, 0, 0}));
+                instruction_at(split.value()).m_y = next_pc();
+            }
+        }
+        for (auto const jump : jumps_to_end) {
+            instruction_at(jump).m_x = next_pc();
+        }
+    }
+
+    auto emit_repeat(Node const& child, size_t min, std::optional<size_t> max) -> void {
+        for (size_t i{0}; i < min; ++i) {
+            emit(child);
+        }
+        if (false == max.has_value()) {
+            // L0: split L1, L2; L1: child; jump L0; L2:
+            auto const split{append({OpCode::Split, 0, 0, 0})};
+            instruction_at(split).m_x = next_pc();
+            emit(child);
+            append({OpCode::Jump, 0, split, 0});
+            instruction_at(split).m_y = next_pc();
+            return;
+        }
+        // Each optional repetition: split L1, L_end; L1: child
+        std::vector<size_t> splits;
+        for (size_t i{min}; i < max.value(); ++i) {
+            auto const split{append({OpCode::Split, 0, 0, 0})};
+            instruction_at(split).m_x = next_pc();
+            splits.emplace_back(split);
+            emit(child);
+        }
+        for (auto const split : splits) {
+            instruction_at(split).m_y = next_pc();
+        }
+    }
+
+    /**
+     * Finds the longest run of consecutive literals in the top-level
+     * concatenation, which every match must contain.
+     * @param root
+     * @param is_literal Returns whether the whole pattern is a literal string.
+     * @return The required literal, or an empty string if there's none.
+     */
+    static auto find_required_literal(Node const& root, bool& is_literal) -> std::string {
+        is_literal = false;
+        if (NodeType::Literal == root.m_type) {
+            is_literal = true;
+            return std::string(1, static_cast<char>(root.m_char));
+        }
+        if (NodeType::Concat != root.m_type) {
+            return {};
+        }
+        std::string longest;
+        std::string current;
+        for (auto const& child : root.m_children) {
+            if (NodeType::Literal == child->m_type) {
+                current += static_cast<char>(child->m_char);
+                continue;
+            }
+            if (current.size() > longest.size()) {
+                longest = current;
+            }
+            current.clear();
+        }
+        if (current.size() > longest.size()) {
+            longest = current;
+        }
+        is_literal = (longest.size() == root.m_children.size());
+        return longest;
+    }
+
+    static auto starts_with_begin_assertion(Node const& root) -> bool {
+        if (NodeType::AssertBegin == root.m_type) {
+            return true;
+        }
+        return NodeType::Concat == root.m_type
+               && NodeType::AssertBegin == root.m_children.front()->m_type;
+    }
+
+    std::string_view m_pattern;
+    size_t m_pos{0};
+    RegexMatcher& m_matcher;
+    // The classes of UTF-8 continuation bytes, and of the lead bytes of 2, 3
+    // and 4-byte sequences, added by the first `emit_non_ascii_code_point`.
+    std::optional<std::array<size_t, 4>> m_utf8_class_indices;
+};
+
+RegexMatcher::RegexMatcher(std::string_view pattern, bool case_sensitive)
+        : m_case_sensitive{case_sensitive} {
+    for (size_t i{0}; i < m_fold_table.size(); ++i) {
+        auto c{static_cast<uint8_t>(i)};
+        if (false == case_sensitive && 'A' <= c && c <= 'Z') {
+            c = static_cast<uint8_t>(c - 'A' + 'a');
+        }
+        m_fold_table[i] = c;
+    }
+    RegexCompiler compiler{pattern, *this};
+    compiler.compile();
+    m_visited.resize(m_program.size(), 0);
+    m_curr_threads.reserve(m_program.size());
+    m_next_threads.reserve(m_program.size());
+}
+
+auto RegexMatcher::contains_required_literal(std::string_view str) const -> bool {
+    if (m_case_sensitive) {
+        return std::string_view::npos != str.find(m_required_literal);
+    }
+    return str.end()
+           != std::search(
+                   str.begin(),
+                   str.end(),
+                   m_required_literal.begin(),
+                   m_required_literal.end(),
+                   [&](char lhs, char rhs) { return fold(lhs) == static_cast<uint8_t>(rhs); }
+           );
+}
+
+auto RegexMatcher::add_thread(
+        std::vector<size_t>& thread_list,
+        size_t pc,
+        size_t pos,
+        std::string_view str
+) const -> bool {
+    m_stack.clear();
+    m_stack.emplace_back(pc);
+    while (false == m_stack.empty()) {
+        auto const curr_pc{m_stack.back()};
+        m_stack.pop_back();
+        if (m_visit_generation == m_visited[curr_pc]) {
+            continue;
+        }
+        m_visited[curr_pc] = m_visit_generation;
+        auto const& instruction{m_program[curr_pc]};
+        switch (instruction.m_op) {
+            case OpCode::Jump:
+                m_stack.emplace_back(instruction.m_x);
+                break;
+            case OpCode::Split:
+                m_stack.emplace_back(instruction.m_y);
+                m_stack.emplace_back(instruction.m_x);
+                break;
+            case OpCode::AssertBegin:
+                if (0 == pos) {
+                    m_stack.emplace_back(curr_pc + 1);
+                }
+                break;
+            case OpCode::AssertEnd:
+                if (str.size() == pos || (str.size() == pos + 1 && '\n' == str[pos])) {
+                    m_stack.emplace_back(curr_pc + 1);
+                }
+                break;
+            case OpCode::Match:
+                return true;
+            default:
+                thread_list.emplace_back(curr_pc);
+                break;
+        }
+    }
+    return false;
+}
+
+auto RegexMatcher::matches(std::string_view str) const -> bool {
+    if (false == m_required_literal.empty() && false == contains_required_literal(str)) {
+        return false;
+    }
+    if (m_is_literal) {
+        return true;
+    }
+
+    m_curr_threads.clear();
+    ++m_visit_generation;
+    if (add_thread(m_curr_threads, 0, 0, str)) {
+        return true;
+    }
+    for (size_t pos{0}; pos < str.size(); ++pos) {
+        if (m_anchored_begin && m_curr_threads.empty()) {
+            return false;
+        }
+        auto const c{fold(str[pos])};
+        m_next_threads.clear();
+        ++m_visit_generation;
+        for (auto const pc : m_curr_threads) {
+            auto const& instruction{m_program[pc]};
+            bool consumed{false};
+            switch (instruction.m_op) {
+                case OpCode::Char:
+                    consumed = (instruction.m_char == c);
+                    break;
+                case OpCode::CharClass:
+                    consumed = m_char_classes[instruction.m_x][c];
+                    break;
+                default:
+                    break;
+            }
+            if (consumed && add_thread(m_next_threads, pc + 1, pos + 1, str)) {
+                return true;
+            }
+        }
+        if (false == m_anchored_begin && add_thread(m_next_threads, 0, pos + 1, str)) {
+            return true;
+        }
+        std::swap(m_curr_threads, m_next_threads);
+    }
+    return false;
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,137 @@
+#ifndef CLP_FFI_PY_REGEX_MATCHER_HPP
+#define CLP_FFI_PY_REGEX_MATCHER_HPP
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class represents a regular expression compiled into a Thompson NFA. The
+ * NFA is simulated in lockstep (Pike VM without capture groups), so the match
+ * runs in O(n * m) time for an input of n bytes and a program of m
+ * instructions, with no backtracking.
+ *
+ * Matching follows the semantics of Python's `re.search` with the `re.ASCII`
+ * flag: a match can start at any position of the input. `^` only matches at
+ * the start of the input and `$` only matches at the end of the input or before
+ * a trailing newline.
+ *
+ * The input is matched as UTF-8: `.`, negated classes and `\D`, `\W`, `\S`
+ * match a whole non-ASCII code point, the same as `re` matches a character of
+ * a `str`. As with `re.ASCII`, `\d`, `\w`, `\s` and case-insensitive matching
+ * only apply to ASCII characters. Patterns must only contain ASCII characters,
+ * and bytes that aren't valid UTF-8 never match.
+ *
+ * The following syntax is supported:
+ * - Literals, and escaped literals (`\.`, `\*`, `\\`, ...).
+ * - `.`, which matches any character except `\n`.
+ * - Character classes (`[abc]`, `[^a-z0-9_]`), and the escapes `\d`, `\D`,
+ *   `\w`, `\W`, `\s`, `\S` both inside and outside of a class.
+ * - The escapes `\n`, `\r`, `\t`, `\f`, `\v`, and `\xHH`.
+ * - Groups (`(...)` and `(?:...)`), and alternation (`|`).
+ * - Quantifiers `*`, `+`, `?`, `{m}`, `{m,}`, `{m,n}`, and their lazy forms,
+ *   which are equivalent to the greedy ones for a boolean match.
+ * - Anchors `^` and `$`.
+ *
+ * Before running the NFA, the input is checked for the longest literal string
+ * that every match must contain. Inputs without this literal are rejected
+ * without running the NFA at all.
+ *
+ * NOTE: The matcher reuses internal scratch buffers across calls, so a single
+ * instance must not be used by multiple threads concurrently.
+ */
+class RegexMatcher {
+public:
+    static constexpr size_t cMaxProgramSize{65'536};
+    static constexpr size_t cMaxRepeatCount{1000};
+
+    /**
+     * Compiles the given regular expression.
+     * @param pattern
+     * @param case_sensitive
+     * @throw ExceptionFFI if the pattern is invalid or too large to compile.
+     */
+    RegexMatcher(std::string_view pattern, bool case_sensitive);
+
+    /**
+     * @param str
+     * @return Whether any substring of `str` matches the compiled regular
+     * expression.
+     */
+    [[nodiscard]] auto matches(std::string_view str) const -> bool;
+
+    /**
+     * @return The literal string that every match must contain. The string is
+     * lowercase if the matcher is case-insensitive.
+     */
+    [[nodiscard]] auto get_required_literal() const -> std::string const& {
+        return m_required_literal;
+    }
+
+    [[nodiscard]] auto get_program_size() const -> size_t { return m_program.size(); }
+
+private:
+    enum class OpCode : uint8_t {
+        Char,
+        CharClass,
+        Split,
+        Jump,
+        AssertBegin,
+        AssertEnd,
+        Match
+    };
+
+    struct Instruction {
+        OpCode m_op;
+        uint8_t m_char;
+        size_t m_x;
+        size_t m_y;
+    };
+
+    using char_class_t = std::bitset<256>;
+
+    friend class RegexCompiler;
+
+    /**
+     * @param str
+     * @return Whether `str` contains `m_required_literal`.
+     */
+    [[nodiscard]] auto contains_required_literal(std::string_view str) const -> bool;
+
+    /**
+     * Adds the thread starting at `pc` to `thread_list`, following all the
+     * epsilon transitions.
+     * @param thread_list
+     * @param pc
+     * @param pos Current position in the input.
+     * @param str Input string.
+     * @return Whether the `Match` instruction is reachable.
+     */
+    auto add_thread(std::vector<size_t>& thread_list, size_t pc, size_t pos, std::string_view str)
+            const -> bool;
+
+    [[nodiscard]] auto fold(char c) const -> uint8_t {
+        return m_fold_table[static_cast<uint8_t>(c)];
+    }
+
+    bool m_case_sensitive;
+    bool m_anchored_begin{false};
+    bool m_is_literal{false};
+    std::vector<Instruction> m_program;
+    std::vector<char_class_t> m_char_classes;
+    std::string m_required_literal;
+    std::array<uint8_t, 256> m_fold_table{};
+
+    // Scratch buffers reused across `matches` calls
+    mutable std::vector<size_t> m_visited;
+    mutable size_t m_visit_generation{0};
+    mutable std::vector<size_t> m_stack;
+    mutable std::vector<size_t> m_curr_threads;
+    mutable std::vector<size_t> m_next_threads;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_REGEX_MATCHER_HPP
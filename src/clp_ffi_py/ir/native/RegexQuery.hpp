@@ -0,0 +1,46 @@
+#ifndef CLP_FFI_PY_REGEX_QUERY_HPP
+#define CLP_FFI_PY_REGEX_QUERY_HPP
+
+#include <string>
+#include <string_view>
+
+#include <clp_ffi_py/ir/native/RegexMatcher.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class defines a regex query, which includes a regular expression and a
+ * boolean value to indicate if the match is case-sensitive. The regular
+ * expression is compiled once on construction (see `RegexMatcher`).
+ */
+class RegexQuery {
+public:
+    /**
+     * Initializes and compiles the regex query.
+     * @param regex_query Regular expression.
+     * @param case_sensitive Case sensitive indicator.
+     * @throw ExceptionFFI if the regular expression is invalid.
+     */
+    RegexQuery(std::string regex_query, bool case_sensitive)
+            : m_regex_query(std::move(regex_query)),
+              m_case_sensitive(case_sensitive),
+              m_matcher{m_regex_query, case_sensitive} {};
+
+    [[nodiscard]] auto get_regex_query() const -> std::string const& { return m_regex_query; }
+
+    [[nodiscard]] auto is_case_sensitive() const -> bool { return m_case_sensitive; }
+
+    /**
+     * @param log_message
+     * @return Whether any substring of the log message matches the regex.
+     */
+    [[nodiscard]] auto matches(std::string_view log_message) const -> bool {
+        return m_matcher.matches(log_message);
+    }
+
+private:
+    std::string m_regex_query;
+    bool m_case_sensitive;
+    RegexMatcher m_matcher;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif
@@ -0,0 +1,295 @@
+#include "TimestampFormatter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+namespace clp_ffi_py::ir::native {
+namespace {
+constexpr int64_t cNumSecondsInDay{86'400};
+constexpr int64_t cNumMillisecondsInSecond{1000};
+constexpr int64_t cMinYear{1};
+constexpr int64_t cMaxYear{9999};
+
+/**
+ * The directories searched by `dateutil.tz.gettz`, in order.
+ */
+constexpr std::array<char const*, 4> cTzDatabasePaths{
+        "/usr/share/zoneinfo",
+        "/usr/lib/zoneinfo",
+        "/usr/share/lib/zoneinfo",
+        "/etc/zoneinfo"
+};
+
+/**
+ * A calendar date and time of day.
+ */
+struct CivilTime {
+    int64_t year;
+    int64_t month;
+    int64_t day;
+    int64_t hour;
+    int64_t minute;
+    int64_t second;
+};
+
+/**
+ * Reads a big-endian 32-bit signed integer.
+ * @param data Must contain at least 4 bytes.
+ * @return The integer.
+ */
+auto read_int32(std::string_view data) -> int32_t {
+    uint32_t value{0};
+    for (size_t i{0}; i < sizeof(value); ++i) {
+        value = (value << 8U) | static_cast<uint8_t>(data[i]);
+    }
+    return static_cast<int32_t>(value);
+}
+
+/**
+ * Converts seconds since the Unix epoch into the calendar date and time, using
+ * the algorithm from http://howardhinnant.github.io/date_algorithms.html.
+ * @param time
+ * @return The calendar date and time.
+ */
+auto get_civil_time(int64_t time) -> CivilTime {
+    // Floor division, so that negative times fall into the previous day.
+    auto days{time / cNumSecondsInDay};
+    auto seconds_in_day{time % cNumSecondsInDay};
+    if (seconds_in_day < 0) {
+        seconds_in_day += cNumSecondsInDay;
+        --days;
+    }
+
+    days += 719'468;
+    auto const era{(days >= 0 ? days : days - 146'096) / 146'097};
+    auto const day_of_era{days - era * 146'097};
+    auto const year_of_era{
+            (day_of_era - day_of_era / 1460 + day_of_era / 36'524 - day_of_era / 146'096) / 365
+    };
+    auto const day_of_year{day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100)};
+    auto const shifted_month{(5 * day_of_year + 2) / 153};
+    auto const month{shifted_month < 10 ? shifted_month + 3 : shifted_month - 9};
+    return {year_of_era + era * 400 + (month <= 2 ? 1 : 0),
+            month,
+            day_of_year - (153 * shifted_month + 2) / 5 + 1,
+            seconds_in_day / 3600,
+            seconds_in_day / 60 % 60,
+            seconds_in_day % 60};
+}
+
+/**
+ * Splits the given timestamp into seconds and milliseconds the same way as
+ * `clp_ffi_py.utils.get_formatted_timestamp`: `datetime.fromtimestamp` rounds
+ * the fraction of the floating-point seconds `timestamp / 1000` half to even to
+ * microseconds, which are then truncated to milliseconds by `isoformat`. Far
+ * from the epoch, the floating-point seconds can't represent every millisecond
+ * exactly, so this can differ from the exact integer split.
+ * @param timestamp Milliseconds since the Unix epoch, within +/-2^53.
+ * @return A pair of the seconds since the Unix epoch and the milliseconds.
+ */
+auto split_timestamp(ffi::epoch_time_ms_t timestamp) -> std::pair<int64_t, int64_t> {
+    constexpr double cNumMicrosecondsInSecond{1'000'000};
+    double seconds{0};
+    // `std::nearbyint` rounds half to even in the default rounding mode.
+    auto microseconds{std::nearbyint(
+            std::modf(static_cast<double>(timestamp) / cNumMillisecondsInSecond, &seconds)
+            * cNumMicrosecondsInSecond
+    )};
+    if (microseconds >= cNumMicrosecondsInSecond) {
+        microseconds -= cNumMicrosecondsInSecond;
+        seconds += 1;
+    } else if (microseconds < 0) {
+        microseconds += cNumMicrosecondsInSecond;
+        seconds -= 1;
+    }
+    return {static_cast<int64_t>(seconds),
+            static_cast<int64_t>(microseconds) / cNumMillisecondsInSecond};
+}
+
+/**
+ * Writes the given value into the buffer as zero-padded decimal digits.
+ * @param value A non-negative value with at most `num_digits` digits.
+ * @param buffer
+ * @param num_digits
+ */
+auto write_digits(int64_t value, char* buffer, size_t num_digits) -> void {
+    for (auto i{num_digits}; i > 0; --i) {
+        buffer[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+}  // namespace
+
+auto TimezoneTransitions::load(std::string_view timezone_id)
+        -> std::optional<TimezoneTransitions> {
+    if (false == timezone_id.empty() && ':' == timezone_id.front()) {
+        timezone_id.remove_prefix(1);
+    }
+    // Empty and absolute IDs aren't resolved from the tz database by
+    // `dateutil.tz.gettz`, so they're left to the Python implementation.
+    if (timezone_id.empty() || '/' == timezone_id.front()) {
+        return std::nullopt;
+    }
+
+    std::string timezone_id_with_underscores{timezone_id};
+    std::replace(
+            timezone_id_with_underscores.begin(),
+            timezone_id_with_underscores.end(),
+            ' ',
+            '_'
+    );
+    for (auto const* tz_database_path : cTzDatabasePaths) {
+        std::filesystem::path tzif_path{tz_database_path};
+        tzif_path /= std::string{timezone_id};
+        std::error_code error_code;
+        if (false == std::filesystem::is_regular_file(tzif_path, error_code)) {
+            tzif_path = std::filesystem::path{tz_database_path} / timezone_id_with_underscores;
+            if (false == std::filesystem::is_regular_file(tzif_path, error_code)) {
+                continue;
+            }
+        }
+
+        std::ifstream tzif_file{tzif_path, std::ios::binary};
+        std::string const tzif{
+                std::istreambuf_iterator<char>{tzif_file},
+                std::istreambuf_iterator<char>{}
+        };
+        if (auto transitions{parse(tzif)}; transitions.has_value()) {
+            return transitions;
+        }
+    }
+    return std::nullopt;
+}
+
+auto TimezoneTransitions::parse(std::string_view tzif) -> std::optional<TimezoneTransitions> {
+    constexpr std::string_view cMagic{"TZif"};
+    constexpr size_t cCountsPos{20};
+    constexpr size_t cHeaderSize{44};
+    constexpr size_t cTimeTypeSize{6};
+    if (tzif.size() < cHeaderSize || cMagic != tzif.substr(0, cMagic.size())) {
+        return std::nullopt;
+    }
+
+    std::array<int32_t, 6> counts{};
+    for (size_t i{0}; i < counts.size(); ++i) {
+        counts[i] = read_int32(tzif.substr(cCountsPos + i * sizeof(int32_t)));
+        if (counts[i] < 0) {
+            return std::nullopt;
+        }
+    }
+    auto const num_transitions{static_cast<size_t>(counts[3])};
+    auto const num_time_types{static_cast<size_t>(counts[4])};
+    if (0 == num_time_types) {
+        return std::nullopt;
+    }
+    auto const transition_times_pos{cHeaderSize};
+    auto const transition_types_pos{transition_times_pos + num_transitions * sizeof(int32_t)};
+    auto const time_types_pos{transition_types_pos + num_transitions};
+    if (tzif.size() < time_types_pos + num_time_types * cTimeTypeSize) {
+        return std::nullopt;
+    }
+
+    std::vector<int32_t> utc_offsets;
+    std::vector<bool> is_dst;
+    for (size_t i{0}; i < num_time_types; ++i) {
+        auto const time_type{tzif.substr(time_types_pos + i * cTimeTypeSize)};
+        utc_offsets.push_back(read_int32(time_type));
+        is_dst.push_back(0 != time_type[sizeof(int32_t)]);
+    }
+
+    TimezoneTransitions transitions;
+    transitions.m_transition_times.reserve(num_transitions);
+    transitions.m_transition_utc_offsets.reserve(num_transitions);
+    std::vector<size_t> transition_types;
+    for (size_t i{0}; i < num_transitions; ++i) {
+        auto const type{static_cast<uint8_t>(tzif[transition_types_pos + i])};
+        if (type >= num_time_types) {
+            return std::nullopt;
+        }
+        transition_types.push_back(type);
+        transitions.m_transition_times.push_back(
+                read_int32(tzif.substr(transition_times_pos + i * sizeof(int32_t)))
+        );
+        transitions.m_transition_utc_offsets.push_back(utc_offsets[type]);
+    }
+
+    // The offsets before and after the transitions are chosen the same way as
+    // `dateutil.tz.tzfile`.
+    auto const first_std_type{std::find(is_dst.cbegin(), is_dst.cend(), false)};
+    transitions.m_utc_offset_before_transitions
+            = utc_offsets[is_dst.cend() == first_std_type ? 0 : first_std_type - is_dst.cbegin()];
+    if (transition_types.empty()) {
+        transitions.m_utc_offset_after_transitions = utc_offsets[0];
+    } else {
+        auto const last_std_type{std::find_if(
+                transition_types.crbegin(),
+                transition_types.crend(),
+                [&](size_t type) { return false == is_dst[type]; }
+        )};
+        transitions.m_utc_offset_after_transitions = utc_offsets
+                [transition_types.crend() == last_std_type ? transition_types.back()
+                                                           : *last_std_type];
+    }
+    return transitions;
+}
+
+auto TimezoneTransitions::get_utc_offset(int64_t utc_time) const -> int32_t {
+    auto const next_transition{std::upper_bound(
+            m_transition_times.cbegin(),
+            m_transition_times.cend(),
+            utc_time
+    )};
+    if (m_transition_times.cbegin() == next_transition) {
+        return m_transition_times.empty() ? m_utc_offset_after_transitions
+                                          : m_utc_offset_before_transitions;
+    }
+    if (m_transition_times.cend() == next_transition) {
+        return m_utc_offset_after_transitions;
+    }
+    return m_transition_utc_offsets[next_transition - m_transition_times.cbegin() - 1];
+}
+
+auto TimestampFormatter::format(ffi::epoch_time_ms_t timestamp)
+        -> std::optional<std::string_view> {
+    // Timestamps far beyond the supported years are rejected before the
+    // conversion so that it can't overflow.
+    constexpr int64_t cMaxAbsTimestamp{4'000'000 * cNumSecondsInDay * cNumMillisecondsInSecond};
+    if (timestamp > cMaxAbsTimestamp || timestamp < -cMaxAbsTimestamp) {
+        return std::nullopt;
+    }
+    auto const [utc_time, milliseconds]{split_timestamp(timestamp)};
+
+    if (false == m_cached_utc_time.has_value() || utc_time != m_cached_utc_time.value()) {
+        auto const utc_year{get_civil_time(utc_time).year};
+        auto const local_time{get_civil_time(utc_time + m_transitions.get_utc_offset(utc_time))};
+        if (utc_year < cMinYear || utc_year > cMaxYear || local_time.year < cMinYear
+            || local_time.year > cMaxYear)
+        {
+            return std::nullopt;
+        }
+
+        auto* buffer{m_formatted_timestamp.data()};
+        write_digits(local_time.year, buffer, 4);
+        buffer[4] = '-';
+        write_digits(local_time.month, buffer + 5, 2);
+        buffer[7] = '-';
+        write_digits(local_time.day, buffer + 8, 2);
+        buffer[10] = ' ';
+        write_digits(local_time.hour, buffer + 11, 2);
+        buffer[13] = ':';
+        write_digits(local_time.minute, buffer + 14, 2);
+        buffer[16] = ':';
+        write_digits(local_time.second, buffer + 17, 2);
+        buffer[19] = '.';
+        m_cached_utc_time = utc_time;
+    }
+
+    write_digits(milliseconds, m_formatted_timestamp.data() + 20, 3);
+    return std::string_view{m_formatted_timestamp.data(), m_formatted_timestamp.size()};
+}
+}  // namespace clp_ffi_py::ir::native
@@ -0,0 +1,93 @@
+#ifndef CLP_FFI_PY_TIMESTAMP_FORMATTER_HPP
+#define CLP_FFI_PY_TIMESTAMP_FORMATTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class represents the UTC offset transitions of a timezone, loaded once
+ * from the timezone's TZif file in the system tz database. The transitions are
+ * interpreted the same way as `dateutil.tz.tzfile`, which is the tzinfo
+ * returned by `clp_ffi_py.utils.get_timezone_from_timezone_id`, so that the
+ * UTC offsets always match the ones used by the Python timestamp formatting:
+ * - Only the version 1 data block of the file is read.
+ * - Before the first transition, the first non-DST local time type applies.
+ * - From the last transition on, the last non-DST local time type applies.
+ */
+class TimezoneTransitions {
+public:
+    /**
+     * Loads the transitions of the given timezone from the system tz database,
+     * searching the same directories as `dateutil.tz.gettz`.
+     * @param timezone_id
+     * @return The loaded transitions, or std::nullopt if the timezone isn't a
+     * relative path to a valid TZif file in the tz database.
+     */
+    [[nodiscard]] static auto load(std::string_view timezone_id)
+            -> std::optional<TimezoneTransitions>;
+
+    /**
+     * Parses the content of a TZif file.
+     * @param tzif
+     * @return The parsed transitions, or std::nullopt if the content is
+     * invalid.
+     */
+    [[nodiscard]] static auto parse(std::string_view tzif) -> std::optional<TimezoneTransitions>;
+
+    /**
+     * @return The transitions of UTC, which has no transitions.
+     */
+    [[nodiscard]] static auto create_utc() -> TimezoneTransitions { return {}; }
+
+    /**
+     * @param utc_time Seconds since the Unix epoch.
+     * @return The UTC offset, in seconds, in effect at the given time.
+     */
+    [[nodiscard]] auto get_utc_offset(int64_t utc_time) const -> int32_t;
+
+private:
+    TimezoneTransitions() = default;
+
+    std::vector<int64_t> m_transition_times;
+    std::vector<int32_t> m_transition_utc_offsets;
+    int32_t m_utc_offset_before_transitions{0};
+    int32_t m_utc_offset_after_transitions{0};
+};
+
+/**
+ * This class formats timestamps in the local time of a timezone, the same way
+ * as `clp_ffi_py.utils.get_formatted_timestamp`: "YYYY-MM-DD HH:MM:SS.mmm".
+ * The date and time of the last formatted second are cached, so consecutive
+ * timestamps within the same second only reformat the milliseconds.
+ */
+class TimestampFormatter {
+public:
+    static constexpr size_t cFormattedTimestampSize{23};
+
+    explicit TimestampFormatter(TimezoneTransitions transitions)
+            : m_transitions{std::move(transitions)} {}
+
+    /**
+     * Formats the given timestamp.
+     * @param timestamp Milliseconds since the Unix epoch.
+     * @return A view of the formatted timestamp, valid until the next call.
+     * @return std::nullopt if either the UTC or the local time is outside the
+     * range of years from 1 to 9999, which Python's datetime can't represent.
+     */
+    [[nodiscard]] auto format(ffi::epoch_time_ms_t timestamp) -> std::optional<std::string_view>;
+
+private:
+    TimezoneTransitions m_transitions;
+    std::optional<int64_t> m_cached_utc_time;
+    std::array<char, cFormattedTimestampSize> m_formatted_timestamp{};
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_TIMESTAMP_FORMATTER_HPP
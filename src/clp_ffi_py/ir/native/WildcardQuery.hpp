@@ -0,0 +1,31 @@
+#ifndef CLP_FFI_PY_WILDCARD_QUERY_HPP
+#define CLP_FFI_PY_WILDCARD_QUERY_HPP
+
+#include <string>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class defines a wildcard query, which includes a wildcard string and a
+ * boolean value to indicate if the match is case-sensitive.
+ */
+class WildcardQuery {
+public:
+    /**
+     * Initializes the wildcard query.
+     * @param wildcard_query Wildcard query.
+     * @param case_sensitive Case sensitive indicator.
+     */
+    WildcardQuery(std::string wildcard_query, bool case_sensitive)
+            : m_wildcard_query(std::move(wildcard_query)),
+              m_case_sensitive(case_sensitive){};
+
+    [[nodiscard]] auto get_wildcard_query() const -> std::string const& { return m_wildcard_query; }
+
+    [[nodiscard]] auto is_case_sensitive() const -> bool { return m_case_sensitive; }
+
+private:
+    std::string m_wildcard_query;
+    bool m_case_sensitive;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif
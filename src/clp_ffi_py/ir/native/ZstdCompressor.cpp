@@ -0,0 +1,75 @@
+#include "ZstdCompressor.hpp"
+
+#include <cstddef>
+#include <string>
+
+#include <clp_ffi_py/ExceptionFFI.hpp>
+
+namespace clp_ffi_py::ir::native {
+ZstdCompressor::ZstdCompressor(int compression_level) : m_context{ZSTD_createCCtx()} {
+    if (nullptr == m_context) {
+        throw ExceptionFFI(
+                ErrorCode_NoMem,
+                __FILE__,
+                __LINE__,
+                "Failed to create the zstd compression context."
+        );
+    }
+    if (compression_level < ZSTD_minCLevel() || compression_level > ZSTD_maxCLevel()) {
+        ZSTD_freeCCtx(m_context);
+        throw ExceptionFFI(
+                ErrorCode_BadParam,
+                __FILE__,
+                __LINE__,
+                "Unsupported zstd compression level: " + std::to_string(compression_level)
+        );
+    }
+    if (auto const result{
+                ZSTD_CCtx_setParameter(m_context, ZSTD_c_compressionLevel, compression_level)
+        };
+        static_cast<bool>(ZSTD_isError(result)))
+    {
+        ZSTD_freeCCtx(m_context);
+        throw ExceptionFFI(ErrorCode_Failure, __FILE__, __LINE__, ZSTD_getErrorName(result));
+    }
+}
+
+ZstdCompressor::~ZstdCompressor() {
+    ZSTD_freeCCtx(m_context);
+}
+
+auto ZstdCompressor::compress(
+        std::string_view input,
+        ZSTD_EndDirective directive,
+        std::string& output
+) -> void {
+    ZSTD_inBuffer input_buffer{input.data(), input.size(), 0};
+    auto const output_chunk_size{ZSTD_CStreamOutSize()};
+    while (true) {
+        auto const output_size{output.size()};
+        output.resize(output_size + output_chunk_size);
+        ZSTD_outBuffer output_buffer{output.data() + output_size, output_chunk_size, 0};
+        auto const num_bytes_remaining{
+                ZSTD_compressStream2(m_context, &output_buffer, &input_buffer, directive)
+        };
+        output.resize(output_size + output_buffer.pos);
+        if (static_cast<bool>(ZSTD_isError(num_bytes_remaining))) {
+            throw ExceptionFFI(
+                    ErrorCode_Failure,
+                    __FILE__,
+                    __LINE__,
+                    ZSTD_getErrorName(num_bytes_remaining)
+            );
+        }
+        // With `ZSTD_e_continue`, the call returns once all the input is
+        // consumed. Otherwise, it's done once zstd has nothing left to flush.
+        bool const is_done{
+                ZSTD_e_continue == directive ? input_buffer.pos == input_buffer.size
+                                             : 0 == num_bytes_remaining
+        };
+        if (is_done) {
+            return;
+        }
+    }
+}
+}  // namespace clp_ffi_py::ir::native
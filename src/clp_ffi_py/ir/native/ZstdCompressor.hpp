@@ -0,0 +1,51 @@
+#ifndef CLP_FFI_PY_ZSTD_COMPRESSOR_HPP
+#define CLP_FFI_PY_ZSTD_COMPRESSOR_HPP
+
+#include <string>
+#include <string_view>
+
+#include <zstd.h>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * This class compresses a stream of bytes into a single zstd frame, which can
+ * be decompressed by `zstandard.ZstdDecompressor` (or any zstd decoder). The
+ * compressed bytes are appended to a caller-owned output buffer, so the caller
+ * decides when to write them out.
+ */
+class ZstdCompressor {
+public:
+    /**
+     * @param compression_level
+     * @throw ExceptionFFI if the compression context can't be created, or the
+     * compression level is out of zstd's supported range.
+     */
+    explicit ZstdCompressor(int compression_level);
+
+    ~ZstdCompressor();
+
+    // Delete copy/move constructors and assignments
+    ZstdCompressor(ZstdCompressor const&) = delete;
+    ZstdCompressor(ZstdCompressor&&) = delete;
+    auto operator=(ZstdCompressor const&) -> ZstdCompressor& = delete;
+    auto operator=(ZstdCompressor&&) -> ZstdCompressor& = delete;
+
+    /**
+     * Compresses the given bytes and appends the compressed bytes to `output`.
+     * @param input
+     * @param directive Either:
+     * - `ZSTD_e_continue`: zstd may keep some of the input buffered.
+     * - `ZSTD_e_flush`: all the input received so far is compressed into
+     *   `output`, so it can be decompressed without ending the frame.
+     * - `ZSTD_e_end`: the frame is ended. Any further input starts a new frame.
+     * @param output
+     * @throw ExceptionFFI if zstd fails to compress.
+     */
+    auto compress(std::string_view input, ZSTD_EndDirective directive, std::string& output)
+            -> void;
+
+private:
+    ZSTD_CCtx* m_context;
+};
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_ZSTD_COMPRESSOR_HPP
@@ -2,6 +2,17 @@
 
 #include "decoding_methods.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <clp/components/core/src/BufferReader.hpp>
 #include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
 #include <clp/components/core/src/ffi/ir_stream/decoding_methods.hpp>
@@ -11,11 +22,14 @@
 #include <json/single_include/nlohmann/json.hpp>
 
 #include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/AttributeEncoder.hpp>
 #include <clp_ffi_py/ir/native/error_messages.hpp>
+#include <clp_ffi_py/ir/native/LogEventExporter.hpp>
 #include <clp_ffi_py/ir/native/PyDecoderBuffer.hpp>
 #include <clp_ffi_py/ir/native/PyLogEvent.hpp>
 #include <clp_ffi_py/ir/native/PyMetadata.hpp>
 #include <clp_ffi_py/ir/native/PyQuery.hpp>
+#include <clp_ffi_py/PyFastcallArgParser.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 #include <clp_ffi_py/utils.hpp>
@@ -23,41 +37,142 @@
 namespace clp_ffi_py::ir::native {
 namespace {
 /**
- * Decodes the next log event from the CLP IR buffer `decoder_buffer`. If
- * `py_query` is non-null decode until finding a log event that matches the
- * query.
+ * The shapes of the search query that the decoding loop is specialized for.
+ * - None: No query is given.
+ * - TimeRange: The query only specifies a search time range.
+ * - LogMessage: The query specifies a search time range, and wildcard and/or
+ *   regex queries on the log message.
+ * - Attributes: The query specifies a search time range and attribute queries.
+ * - General: Any other query. The predicates are evaluated in the adaptive
+ *   order (see `Query::matches_decoded`).
+ */
+enum class QueryShape : uint8_t {
+    None,
+    TimeRange,
+    LogMessage,
+    Attributes,
+    General
+};
+
+/**
+ * @param query
+ * @return The most specialized shape of the given query.
+ */
+auto get_query_shape(Query const& query) -> QueryShape {
+    if (false == query.get_expression().empty()) {
+        return QueryShape::General;
+    }
+    bool const has_log_message_queries{
+            false == query.get_wildcard_queries().empty()
+            || false == query.get_regex_queries().empty()
+    };
+    bool const has_attribute_queries{false == query.get_attribute_queries().empty()};
+    if (has_log_message_queries && has_attribute_queries) {
+        return QueryShape::General;
+    }
+    if (has_log_message_queries) {
+        return QueryShape::LogMessage;
+    }
+    if (has_attribute_queries) {
+        return QueryShape::Attributes;
+    }
+    return QueryShape::TimeRange;
+}
+
+/**
+ * Validates whether a decoded log event matches a query of the given shape.
+ * @tparam shape The shape of the query. Must not be `QueryShape::None`.
+ * @param query
+ * @param timestamp
+ * @param decoded_message
+ * @param decoded_attributes
+ * @param attribute_idx_map
+ * @return Whether the log event matches the query.
+ * @throw ExceptionFFI if the query contains attribute names that doesn't
+ * belong to the log event.
+ */
+template <QueryShape shape>
+auto matches_query(
+        Query& query,
+        ffi::epoch_time_ms_t timestamp,
+        std::string_view decoded_message,
+        std::vector<std::optional<ffi::ir_stream::Attribute>> const& decoded_attributes,
+        std::unordered_map<std::string, size_t> const& attribute_idx_map
+) -> bool {
+    static_assert(QueryShape::None != shape);
+    if constexpr (QueryShape::TimeRange == shape) {
+        return query.matches_time_range(timestamp);
+    } else if constexpr (QueryShape::LogMessage == shape) {
+        return query.matches_time_range(timestamp) && query.matches_log_message(decoded_message);
+    } else if constexpr (QueryShape::Attributes == shape) {
+        // Validated first, so that a missing attribute throws even if the log
+        // event is out of the time range, as in `Query::matches_decoded`.
+        query.validate_decoded_attribute_names(attribute_idx_map);
+        return query.matches_time_range(timestamp)
+               && query.matches_decoded_attributes(decoded_attributes, attribute_idx_map);
+    } else {
+        return query.matches_decoded(
+                timestamp,
+                decoded_message,
+                decoded_attributes,
+                attribute_idx_map
+        );
+    }
+}
+
+/**
+ * The result of decoding the next log event into the decoder buffer's decoded
+ * log event buffers.
+ */
+enum class DecodingResult : uint8_t {
+    Decoded,
+    Terminated,
+    Failed
+};
+
+/**
+ * Decodes the next log event from the CLP IR buffer `decoder_buffer` into its
+ * decoded log event buffers. If a query is given, decode until finding a log
+ * event that matches the query. The decoding loop is specialized at compile
+ * time for the query shape, so the loop doesn't branch on it per event.
+ * @tparam shape The shape of the query (see `get_query_shape`).
  * @param decoder_buffer IR decoder buffer of the input IR stream.
- * @param py_metadata Theffi::ir_stream::IrBuffer metadata associated with the input IR stream.
- * @param py_query Search query to filter log events.
+ * @param py_metadata The metadata associated with the input IR stream.
+ * @param query Search query to filter log events. It must be non-null unless
+ * `shape` is `QueryShape::None`.
  * @param allow_incomplete_stream A flag to indicate whether the incomplete
  * stream error should be ignored. If it is set to true, incomplete stream error
  * should be treated as the termination.
- * @param cache_encoded_log_event A flag to indicate whether to cache the
- * encoded log event. The buffered log event will contain all the encoded
- * attributes, variables, and the logtype. The encoded timestamp delta is not
- * cached because it should be recalculated whenever to reuse the cached
- * encoded results.
- * @return Log event represented as PyLogEvent on success.
- * @return PyNone on termination.
- * @return nullptr on failure with the relevant Python exception and error set.
+ * @param timestamp Returns the timestamp of the decoded log event.
+ * @param timestamp_delta Returns the timestamp delta of the decoded log event.
+ * @param log_event_idx Returns the index of the decoded log event.
+ * @param encoded_log_event_view Returns a view of the encoded log event.
+ * @return DecodingResult::Decoded on success.
+ * @return DecodingResult::Terminated when the end of the IR stream is reached
+ * or the query search terminates.
+ * @return DecodingResult::Failed on failure with the relevant Python exception
+ * and error set.
  */
-auto decode(
+template <QueryShape shape>
+auto decode_into_buffers(
         PyDecoderBuffer* decoder_buffer,
         PyMetadata* py_metadata,
-        PyQuery* py_query,
+        Query* query,
         bool allow_incomplete_stream,
-        bool cache_encoded_log_event
-) -> PyObject* {
-    std::string decoded_message;
-    ffi::epoch_time_ms_t timestamp_delta{0};
-    auto timestamp{decoder_buffer->get_ref_timestamp()};
+        ffi::epoch_time_ms_t& timestamp,
+        ffi::epoch_time_ms_t& timestamp_delta,
+        size_t& log_event_idx,
+        gsl::span<int8_t>& encoded_log_event_view
+) -> DecodingResult {
+    auto& decoded_log_event_buffers{decoder_buffer->get_decoded_log_event_buffers()};
+    auto& decoded_message{decoded_log_event_buffers.m_log_message};
+    auto& decoded_attributes{decoded_log_event_buffers.m_attributes};
+    bool const trusted_stream{decoder_buffer->is_trusted_stream()};
+    timestamp_delta = 0;
+    timestamp = decoder_buffer->get_ref_timestamp();
     auto const num_attributes{py_metadata->get_metadata()->get_num_attributes()};
     auto const& attribute_info_table{py_metadata->get_metadata()->get_attribute_table()};
     auto const& attribute_idx_map{py_metadata->get_metadata()->get_attribute_idx_map()};
-    std::vector<std::optional<ffi::ir_stream::Attribute>> decoded_attributes;
-    size_t current_log_event_idx{0};
-    bool reached_eof{false};
-    gsl::span<int8_t> encoded_log_event_view;
 
     while (true) {
         auto const unconsumed_bytes{decoder_buffer->get_unconsumed_bytes()};
@@ -73,95 +188,403 @@ auto decode(
                 num_attributes
         )};
         if (ffi::ir_stream::IRErrorCode_Incomplete_IR == err) {
-            if (false == decoder_buffer->try_read()) {
+            if (false == decoder_buffer->try_read_for_incomplete_data()) {
                 if (allow_incomplete_stream
                     && static_cast<bool>(PyErr_ExceptionMatches(
                             PyDecoderBuffer::get_py_incomplete_stream_error()
                     )))
                 {
                     PyErr_Clear();
-                    Py_RETURN_NONE;
+                    return DecodingResult::Terminated;
                 }
-                return nullptr;
+                return DecodingResult::Failed;
             }
             continue;
         }
         if (ffi::ir_stream::IRErrorCode_Eof == err) {
-            reached_eof = true;
-            break;
+            return DecodingResult::Terminated;
         }
         if (ffi::ir_stream::IRErrorCode_Success != err) {
             PyErr_Format(PyExc_RuntimeError, cDecoderErrorCodeFormatStr, err);
-            return nullptr;
+            return DecodingResult::Failed;
         }
 
-        if (false == ffi::ir_stream::validate_attributes(attribute_info_table, decoded_attributes))
-        {
+        // A trusted stream is only checked for the number of attributes, which
+        // the unchecked attribute indexing below relies on.
+        bool const attributes_valid{
+                trusted_stream ? attribute_info_table.size() == decoded_attributes.size()
+                               : ffi::ir_stream::validate_attributes(
+                                       attribute_info_table,
+                                       decoded_attributes
+                               )
+        };
+        if (false == attributes_valid) {
             PyErr_SetString(
                     PyExc_RuntimeError,
                     "The decoded attributes do not match the declared ones in the metadata"
             );
-            return nullptr;
+            return DecodingResult::Failed;
         }
         timestamp += timestamp_delta;
-        current_log_event_idx = decoder_buffer->get_and_increment_decoded_message_count();
+        log_event_idx = decoder_buffer->get_and_increment_decoded_message_count();
         auto const curr_pos{ir_buffer.get_pos()};
         decoder_buffer->commit_read_buffer_consumption(curr_pos, encoded_log_event_view);
 
-        if (nullptr == py_query) {
-            break;
-        }
-
-        auto* query{py_query->get_query()};
-        if (query->ts_safely_outside_time_range(timestamp)) {
-            Py_RETURN_NONE;
-        }
-        bool matches{false};
-        try {
-            matches = query->matches_time_range(timestamp)
-                      && query->matches_wildcard_queries(decoded_message)
-                      && query->matches_decoded_attributes(decoded_attributes, attribute_idx_map);
-        } catch (ExceptionFFI const& ex) {
-            PyErr_Format(PyExc_RuntimeError, "Failed to match the queries: %s", ex.what());
-            return nullptr;
-        }
-        if (matches) {
+        if constexpr (QueryShape::None == shape) {
             break;
+        } else {
+            if (query->ts_safely_outside_time_range(timestamp)) {
+                return DecodingResult::Terminated;
+            }
+            bool matches{false};
+            try {
+                matches = matches_query<shape>(
+                        *query,
+                        timestamp,
+                        decoded_message,
+                        decoded_attributes,
+                        attribute_idx_map
+                );
+            } catch (ExceptionFFI const& ex) {
+                PyErr_Format(PyExc_RuntimeError, "Failed to match the queries: %s", ex.what());
+                return DecodingResult::Failed;
+            }
+            if (matches) {
+                break;
+            }
         }
     }
 
-    if (reached_eof) {
-        Py_RETURN_NONE;
-    }
-
     decoder_buffer->set_ref_timestamp(timestamp);
-    LogEvent::attribute_table_t attributes;
-    for (size_t i{0}; i < attribute_info_table.size(); ++i) {
-        attributes.emplace(attribute_info_table[i].get_name(), decoded_attributes[i]);
+    return DecodingResult::Decoded;
+}
+
+/**
+ * Decodes the next log event from the CLP IR buffer `decoder_buffer` (see
+ * `decode_into_buffers`) and creates a PyLogEvent from it.
+ * @tparam shape The shape of the query (see `get_query_shape`).
+ * @tparam cache_encoded_log_event A flag to indicate whether to cache the
+ * encoded log event. The buffered log event will contain all the encoded
+ * attributes, variables, and the logtype. The encoded timestamp delta is not
+ * cached because it should be recalculated whenever to reuse the cached
+ * encoded results.
+ * If the decoder buffer has a log message intern cache, the message of the
+ * returned log event is interned by its encoded logtype and variables.
+ * @param decoder_buffer IR decoder buffer of the input IR stream.
+ * @param py_metadata The metadata associated with the input IR stream.
+ * @param py_query Search query to filter log events. It must be non-null
+ * unless `shape` is `QueryShape::None`.
+ * @param allow_incomplete_stream
+ * @return Log event represented as PyLogEvent on success.
+ * @return PyNone on termination.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+template <QueryShape shape, bool cache_encoded_log_event>
+auto decode(
+        PyDecoderBuffer* decoder_buffer,
+        PyMetadata* py_metadata,
+        PyQuery* py_query,
+        bool allow_incomplete_stream
+) -> PyObject* {
+    ffi::epoch_time_ms_t timestamp{0};
+    ffi::epoch_time_ms_t timestamp_delta{0};
+    size_t current_log_event_idx{0};
+    gsl::span<int8_t> encoded_log_event_view;
+    Query* query{nullptr};
+    if constexpr (QueryShape::None != shape) {
+        query = py_query->get_query();
     }
-    if (false == cache_encoded_log_event) {
-        return py_reinterpret_cast<PyObject>(PyLogEvent::create_new_log_event(
-                decoded_message,
-                timestamp,
-                current_log_event_idx,
-                py_metadata,
-                attributes
-        ));
+    switch (decode_into_buffers<shape>(
+            decoder_buffer,
+            py_metadata,
+            query,
+            allow_incomplete_stream,
+            timestamp,
+            timestamp_delta,
+            current_log_event_idx,
+            encoded_log_event_view
+    ))
+    {
+        case DecodingResult::Decoded:
+            break;
+        case DecodingResult::Terminated:
+            Py_RETURN_NONE;
+        case DecodingResult::Failed:
+        default:
+            return nullptr;
     }
+
+    auto& decoded_log_event_buffers{decoder_buffer->get_decoded_log_event_buffers()};
+    auto& decoded_message{decoded_log_event_buffers.m_log_message};
+    auto& decoded_attributes{decoded_log_event_buffers.m_attributes};
+    auto const& attribute_schema{py_metadata->get_metadata()->get_attribute_schema()};
     auto const encoded_timestamp_delta_size{
             ffi::ir_stream::four_byte_encoding::get_encoded_timestamp_delta_size(timestamp_delta)
     };
-    auto const encoded_log_event_size_without_ts_delta{
+    auto const encoded_log_event_without_ts_delta{encoded_log_event_view.first(
             encoded_log_event_view.size() - encoded_timestamp_delta_size
-    };
-    return py_reinterpret_cast<PyObject>(PyLogEvent::create_new_log_event(
-            decoded_message,
+    )};
+
+    std::shared_ptr<InternedLogMessage> interned_log_message;
+    auto* log_message_intern_cache{decoder_buffer->get_log_message_intern_cache()};
+    if (nullptr != log_message_intern_cache) {
+        // The encoded attributes precede the encoded variables and logtype, and
+        // aren't part of the key, since they don't affect the message.
+        auto const encoded_attributes_size{
+                AttributeEncoder::get_encoded_attribute_values_size(decoded_attributes)
+        };
+        if (encoded_attributes_size <= encoded_log_event_without_ts_delta.size()) {
+            interned_log_message = log_message_intern_cache->intern(
+                    encoded_log_event_without_ts_delta.subspan(encoded_attributes_size),
+                    decoded_message
+            );
+        }
+    }
+
+    std::optional<EncodedLogEventRef> cached_encoded_log_event;
+    if constexpr (cache_encoded_log_event) {
+        cached_encoded_log_event = decoded_log_event_buffers.m_encoded_log_event_arena.store(
+                encoded_log_event_without_ts_delta
+        );
+    }
+
+    // The decoded message and attributes are swapped with the buffers of the
+    // new log event, which are recycled if it's taken from the free list.
+    std::string no_log_message;
+    auto* py_log_event{PyLogEvent::create_new_log_event(
+            nullptr == interned_log_message ? decoded_message : no_log_message,
             timestamp,
             current_log_event_idx,
             py_metadata,
-            attributes,
-            encoded_log_event_view.subspan(0, encoded_log_event_size_without_ts_delta)
-    ));
+            attribute_schema,
+            decoded_attributes,
+            std::move(cached_encoded_log_event)
+    )};
+    if (nullptr != py_log_event && nullptr != interned_log_message) {
+        py_log_event->set_interned_log_message(interned_log_message);
+    }
+    return py_reinterpret_cast<PyObject>(py_log_event);
+}
+
+/**
+ * Dispatches to the decoding loop specialized for the given query shape and
+ * the given encoded log event caching flag.
+ * @tparam shape
+ * @param decoder_buffer
+ * @param py_metadata
+ * @param py_query
+ * @param allow_incomplete_stream
+ * @param cache_encoded_log_event
+ * @return Forwards `decode`'s return values.
+ */
+template <QueryShape shape>
+auto decode_with_query_shape(
+        PyDecoderBuffer* decoder_buffer,
+        PyMetadata* py_metadata,
+        PyQuery* py_query,
+        bool allow_incomplete_stream,
+        bool cache_encoded_log_event
+) -> PyObject* {
+    if (cache_encoded_log_event) {
+        return decode<shape, true>(decoder_buffer, py_metadata, py_query, allow_incomplete_stream);
+    }
+    return decode<shape, false>(decoder_buffer, py_metadata, py_query, allow_incomplete_stream);
+}
+
+/**
+ * Decodes the next log event using the decoding loop specialized for the given
+ * query and the given encoded log event caching flag. The specialization is
+ * selected once per call.
+ * @param decoder_buffer
+ * @param py_metadata
+ * @param py_query Search query to filter log events, or nullptr if no query is
+ * given.
+ * @param allow_incomplete_stream
+ * @param cache_encoded_log_event
+ * @return Forwards `decode`'s return values.
+ */
+auto decode(
+        PyDecoderBuffer* decoder_buffer,
+        PyMetadata* py_metadata,
+        PyQuery* py_query,
+        bool allow_incomplete_stream,
+        bool cache_encoded_log_event
+) -> PyObject* {
+    auto const shape{
+            nullptr == py_query ? QueryShape::None : get_query_shape(*py_query->get_query())
+    };
+    switch (shape) {
+        case QueryShape::None:
+            return decode_with_query_shape<QueryShape::None>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    cache_encoded_log_event
+            );
+        case QueryShape::TimeRange:
+            return decode_with_query_shape<QueryShape::TimeRange>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    cache_encoded_log_event
+            );
+        case QueryShape::LogMessage:
+            return decode_with_query_shape<QueryShape::LogMessage>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    cache_encoded_log_event
+            );
+        case QueryShape::Attributes:
+            return decode_with_query_shape<QueryShape::Attributes>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    cache_encoded_log_event
+            );
+        case QueryShape::General:
+        default:
+            return decode_with_query_shape<QueryShape::General>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    cache_encoded_log_event
+            );
+    }
+}
+
+/**
+ * Decodes the log events (matching the query if given) from the CLP IR buffer
+ * `decoder_buffer` until the end of the IR stream is reached or the query
+ * search terminates, and exports them with the given exporter. The log events
+ * are formatted straight from the decoded log event buffers, without creating
+ * any PyLogEvent.
+ * @tparam shape The shape of the query (see `get_query_shape`).
+ * @param decoder_buffer IR decoder buffer of the input IR stream.
+ * @param py_metadata The metadata associated with the input IR stream.
+ * @param py_query Search query to filter log events. It must be non-null
+ * unless `shape` is `QueryShape::None`.
+ * @param allow_incomplete_stream
+ * @param exporter
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+template <QueryShape shape>
+auto export_decoded_log_events(
+        PyDecoderBuffer* decoder_buffer,
+        PyMetadata* py_metadata,
+        PyQuery* py_query,
+        bool allow_incomplete_stream,
+        LogEventExporter& exporter
+) -> bool {
+    auto const& decoded_log_event_buffers{decoder_buffer->get_decoded_log_event_buffers()};
+    ffi::epoch_time_ms_t timestamp{0};
+    ffi::epoch_time_ms_t timestamp_delta{0};
+    size_t log_event_idx{0};
+    gsl::span<int8_t> encoded_log_event_view;
+    Query* query{nullptr};
+    if constexpr (QueryShape::None != shape) {
+        query = py_query->get_query();
+    }
+    while (true) {
+        auto const result{decode_into_buffers<shape>(
+                decoder_buffer,
+                py_metadata,
+                query,
+                allow_incomplete_stream,
+                timestamp,
+                timestamp_delta,
+                log_event_idx,
+                encoded_log_event_view
+        )};
+        if (DecodingResult::Failed == result) {
+            return false;
+        }
+        if (DecodingResult::Terminated == result) {
+            break;
+        }
+        if (false
+            == exporter.export_log_event(
+                    decoded_log_event_buffers.m_log_message,
+                    timestamp,
+                    log_event_idx,
+                    decoded_log_event_buffers.m_attributes
+            ))
+        {
+            return false;
+        }
+    }
+    return exporter.flush();
+}
+
+/**
+ * Dispatches to the export loop specialized for the given query.
+ * @param decoder_buffer
+ * @param py_metadata
+ * @param py_query Search query to filter log events, or nullptr if no query is
+ * given.
+ * @param allow_incomplete_stream
+ * @param exporter
+ * @return Forwards `export_decoded_log_events`'s return values.
+ */
+auto export_decoded_log_events(
+        PyDecoderBuffer* decoder_buffer,
+        PyMetadata* py_metadata,
+        PyQuery* py_query,
+        bool allow_incomplete_stream,
+        LogEventExporter& exporter
+) -> bool {
+    auto const shape{
+            nullptr == py_query ? QueryShape::None : get_query_shape(*py_query->get_query())
+    };
+    switch (shape) {
+        case QueryShape::None:
+            return export_decoded_log_events<QueryShape::None>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    exporter
+            );
+        case QueryShape::TimeRange:
+            return export_decoded_log_events<QueryShape::TimeRange>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    exporter
+            );
+        case QueryShape::LogMessage:
+            return export_decoded_log_events<QueryShape::LogMessage>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    exporter
+            );
+        case QueryShape::Attributes:
+            return export_decoded_log_events<QueryShape::Attributes>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    exporter
+            );
+        case QueryShape::General:
+        default:
+            return export_decoded_log_events<QueryShape::General>(
+                    decoder_buffer,
+                    py_metadata,
+                    py_query,
+                    allow_incomplete_stream,
+                    exporter
+            );
+    }
 }
 }  // namespace
 
@@ -192,7 +615,7 @@ auto decode_preamble(PyObject* Py_UNUSED(self), PyObject* py_decoder_buffer) ->
             PyErr_Format(PyExc_RuntimeError, cDecoderErrorCodeFormatStr, err);
             return nullptr;
         }
-        if (false == decoder_buffer->try_read()) {
+        if (false == decoder_buffer->try_read_for_incomplete_data()) {
             return nullptr;
         }
     }
@@ -225,7 +648,7 @@ auto decode_preamble(PyObject* Py_UNUSED(self), PyObject* py_decoder_buffer) ->
             PyErr_Format(PyExc_RuntimeError, cDecoderErrorCodeFormatStr, err);
             return nullptr;
         }
-        if (false == decoder_buffer->try_read()) {
+        if (false == decoder_buffer->try_read_for_incomplete_data()) {
             return nullptr;
         }
     }
@@ -253,37 +676,91 @@ auto decode_preamble(PyObject* Py_UNUSED(self), PyObject* py_decoder_buffer) ->
     return py_reinterpret_cast<PyObject>(metadata);
 }
 
-auto decode_next_log_event(PyObject* Py_UNUSED(self), PyObject* args, PyObject* keywords)
-        -> PyObject* {
-    static char keyword_decoder_buffer[]{"decoder_buffer"};
-    static char keyword_query[]{"query"};
-    static char keyword_allow_incomplete_stream[]{"allow_incomplete_stream"};
-    static char keyword_cache_encoded_log_event[]{"cache_encoded_log_event"};
-    static char* keyword_table[]{
-            static_cast<char*>(keyword_decoder_buffer),
-            static_cast<char*>(keyword_query),
-            static_cast<char*>(keyword_allow_incomplete_stream),
-            static_cast<char*>(keyword_cache_encoded_log_event),
-            nullptr
+auto decode_next_log_event(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "decode_next_log_event",
+            {"decoder_buffer", "query", "allow_incomplete_stream", "cache_encoded_log_event"},
+            1
     };
+    std::array<PyObject*, 4> parsed_args{};
+    if (false == arg_parser.parse(args, num_args, keyword_names, parsed_args)) {
+        return nullptr;
+    }
+
+    if (false
+        == static_cast<bool>(PyObject_TypeCheck(parsed_args[0], PyDecoderBuffer::get_py_type())))
+    {
+        PyErr_SetString(PyExc_TypeError, cPyTypeError);
+        return nullptr;
+    }
+    auto* decoder_buffer{py_reinterpret_cast<PyDecoderBuffer>(parsed_args[0])};
+    PyObject* query{nullptr == parsed_args[1] ? Py_None : parsed_args[1]};
+    bool allow_incomplete_stream{false};
+    bool cache_encoded_log_event{false};
+    if ((nullptr != parsed_args[2]
+         && false == parse_py_bool(parsed_args[2], allow_incomplete_stream))
+        || (nullptr != parsed_args[3]
+            && false == parse_py_bool(parsed_args[3], cache_encoded_log_event)))
+    {
+        return nullptr;
+    }
+
+    bool const is_query_given{Py_None != query};
+    if (is_query_given
+        && false == static_cast<bool>(PyObject_TypeCheck(query, PyQuery::get_py_type())))
+    {
+        PyErr_SetString(PyExc_TypeError, cPyTypeError);
+        return nullptr;
+    }
+
+    if (false == decoder_buffer->has_metadata()) {
+        PyErr_SetString(
+                PyExc_RuntimeError,
+                "The given DecoderBuffer does not have a valid CLP IR metadata decoded."
+        );
+        return nullptr;
+    }
+
+    return decode_next_log_event_from_buffer(
+            decoder_buffer,
+            is_query_given ? py_reinterpret_cast<PyQuery>(query) : nullptr,
+            allow_incomplete_stream,
+            cache_encoded_log_event
+    );
+}
 
-    PyDecoderBuffer* decoder_buffer{nullptr};
-    PyObject* query{Py_None};
-    int allow_incomplete_stream{0};
-    int cache_encoded_log_event{0};
+auto export_log_events(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "export_log_events",
+            {"decoder_buffer", "sink", "format", "query", "allow_incomplete_stream"},
+            2
+    };
+    std::array<PyObject*, 5> parsed_args{};
+    if (false == arg_parser.parse(args, num_args, keyword_names, parsed_args)) {
+        return nullptr;
+    }
 
     if (false
-        == static_cast<bool>(PyArg_ParseTupleAndKeywords(
-                args,
-                keywords,
-                "O!|Opp",
-                static_cast<char**>(keyword_table),
-                PyDecoderBuffer::get_py_type(),
-                &decoder_buffer,
-                &query,
-                &allow_incomplete_stream,
-                &cache_encoded_log_event
-        )))
+        == static_cast<bool>(PyObject_TypeCheck(parsed_args[0], PyDecoderBuffer::get_py_type())))
+    {
+        PyErr_SetString(PyExc_TypeError, cPyTypeError);
+        return nullptr;
+    }
+    auto* decoder_buffer{py_reinterpret_cast<PyDecoderBuffer>(parsed_args[0])};
+    PyObject* query{nullptr == parsed_args[3] ? Py_None : parsed_args[3]};
+    bool allow_incomplete_stream{false};
+    if (nullptr != parsed_args[4]
+        && false == parse_py_bool(parsed_args[4], allow_incomplete_stream))
     {
         return nullptr;
     }
@@ -304,13 +781,38 @@ auto decode_next_log_event(PyObject* Py_UNUSED(self), PyObject* args, PyObject*
         return nullptr;
     }
 
+    auto* py_metadata{decoder_buffer->get_metadata()};
+    auto exporter{LogEventExporter::create(py_metadata, parsed_args[1], parsed_args[2])};
+    if (false == exporter.has_value()) {
+        return nullptr;
+    }
+    if (false
+        == export_decoded_log_events(
+                decoder_buffer,
+                py_metadata,
+                is_query_given ? py_reinterpret_cast<PyQuery>(query) : nullptr,
+                allow_incomplete_stream,
+                exporter.value()
+        ))
+    {
+        return nullptr;
+    }
+    return PyLong_FromSize_t(exporter->get_num_exported_log_events());
+}
+}
+
+auto decode_next_log_event_from_buffer(
+        PyDecoderBuffer* decoder_buffer,
+        PyQuery* py_query,
+        bool allow_incomplete_stream,
+        bool cache_encoded_log_event
+) -> PyObject* {
     return decode(
             decoder_buffer,
             decoder_buffer->get_metadata(),
-            is_query_given ? py_reinterpret_cast<PyQuery>(query) : nullptr,
-            static_cast<bool>(allow_incomplete_stream),
-            static_cast<bool>(cache_encoded_log_event)
+            py_query,
+            allow_incomplete_stream,
+            cache_encoded_log_event
     );
 }
-}
 }  // namespace clp_ffi_py::ir::native
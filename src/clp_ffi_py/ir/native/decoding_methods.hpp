@@ -3,13 +3,49 @@
 
 #include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
 
+#include <clp_ffi_py/ir/native/PyDecoderBuffer.hpp>
+#include <clp_ffi_py/ir/native/PyQuery.hpp>
+
 // Documentation for these methods is in clp/ir/native/PyDecoder.cpp, as it also
 // serves as the documentation for Python.
 namespace clp_ffi_py::ir::native {
 extern "C" {
 auto decode_preamble(PyObject* self, PyObject* py_decoder_buffer) -> PyObject*;
-auto decode_next_log_event(PyObject* self, PyObject* args, PyObject* keywords) -> PyObject*;
+auto decode_next_log_event(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject*;
+auto export_log_events(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject*;
 }
+
+/**
+ * Decodes the next log event from the IR stream buffered in the given decoder
+ * buffer. It is the native counterpart of `decode_next_log_event`, for callers
+ * that have already validated their arguments.
+ * @param decoder_buffer A decoder buffer whose metadata has been decoded.
+ * @param py_query Search query to filter log events, or nullptr if no query is
+ * given.
+ * @param allow_incomplete_stream
+ * @param cache_encoded_log_event
+ * @return a new reference of the next decoded log event (matching the query
+ * if given) represented as a PyLogEvent.
+ * @return a new reference of Py_None when the end of the IR stream is reached
+ * or the query search terminates.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+auto decode_next_log_event_from_buffer(
+        PyDecoderBuffer* decoder_buffer,
+        PyQuery* py_query,
+        bool allow_incomplete_stream,
+        bool cache_encoded_log_event
+) -> PyObject*;
 }  // namespace clp_ffi_py::ir::native
 
 #endif
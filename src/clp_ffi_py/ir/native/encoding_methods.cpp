@@ -2,41 +2,590 @@
 
 #include "encoding_methods.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <gsl/span>
+
 #include <clp/components/core/src/ffi/encoding_methods.hpp>
 #include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
 #include <clp/components/core/src/ffi/ir_stream/encoding_methods.hpp>
 #include <clp/components/core/src/ffi/ir_stream/protocol_constants.hpp>
 #include <clp/components/core/src/type_utils.hpp>
 
+#include <clp_ffi_py/ir/native/AttributeEncoder.hpp>
 #include <clp_ffi_py/ir/native/error_messages.hpp>
+#include <clp_ffi_py/ir/native/FourByteMessageEncoder.hpp>
+#include <clp_ffi_py/ir/native/MessageTokenizer.hpp>
+#include <clp_ffi_py/ir/native/utils.hpp>
+#include <clp_ffi_py/PyFastcallArgParser.hpp>
+#include <clp_ffi_py/PyObjectUtils.hpp>
+#include <clp_ffi_py/utils.hpp>
 
 namespace clp_ffi_py::ir::native {
-auto encode_four_byte_preamble(PyObject* Py_UNUSED(self), PyObject* args) -> PyObject* {
+namespace {
+/**
+ * Parses the arguments of the preamble encoding methods:
+ * (ref_timestamp, timestamp_format, timezone)
+ * @param arg_parser
+ * @param args
+ * @param num_args
+ * @param ref_timestamp Returns the parsed reference timestamp.
+ * @param timestamp_format Returns the parsed timestamp format.
+ * @param timezone Returns the parsed timezone.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto parse_preamble_args(
+        PyFastcallArgParser& arg_parser,
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        ffi::epoch_time_ms_t& ref_timestamp,
+        std::string_view& timestamp_format,
+        std::string_view& timezone
+) -> bool {
+    std::array<PyObject*, 3> parsed_args{};
+    return arg_parser.parse(args, num_args, nullptr, parsed_args)
+           && parse_py_int(parsed_args[0], ref_timestamp)
+           && parse_py_string_as_string_view(parsed_args[1], timestamp_format)
+           && parse_py_string_as_string_view(parsed_args[2], timezone);
+}
+
+/**
+ * This class holds the log events of a batch parsed from Python objects. The
+ * parsed log messages are views into the Python objects, which the batch keeps
+ * alive (and, for a buffer, unresizable), so the log events can be encoded with
+ * the GIL released.
+ */
+class LogEventBatch {
+public:
+    LogEventBatch() = default;
+
+    ~LogEventBatch() {
+        if (m_has_buffer) {
+            PyBuffer_Release(&m_buffer);
+        }
+    }
+
+    // Delete copy/move constructors and assignments
+    LogEventBatch(LogEventBatch const&) = delete;
+    LogEventBatch(LogEventBatch&&) = delete;
+    auto operator=(LogEventBatch const&) -> LogEventBatch& = delete;
+    auto operator=(LogEventBatch&&) -> LogEventBatch& = delete;
+
+    /**
+     * Parses the log events of the batch.
+     * @param py_timestamps A sequence of absolute timestamps.
+     * @param py_messages A sequence of bytes if `py_offsets` is nullptr, or a
+     * bytes-like object that contains all the log messages otherwise.
+     * @param py_offsets A sequence of `len(timestamps) + 1` non-decreasing
+     * offsets into `py_messages`, where the i-th log message spans from
+     * `offsets[i]` to `offsets[i + 1]`, or nullptr.
+     * @return true on success.
+     * @return false on failure with the relevant Python exception and error
+     * set.
+     */
+    [[nodiscard]] auto
+    parse(PyObject* py_timestamps, PyObject* py_messages, PyObject* py_offsets) -> bool;
+
+    [[nodiscard]] auto get_timestamps() const -> gsl::span<ffi::epoch_time_ms_t const> {
+        return m_timestamps;
+    }
+
+    [[nodiscard]] auto get_messages() const -> gsl::span<std::string_view const> {
+        return m_messages;
+    }
+
+private:
+    /**
+     * Parses the log messages from a sequence of bytes.
+     * @param py_messages
+     * @return Same as `parse`.
+     */
+    [[nodiscard]] auto parse_message_sequence(PyObject* py_messages) -> bool;
+
+    /**
+     * Parses the log messages from a buffer and its offsets.
+     * @param py_buffer
+     * @param py_offsets
+     * @return Same as `parse`.
+     */
+    [[nodiscard]] auto parse_message_buffer(PyObject* py_buffer, PyObject* py_offsets) -> bool;
+
+    std::vector<ffi::epoch_time_ms_t> m_timestamps;
+    std::vector<std::string_view> m_messages;
+    PyObjectPtr<PyObject> m_py_messages;
+    Py_buffer m_buffer{};
+    bool m_has_buffer{false};
+};
+
+auto LogEventBatch::parse(PyObject* py_timestamps, PyObject* py_messages, PyObject* py_offsets)
+        -> bool {
+    PyObjectPtr<PyObject> const py_timestamp_seq{
+            PySequence_Fast(py_timestamps, "The timestamps must be a sequence of integers.")
+    };
+    if (nullptr == py_timestamp_seq) {
+        return false;
+    }
+    auto const num_log_events{PySequence_Fast_GET_SIZE(py_timestamp_seq.get())};
+    m_timestamps.resize(static_cast<size_t>(num_log_events));
+    for (Py_ssize_t idx{0}; idx < num_log_events; ++idx) {
+        if (false
+            == parse_py_int(
+                    PySequence_Fast_GET_ITEM(py_timestamp_seq.get(), idx),
+                    m_timestamps[static_cast<size_t>(idx)]
+            ))
+        {
+            return false;
+        }
+    }
+
+    if (nullptr == py_offsets || Py_None == py_offsets) {
+        if (false == parse_message_sequence(py_messages)) {
+            return false;
+        }
+    } else if (false == parse_message_buffer(py_messages, py_offsets)) {
+        return false;
+    }
+    if (m_messages.size() != m_timestamps.size()) {
+        PyErr_Format(
+                PyExc_ValueError,
+                "The number of log messages (%zu) doesn't match the number of timestamps (%zu).",
+                m_messages.size(),
+                m_timestamps.size()
+        );
+        return false;
+    }
+    return true;
+}
+
+auto LogEventBatch::parse_message_sequence(PyObject* py_messages) -> bool {
+    // A tuple is immutable, so the log messages stay alive while the GIL is
+    // released, even if the given sequence is modified by another thread.
+    m_py_messages.reset(PySequence_Tuple(py_messages));
+    if (nullptr == m_py_messages) {
+        return false;
+    }
+    auto const num_messages{PyTuple_GET_SIZE(m_py_messages.get())};
+    m_messages.resize(static_cast<size_t>(num_messages));
+    for (Py_ssize_t idx{0}; idx < num_messages; ++idx) {
+        auto& message{m_messages[static_cast<size_t>(idx)]};
+        if (false
+            == parse_py_bytes_as_string_view(PyTuple_GET_ITEM(m_py_messages.get(), idx), message))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto LogEventBatch::parse_message_buffer(PyObject* py_buffer, PyObject* py_offsets) -> bool {
+    if (0 != PyObject_GetBuffer(py_buffer, &m_buffer, PyBUF_SIMPLE)) {
+        return false;
+    }
+    m_has_buffer = true;
+    std::string_view const buffer{
+            static_cast<char const*>(m_buffer.buf),
+            static_cast<size_t>(m_buffer.len)
+    };
+
+    PyObjectPtr<PyObject> const py_offset_seq{
+            PySequence_Fast(py_offsets, "The offsets must be a sequence of integers.")
+    };
+    if (nullptr == py_offset_seq) {
+        return false;
+    }
+    auto const num_offsets{PySequence_Fast_GET_SIZE(py_offset_seq.get())};
+    if (num_offsets != static_cast<Py_ssize_t>(m_timestamps.size()) + 1) {
+        PyErr_Format(
+                PyExc_ValueError,
+                "The number of offsets (%zd) must be the number of timestamps plus one.",
+                num_offsets
+        );
+        return false;
+    }
+    Py_ssize_t begin_offset{0};
+    for (Py_ssize_t idx{0}; idx < num_offsets; ++idx) {
+        Py_ssize_t end_offset{0};
+        if (false == parse_py_int(PySequence_Fast_GET_ITEM(py_offset_seq.get(), idx), end_offset))
+        {
+            return false;
+        }
+        if (end_offset < (0 == idx ? 0 : begin_offset) || end_offset > m_buffer.len) {
+            PyErr_Format(
+                    PyExc_ValueError,
+                    "The offset %zd at index %zd is decreasing or out of the buffer's bounds.",
+                    end_offset,
+                    idx
+            );
+            return false;
+        }
+        if (0 != idx) {
+            auto const message_size{static_cast<size_t>(end_offset - begin_offset)};
+            m_messages.emplace_back(buffer.substr(static_cast<size_t>(begin_offset), message_size));
+        }
+        begin_offset = end_offset;
+    }
+    return true;
+}
+
+/**
+ * The log event that failed to be encoded in a batch.
+ */
+struct BatchEncodingFailure {
+    size_t log_event_idx;
+    char const* error_message;
+};
+
+/**
+ * Encodes the given log events and appends them to `ir_buf`. This method
+ * doesn't access any Python object, so it can be called with the GIL released.
+ * @param ref_timestamp The timestamp that the first timestamp delta is
+ * computed from.
+ * @param timestamps
+ * @param messages
+ * @param message_encoder
+ * @param ir_buf
+ * @return std::nullopt on success.
+ * @return The failed log event on failure.
+ */
+auto encode_log_events(
+        ffi::epoch_time_ms_t ref_timestamp,
+        gsl::span<ffi::epoch_time_ms_t const> timestamps,
+        gsl::span<std::string_view const> messages,
+        FourByteMessageEncoder& message_encoder,
+        std::vector<int8_t>& ir_buf
+) -> std::optional<BatchEncodingFailure> {
+    auto last_timestamp{ref_timestamp};
+    for (size_t idx{0}; idx < timestamps.size(); ++idx) {
+        if (false == message_encoder.encode_message(messages[idx], ir_buf)) {
+            return BatchEncodingFailure{idx, cEncodeMessageError};
+        }
+        if (false
+            == ffi::ir_stream::four_byte_encoding::encode_timestamp(
+                    timestamps[idx] - last_timestamp,
+                    ir_buf
+            ))
+        {
+            return BatchEncodingFailure{idx, cEncodeTimestampError};
+        }
+        last_timestamp = timestamps[idx];
+    }
+    return std::nullopt;
+}
+
+/**
+ * Estimates the size of the given log events once encoded. The encoded
+ * variables are usually no larger than their text, and each log event has at
+ * most a few bytes of tags and lengths.
+ * @param messages
+ * @return The estimated size.
+ */
+auto estimate_encoded_size(gsl::span<std::string_view const> messages) -> size_t {
+    constexpr size_t cMaxOverheadPerLogEvent{16};
+    size_t encoded_size{messages.size() * cMaxOverheadPerLogEvent};
+    for (auto const message : messages) {
+        encoded_size += message.size();
+    }
+    return encoded_size;
+}
+
+/**
+ * Encodes the given log events with up to `num_threads` threads, and appends
+ * them to `ir_buf`. The log events are split into contiguous chunks, each of
+ * which is encoded into its own buffer by one thread. Since every log event
+ * comes with its absolute timestamp, the first timestamp delta of a chunk is
+ * computed from the last timestamp of the previous chunk, so the concatenated
+ * chunks are identical to the log events encoded sequentially. This method
+ * doesn't access any Python object, so it can be called with the GIL released.
+ * @param ref_timestamp The timestamp that the first timestamp delta is
+ * computed from.
+ * @param timestamps
+ * @param messages
+ * @param num_threads The maximum number of threads, including the calling
+ * thread.
+ * @param ir_buf
+ * @return std::nullopt on success.
+ * @return The first failed log event on failure.
+ * @throw Any exception thrown while encoding a chunk, rethrown once all the
+ * threads have been joined.
+ */
+auto encode_log_events_in_parallel(
+        ffi::epoch_time_ms_t ref_timestamp,
+        gsl::span<ffi::epoch_time_ms_t const> timestamps,
+        gsl::span<std::string_view const> messages,
+        size_t num_threads,
+        std::vector<int8_t>& ir_buf
+) -> std::optional<BatchEncodingFailure> {
+    // Each thread gets enough log events to amortize the cost of starting it.
+    constexpr size_t cMinLogEventsPerThread{4096};
+    auto const num_log_events{timestamps.size()};
+    auto const num_chunks{std::clamp<size_t>(
+            num_log_events / cMinLogEventsPerThread,
+            1,
+            std::max<size_t>(num_threads, 1)
+    )};
+    if (1 == num_chunks) {
+        FourByteMessageEncoder message_encoder;
+        ir_buf.reserve(ir_buf.size() + estimate_encoded_size(messages));
+        return encode_log_events(ref_timestamp, timestamps, messages, message_encoder, ir_buf);
+    }
+
+    // The first chunk is encoded by the calling thread directly into `ir_buf`.
+    auto const chunk_size{(num_log_events + num_chunks - 1) / num_chunks};
+    std::vector<std::vector<int8_t>> chunk_ir_bufs(num_chunks);
+    std::vector<std::optional<BatchEncodingFailure>> chunk_failures(num_chunks);
+    // An exception escaping a thread terminates the process, so each chunk's
+    // exception is stored and rethrown after all the threads are joined.
+    std::vector<std::exception_ptr> chunk_exceptions(num_chunks);
+    auto encode_chunk = [&](size_t chunk_idx) {
+        try {
+            auto const begin_idx{chunk_idx * chunk_size};
+            auto const chunk_length{std::min(chunk_size, num_log_events - begin_idx)};
+            auto const chunk_messages{messages.subspan(begin_idx, chunk_length)};
+            auto& chunk_ir_buf{0 == chunk_idx ? ir_buf : chunk_ir_bufs[chunk_idx]};
+            chunk_ir_buf.reserve(chunk_ir_buf.size() + estimate_encoded_size(chunk_messages));
+            FourByteMessageEncoder message_encoder;
+            auto& failure{chunk_failures[chunk_idx]};
+            failure = encode_log_events(
+                    0 == begin_idx ? ref_timestamp : timestamps[begin_idx - 1],
+                    timestamps.subspan(begin_idx, chunk_length),
+                    chunk_messages,
+                    message_encoder,
+                    chunk_ir_buf
+            );
+            if (failure.has_value()) {
+                failure->log_event_idx += begin_idx;
+            }
+        } catch (...) {
+            chunk_exceptions[chunk_idx] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_chunks - 1);
+    size_t num_started_chunks{1};
+    try {
+        for (; num_started_chunks < num_chunks; ++num_started_chunks) {
+            threads.emplace_back(encode_chunk, num_started_chunks);
+        }
+    } catch (std::system_error const&) {
+        // The chunks that couldn't get a thread are encoded below.
+    }
+    encode_chunk(0);
+    for (auto chunk_idx{num_started_chunks}; chunk_idx < num_chunks; ++chunk_idx) {
+        encode_chunk(chunk_idx);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    size_t total_size{ir_buf.size()};
+    for (size_t chunk_idx{0}; chunk_idx < num_chunks; ++chunk_idx) {
+        if (nullptr != chunk_exceptions[chunk_idx]) {
+            std::rethrow_exception(chunk_exceptions[chunk_idx]);
+        }
+        if (chunk_failures[chunk_idx].has_value()) {
+            return chunk_failures[chunk_idx];
+        }
+        total_size += chunk_ir_bufs[chunk_idx].size();
+    }
+    ir_buf.reserve(total_size);
+    for (auto const& chunk_ir_buf : chunk_ir_bufs) {
+        ir_buf.insert(ir_buf.end(), chunk_ir_buf.cbegin(), chunk_ir_buf.cend());
+    }
+    return std::nullopt;
+}
+
+/**
+ * Parses the arguments of the batch encoding methods and encodes the batch.
+ * @param py_timestamps
+ * @param py_messages
+ * @param py_ref_timestamp
+ * @param py_offsets The offsets into `py_messages`, or nullptr/None if
+ * `py_messages` is a sequence of bytes.
+ * @param py_num_threads The number of encoding threads, 0 for the number of
+ * CPUs, or nullptr to encode on the calling thread only.
+ * @param ir_buf Returns the encoded log events.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto encode_batch(
+        PyObject* py_timestamps,
+        PyObject* py_messages,
+        PyObject* py_ref_timestamp,
+        PyObject* py_offsets,
+        PyObject* py_num_threads,
+        std::vector<int8_t>& ir_buf
+) -> bool {
     ffi::epoch_time_ms_t ref_timestamp{};
-    char const* input_timestamp_format{};
-    char const* input_timezone{};
-    Py_ssize_t input_timestamp_format_size{};
-    Py_ssize_t input_timezone_size{};
+    size_t num_threads{1};
+    LogEventBatch batch;
+    if (false == parse_py_int(py_ref_timestamp, ref_timestamp)
+        || (nullptr != py_num_threads && false == parse_py_int(py_num_threads, num_threads))
+        || false == batch.parse(py_timestamps, py_messages, py_offsets))
+    {
+        return false;
+    }
+    if (0 == num_threads) {
+        num_threads = std::thread::hardware_concurrency();
+    }
+
+    std::optional<BatchEncodingFailure> failure;
+    std::exception_ptr exception;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        failure = encode_log_events_in_parallel(
+                ref_timestamp,
+                batch.get_timestamps(),
+                batch.get_messages(),
+                num_threads,
+                ir_buf
+        );
+    } catch (...) {
+        // The exception can only be raised once the GIL is reacquired.
+        exception = std::current_exception();
+    }
+    Py_END_ALLOW_THREADS
+    if (nullptr != exception) {
+        try {
+            std::rethrow_exception(exception);
+        } catch (std::bad_alloc const&) {
+            PyErr_NoMemory();
+        } catch (std::exception const& ex) {
+            PyErr_Format(PyExc_RuntimeError, "Failed to encode the log events: %s", ex.what());
+        } catch (...) {
+            PyErr_SetString(PyExc_RuntimeError, "Failed to encode the log events.");
+        }
+        return false;
+    }
+    if (failure.has_value()) {
+        PyErr_Format(
+                PyExc_NotImplementedError,
+                "%s (log event index: %zu).",
+                failure->error_message,
+                failure->log_event_idx
+        );
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Copies the encoded bytes into a writable Python buffer at the given offset.
+ * @param py_buffer An object that supports the writable buffer protocol.
+ * @param py_offset
+ * @param ir_buf
+ * @return A new reference to the number of bytes written on success.
+ * @return A new reference to the negated number of bytes missing if the buffer
+ * is too small, in which case nothing is written.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ * In particular, TypeError is set if `py_buffer` isn't writable.
+ */
+auto write_into_buffer(PyObject* py_buffer, PyObject* py_offset, std::vector<int8_t> const& ir_buf)
+        -> PyObject* {
+    Py_ssize_t offset{0};
+    if (false == parse_py_int(py_offset, offset)) {
+        return nullptr;
+    }
+    Py_buffer buffer{};
+    if (0 != PyObject_GetBuffer(py_buffer, &buffer, PyBUF_WRITABLE)) {
+        // A read-only buffer (e.g., bytes) raises BufferError, which is reported
+        // as a TypeError like any other object that isn't a writable buffer.
+        if (static_cast<bool>(PyErr_ExceptionMatches(PyExc_BufferError))) {
+            PyErr_Clear();
+            PyErr_SetString(PyExc_TypeError, "`buffer` must be a writable bytes-like object.");
+        }
+        return nullptr;
+    }
+    if (offset < 0 || offset > buffer.len) {
+        PyErr_Format(
+                PyExc_ValueError,
+                "The offset %zd is out of the buffer's bounds [0, %zd].",
+                offset,
+                buffer.len
+        );
+        PyBuffer_Release(&buffer);
+        return nullptr;
+    }
+    auto const num_bytes_available{buffer.len - offset};
+    auto const num_bytes_encoded{static_cast<Py_ssize_t>(ir_buf.size())};
+    if (num_bytes_encoded > num_bytes_available) {
+        PyBuffer_Release(&buffer);
+        return PyLong_FromSsize_t(num_bytes_available - num_bytes_encoded);
+    }
+    std::memcpy(static_cast<char*>(buffer.buf) + offset, ir_buf.data(), ir_buf.size());
+    PyBuffer_Release(&buffer);
+    return PyLong_FromSsize_t(num_bytes_encoded);
+}
+
+/**
+ * Scopes a use of a thread-local IR buffer: the buffer is cleared when the
+ * guard is created, and released when the guard is destroyed if it grew past
+ * `cMaxRetainedCapacity`, so that encoding one large batch doesn't pin its
+ * memory for the lifetime of the thread.
+ */
+class ReusedIrBufGuard {
+public:
+    /**
+     * Same as `LogEventQueue::cMaxRetainedMessageCapacity`.
+     */
+    static constexpr size_t cMaxRetainedCapacity{64ULL * 1024ULL};
+
+    explicit ReusedIrBufGuard(std::vector<int8_t>& ir_buf) : m_ir_buf{ir_buf} { m_ir_buf.clear(); }
 
-    if (0
-        == PyArg_ParseTuple(
+    // Delete copy/move constructors and assignments
+    ReusedIrBufGuard(ReusedIrBufGuard const&) = delete;
+    ReusedIrBufGuard(ReusedIrBufGuard&&) = delete;
+    auto operator=(ReusedIrBufGuard const&) -> ReusedIrBufGuard& = delete;
+    auto operator=(ReusedIrBufGuard&&) -> ReusedIrBufGuard& = delete;
+
+    ~ReusedIrBufGuard() {
+        if (m_ir_buf.capacity() > cMaxRetainedCapacity) {
+            std::vector<int8_t>{}.swap(m_ir_buf);
+        }
+    }
+
+private:
+    std::vector<int8_t>& m_ir_buf;
+};
+}  // namespace
+
+auto encode_four_byte_preamble(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "encode_preamble",
+            {"ref_timestamp", "timestamp_format", "timezone"},
+            3
+    };
+    ffi::epoch_time_ms_t ref_timestamp{};
+    std::string_view timestamp_format;
+    std::string_view timezone;
+    if (false
+        == parse_preamble_args(
+                arg_parser,
                 args,
-                "Ls#s#",
-                &ref_timestamp,
-                &input_timestamp_format,
-                &input_timestamp_format_size,
-                &input_timezone,
-                &input_timezone_size
+                num_args,
+                ref_timestamp,
+                timestamp_format,
+                timezone
         ))
     {
         return nullptr;
     }
-
-    std::string_view const timestamp_format{
-            input_timestamp_format,
-            static_cast<size_t>(input_timestamp_format_size)
-    };
-    std::string_view const timezone{input_timezone, static_cast<size_t>(input_timezone_size)};
     std::vector<int8_t> ir_buf;
 
     if (false
@@ -58,32 +607,31 @@ auto encode_four_byte_preamble(PyObject* Py_UNUSED(self), PyObject* args) -> PyO
     );
 }
 
-auto encode_four_byte_android_preamble(PyObject* self, PyObject* args) -> PyObject* {
+auto encode_four_byte_android_preamble(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "encode_android_preamble",
+            {"ref_timestamp", "timestamp_format", "timezone"},
+            3
+    };
     ffi::epoch_time_ms_t ref_timestamp{};
-    char const* input_timestamp_format{};
-    char const* input_timezone{};
-    Py_ssize_t input_timestamp_format_size{};
-    Py_ssize_t input_timezone_size{};
-
-    if (0
-        == PyArg_ParseTuple(
+    std::string_view timestamp_format;
+    std::string_view timezone;
+    if (false
+        == parse_preamble_args(
+                arg_parser,
                 args,
-                "Ls#s#",
-                &ref_timestamp,
-                &input_timestamp_format,
-                &input_timestamp_format_size,
-                &input_timezone,
-                &input_timezone_size
+                num_args,
+                ref_timestamp,
+                timestamp_format,
+                timezone
         ))
     {
         return nullptr;
     }
-
-    std::string_view const timestamp_format{
-            input_timestamp_format,
-            static_cast<size_t>(input_timestamp_format_size)
-    };
-    std::string_view const timezone{input_timezone, static_cast<size_t>(input_timezone_size)};
     std::vector<int8_t> ir_buf;
 
     std::vector<ffi::ir_stream::AttributeInfo> const attribute_table{
@@ -114,24 +662,104 @@ auto encode_four_byte_android_preamble(PyObject* self, PyObject* args) -> PyObje
     );
 }
 
-auto encode_four_byte_message_and_timestamp_delta(PyObject* Py_UNUSED(self), PyObject* args)
-        -> PyObject* {
+auto encode_four_byte_preamble_with_attributes(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "encode_preamble_with_attributes",
+            {"ref_timestamp", "timestamp_format", "timezone", "attribute_table"},
+            4
+    };
+    std::array<PyObject*, 4> parsed_args{};
+    ffi::epoch_time_ms_t ref_timestamp{};
+    std::string_view timestamp_format;
+    std::string_view timezone;
+    std::vector<ffi::ir_stream::AttributeInfo> attribute_table;
+    if (false == arg_parser.parse(args, num_args, nullptr, parsed_args)
+        || false == parse_py_int(parsed_args[0], ref_timestamp)
+        || false == parse_py_string_as_string_view(parsed_args[1], timestamp_format)
+        || false == parse_py_string_as_string_view(parsed_args[2], timezone)
+        || false == deserialize_attribute_table(parsed_args[3], attribute_table))
+    {
+        return nullptr;
+    }
+    std::vector<int8_t> ir_buf;
+
+    if (false
+        == AttributeEncoder::encode_preamble(
+                timestamp_format,
+                timezone,
+                ref_timestamp,
+                attribute_table,
+                ir_buf
+        ))
+    {
+        PyErr_SetString(PyExc_NotImplementedError, clp_ffi_py::ir::native::cEncodePreambleError);
+        return nullptr;
+    }
+
+    return PyByteArray_FromStringAndSize(
+            size_checked_pointer_cast<char>(ir_buf.data()),
+            static_cast<Py_ssize_t>(ir_buf.size())
+    );
+}
+
+auto encode_four_byte_attributes(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{"encode_attributes", {"attributes"}, 1};
+    std::array<PyObject*, 1> parsed_args{};
+    std::vector<std::optional<ffi::ir_stream::Attribute>> attributes;
+    if (false == arg_parser.parse(args, num_args, nullptr, parsed_args)
+        || false == deserialize_attribute_values_from_python_sequence(parsed_args[0], attributes))
+    {
+        return nullptr;
+    }
+
+    std::vector<int8_t> ir_buf;
+    if (false == AttributeEncoder::encode_attribute_values(attributes, ir_buf)) {
+        PyErr_SetString(PyExc_NotImplementedError, clp_ffi_py::ir::native::cEncodeAttributesError);
+        return nullptr;
+    }
+
+    return PyByteArray_FromStringAndSize(
+            size_checked_pointer_cast<char>(ir_buf.data()),
+            static_cast<Py_ssize_t>(ir_buf.size())
+    );
+}
+
+auto encode_four_byte_message_and_timestamp_delta(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "encode_message_and_timestamp_delta",
+            {"timestamp_delta", "msg"},
+            2
+    };
+    std::array<PyObject*, 2> parsed_args{};
     ffi::epoch_time_ms_t delta{};
-    char const* input_buffer{};
-    Py_ssize_t input_buffer_size{};
-    if (0 == PyArg_ParseTuple(args, "Ly#", &delta, &input_buffer, &input_buffer_size)) {
+    std::string_view msg;
+    if (false == arg_parser.parse(args, num_args, nullptr, parsed_args)
+        || false == parse_py_int(parsed_args[0], delta)
+        || false == parse_py_bytes_as_string_view(parsed_args[1], msg))
+    {
         return nullptr;
     }
 
-    std::string logtype;
+    FourByteMessageEncoder message_encoder;
     std::vector<int8_t> ir_buf;
-    std::string_view const msg{input_buffer, static_cast<size_t>(input_buffer_size)};
 
     // To avoid the frequent expansion of ir_buf,
     // allocate sufficient space in advance
-    ir_buf.reserve(input_buffer_size * 2);
+    ir_buf.reserve(msg.size() * 2);
 
-    if (false == ffi::ir_stream::four_byte_encoding::encode_message(msg, logtype, ir_buf)) {
+    if (false == message_encoder.encode_message(msg, ir_buf)) {
         PyErr_SetString(PyExc_NotImplementedError, clp_ffi_py::ir::native::cEncodeMessageError);
         return nullptr;
     }
@@ -147,21 +775,27 @@ auto encode_four_byte_message_and_timestamp_delta(PyObject* Py_UNUSED(self), PyO
     );
 }
 
-auto encode_four_byte_message(PyObject* Py_UNUSED(self), PyObject* args) -> PyObject* {
-    char const* input_buffer{};
-    Py_ssize_t input_buffer_size{};
-    if (0 == PyArg_ParseTuple(args, "y#", &input_buffer, &input_buffer_size)) {
+auto encode_four_byte_message(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{"encode_message", {"msg"}, 1};
+    std::array<PyObject*, 1> parsed_args{};
+    std::string_view msg;
+    if (false == arg_parser.parse(args, num_args, nullptr, parsed_args)
+        || false == parse_py_bytes_as_string_view(parsed_args[0], msg))
+    {
         return nullptr;
     }
 
-    std::string log_type;
+    FourByteMessageEncoder message_encoder;
     std::vector<int8_t> ir_buf;
-    std::string_view const msg{input_buffer, static_cast<size_t>(input_buffer_size)};
 
     // To avoid frequent resize of ir_buf, allocate sufficient space in advance
-    ir_buf.reserve(input_buffer_size * 2);
+    ir_buf.reserve(msg.size() * 2);
 
-    if (false == ffi::ir_stream::four_byte_encoding::encode_message(msg, log_type, ir_buf)) {
+    if (false == message_encoder.encode_message(msg, ir_buf)) {
         PyErr_SetString(PyExc_NotImplementedError, clp_ffi_py::ir::native::cEncodeMessageError);
         return nullptr;
     }
@@ -172,9 +806,61 @@ auto encode_four_byte_message(PyObject* Py_UNUSED(self), PyObject* args) -> PyOb
     );
 }
 
-auto encode_four_byte_timestamp_delta(PyObject* Py_UNUSED(self), PyObject* args) -> PyObject* {
+auto encode_four_byte_message_with_clp_tokenizer(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{"_encode_message_with_clp_tokenizer", {"msg"}, 1};
+    std::array<PyObject*, 1> parsed_args{};
+    std::string_view msg;
+    if (false == arg_parser.parse(args, num_args, nullptr, parsed_args)
+        || false == parse_py_bytes_as_string_view(parsed_args[0], msg))
+    {
+        return nullptr;
+    }
+
+    std::string logtype;
+    std::vector<int8_t> ir_buf;
+    if (false == ffi::ir_stream::four_byte_encoding::encode_message(msg, logtype, ir_buf)) {
+        PyErr_SetString(PyExc_NotImplementedError, clp_ffi_py::ir::native::cEncodeMessageError);
+        return nullptr;
+    }
+
+    return PyByteArray_FromStringAndSize(
+            size_checked_pointer_cast<char>(ir_buf.data()),
+            static_cast<Py_ssize_t>(ir_buf.size())
+    );
+}
+
+auto set_four_byte_vectorized_tokenizer_enabled(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{"_set_vectorized_tokenizer_enabled", {"enabled"}, 1};
+    std::array<PyObject*, 1> parsed_args{};
+    bool enabled{true};
+    if (false == arg_parser.parse(args, num_args, nullptr, parsed_args)
+        || false == parse_py_bool(parsed_args[0], enabled))
+    {
+        return nullptr;
+    }
+    MessageTokenizer::set_vectorized_classifier_enabled(enabled);
+    Py_RETURN_NONE;
+}
+
+auto encode_four_byte_timestamp_delta(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{"encode_timestamp_delta", {"timestamp_delta"}, 1};
+    std::array<PyObject*, 1> parsed_args{};
     ffi::epoch_time_ms_t delta{};
-    if (0 == PyArg_ParseTuple(args, "L", &delta)) {
+    if (false == arg_parser.parse(args, num_args, nullptr, parsed_args)
+        || false == parse_py_int(parsed_args[0], delta))
+    {
         return nullptr;
     }
 
@@ -190,6 +876,125 @@ auto encode_four_byte_timestamp_delta(PyObject* Py_UNUSED(self), PyObject* args)
     );
 }
 
+auto encode_four_byte_batch(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "encode_batch",
+            {"timestamps", "messages", "ref_timestamp", "offsets", "num_threads"},
+            3
+    };
+    std::array<PyObject*, 5> parsed_args{};
+    std::vector<int8_t> ir_buf;
+    if (false == arg_parser.parse(args, num_args, keyword_names, parsed_args)) {
+        return nullptr;
+    }
+    if (false
+        == encode_batch(
+                parsed_args[0],
+                parsed_args[1],
+                parsed_args[2],
+                parsed_args[3],
+                parsed_args[4],
+                ir_buf
+        ))
+    {
+        return nullptr;
+    }
+    return PyByteArray_FromStringAndSize(
+            size_checked_pointer_cast<char>(ir_buf.data()),
+            static_cast<Py_ssize_t>(ir_buf.size())
+    );
+}
+
+auto encode_four_byte_into(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "encode_into",
+            {"buffer", "offset", "msg", "timestamp_delta"},
+            3
+    };
+    std::array<PyObject*, 4> parsed_args{};
+    std::string_view msg;
+    if (false == arg_parser.parse(args, num_args, keyword_names, parsed_args)
+        || false == parse_py_bytes_as_string_view(parsed_args[2], msg))
+    {
+        return nullptr;
+    }
+    std::optional<ffi::epoch_time_ms_t> delta;
+    if (nullptr != parsed_args[3] && Py_None != parsed_args[3]) {
+        if (false == parse_py_int(parsed_args[3], delta.emplace())) {
+            return nullptr;
+        }
+    }
+
+    // The log event is encoded into a reused buffer before being copied into
+    // the given buffer, since the CLP encoding methods only output to vectors.
+    thread_local FourByteMessageEncoder message_encoder;
+    thread_local std::vector<int8_t> ir_buf;
+    ReusedIrBufGuard const ir_buf_guard{ir_buf};
+    if (false == message_encoder.encode_message(msg, ir_buf)) {
+        PyErr_SetString(PyExc_NotImplementedError, clp_ffi_py::ir::native::cEncodeMessageError);
+        return nullptr;
+    }
+    if (delta.has_value()
+        && false == ffi::ir_stream::four_byte_encoding::encode_timestamp(delta.value(), ir_buf))
+    {
+        PyErr_SetString(PyExc_NotImplementedError, clp_ffi_py::ir::native::cEncodeTimestampError);
+        return nullptr;
+    }
+    return write_into_buffer(parsed_args[0], parsed_args[1], ir_buf);
+}
+
+auto encode_four_byte_batch_into(
+        PyObject* Py_UNUSED(self),
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject* {
+    static PyFastcallArgParser arg_parser{
+            "encode_batch_into",
+            {"buffer",
+             "offset",
+             "timestamps",
+             "messages",
+             "ref_timestamp",
+             "offsets",
+             "num_threads"},
+            5
+    };
+    std::array<PyObject*, 7> parsed_args{};
+    if (false == arg_parser.parse(args, num_args, keyword_names, parsed_args)) {
+        return nullptr;
+    }
+
+    // Same as in `encode_four_byte_into`, the batch is encoded into a reused
+    // buffer, so that neither the copy nor a batch discarded because `buffer`
+    // is too small costs an allocation, unless the batch is large.
+    thread_local std::vector<int8_t> ir_buf;
+    ReusedIrBufGuard const ir_buf_guard{ir_buf};
+    if (false
+        == encode_batch(
+                parsed_args[2],
+                parsed_args[3],
+                parsed_args[4],
+                parsed_args[5],
+                parsed_args[6],
+                ir_buf
+        ))
+    {
+        return nullptr;
+    }
+    return write_into_buffer(parsed_args[0], parsed_args[1], ir_buf);
+}
+
 auto encode_end_of_ir(PyObject* Py_UNUSED(self)) -> PyObject* {
     static constexpr char cEof{ffi::ir_stream::cProtocol::Eof};
     return PyByteArray_FromStringAndSize(&cEof, sizeof(cEof));
@@ -7,11 +7,54 @@
 // clp_ffi_py/ir/native/PyFourByteEncoder.cpp, as it also serves as the
 // documentation for python.
 namespace clp_ffi_py::ir::native {
-auto encode_four_byte_preamble(PyObject* self, PyObject* args) -> PyObject*;
-auto encode_four_byte_android_preamble(PyObject* self, PyObject* args) -> PyObject*;
-auto encode_four_byte_message_and_timestamp_delta(PyObject* self, PyObject* args) -> PyObject*;
-auto encode_four_byte_message(PyObject* self, PyObject* args) -> PyObject*;
-auto encode_four_byte_timestamp_delta(PyObject* self, PyObject* args) -> PyObject*;
+auto encode_four_byte_preamble(PyObject* self, PyObject* const* args, Py_ssize_t num_args)
+        -> PyObject*;
+auto encode_four_byte_android_preamble(PyObject* self, PyObject* const* args, Py_ssize_t num_args)
+        -> PyObject*;
+auto encode_four_byte_preamble_with_attributes(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject*;
+auto encode_four_byte_attributes(PyObject* self, PyObject* const* args, Py_ssize_t num_args)
+        -> PyObject*;
+auto encode_four_byte_message_and_timestamp_delta(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject*;
+auto encode_four_byte_message(PyObject* self, PyObject* const* args, Py_ssize_t num_args)
+        -> PyObject*;
+auto encode_four_byte_message_with_clp_tokenizer(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject*;
+auto set_four_byte_vectorized_tokenizer_enabled(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t num_args
+) -> PyObject*;
+auto encode_four_byte_timestamp_delta(PyObject* self, PyObject* const* args, Py_ssize_t num_args)
+        -> PyObject*;
+auto encode_four_byte_batch(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject*;
+auto encode_four_byte_into(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject*;
+auto encode_four_byte_batch_into(
+        PyObject* self,
+        PyObject* const* args,
+        Py_ssize_t num_args,
+        PyObject* keyword_names
+) -> PyObject*;
 auto encode_end_of_ir(PyObject* self) -> PyObject*;
 }  // namespace clp_ffi_py::ir::native
 
@@ -0,0 +1,62 @@
+#ifndef CLP_FFI_PY_ENCODING_UTILS_HPP
+#define CLP_FFI_PY_ENCODING_UTILS_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace clp_ffi_py::ir::native {
+/**
+ * Appends the given integer to `ir_buf` in big-endian order.
+ * @tparam integer_t
+ * @param value
+ * @param ir_buf
+ */
+template <typename integer_t>
+auto append_int(integer_t value, std::vector<int8_t>& ir_buf) -> void {
+    for (size_t idx{sizeof(integer_t)}; idx > 0; --idx) {
+        ir_buf.push_back(static_cast<int8_t>(
+                static_cast<std::make_unsigned_t<integer_t>>(value) >> ((idx - 1) * CHAR_BIT)
+        ));
+    }
+}
+
+/**
+ * Appends the given string to `ir_buf`, preceded by the tag that fits its
+ * length and the length itself.
+ * @param str
+ * @param ubyte_len_tag The tag to use if the length fits in an unsigned byte.
+ * @param ushort_len_tag The tag to use if the length fits in an unsigned
+ * short.
+ * @param int_len_tag The tag to use if the length fits in a signed int.
+ * @param ir_buf
+ * @return Whether the string could be encoded.
+ */
+inline auto append_string(
+        std::string_view str,
+        int8_t ubyte_len_tag,
+        int8_t ushort_len_tag,
+        int8_t int_len_tag,
+        std::vector<int8_t>& ir_buf
+) -> bool {
+    auto const length{str.length()};
+    if (length <= UINT8_MAX) {
+        ir_buf.push_back(ubyte_len_tag);
+        ir_buf.push_back(static_cast<int8_t>(static_cast<uint8_t>(length)));
+    } else if (length <= UINT16_MAX) {
+        ir_buf.push_back(ushort_len_tag);
+        append_int(static_cast<uint16_t>(length), ir_buf);
+    } else if (length <= INT32_MAX) {
+        ir_buf.push_back(int_len_tag);
+        append_int(static_cast<int32_t>(length), ir_buf);
+    } else {
+        return false;
+    }
+    ir_buf.insert(ir_buf.end(), str.cbegin(), str.cend());
+    return true;
+}
+}  // namespace clp_ffi_py::ir::native
+#endif  // CLP_FFI_PY_ENCODING_UTILS_HPP
@@ -9,6 +9,7 @@ constexpr char const* cEncodeTimestampError
         = "Native encoder cannot encode the given timestamp delta";
 constexpr char const* cEncodePreambleError = "Native encoder cannot encode the given preamble";
 constexpr char const* cEncodeMessageError = "Native encoder cannot encode the given message";
+constexpr char const* cEncodeAttributesError = "Native encoder cannot encode the given attributes";
 }  // namespace clp_ffi_py::ir::native
 
 #endif  // CLP_FFI_PY_IR_ERROR_MESSAGES
@@ -1,11 +1,103 @@
 #include "utils.hpp"
 
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include <clp_ffi_py/error_messages.hpp>
+#include <clp_ffi_py/ir/native/TimestampFormatter.hpp>
+#include <clp_ffi_py/Py_utils.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
 #include <clp_ffi_py/PyObjectUtils.hpp>
 #include <clp_ffi_py/utils.hpp>
 
 namespace clp_ffi_py::ir::native {
+namespace {
+/**
+ * Serializes a single attribute into a Python dict item.
+ * @param attr_name
+ * @param attribute
+ * @param py_attributes
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto serialize_attribute_to_python_dict_item(
+        std::string const& attr_name,
+        std::optional<ffi::ir_stream::Attribute> const& attribute,
+        PyObject* py_attributes
+) -> bool {
+    PyObjectPtr<PyObject> const attr_name_py{py_string_from_utf8(attr_name)};
+    if (nullptr == attr_name_py.get()) {
+        return false;
+    }
+    if (false == attribute.has_value()) {
+        return 0 == PyDict_SetItem(py_attributes, attr_name_py.get(), Py_None);
+    }
+    auto const& attr_val{attribute.value()};
+    PyObjectPtr<PyObject> attr_py{nullptr};
+    if (attr_val.is_type<ffi::ir_stream::attr_int_t>()) {
+        auto* attr_int_py{PyLong_FromLongLong(attr_val.get_value<ffi::ir_stream::attr_int_t>())};
+        attr_py.reset(attr_int_py);
+    } else if (attr_val.is_type<ffi::ir_stream::attr_str_t>()) {
+        auto* attr_str_py{py_string_from_utf8(attr_val.get_value<ffi::ir_stream::attr_str_t>())};
+        attr_py.reset(attr_str_py);
+    } else {
+        PyErr_SetString(PyExc_NotImplementedError, "Unsupported attribute type");
+    }
+    if (nullptr == attr_py.get()) {
+        return false;
+    }
+    return 0 == PyDict_SetItem(py_attributes, attr_name_py.get(), attr_py.get());
+}
+
+/**
+ * Gets the value of an attribute from the attribute values indexed by the
+ * given attribute schema.
+ * @param attribute_schema
+ * @param attribute_values
+ * @param name
+ * @return A const reference to the attribute value.
+ * @throw std::out_of_range if the log event doesn't have the attribute.
+ */
+auto get_attribute_value(
+        AttributeSchema const* attribute_schema,
+        LogEvent::attribute_values_t const& attribute_values,
+        std::string const& name
+) -> std::optional<ffi::ir_stream::Attribute> const& {
+    auto const idx{
+            nullptr == attribute_schema ? std::nullopt : attribute_schema->find_idx(name)
+    };
+    if (false == idx.has_value() || idx.value() >= attribute_values.size()) {
+        throw std::out_of_range("Attribute not found: " + name);
+    }
+    return attribute_values[idx.value()];
+}
+
+/**
+ * Appends the given integer to the string, right-aligned in a field of the
+ * given width.
+ * @param value
+ * @param width
+ * @param str
+ */
+auto append_right_aligned(ffi::ir_stream::attr_int_t value, size_t width, std::string& str)
+        -> void {
+    // Large enough for any 64-bit integer with its sign.
+    std::array<char, 20> digits{};
+    auto const result{std::to_chars(digits.data(), digits.data() + digits.size(), value)};
+    auto const num_chars{static_cast<size_t>(result.ptr - digits.data())};
+    if (num_chars < width) {
+        str.append(width - num_chars, ' ');
+    }
+    str.append(digits.data(), num_chars);
+}
+}  // namespace
+
 auto serialize_attributes_to_python_dict(LogEvent::attribute_table_t const& attributes)
         -> PyObject* {
     if (attributes.empty()) {
@@ -15,46 +107,69 @@ auto serialize_attributes_to_python_dict(LogEvent::attribute_table_t const& attr
     if (nullptr == py_attributes) {
         return nullptr;
     }
-    bool failed{false};
     for (auto const& [attr_name, attribute] : attributes) {
-        PyObjectPtr<PyObject> const attr_name_py{PyUnicode_FromString(attr_name.c_str())};
-        if (nullptr == attr_name_py.get()) {
-            failed = true;
-            break;
-        }
-        if (false == attribute.has_value()) {
-            PyDict_SetItem(py_attributes, attr_name_py.get(), Py_None);
-            continue;
-        }
-        auto const& attr_val{attribute.value()};
-        PyObjectPtr<PyObject> attr_py{nullptr};
-        if (attr_val.is_type<ffi::ir_stream::attr_int_t>()) {
-            auto* attr_int_py{PyLong_FromLongLong(attr_val.get_value<ffi::ir_stream::attr_int_t>())
-            };
-            attr_py.reset(attr_int_py);
-        } else if (attr_val.is_type<ffi::ir_stream::attr_str_t>()) {
-            std::string_view attr_str{attr_val.get_value<ffi::ir_stream::attr_str_t>()};
-            auto* attr_str_py{PyUnicode_FromString(attr_str.data())};
-            attr_py.reset(attr_str_py);
-        } else {
-            PyErr_SetString(PyExc_NotImplementedError, "Unsupported attribute type");
-        }
-        if (nullptr == attr_py.get()) {
-            failed = true;
-            break;
-        }
-        if (-1 == PyDict_SetItem(py_attributes, attr_name_py.get(), attr_py.get())) {
-            failed = true;
-            break;
+        if (false == serialize_attribute_to_python_dict_item(attr_name, attribute, py_attributes))
+        {
+            Py_DECREF(py_attributes);
+            return nullptr;
         }
     }
-    if (failed) {
-        Py_DECREF(py_attributes);
+    return py_attributes;
+}
+
+auto serialize_attributes_to_python_dict(
+        AttributeSchema const& attribute_schema,
+        LogEvent::attribute_values_t const& attribute_values
+) -> PyObject* {
+    if (attribute_values.empty()) {
+        Py_RETURN_NONE;
+    }
+    auto* py_attributes{PyDict_New()};
+    if (nullptr == py_attributes) {
         return nullptr;
     }
+    auto const& attr_names{attribute_schema.get_names()};
+    for (size_t idx{0}; idx < attribute_values.size() && idx < attr_names.size(); ++idx) {
+        if (false
+            == serialize_attribute_to_python_dict_item(
+                    attr_names[idx],
+                    attribute_values[idx],
+                    py_attributes
+            ))
+        {
+            Py_DECREF(py_attributes);
+            return nullptr;
+        }
+    }
     return py_attributes;
 }
 
+auto deserialize_attribute(PyObject* py_attr, std::optional<ffi::ir_stream::Attribute>& attribute)
+        -> bool {
+    if (Py_None == py_attr) {
+        attribute.reset();
+        return true;
+    }
+    if (static_cast<bool>(PyUnicode_Check(py_attr))) {
+        ffi::ir_stream::attr_str_t attr_str;
+        if (false == parse_py_string(py_attr, attr_str)) {
+            return false;
+        }
+        attribute.emplace(std::move(attr_str));
+        return true;
+    }
+    if (static_cast<bool>(PyLong_Check(py_attr))) {
+        ffi::ir_stream::attr_int_t attr_int{};
+        if (false == parse_py_int<ffi::ir_stream::attr_int_t>(py_attr, attr_int)) {
+            return false;
+        }
+        attribute.emplace(attr_int);
+        return true;
+    }
+    PyErr_SetString(PyExc_TypeError, "Unknown serialized log attribute type.");
+    return false;
+}
+
 auto deserialize_attributes_from_python_dict(
         PyObject* py_attr_dict,
         LogEvent::attribute_table_t& attributes
@@ -70,8 +185,7 @@ auto deserialize_attributes_from_python_dict(
     PyObject* py_attr_name{};
     PyObject* py_attr{};
     Py_ssize_t pos{0};
-    ffi::ir_stream::attr_str_t attr_str;
-    ffi::ir_stream::attr_int_t attr_int;
+    std::optional<ffi::ir_stream::Attribute> attribute;
 
     std::string_view attr_name_view;
     while (static_cast<bool>(PyDict_Next(py_attr_dict, &pos, &py_attr_name, &py_attr))) {
@@ -87,25 +201,282 @@ auto deserialize_attributes_from_python_dict(
             );
             return false;
         }
-        if (Py_None == py_attr) {
-            attributes.emplace(attr_name_view, std::nullopt);
-            continue;
-        }
-        if (static_cast<bool>(PyUnicode_Check(py_attr))) {
-            if (false == parse_py_string(py_attr, attr_str)) {
-                return false;
-            }
-            attributes.emplace(attr_name_view, attr_str);
-        } else if (static_cast<bool>(PyLong_Check(py_attr))) {
-            if (false == parse_py_int<ffi::ir_stream::attr_int_t>(py_attr, attr_int)) {
-                return false;
-            }
-            attributes.emplace(attr_name_view, attr_int);
+        if (false == deserialize_attribute(py_attr, attribute)) {
+            return false;
+        }
+        attributes.emplace(attr_name_view, std::move(attribute));
+    }
+    return true;
+}
+
+auto deserialize_attributes_from_python_dict(
+        PyObject* py_attr_dict,
+        std::shared_ptr<AttributeSchema const>& attribute_schema,
+        LogEvent::attribute_values_t& attribute_values
+) -> bool {
+    attribute_schema.reset();
+    attribute_values.clear();
+    if (Py_None == py_attr_dict) {
+        return true;
+    }
+    if (false == static_cast<bool>(PyDict_CheckExact(py_attr_dict))) {
+        PyErr_SetString(PyExc_TypeError, clp_ffi_py::cPyTypeError);
+        return false;
+    }
+    PyObject* py_attr_name{};
+    PyObject* py_attr{};
+    Py_ssize_t pos{0};
+    std::optional<ffi::ir_stream::Attribute> attribute;
+    std::vector<std::string> attr_names;
+    attr_names.reserve(static_cast<size_t>(PyDict_Size(py_attr_dict)));
+    attribute_values.reserve(attr_names.capacity());
+
+    std::string_view attr_name_view;
+    while (static_cast<bool>(PyDict_Next(py_attr_dict, &pos, &py_attr_name, &py_attr))) {
+        if (false == parse_py_string_as_string_view(py_attr_name, attr_name_view)) {
+            PyErr_SetString(PyExc_TypeError, "String keys are expected in attribute table.");
+            return false;
+        }
+        if (false == deserialize_attribute(py_attr, attribute)) {
+            return false;
+        }
+        attr_names.emplace_back(attr_name_view);
+        attribute_values.emplace_back(std::move(attribute));
+    }
+    attribute_schema = std::make_shared<AttributeSchema const>(std::move(attr_names));
+    return true;
+}
+
+auto deserialize_attribute_table(
+        PyObject* py_attribute_table,
+        std::vector<ffi::ir_stream::AttributeInfo>& attribute_table
+) -> bool {
+    attribute_table.clear();
+    if (Py_None == py_attribute_table) {
+        return true;
+    }
+    if (false == static_cast<bool>(PyDict_Check(py_attribute_table))) {
+        PyErr_SetString(PyExc_TypeError, "The attribute table must be a dict.");
+        return false;
+    }
+    PyObject* py_attr_name{};
+    PyObject* py_attr_type{};
+    Py_ssize_t pos{0};
+    std::string_view attr_name_view;
+    attribute_table.reserve(static_cast<size_t>(PyDict_Size(py_attribute_table)));
+    while (static_cast<bool>(PyDict_Next(py_attribute_table, &pos, &py_attr_name, &py_attr_type))) {
+        if (false == parse_py_string_as_string_view(py_attr_name, attr_name_view)) {
+            PyErr_SetString(PyExc_TypeError, "String keys are expected in attribute table.");
+            return false;
+        }
+        if (py_reinterpret_cast<PyObject>(&PyUnicode_Type) == py_attr_type) {
+            attribute_table.emplace_back(
+                    std::string{attr_name_view},
+                    ffi::ir_stream::AttributeInfo::TypeTag::String
+            );
+        } else if (py_reinterpret_cast<PyObject>(&PyLong_Type) == py_attr_type) {
+            attribute_table.emplace_back(
+                    std::string{attr_name_view},
+                    ffi::ir_stream::AttributeInfo::TypeTag::Int
+            );
         } else {
-            PyErr_SetString(PyExc_TypeError, "Unknown serialized log attribute type.");
+            PyErr_Format(
+                    PyExc_TypeError,
+                    "The type of attribute `%s` must be either `str` or `int`.",
+                    std::string{attr_name_view}.c_str()
+            );
+            return false;
+        }
+    }
+    return true;
+}
+
+auto deserialize_attribute_values_from_python_dict(
+        PyObject* py_attr_dict,
+        AttributeSchema const& attribute_schema,
+        std::vector<std::optional<ffi::ir_stream::Attribute>>& attribute_values
+) -> bool {
+    attribute_values.clear();
+    attribute_values.resize(attribute_schema.get_num_attributes());
+    if (Py_None == py_attr_dict) {
+        return true;
+    }
+    if (false == static_cast<bool>(PyDict_Check(py_attr_dict))) {
+        PyErr_SetString(PyExc_TypeError, clp_ffi_py::cPyTypeError);
+        return false;
+    }
+    PyObject* py_attr_name{};
+    PyObject* py_attr{};
+    Py_ssize_t pos{0};
+    std::string attr_name;
+    while (static_cast<bool>(PyDict_Next(py_attr_dict, &pos, &py_attr_name, &py_attr))) {
+        if (false == parse_py_string(py_attr_name, attr_name)) {
+            PyErr_SetString(PyExc_TypeError, "String keys are expected in attribute table.");
+            return false;
+        }
+        auto const idx{attribute_schema.find_idx(attr_name)};
+        if (false == idx.has_value()) {
+            PyErr_Format(
+                    PyExc_ValueError,
+                    "Attribute `%s` isn't declared in the attribute table.",
+                    attr_name.c_str()
+            );
+            return false;
+        }
+        if (false == deserialize_attribute(py_attr, attribute_values[idx.value()])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto deserialize_attribute_values_from_python_sequence(
+        PyObject* py_attr_sequence,
+        std::vector<std::optional<ffi::ir_stream::Attribute>>& attribute_values
+) -> bool {
+    attribute_values.clear();
+    PyObjectPtr<PyObject> const py_attr_tuple{PySequence_Tuple(py_attr_sequence)};
+    if (nullptr == py_attr_tuple) {
+        return false;
+    }
+    auto const num_attributes{PyTuple_GET_SIZE(py_attr_tuple.get())};
+    attribute_values.resize(static_cast<size_t>(num_attributes));
+    for (Py_ssize_t idx{0}; idx < num_attributes; ++idx) {
+        if (false
+            == deserialize_attribute(
+                    PyTuple_GET_ITEM(py_attr_tuple.get(), idx),
+                    attribute_values[static_cast<size_t>(idx)]
+            ))
+        {
             return false;
         }
     }
     return true;
 }
+
+auto append_formatted_timestamp(
+        ffi::epoch_time_ms_t timestamp,
+        PyMetadata* py_metadata,
+        PyObject* timezone,
+        std::string& formatted_log_event
+) -> bool {
+    TimestampFormatter* timestamp_formatter{nullptr};
+    if (Py_None == timezone) {
+        static TimestampFormatter utc_timestamp_formatter{TimezoneTransitions::create_utc()};
+        timestamp_formatter = &utc_timestamp_formatter;
+    } else if (nullptr != py_metadata && timezone == py_metadata->get_py_timezone()) {
+        timestamp_formatter = py_metadata->get_timestamp_formatter();
+    }
+    if (nullptr != timestamp_formatter) {
+        if (auto const formatted{timestamp_formatter->format(timestamp)}; formatted.has_value()) {
+            formatted_log_event.append(formatted.value());
+            return true;
+        }
+    }
+
+    PyObjectPtr<PyObject> const formatted_timestamp_object{
+            py_utils_get_formatted_timestamp(timestamp, timezone)
+    };
+    auto* formatted_timestamp_ptr{formatted_timestamp_object.get()};
+    if (nullptr == formatted_timestamp_ptr) {
+        return false;
+    }
+    std::string_view formatted_timestamp;
+    if (false == parse_py_string_as_string_view(formatted_timestamp_ptr, formatted_timestamp)) {
+        return false;
+    }
+    formatted_log_event.append(formatted_timestamp);
+    return true;
+}
+
+auto append_formatted_android_attributes(
+        AttributeSchema const* attribute_schema,
+        LogEvent::attribute_values_t const& attribute_values,
+        std::string& formatted_log_event
+) -> bool {
+    auto get_priority_char = [](ffi::ir_stream::attr_int_t priority) -> char {
+        switch (priority) {
+                /* clang-format off */
+            case 2: return 'V';
+            case 3: return 'D';
+            case 4: return 'I';
+            case 5: return 'W';
+            case 6: return 'E';
+            case 7: return 'F';
+            case 8: return 'S';
+
+            default:                  return '?';
+                /* clang-format on */
+        }
+    };
+    constexpr size_t cIdWidth{5};
+    constexpr size_t cTagWidth{8};
+    try {
+        auto const pid_val{get_attribute_value(attribute_schema, attribute_values, "pid")
+                                   .value()
+                                   .get_value<ffi::ir_stream::attr_int_t>()};
+        auto const tid_val{get_attribute_value(attribute_schema, attribute_values, "tid")
+                                   .value()
+                                   .get_value<ffi::ir_stream::attr_int_t>()};
+        auto const priority_val{
+                get_attribute_value(attribute_schema, attribute_values, "priority")
+                        .value()
+                        .get_value<ffi::ir_stream::attr_int_t>()
+        };
+        auto const& tag_val{get_attribute_value(attribute_schema, attribute_values, "tag")
+                                    .value()
+                                    .get_value<ffi::ir_stream::attr_str_t>()};
+        formatted_log_event += ' ';
+        append_right_aligned(pid_val, cIdWidth, formatted_log_event);
+        formatted_log_event += ' ';
+        append_right_aligned(tid_val, cIdWidth, formatted_log_event);
+        formatted_log_event += ' ';
+        formatted_log_event += get_priority_char(priority_val);
+        formatted_log_event += ' ';
+        formatted_log_event += tag_val;
+        if (tag_val.size() < cTagWidth) {
+            formatted_log_event.append(cTagWidth - tag_val.size(), ' ');
+        }
+        formatted_log_event += ": ";
+    } catch (std::exception const& ex) {
+        PyErr_Format(
+                PyExc_RuntimeError,
+                "Failed to format android logs with attributes. std::exception: %s",
+                ex.what()
+        );
+        return false;
+    }
+    return true;
+}
+
+auto set_py_error_from_exception(ExceptionFFI const& exception) -> void {
+    PyObject* py_exception_type{PyExc_RuntimeError};
+    switch (exception.get_error_code()) {
+        case ErrorCode_BadParam:
+            py_exception_type = PyExc_ValueError;
+            break;
+        case ErrorCode_Unsupported:
+            py_exception_type = PyExc_NotImplementedError;
+            break;
+        default:
+            break;
+    }
+    PyErr_SetString(py_exception_type, exception.what());
+}
+
+auto serialize_logtype_cache_stats_to_python_dict(LogtypeCache const* logtype_cache)
+        -> PyObject* {
+    if (nullptr == logtype_cache) {
+        return Py_BuildValue("{sKsKsK}", "capacity", 0ULL, "hits", 0ULL, "misses", 0ULL);
+    }
+    return Py_BuildValue(
+            "{sKsKsK}",
+            "capacity",
+            static_cast<unsigned long long>(logtype_cache->get_capacity()),
+            "hits",
+            static_cast<unsigned long long>(logtype_cache->get_num_hits()),
+            "misses",
+            static_cast<unsigned long long>(logtype_cache->get_num_misses())
+    );
+}
 }  // namespace clp_ffi_py::ir::native
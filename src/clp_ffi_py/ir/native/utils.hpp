@@ -4,7 +4,19 @@
 
 #include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
 
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <clp/components/core/src/ffi/encoding_methods.hpp>
+#include <clp/components/core/src/ffi/ir_stream/attributes.hpp>
+
+#include <clp_ffi_py/ExceptionFFI.hpp>
+#include <clp_ffi_py/ir/native/AttributeSchema.hpp>
 #include <clp_ffi_py/ir/native/LogEvent.hpp>
+#include <clp_ffi_py/ir/native/LogtypeCache.hpp>
+#include <clp_ffi_py/ir/native/PyMetadata.hpp>
 
 namespace clp_ffi_py::ir::native {
 /**
@@ -17,6 +29,32 @@ namespace clp_ffi_py::ir::native {
 auto serialize_attributes_to_python_dict(LogEvent::attribute_table_t const& attributes)
         -> PyObject*;
 
+/**
+ * Serializes the attribute values indexed by an attribute schema into the
+ * Python dict.
+ * @param attribute_schema
+ * @param attribute_values
+ * @return Python dict with the serialized [name, value] attribute pairs on
+ * success.
+ * @return Py_None if there are no attribute values.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+auto serialize_attributes_to_python_dict(
+        AttributeSchema const& attribute_schema,
+        LogEvent::attribute_values_t const& attribute_values
+) -> PyObject*;
+
+/**
+ * Deserializes a single attribute value from a Python object. Py_None is
+ * deserialized as a null attribute.
+ * @param py_attr A Python str, int, or None.
+ * @param attribute Returns the deserialized attribute.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto deserialize_attribute(PyObject* py_attr, std::optional<ffi::ir_stream::Attribute>& attribute)
+        -> bool;
+
 /**
  * Deserializes the attributes from the Python dict.
  * @param py_attr_dict
@@ -28,6 +66,120 @@ auto deserialize_attributes_from_python_dict(
         PyObject* py_attr_dict,
         LogEvent::attribute_table_t& attributes
 ) -> bool;
+
+/**
+ * Deserializes the attributes from the Python dict into attribute values
+ * indexed by a newly created attribute schema, in the dict's order.
+ * @param py_attr_dict
+ * @param attribute_schema Returns the attribute schema, or nullptr if the dict
+ * is Py_None.
+ * @param attribute_values Returns the attribute values.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto deserialize_attributes_from_python_dict(
+        PyObject* py_attr_dict,
+        std::shared_ptr<AttributeSchema const>& attribute_schema,
+        LogEvent::attribute_values_t& attribute_values
+) -> bool;
+
+/**
+ * Deserializes an attribute table from a Python dict mapping each attribute
+ * name to its type, either `str` or `int`, in the dict's order.
+ * @param py_attribute_table A Python dict, or None for an empty table.
+ * @param attribute_table Returns the deserialized attribute table.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto deserialize_attribute_table(
+        PyObject* py_attribute_table,
+        std::vector<ffi::ir_stream::AttributeInfo>& attribute_table
+) -> bool;
+
+/**
+ * Deserializes the attribute values from a Python dict mapping attribute
+ * names to values, ordered by the given attribute schema. Attributes missing
+ * from the dict are deserialized as null.
+ * @param py_attr_dict A Python dict, or None for all-null attributes.
+ * @param attribute_schema
+ * @param attribute_values Returns the attribute values.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto deserialize_attribute_values_from_python_dict(
+        PyObject* py_attr_dict,
+        AttributeSchema const& attribute_schema,
+        std::vector<std::optional<ffi::ir_stream::Attribute>>& attribute_values
+) -> bool;
+
+/**
+ * Deserializes the attribute values from a Python sequence, in the sequence's
+ * order.
+ * @param py_attr_sequence
+ * @param attribute_values Returns the attribute values.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto deserialize_attribute_values_from_python_sequence(
+        PyObject* py_attr_sequence,
+        std::vector<std::optional<ffi::ir_stream::Attribute>>& attribute_values
+) -> bool;
+
+/**
+ * Formats the given timestamp in the given timezone and appends it to the
+ * given string. If the timezone is UTC (None) or the metadata's timezone, the
+ * timestamp is formatted natively when possible, without calling the Python
+ * level format function.
+ * @param timestamp
+ * @param py_metadata The metadata of the log event, or nullptr if it has none.
+ * @param timezone Python tzinfo object, or None for UTC.
+ * @param formatted_log_event Returns the string with the formatted timestamp
+ * appended.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto append_formatted_timestamp(
+        ffi::epoch_time_ms_t timestamp,
+        PyMetadata* py_metadata,
+        PyObject* timezone,
+        std::string& formatted_log_event
+) -> bool;
+
+/**
+ * Formats the attributes of an android log event (pid, tid, priority and tag)
+ * and appends them to the given string.
+ * @param attribute_schema
+ * @param attribute_values
+ * @param formatted_log_event Returns the string with the formatted attributes
+ * appended.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto append_formatted_android_attributes(
+        AttributeSchema const* attribute_schema,
+        LogEvent::attribute_values_t const& attribute_values,
+        std::string& formatted_log_event
+) -> bool;
+
+/**
+ * Sets the Python exception that corresponds to the given native exception:
+ * - ValueError for ErrorCode_BadParam;
+ * - NotImplementedError for ErrorCode_Unsupported;
+ * - RuntimeError otherwise.
+ * @param exception
+ */
+auto set_py_error_from_exception(ExceptionFFI const& exception) -> void;
+
+/**
+ * Serializes the statistics of a logtype cache into a Python dict.
+ * @param logtype_cache The cache, or nullptr if the encoder doesn't have one.
+ * @return Python dict with the capacity of the cache (`capacity`, 0 if there's
+ * no cache), the number of log messages whose logtype was found in the cache
+ * (`hits`), and the number of log messages whose logtype was built (`misses`).
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+auto serialize_logtype_cache_stats_to_python_dict(LogtypeCache const* logtype_cache)
+        -> PyObject*;
 }  // namespace clp_ffi_py::ir::native
 
 #endif
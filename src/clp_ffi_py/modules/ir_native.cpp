@@ -1,9 +1,12 @@
 #include <clp_ffi_py/Python.hpp>  // Must always be included before any other header files
 
+#include <clp_ffi_py/ir/native/PyAsyncClpIrStreamWriter.hpp>
+#include <clp_ffi_py/ir/native/PyClpIrStreamWriter.hpp>
 #include <clp_ffi_py/ir/native/PyDecoder.hpp>
 #include <clp_ffi_py/ir/native/PyDecoderBuffer.hpp>
 #include <clp_ffi_py/ir/native/PyFourByteEncoder.hpp>
 #include <clp_ffi_py/ir/native/PyLogEvent.hpp>
+#include <clp_ffi_py/ir/native/PyLogEventIterator.hpp>
 #include <clp_ffi_py/ir/native/PyMetadata.hpp>
 #include <clp_ffi_py/ir/native/PyQuery.hpp>
 #include <clp_ffi_py/Py_utils.hpp>
@@ -61,10 +64,27 @@ PyMODINIT_FUNC PyInit_native() {
         return nullptr;
     }
 
+    if (false == clp_ffi_py::ir::native::PyLogEventIterator::module_level_init(new_module)) {
+        Py_DECREF(new_module);
+        return nullptr;
+    }
+
     if (false == clp_ffi_py::ir::native::PyFourByteEncoder::module_level_init(new_module)) {
         Py_DECREF(new_module);
         return nullptr;
     }
 
+    if (false == clp_ffi_py::ir::native::PyClpIrStreamWriter::module_level_init(new_module)) {
+        Py_DECREF(new_module);
+        return nullptr;
+    }
+
+    if (false
+        == clp_ffi_py::ir::native::PyAsyncClpIrStreamWriter::module_level_init(new_module))
+    {
+        Py_DECREF(new_module);
+        return nullptr;
+    }
+
     return new_module;
 }
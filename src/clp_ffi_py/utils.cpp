@@ -2,7 +2,11 @@
 
 #include "utils.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <string>
 
 #include <clp_ffi_py/error_messages.hpp>
 #include <clp_ffi_py/PyObjectCast.hpp>
@@ -14,15 +18,17 @@ namespace {
  * @param py_string PyObject that represents a Python level string. Only Python
  * Unicode object or an instance of a Python Unicode subtype will be considered
  * as valid input.
+ * @param size Returns the size of the byte data, including any embedded null
+ * characters.
  * @return pointer to the byte data on success.
  * @return nullptr on failure with the relevant Python exception and error set.
  */
-auto get_py_string_data(PyObject* py_string) -> char const* {
+auto get_py_string_data(PyObject* py_string, Py_ssize_t& size) -> char const* {
     if (false == static_cast<bool>(PyUnicode_Check(py_string))) {
         PyErr_SetString(PyExc_TypeError, "parse_py_string receives none-string argument.");
         return nullptr;
     }
-    return PyUnicode_AsUTF8(py_string);
+    return PyUnicode_AsUTF8AndSize(py_string, &size);
 }
 }  // namespace
 
@@ -38,23 +44,112 @@ auto add_python_type(PyTypeObject* new_type, char const* type_name, PyObject* mo
 }
 
 auto parse_py_string(PyObject* py_string, std::string& out) -> bool {
-    char const* str{get_py_string_data(py_string)};
+    Py_ssize_t size{0};
+    char const* str{get_py_string_data(py_string, size)};
     if (nullptr == str) {
         return false;
     }
-    out = std::string(str);
+    out.assign(str, static_cast<size_t>(size));
     return true;
 }
 
 auto parse_py_string_as_string_view(PyObject* py_string, std::string_view& view) -> bool {
-    char const* str{get_py_string_data(py_string)};
+    Py_ssize_t size{0};
+    char const* str{get_py_string_data(py_string, size)};
     if (nullptr == str) {
         return false;
     }
-    view = std::string_view(str);
+    view = std::string_view(str, static_cast<size_t>(size));
     return true;
 }
 
+auto parse_py_bytes_as_string_view(PyObject* py_bytes, std::string_view& view) -> bool {
+    if (static_cast<bool>(PyBytes_Check(py_bytes))) {
+        view = std::string_view(
+                PyBytes_AS_STRING(py_bytes),
+                static_cast<size_t>(PyBytes_GET_SIZE(py_bytes))
+        );
+        return true;
+    }
+    char const* buf{nullptr};
+    Py_ssize_t buf_size{0};
+    if (false == static_cast<bool>(PyArg_Parse(py_bytes, "y#", &buf, &buf_size))) {
+        return false;
+    }
+    view = std::string_view(buf, static_cast<size_t>(buf_size));
+    return true;
+}
+
+auto parse_py_string_or_bytes_as_string_view(PyObject* py_obj, std::string_view& view) -> bool {
+    if (false == static_cast<bool>(PyUnicode_Check(py_obj))) {
+        return parse_py_bytes_as_string_view(py_obj, view);
+    }
+    Py_ssize_t size{0};
+    auto const* data{PyUnicode_AsUTF8AndSize(py_obj, &size)};
+    if (nullptr == data) {
+        return false;
+    }
+    view = std::string_view{data, static_cast<size_t>(size)};
+    return true;
+}
+
+auto parse_py_bool(PyObject* py_obj, bool& val) -> bool {
+    auto const is_true{PyObject_IsTrue(py_obj)};
+    if (-1 == is_true) {
+        return false;
+    }
+    val = static_cast<bool>(is_true);
+    return true;
+}
+
+auto is_ascii(std::string_view str) -> bool {
+    // Checks 8 bytes at a time by testing the high bit of each byte in a word.
+    constexpr uint64_t cHighBitsMask{0x8080'8080'8080'8080ULL};
+    auto const* data{str.data()};
+    auto const size{str.size()};
+    size_t idx{0};
+    uint64_t high_bits{0};
+    for (; idx + sizeof(uint64_t) <= size; idx += sizeof(uint64_t)) {
+        uint64_t word{};
+        std::memcpy(&word, data + idx, sizeof(word));
+        high_bits |= word;
+    }
+    if (0 != (high_bits & cHighBitsMask)) {
+        return false;
+    }
+    for (; idx < size; ++idx) {
+        if (0 != (static_cast<unsigned char>(data[idx]) & 0x80U)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto py_string_from_utf8(std::string_view str) -> PyObject* {
+    return py_string_from_utf8(str, {});
+}
+
+auto py_string_from_utf8(std::string_view prefix, std::string_view suffix) -> PyObject* {
+    if (is_ascii(prefix) && is_ascii(suffix)) {
+        auto* py_string{PyUnicode_New(static_cast<Py_ssize_t>(prefix.size() + suffix.size()), 127)
+        };
+        if (nullptr == py_string) {
+            return nullptr;
+        }
+        auto* py_string_data{static_cast<char*>(PyUnicode_DATA(py_string))};
+        auto* suffix_data{std::copy(prefix.cbegin(), prefix.cend(), py_string_data)};
+        std::copy(suffix.cbegin(), suffix.cend(), suffix_data);
+        return py_string;
+    }
+    if (suffix.empty()) {
+        return PyUnicode_DecodeUTF8(prefix.data(), static_cast<Py_ssize_t>(prefix.size()), nullptr);
+    }
+    std::string str;
+    str.reserve(prefix.size() + suffix.size());
+    str.append(prefix).append(suffix);
+    return PyUnicode_DecodeUTF8(str.data(), static_cast<Py_ssize_t>(str.size()), nullptr);
+}
+
 auto get_py_bool(bool is_true) -> PyObject* {
     if (is_true) {
         Py_RETURN_TRUE;
@@ -5,6 +5,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace clp_ffi_py {
@@ -19,7 +20,7 @@ namespace clp_ffi_py {
 auto add_python_type(PyTypeObject* new_type, char const* type_name, PyObject* module) -> bool;
 
 /**
- * Parses a Python string into std::string.
+ * Parses a Python string into std::string. Embedded null characters are kept.
  * @param py_string PyObject that represents a Python level string. Only Python
  * Unicode object or an instance of a Python Unicode subtype will be considered
  * as valid input.
@@ -30,7 +31,8 @@ auto add_python_type(PyTypeObject* new_type, char const* type_name, PyObject* mo
 auto parse_py_string(PyObject* py_string, std::string& out) -> bool;
 
 /**
- * Parses a Python string into std::string_view.
+ * Parses a Python string into std::string_view. Embedded null characters are
+ * kept.
  * @param py_string PyObject that represents a Python level string. Only Python
  * Unicode object or an instance of a Python Unicode subtype will be considered
  * as valid input.
@@ -40,6 +42,66 @@ auto parse_py_string(PyObject* py_string, std::string& out) -> bool;
  */
 auto parse_py_string_as_string_view(PyObject* py_string, std::string_view& view) -> bool;
 
+/**
+ * Parses a Python bytes object into std::string_view without copying it.
+ * @param py_bytes PyObject that represents a Python level bytes object. Other
+ * read-only bytes-like objects are also considered as valid input, same as
+ * the `y#` format unit of `PyArg_ParseTuple`.
+ * @param view The string_view of the underlying byte data of py_bytes.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto parse_py_bytes_as_string_view(PyObject* py_bytes, std::string_view& view) -> bool;
+
+/**
+ * Parses a Python string or bytes-like object into std::string_view without
+ * copying it. A string is viewed as its UTF-8 encoding.
+ * @param py_obj
+ * @param view The string_view of the underlying byte data of py_obj.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto parse_py_string_or_bytes_as_string_view(PyObject* py_obj, std::string_view& view) -> bool;
+
+/**
+ * Parses the truth value of a Python object, same as the `p` format unit of
+ * `PyArg_ParseTuple`.
+ * @param py_obj
+ * @param val The truth value parsed.
+ * @return true on success.
+ * @return false on failure with the relevant Python exception and error set.
+ */
+auto parse_py_bool(PyObject* py_obj, bool& val) -> bool;
+
+/**
+ * @param str
+ * @return Whether the given string only contains ASCII characters.
+ */
+[[nodiscard]] auto is_ascii(std::string_view str) -> bool;
+
+/**
+ * Creates a Python string from a UTF-8 encoded string. Unlike
+ * `PyUnicode_FromString`, the length is given explicitly, so embedded NULs are
+ * preserved and the string isn't scanned for its terminator. Pure ASCII
+ * strings are copied directly into a compact ASCII Python string without
+ * being decoded.
+ * @param str
+ * @return A new reference to the created Python string.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto py_string_from_utf8(std::string_view str) -> PyObject*;
+
+/**
+ * Creates a Python string from the concatenation of two UTF-8 encoded strings,
+ * without concatenating them in an intermediate buffer when both are ASCII.
+ * @param prefix
+ * @param suffix
+ * @return A new reference to the created Python string.
+ * @return nullptr on failure with the relevant Python exception and error set.
+ */
+[[nodiscard]] auto py_string_from_utf8(std::string_view prefix, std::string_view suffix)
+        -> PyObject*;
+
 /**
  * Gets the Python True/False object from a given `bool` value/expression.
  * @param is_true A boolean value/expression.
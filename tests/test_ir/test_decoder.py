@@ -1,23 +1,45 @@
 import random
+import sys
+from io import BytesIO
 from pathlib import Path
-from typing import List, Optional, Tuple
+from typing import Any, Dict, IO, List, Optional, Tuple, Union
 
 from smart_open import open  # type: ignore
 from test_ir.test_utils import get_current_timestamp, LogGenerator, TestCLPBase
 
 from clp_ffi_py.ir import (
+    ClpIrStreamReader,
     Decoder,
     DecoderBuffer,
     FourByteEncoder,
     LogEvent,
+    LogEventIterator,
     Metadata,
     Query,
 )
+from clp_ffi_py.query_expression import NotExpression, OrExpression, TimeRange
 from clp_ffi_py.wildcard_query import WildcardQuery
 
 LOG_DIR: Path = Path("unittest-logs")
 
 
+class ShortReadStream:
+    """
+    Wrapper of an input stream whose `readinto` returns at most a few bytes per
+    call, which simulates a slow pipe.
+    """
+
+    def __init__(self, istream: IO[bytes], max_read_size: int):
+        self._istream: IO[bytes] = istream
+        self._max_read_size: int = max_read_size
+
+    def readinto(self, buffer: Any) -> int:
+        view: memoryview = memoryview(buffer).cast("B")
+        data: bytes = self._istream.read(min(len(view), self._max_read_size))
+        view[: len(data)] = data
+        return len(data)
+
+
 class TestCaseDecoderBase(TestCLPBase):
     """
     Class for testing clp_ffi_py.ir.Decoder.
@@ -275,6 +297,341 @@ class TestCaseDecoderDecompressZstdDefaultQuery(TestCaseDecoderBase):
         super().setUp()
 
 
+class TestCaseDecoderShortReads(TestCaseDecoderBase):
+    """
+    Tests decoding methods against uncompressed IR stream read through an input
+    stream that only returns a few bytes per read, so that most log events
+    straddle multiple reads.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = False
+        self.has_query = False
+        self.num_test_iterations = 5
+        super().setUp()
+
+    # override
+    def _decode_log_stream(
+        self, log_path: Path, query: Optional[Query]
+    ) -> Tuple[Metadata, List[LogEvent]]:
+        with open(str(log_path), "rb") as istream:
+            decoder_buffer: DecoderBuffer = DecoderBuffer(
+                ShortReadStream(istream, random.randint(1, 16)), 16
+            )
+            metadata: Metadata = Decoder.decode_preamble(decoder_buffer)
+            log_events: List[LogEvent] = []
+            while True:
+                log_event: Optional[LogEvent] = Decoder.decode_next_log_event(decoder_buffer, query)
+                if None is log_event:
+                    break
+                log_events.append(log_event)
+        return metadata, log_events
+
+
+class TestCaseDecoderPredicateStats(TestCaseDecoderBase):
+    """
+    Tests the runtime statistics of the query predicates collected while
+    decoding an uncompressed IR stream.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = False
+        self.has_query = True
+        self.num_test_iterations = 1
+        super().setUp()
+
+    def test_predicate_stats(self) -> None:
+        """
+        Tests that the predicate statistics are consistent with the decoded log
+        events, and that reordering the predicates doesn't change the results.
+        """
+        seed: int = get_current_timestamp()
+        random.seed(seed)
+        log_path: Path = self._get_log_path(0)
+        ref_metadata: Metadata
+        ref_log_events: List[LogEvent]
+        ref_metadata, ref_log_events = self._encode_random_log_stream(log_path, 5000, seed)
+
+        query: Query = Query(
+            wildcard_queries=LogGenerator.generate_random_log_type_wildcard_queries(1),
+            expression=~TimeRange(upper_bound=ref_log_events[0].get_timestamp()),
+        )
+        matched_log_events: List[LogEvent] = [
+            log_event for log_event in ref_log_events if log_event.match_query(query)
+        ]
+        metadata: Metadata
+        log_events: List[LogEvent]
+        metadata, log_events = self._decode_log_stream(log_path, query)
+        self._validate_decoded_logs(
+            ref_metadata, matched_log_events, metadata, log_events, log_path, seed
+        )
+
+        test_info: str = f"Seed: {seed}, Log Path: {log_path}"
+        predicate_stats: List[Dict[str, Union[str, int, float]]] = query.get_predicate_stats()
+        self.assertEqual(
+            {"time_range", "log_message", "attributes", "expression"},
+            {stats["predicate"] for stats in predicate_stats},
+            test_info,
+        )
+        # Each log event is either rejected by exactly one predicate or matched by all of them,
+        # regardless of how the predicates have been reordered.
+        num_rejected: int = 0
+        for stats in predicate_stats:
+            evaluations: int = int(stats["evaluations"])
+            matches: int = int(stats["matches"])
+            self.assertLessEqual(matches, evaluations, test_info)
+            self.assertGreaterEqual(matches, len(matched_log_events), test_info)
+            num_rejected += evaluations - matches
+        self.assertEqual(len(ref_log_events) - len(matched_log_events), num_rejected, test_info)
+
+        query.reset_predicate_stats()
+        predicate_stats = query.get_predicate_stats()
+        self.assertEqual(
+            ["time_range", "log_message", "attributes", "expression"],
+            [stats["predicate"] for stats in predicate_stats],
+            test_info,
+        )
+        for stats in predicate_stats:
+            self.assertEqual(0, stats["evaluations"], test_info)
+            self.assertEqual(0, stats["matches"], test_info)
+
+    def test_missing_attribute(self) -> None:
+        """
+        Tests that a query on an attribute that the stream doesn't declare fails
+        even if the log events are rejected by another predicate first.
+        """
+        ref_timestamp: int = get_current_timestamp()
+        ir_stream: bytearray = FourByteEncoder.encode_preamble_with_attributes(
+            ref_timestamp, "yyyy-MM-dd HH:mm:ss,SSS", "UTC", {"tid": int}
+        )
+        ir_stream += FourByteEncoder.encode_attributes([17])
+        ir_stream += FourByteEncoder.encode_message_and_timestamp_delta(1, b" INFO Heartbeat\n")
+        ir_stream += FourByteEncoder.encode_end_of_ir()
+
+        queries: List[Query] = [
+            Query(search_time_lower_bound=ref_timestamp + 1000, attribute_queries={"pid": 1}),
+            Query(
+                search_time_lower_bound=ref_timestamp + 1000,
+                wildcard_queries=[WildcardQuery("*Heartbeat*")],
+                attribute_queries={"pid": 1},
+            ),
+        ]
+        for query in queries:
+            decoder_buffer: DecoderBuffer = DecoderBuffer(BytesIO(bytes(ir_stream)))
+            Decoder.decode_preamble(decoder_buffer)
+            with self.assertRaises(RuntimeError, msg=str(query)):
+                Decoder.decode_next_log_event(decoder_buffer, query)
+
+
+class TestCaseDecoderFreeList(TestCaseDecoderBase):
+    """
+    Tests the reuse of deallocated log events while decoding an uncompressed IR
+    stream.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = False
+        self.has_query = False
+        self.num_test_iterations = 1
+        super().setUp()
+
+    def test_free_list(self) -> None:
+        """
+        Tests that log events discarded while decoding are reused, and that the
+        free list respects its capacity.
+        """
+        seed: int = get_current_timestamp()
+        random.seed(seed)
+        log_path: Path = self._get_log_path(0)
+        ref_log_events: List[LogEvent]
+        _, ref_log_events = self._encode_random_log_stream(log_path, 1000, seed)
+        test_info: str = f"Seed: {seed}, Log Path: {log_path}"
+
+        stats_before: Dict[str, int] = LogEvent.get_free_list_stats()
+        capacity: int = 8
+        LogEvent.set_free_list_capacity(capacity)
+        try:
+            num_decoded_log_events: int = 0
+            with open(str(log_path), "rb") as istream:
+                decoder_buffer: DecoderBuffer = DecoderBuffer(istream)
+                Decoder.decode_preamble(decoder_buffer)
+                type_ref_count: int = sys.getrefcount(LogEvent)
+                while True:
+                    log_event: Optional[LogEvent] = Decoder.decode_next_log_event(decoder_buffer)
+                    if None is log_event:
+                        break
+                    ref_log_event: LogEvent = ref_log_events[num_decoded_log_events]
+                    self.assertEqual(
+                        ref_log_event.get_log_message(), log_event.get_log_message(), test_info
+                    )
+                    self.assertEqual(
+                        ref_log_event.get_timestamp(), log_event.get_timestamp(), test_info
+                    )
+                    self.assertEqual(num_decoded_log_events, log_event.get_index(), test_info)
+                    num_decoded_log_events += 1
+                log_event = None
+                self.assertEqual(type_ref_count, sys.getrefcount(LogEvent), test_info)
+            self.assertEqual(len(ref_log_events), num_decoded_log_events, test_info)
+
+            stats: Dict[str, int] = LogEvent.get_free_list_stats()
+            self.assertEqual(capacity, stats["capacity"], test_info)
+            self.assertLessEqual(stats["size"], capacity, test_info)
+            num_hits: int = stats["hits"] - stats_before["hits"]
+            num_misses: int = stats["misses"] - stats_before["misses"]
+            self.assertEqual(num_decoded_log_events, num_hits + num_misses, test_info)
+            self.assertGreater(num_hits, 0, test_info)
+
+            LogEvent.set_free_list_capacity(0)
+            self.assertEqual(0, LogEvent.get_free_list_stats()["size"], test_info)
+        finally:
+            LogEvent.set_free_list_capacity(stats_before["capacity"])
+
+
+class TestCaseDecoderMessageIntern(TestCaseDecoderBase):
+    """
+    Tests the interning of identical log messages while decoding an
+    uncompressed IR stream.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = False
+        self.has_query = False
+        self.num_test_iterations = 1
+        super().setUp()
+
+    def test_message_intern(self) -> None:
+        """
+        Tests that log events with identical messages share the same Python
+        string when the intern cache is enabled, and only then.
+        """
+        log_path: Path = self._get_log_path(0)
+        ref_timestamp: int = get_current_timestamp()
+        metadata: Metadata = Metadata(ref_timestamp, "yyyy-MM-dd HH:mm:ss,SSS", "UTC")
+        log_messages: List[str] = [
+            " INFO Heartbeat from worker 17\n",
+            " WARN Retrying request 42 after 100 ms\n",
+        ]
+        num_log_events_per_message: int = 50
+        ref_log_events: List[LogEvent] = []
+        for log_message in log_messages:
+            for _ in range(num_log_events_per_message):
+                ref_log_events.append(
+                    LogEvent(log_message, ref_timestamp + len(ref_log_events), len(ref_log_events))
+                )
+        self._encode_log_stream(log_path, metadata, ref_log_events)
+
+        for message_intern_cache_capacity in [0, 1, 16]:
+            test_info: str = f"Message intern cache capacity: {message_intern_cache_capacity}"
+            log_events: List[LogEvent] = []
+            with open(str(log_path), "rb") as istream:
+                decoder_buffer: DecoderBuffer = DecoderBuffer(
+                    istream, message_intern_cache_capacity=message_intern_cache_capacity
+                )
+                Decoder.decode_preamble(decoder_buffer)
+                while True:
+                    log_event: Optional[LogEvent] = Decoder.decode_next_log_event(decoder_buffer)
+                    if None is log_event:
+                        break
+                    log_events.append(log_event)
+                stats: Dict[str, int] = decoder_buffer.get_message_intern_cache_stats()
+            self.assertEqual(message_intern_cache_capacity, stats["capacity"], test_info)
+            if 0 == message_intern_cache_capacity:
+                self.assertEqual(0, stats["hits"] + stats["misses"], test_info)
+            else:
+                # Only the first log event of each run of identical messages
+                # misses
+                self.assertEqual(len(log_messages), stats["misses"], test_info)
+                self.assertEqual(len(log_events) - len(log_messages), stats["hits"], test_info)
+            self.assertEqual(
+                [log_event.get_log_message() for log_event in ref_log_events],
+                [log_event.get_log_message() for log_event in log_events],
+                test_info,
+            )
+            num_distinct_message_objects: int = len(
+                {id(log_event.get_log_message()) for log_event in log_events}
+            )
+            if 0 == message_intern_cache_capacity:
+                self.assertEqual(len(log_events), num_distinct_message_objects, test_info)
+            else:
+                # Each run of identical messages shares a single string object
+                self.assertEqual(len(log_messages), num_distinct_message_objects, test_info)
+
+        with self.assertRaises(ValueError):
+            DecoderBuffer(BytesIO(), message_intern_cache_capacity=-1)
+        with self.assertRaises(ValueError):
+            DecoderBuffer(BytesIO(), message_intern_cache_capacity=2**30 + 1)
+
+    def _decode_ir_stream(
+        self, ir_stream: bytes, message_intern_cache_capacity: int
+    ) -> Tuple[List[LogEvent], Dict[str, int]]:
+        decoder_buffer: DecoderBuffer = DecoderBuffer(
+            BytesIO(ir_stream), message_intern_cache_capacity=message_intern_cache_capacity
+        )
+        Decoder.decode_preamble(decoder_buffer)
+        log_events: List[LogEvent] = []
+        while True:
+            log_event: Optional[LogEvent] = Decoder.decode_next_log_event(decoder_buffer)
+            if None is log_event:
+                break
+            log_events.append(log_event)
+        return log_events, decoder_buffer.get_message_intern_cache_stats()
+
+    def test_message_intern_ignores_attributes(self) -> None:
+        """
+        Tests that log events with identical messages but different attributes
+        share the same Python string, and keep their own attributes.
+        """
+        ref_timestamp: int = get_current_timestamp()
+        log_message: str = " INFO Heartbeat from worker 17\n"
+        num_log_events: int = 20
+        ir_stream: bytearray = FourByteEncoder.encode_preamble_with_attributes(
+            ref_timestamp, "yyyy-MM-dd HH:mm:ss,SSS", "UTC", {"tid": int}
+        )
+        for tid in range(num_log_events):
+            ir_stream += FourByteEncoder.encode_attributes([tid])
+            ir_stream += FourByteEncoder.encode_message_and_timestamp_delta(
+                1, log_message.encode()
+            )
+        ir_stream += FourByteEncoder.encode_end_of_ir()
+
+        log_events, stats = self._decode_ir_stream(bytes(ir_stream), 16)
+        self.assertEqual(num_log_events, len(log_events))
+        self.assertEqual(1, stats["misses"])
+        self.assertEqual(num_log_events - 1, stats["hits"])
+        self.assertEqual(1, len({id(log_event.get_log_message()) for log_event in log_events}))
+        for tid, log_event in enumerate(log_events):
+            self.assertEqual(log_message, log_event.get_log_message())
+            self.assertEqual({"tid": tid}, log_event.get_attributes())
+
+    def test_message_intern_invalid_utf8(self) -> None:
+        """
+        Tests that a log message that isn't valid UTF-8 is decoded, and only
+        fails when its Python string is requested, with or without the intern
+        cache.
+        """
+        ref_timestamp: int = get_current_timestamp()
+        ir_stream: bytearray = FourByteEncoder.encode_preamble(
+            ref_timestamp, "yyyy-MM-dd HH:mm:ss,SSS", "UTC"
+        )
+        for _ in range(2):
+            ir_stream += FourByteEncoder.encode_message_and_timestamp_delta(
+                1, b"Invalid \xff UTF-8 17"
+            )
+        ir_stream += FourByteEncoder.encode_end_of_ir()
+
+        for message_intern_cache_capacity in [0, 16]:
+            test_info: str = f"Message intern cache capacity: {message_intern_cache_capacity}"
+            log_events, _ = self._decode_ir_stream(bytes(ir_stream), message_intern_cache_capacity)
+            self.assertEqual(2, len(log_events), test_info)
+            for log_event in log_events:
+                with self.assertRaises(UnicodeDecodeError, msg=test_info):
+                    log_event.get_log_message()
+
+
 class TestCaseDecoderTimeRangeQueryBase(TestCaseDecoderBase):
     # override
     def _generate_random_query(
@@ -424,3 +781,182 @@ class TestCaseDecoderTimeRangeWildcardQueryZstd(TestCaseDecoderTimeRangeWildcard
         self.has_query = True
         self.num_test_iterations = 10
         super().setUp()
+
+
+class TestCaseDecoderCacheEncodedLogEvent(TestCaseDecoderTimeRangeWildcardQueryBase):
+    """
+    Tests encoding/decoding methods against uncompressed IR stream with the
+    query that specifies a search time range and wildcard queries, caching the
+    encoded log events.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = False
+        self.has_query = True
+        self.num_test_iterations = 10
+        super().setUp()
+
+    # override
+    def _decode_log_stream(
+        self, log_path: Path, query: Optional[Query]
+    ) -> Tuple[Metadata, List[LogEvent]]:
+        with open(str(log_path), "rb") as istream:
+            decoder_buffer: DecoderBuffer = DecoderBuffer(istream)
+            metadata: Metadata = Decoder.decode_preamble(decoder_buffer)
+            log_events: List[LogEvent] = []
+            while True:
+                log_event: Optional[LogEvent] = Decoder.decode_next_log_event(
+                    decoder_buffer, query, cache_encoded_log_event=True
+                )
+                if None is log_event:
+                    break
+                self._validate_cached_encoded_log_event(log_event)
+                log_events.append(log_event)
+        return metadata, log_events
+
+    def _validate_cached_encoded_log_event(self, log_event: LogEvent) -> None:
+        """
+        Validates that the cached encoded log event is a read-only view of the
+        encoded log message.
+
+        :param log_event: A log event decoded with the encoded log event cached.
+        """
+        encoded_log_event: Optional[memoryview] = log_event.get_cached_encoded_log_event()
+        self.assertIsNotNone(encoded_log_event)
+        assert None is not encoded_log_event
+        self.assertTrue(encoded_log_event.readonly)
+        self.assertEqual(
+            FourByteEncoder.encode_message(log_event.get_log_message().encode()),
+            encoded_log_event.tobytes(),
+        )
+
+
+class TestCaseDecoderExpressionQueryBase(TestCaseDecoderBase):
+    # override
+    def _generate_random_query(
+        self, ref_log_events: List[LogEvent]
+    ) -> Tuple[Query, List[LogEvent]]:
+        self.assertGreater(len(ref_log_events), 0, "The reference log event list is empty.")
+        ts_min: int = ref_log_events[0].get_timestamp()
+        ts_max: int = ref_log_events[-1].get_timestamp()
+        lower_bound: int = random.randint(ts_min, ts_max)
+        upper_bound: int = random.randint(lower_bound, ts_max)
+        wildcard_queries: List[WildcardQuery] = (
+            LogGenerator.generate_random_log_type_wildcard_queries(3)
+        )
+        query: Query = Query(
+            expression=(
+                OrExpression(wildcard_queries[0], wildcard_queries[1])
+                & NotExpression(wildcard_queries[2])
+            )
+            | ~TimeRange(lower_bound, upper_bound)
+        )
+        matched_log_events: List[LogEvent] = []
+        for log_event in ref_log_events:
+            if not log_event.match_query(query):
+                continue
+            matched_log_events.append(log_event)
+        return query, matched_log_events
+
+
+class TestCaseDecoderExpressionQuery(TestCaseDecoderExpressionQueryBase):
+    """
+    Tests encoding/decoding methods against uncompressed IR stream with the
+    query that specifies a boolean query expression.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = False
+        self.has_query = True
+        self.num_test_iterations = 10
+        super().setUp()
+
+
+class TestCaseDecoderExpressionQueryZstd(TestCaseDecoderExpressionQueryBase):
+    """
+    Tests encoding/decoding methods against zstd compressed IR stream with the
+    query that specifies a boolean query expression.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = True
+        self.has_query = True
+        self.num_test_iterations = 10
+        super().setUp()
+
+
+class TestCaseLogEventIterator(TestCaseDecoderTimeRangeWildcardQueryBase):
+    """
+    Tests the native log event iterator against zstd compressed IR stream with
+    the query that specifies a search timestamp and wildcard queries.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = True
+        self.has_query = True
+        self.num_test_iterations = 10
+        super().setUp()
+
+    # override
+    def _decode_log_stream(
+        self, log_path: Path, query: Optional[Query]
+    ) -> Tuple[Metadata, List[LogEvent]]:
+        with open(str(log_path), "rb") as istream:
+            decoder_buffer: DecoderBuffer = DecoderBuffer(istream)
+            metadata: Metadata = Decoder.decode_preamble(decoder_buffer)
+            log_events: List[LogEvent] = list(LogEventIterator(decoder_buffer, query))
+        return metadata, log_events
+
+    def test_exhausted_iterator(self) -> None:
+        """
+        Tests that the iterator stays exhausted once the end of the IR stream is
+        reached, and that it can't be created before the preamble is decoded.
+        """
+        seed: int = get_current_timestamp()
+        random.seed(seed)
+        log_path: Path = self._get_log_path(0)
+        ref_log_events: List[LogEvent]
+        _, ref_log_events = self._encode_random_log_stream(log_path, 10, seed)
+        test_info: str = f"Seed: {seed}, Log Path: {log_path}"
+
+        with open(str(log_path), "rb") as istream:
+            decoder_buffer: DecoderBuffer = DecoderBuffer(istream)
+            with self.assertRaises(RuntimeError):
+                LogEventIterator(decoder_buffer)
+            Decoder.decode_preamble(decoder_buffer)
+            log_event_iterator: LogEventIterator = LogEventIterator(decoder_buffer)
+            self.assertIs(log_event_iterator, iter(log_event_iterator), test_info)
+            self.assertEqual(len(ref_log_events), len(list(log_event_iterator)), test_info)
+            self.assertIsNone(next(log_event_iterator, None), test_info)
+
+    def test_reader_iteration(self) -> None:
+        """
+        Tests that a reader is an iterable, not an iterator, and that each of
+        its iterators continues from the log events the previous one left
+        unread.
+        """
+        seed: int = get_current_timestamp()
+        random.seed(seed)
+        log_path: Path = self._get_log_path(0)
+        ref_log_events: List[LogEvent]
+        _, ref_log_events = self._encode_random_log_stream(log_path, 10, seed)
+        test_info: str = f"Seed: {seed}, Log Path: {log_path}"
+
+        with open(str(log_path), "rb") as istream:
+            reader: ClpIrStreamReader = ClpIrStreamReader(istream)
+            self.assertFalse(hasattr(reader, "__next__"), test_info)
+            first_iterator: LogEventIterator = iter(reader)
+            self.assertIsNot(first_iterator, iter(reader), test_info)
+            first_log_event: Optional[LogEvent] = next(first_iterator, None)
+            self.assertIsNotNone(first_log_event, test_info)
+            remaining_log_events: List[LogEvent] = list(reader)
+        self.assertEqual(len(ref_log_events) - 1, len(remaining_log_events), test_info)
+        self.assertEqual(
+            ref_log_events[1].get_log_message(),
+            remaining_log_events[0].get_log_message(),
+            test_info,
+        )
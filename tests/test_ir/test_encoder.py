@@ -1,6 +1,24 @@
+import gc
+import os
+import tempfile
+import threading
+import time
+import weakref
+from io import BytesIO
+from typing import Dict, IO, List, Optional, Tuple, Union
+
 from test_ir.test_utils import TestCLPBase
+from zstandard import ZstdDecompressor
 
-from clp_ffi_py.ir import FourByteEncoder
+from clp_ffi_py.ir import (
+    AsyncClpIrStreamWriter,
+    ClpIrStreamReader,
+    ClpIrStreamWriter,
+    FourByteEncoder,
+    LogEvent,
+    Query,
+)
+from clp_ffi_py.query_expression import AttributeEquals
 
 
 class TestCaseFourByteEncoder(TestCLPBase):
@@ -40,3 +58,760 @@ class TestCaseFourByteEncoder(TestCLPBase):
         encoded_message: bytearray = FourByteEncoder.encode_message(log_message.encode())
         encoded_ts_delta: bytearray = FourByteEncoder.encode_timestamp_delta(timestamp_delta)
         self.assertEqual(encoded_message_and_ts_delta, encoded_message + encoded_ts_delta)
+
+    def test_invalid_arguments(self) -> None:
+        """
+        This test checks that the encoding methods only accept positional
+        arguments of the expected types.
+        """
+        log_message: bytes = b"This is a test message: Do NOT Reply!"
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_message()  # type: ignore
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_message(log_message, log_message)  # type: ignore
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_message(msg=log_message)  # type: ignore
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_message(log_message.decode())  # type: ignore
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_timestamp_delta(str(0))  # type: ignore
+        self.assertEqual(
+            FourByteEncoder.encode_message(log_message),
+            FourByteEncoder.encode_message(memoryview(log_message)),  # type: ignore
+        )
+
+    def test_encode_batch(self) -> None:
+        """
+        This test checks if the result of encode_batch is consistent with the
+        concatenation of encode_message_and_timestamp_delta, for both a sequence
+        of log messages and a buffer with offsets.
+        """
+        ref_timestamp: int = 1679711330789
+        timestamps: List[int] = [1679711330789, 1679711330790, 1679711330690, 1679711331789]
+        log_messages: List[bytes] = [
+            b"This is a test message: Do NOT Reply!",
+            b"Received request 0x1f from 10.0.0.1 after 2.5 seconds",
+            b"",
+            "Grüße from task 3190".encode(),
+        ]
+        expected: bytearray = bytearray()
+        last_timestamp: int = ref_timestamp
+        for timestamp, log_message in zip(timestamps, log_messages):
+            expected += FourByteEncoder.encode_message_and_timestamp_delta(
+                timestamp - last_timestamp, log_message
+            )
+            last_timestamp = timestamp
+
+        self.assertEqual(
+            expected, FourByteEncoder.encode_batch(timestamps, log_messages, ref_timestamp)
+        )
+        self.assertEqual(
+            expected,
+            FourByteEncoder.encode_batch(tuple(timestamps), iter(log_messages), ref_timestamp),
+        )
+
+        offsets: List[int] = [0]
+        for log_message in log_messages:
+            offsets.append(offsets[-1] + len(log_message))
+        self.assertEqual(
+            expected,
+            FourByteEncoder.encode_batch(
+                timestamps, b"".join(log_messages), ref_timestamp, offsets=offsets
+            ),
+        )
+        # The offsets don't have to start from the beginning of the buffer
+        self.assertEqual(
+            expected,
+            FourByteEncoder.encode_batch(
+                timestamps,
+                bytearray(b"prefix" + b"".join(log_messages)),
+                ref_timestamp,
+                offsets=[offset + len(b"prefix") for offset in offsets],
+            ),
+        )
+        self.assertEqual(bytearray(), FourByteEncoder.encode_batch([], [], ref_timestamp))
+
+    def test_encode_batch_invalid_arguments(self) -> None:
+        """
+        This test checks that encode_batch rejects inconsistent batches.
+        """
+        log_messages: List[bytes] = [b"message 0", b"message 1"]
+        buffer: bytes = b"".join(log_messages)
+        with self.assertRaises(ValueError):
+            FourByteEncoder.encode_batch([0], log_messages, 0)
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_batch([0, 1], [b"message 0", "message 1"], 0)  # type: ignore
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_batch([0, "1"], log_messages, 0)  # type: ignore
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_batch([0, 1], log_messages)  # type: ignore
+        with self.assertRaises(ValueError):
+            FourByteEncoder.encode_batch([0, 1], buffer, 0, offsets=[0, 9])
+        with self.assertRaises(ValueError):
+            FourByteEncoder.encode_batch([0, 1], buffer, 0, offsets=[0, 10, 9])
+        with self.assertRaises(ValueError):
+            FourByteEncoder.encode_batch([0, 1], buffer, 0, offsets=[0, 9, len(buffer) + 1])
+        with self.assertRaises(ValueError):
+            FourByteEncoder.encode_batch([0, 1], buffer, 0, offsets=[-1, 9, len(buffer)])
+
+    def test_encode_into(self) -> None:
+        """
+        This test checks that encode_into writes the same bytes as the methods
+        that return a new bytearray, and that it reports the missing space when
+        the buffer is too small.
+        """
+        timestamp_delta: int = -3190
+        log_message: bytes = b"This is a test message: Do NOT Reply!"
+        expected: bytearray = FourByteEncoder.encode_message_and_timestamp_delta(
+            timestamp_delta, log_message
+        )
+        offset: int = 7
+        buffer: bytearray = bytearray(b"\xff" * (offset + len(expected) + 3))
+        self.assertEqual(
+            len(expected), FourByteEncoder.encode_into(buffer, offset, log_message, timestamp_delta)
+        )
+        self.assertEqual(b"\xff" * offset, buffer[:offset])
+        self.assertEqual(expected, buffer[offset : offset + len(expected)])
+        self.assertEqual(b"\xff" * 3, buffer[offset + len(expected) :])
+
+        expected_message: bytearray = FourByteEncoder.encode_message(log_message)
+        view: memoryview = memoryview(buffer)
+        self.assertEqual(
+            len(expected_message), FourByteEncoder.encode_into(view[offset:], 0, log_message)
+        )
+        self.assertEqual(expected_message, buffer[offset : offset + len(expected_message)])
+
+        # The buffer is left untouched if it's too small
+        small_buffer: bytearray = bytearray(len(expected) - 1)
+        self.assertEqual(
+            -2, FourByteEncoder.encode_into(small_buffer, 1, log_message, timestamp_delta)
+        )
+        self.assertEqual(bytearray(len(expected) - 1), small_buffer)
+
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_into(bytes(buffer), 0, log_message)
+        with self.assertRaises(ValueError):
+            FourByteEncoder.encode_into(buffer, len(buffer) + 1, log_message)
+        with self.assertRaises(ValueError):
+            FourByteEncoder.encode_into(buffer, -1, log_message)
+
+    def test_encode_batch_into(self) -> None:
+        """
+        This test checks that encode_batch_into writes the same bytes as
+        encode_batch.
+        """
+        ref_timestamp: int = 1679711330789
+        timestamps: List[int] = [1679711330789, 1679711330790, 1679711331789]
+        log_messages: List[bytes] = [b"message 0", b"message with value 1", b"message 2.0"]
+        expected: bytearray = FourByteEncoder.encode_batch(timestamps, log_messages, ref_timestamp)
+        buffer: bytearray = bytearray(len(expected) + 1)
+        self.assertEqual(
+            len(expected),
+            FourByteEncoder.encode_batch_into(buffer, 1, timestamps, log_messages, ref_timestamp),
+        )
+        self.assertEqual(expected, buffer[1:])
+        self.assertEqual(
+            -1,
+            FourByteEncoder.encode_batch_into(buffer, 2, timestamps, log_messages, ref_timestamp),
+        )
+
+        # A batch discarded for being too large doesn't leak into the next one
+        buffer = bytearray(len(expected))
+        self.assertEqual(
+            len(expected),
+            FourByteEncoder.encode_batch_into(buffer, 0, timestamps, log_messages, ref_timestamp),
+        )
+        self.assertEqual(expected, buffer)
+
+        with self.assertRaises(TypeError):
+            FourByteEncoder.encode_batch_into(
+                bytes(buffer), 0, timestamps, log_messages, ref_timestamp
+            )
+
+    def test_encode_batch_in_parallel(self) -> None:
+        """
+        This test checks that encoding a batch with multiple threads gives the
+        same result as encoding it with a single thread, including the timestamp
+        deltas across the chunks encoded by different threads.
+        """
+        ref_timestamp: int = 1679711330789
+        num_log_events: int = 50000
+        timestamps: List[int] = [
+            ref_timestamp + (idx * 7919) % 1000 - 500 + idx for idx in range(num_log_events)
+        ]
+        log_messages: List[bytes] = [
+            f"Request {idx} from 10.0.{idx % 256}.1 took {idx / 7:.3f} ms".encode()
+            for idx in range(num_log_events)
+        ]
+        expected: bytearray = FourByteEncoder.encode_batch(timestamps, log_messages, ref_timestamp)
+        for num_threads in [0, 2, 3, 16]:
+            self.assertEqual(
+                expected,
+                FourByteEncoder.encode_batch(
+                    timestamps, log_messages, ref_timestamp, num_threads=num_threads
+                ),
+                f"Number of threads: {num_threads}",
+            )
+
+        buffer: bytearray = bytearray(len(expected))
+        self.assertEqual(
+            len(expected),
+            FourByteEncoder.encode_batch_into(
+                buffer, 0, timestamps, log_messages, ref_timestamp, num_threads=4
+            ),
+        )
+        self.assertEqual(expected, buffer)
+
+        with self.assertRaises(OverflowError):
+            FourByteEncoder.encode_batch(timestamps, log_messages, ref_timestamp, num_threads=-1)
+
+    def test_encode_message_matches_clp_tokenizer(self) -> None:
+        """
+        This test checks that the messages encoded with the vectorized
+        tokenizer, with both the AVX2 and the scalar byte classifiers, are
+        byte-identical to the ones encoded with CLP's tokenizer,
+        including messages with tokens crossing 64-byte boundaries, non-ASCII
+        bytes, placeholder bytes, and variables too long for a one-byte length.
+        """
+        log_messages: List[bytes] = [
+            b"",
+            b" ",
+            b"0",
+            b"Do NOT Reply!",
+            b"Request 42 from 10.0.0.1 took 3.14 ms",
+            b"key=value key2=Value3 =x a=b= deadbeef 0xCAFE ab a1 -12 +3.5 -.5 1e10",
+            b"\x11\x12\x13 escaped \\ placeholders \\\x11 var\x12=2",
+            "非ASCII 字符 ünïcödé 123 ñ=ok".encode(),
+            b"\xff\xfe invalid \xc3 utf8 \xc3\xa912",
+            b"a" * 63 + b"1" + b"b" * 64 + b" trailing",
+            b" " * 64 + b"x=y" + b" " * 61 + b"123",
+            b"/path/to/file_" + b"9" * 300 + b".log",
+            b"path=" + b"abc/" * 20000,
+            b"word " * 100 + b"0123456789abcdef" * 30,
+        ]
+        rng_state: int = 1
+        alphabet: bytes = b"aF9 =x0.-_+\\/:,\x11\x12\x13\xff\xc3gZ"
+        for _ in range(2000):
+            rng_state = (rng_state * 1103515245 + 12345) % 2**31
+            length: int = rng_state % 200
+            message: bytearray = bytearray()
+            for _ in range(length):
+                rng_state = (rng_state * 1103515245 + 12345) % 2**31
+                message.append(alphabet[(rng_state >> 16) % len(alphabet)])
+            log_messages.append(bytes(message))
+
+        # The vectorized classifier is only used if the CPU supports it, so the
+        # scalar fallback is forced as well to test both on any machine.
+        try:
+            for vectorized in [True, False]:
+                FourByteEncoder._set_vectorized_tokenizer_enabled(vectorized)
+                for log_message in log_messages:
+                    self.assertEqual(
+                        FourByteEncoder._encode_message_with_clp_tokenizer(log_message),
+                        FourByteEncoder.encode_message(log_message),
+                        f"Vectorized: {vectorized}, log message: {log_message[:100]!r}",
+                    )
+        finally:
+            FourByteEncoder._set_vectorized_tokenizer_enabled(True)
+
+
+class TestCaseClpIrStreamWriter(TestCLPBase):
+    """
+    Class for testing clp_ffi_py.ir.ClpIrStreamWriter.
+    """
+
+    ref_timestamp: int = 1679711330789
+    timestamp_format: str = "yyyy-MM-dd HH:mm:ss"
+    timezone: str = "America/Toronto"
+    log_events: List[Tuple[int, str]] = [
+        (1679711330789, " INFO Service started with 4 workers\n"),
+        (1679711330790, " INFO Received request 0x1f from 10.0.0.1\n"),
+        (1679711330690, " WARN Clock skew of -100 ms detected\n"),
+        (1679711331789, " ERROR Grüße: request 3190 failed after 2.5 seconds\n"),
+        (1679711331789, ""),
+    ]
+
+    @staticmethod
+    def _get_expected_ir_stream() -> bytes:
+        ir_stream: bytearray = FourByteEncoder.encode_preamble(
+            TestCaseClpIrStreamWriter.ref_timestamp,
+            TestCaseClpIrStreamWriter.timestamp_format,
+            TestCaseClpIrStreamWriter.timezone,
+        )
+        last_timestamp: int = TestCaseClpIrStreamWriter.ref_timestamp
+        for timestamp, log_message in TestCaseClpIrStreamWriter.log_events:
+            ir_stream += FourByteEncoder.encode_message_and_timestamp_delta(
+                timestamp - last_timestamp, log_message.encode()
+            )
+            last_timestamp = timestamp
+        ir_stream += FourByteEncoder.encode_end_of_ir()
+        return bytes(ir_stream)
+
+    def _create_writer(self, sink: BytesIO, **kwargs: object) -> ClpIrStreamWriter:
+        return ClpIrStreamWriter(
+            sink,
+            TestCaseClpIrStreamWriter.ref_timestamp,
+            TestCaseClpIrStreamWriter.timestamp_format,
+            TestCaseClpIrStreamWriter.timezone,
+            **kwargs,  # type: ignore
+        )
+
+    def _write_log_events(self, writer: ClpIrStreamWriter) -> None:
+        for timestamp, log_message in TestCaseClpIrStreamWriter.log_events:
+            writer.write_log_event(timestamp, log_message)
+
+    def test_uncompressed_stream(self) -> None:
+        """
+        Tests that the uncompressed IR stream is identical to the one encoded by
+        FourByteEncoder, regardless of the flush threshold.
+        """
+        for flush_threshold in [0, 16, 65536]:
+            sink: BytesIO = BytesIO()
+            with self._create_writer(
+                sink, enable_compression=False, flush_threshold=flush_threshold
+            ) as writer:
+                self._write_log_events(writer)
+                self.assertEqual(
+                    len(TestCaseClpIrStreamWriter.log_events), writer.get_num_log_events()
+                )
+            self.assertEqual(
+                self._get_expected_ir_stream(),
+                sink.getvalue(),
+                f"Flush threshold: {flush_threshold}",
+            )
+
+    def test_compressed_stream(self) -> None:
+        """
+        Tests that the compressed IR stream can be decompressed and decoded.
+        """
+        for flush_threshold in [0, 16, 65536]:
+            sink: BytesIO = BytesIO()
+            with self._create_writer(sink, flush_threshold=flush_threshold) as writer:
+                self._write_log_events(writer)
+            self.assertEqual(
+                self._get_expected_ir_stream(),
+                ZstdDecompressor().decompressobj().decompress(sink.getvalue()),
+                f"Flush threshold: {flush_threshold}",
+            )
+
+            sink.seek(0)
+            reader: ClpIrStreamReader = ClpIrStreamReader(sink)
+            log_events: List[LogEvent] = list(reader)
+            self.assertEqual(len(TestCaseClpIrStreamWriter.log_events), len(log_events))
+            for idx, (timestamp, log_message) in enumerate(TestCaseClpIrStreamWriter.log_events):
+                self._check_log_event(log_events[idx], log_message, timestamp, idx)
+
+    def test_flush(self) -> None:
+        """
+        Tests that the log events are only written to the sink once the buffer
+        reaches the flush threshold, and that a flushed compressed stream can
+        be decompressed before the writer is closed.
+        """
+        sink: BytesIO = BytesIO()
+        writer: ClpIrStreamWriter = self._create_writer(sink)
+        self._write_log_events(writer)
+        self.assertEqual(b"", sink.getvalue())
+        writer.flush()
+        expected_ir_stream: bytes = self._get_expected_ir_stream()
+        self.assertEqual(
+            expected_ir_stream[:-1],
+            ZstdDecompressor().decompressobj().decompress(sink.getvalue()),
+        )
+        writer.close()
+        self.assertEqual(
+            expected_ir_stream, ZstdDecompressor().decompressobj().decompress(sink.getvalue())
+        )
+
+    def test_logtype_cache(self) -> None:
+        """
+        Tests that the logtype cache doesn't change the IR stream, and that its
+        statistics count the log messages whose logtype was cached.
+        """
+        sink: BytesIO = BytesIO()
+        with self._create_writer(sink, enable_compression=False) as writer:
+            self.assertEqual(
+                {"capacity": 0, "hits": 0, "misses": 0}, writer.get_logtype_cache_stats()
+            )
+
+        num_repetitions: int = 10
+        log_events: List[Tuple[int, str]] = TestCaseClpIrStreamWriter.log_events
+        expected_ir_stream: bytearray = FourByteEncoder.encode_preamble(
+            TestCaseClpIrStreamWriter.ref_timestamp,
+            TestCaseClpIrStreamWriter.timestamp_format,
+            TestCaseClpIrStreamWriter.timezone,
+        )
+        last_timestamp: int = TestCaseClpIrStreamWriter.ref_timestamp
+        for timestamp, log_message in log_events:
+            for repetition in range(num_repetitions):
+                expected_ir_stream += FourByteEncoder.encode_message_and_timestamp_delta(
+                    timestamp + repetition - last_timestamp,
+                    log_message.replace("4", str(repetition)).encode(),
+                )
+                last_timestamp = timestamp + repetition
+        expected_ir_stream += FourByteEncoder.encode_end_of_ir()
+
+        sink = BytesIO()
+        with self._create_writer(
+            sink, enable_compression=False, logtype_cache_capacity=64
+        ) as writer:
+            for timestamp, log_message in log_events:
+                for repetition in range(num_repetitions):
+                    writer.write_log_event(
+                        timestamp + repetition, log_message.replace("4", str(repetition))
+                    )
+            stats: Dict[str, int] = writer.get_logtype_cache_stats()
+        self.assertEqual(bytes(expected_ir_stream), sink.getvalue())
+        self.assertEqual(64, stats["capacity"])
+        # Each log message is repeated with different variables, so only the
+        # first repetition misses.
+        self.assertEqual(len(log_events), stats["misses"])
+        self.assertEqual((num_repetitions - 1) * len(log_events), stats["hits"])
+
+        with self.assertRaises(ValueError):
+            self._create_writer(BytesIO(), logtype_cache_capacity=-1)
+        with self.assertRaises(ValueError):
+            self._create_writer(BytesIO(), logtype_cache_capacity=2**30 + 1)
+
+    def test_attributes(self) -> None:
+        """
+        Tests that the attributes declared by the attribute table are written
+        with each log event, identically to the FourByteEncoder methods, and
+        that they're decoded as the log events' attributes.
+        """
+        attribute_table: Dict[str, type] = {"level": str, "request_id": int}
+        attributes: List[Dict[str, Optional[Union[str, int]]]] = [
+            {"level": "INFO", "request_id": 3190},
+            {"request_id": -1},
+            {"level": "WARN"},
+            {"level": "ERROR", "request_id": 3190},
+            {},
+        ]
+        expected_attributes: List[Dict[str, Optional[Union[str, int]]]] = [
+            {name: event_attributes.get(name) for name in attribute_table}
+            for event_attributes in attributes
+        ]
+        log_events: List[Tuple[int, str]] = TestCaseClpIrStreamWriter.log_events
+
+        expected_ir_stream: bytearray = FourByteEncoder.encode_preamble_with_attributes(
+            TestCaseClpIrStreamWriter.ref_timestamp,
+            TestCaseClpIrStreamWriter.timestamp_format,
+            TestCaseClpIrStreamWriter.timezone,
+            attribute_table,
+        )
+        last_timestamp: int = TestCaseClpIrStreamWriter.ref_timestamp
+        for idx, (timestamp, log_message) in enumerate(log_events):
+            expected_ir_stream += FourByteEncoder.encode_attributes(
+                list(expected_attributes[idx].values())
+            )
+            expected_ir_stream += FourByteEncoder.encode_message_and_timestamp_delta(
+                timestamp - last_timestamp, log_message.encode()
+            )
+            last_timestamp = timestamp
+        expected_ir_stream += FourByteEncoder.encode_end_of_ir()
+
+        sink: BytesIO = BytesIO()
+        with self._create_writer(
+            sink, enable_compression=False, attribute_table=attribute_table
+        ) as writer:
+            for idx, (timestamp, log_message) in enumerate(log_events):
+                writer.write_log_event(timestamp, log_message, attributes[idx])
+            with self.assertRaises(ValueError):
+                writer.write_log_event(0, "log message", {"thread": "main"})
+            with self.assertRaises(ValueError):
+                writer.write_log_event(0, "log message", {"request_id": "3190"})
+            with self.assertRaises(TypeError):
+                writer.write_log_event(0, "log message", {"request_id": 0.5})
+            self.assertEqual(len(log_events), writer.get_num_log_events())
+        self.assertEqual(bytes(expected_ir_stream), sink.getvalue())
+
+        sink.seek(0)
+        decoded_log_events: List[LogEvent] = list(
+            ClpIrStreamReader(sink, enable_compression=False)
+        )
+        self.assertEqual(len(log_events), len(decoded_log_events))
+        for idx, (timestamp, log_message) in enumerate(log_events):
+            self._check_log_event(decoded_log_events[idx], log_message, timestamp, idx)
+            self.assertEqual(expected_attributes[idx], decoded_log_events[idx].get_attributes())
+
+        sink.seek(0)
+        query: Query = Query(expression=AttributeEquals("request_id", 3190))
+        matched_log_events: List[LogEvent] = list(
+            ClpIrStreamReader(sink, enable_compression=False).search(query)
+        )
+        self.assertEqual([0, 3], [log_event.get_index() for log_event in matched_log_events])
+
+        with self.assertRaises(TypeError):
+            self._create_writer(BytesIO(), attribute_table={"request_id": float})
+        with self._create_writer(BytesIO()) as writer:
+            with self.assertRaises(ValueError):
+                writer.write_log_event(0, "log message", {"level": "INFO"})
+
+    def test_file_descriptor(self) -> None:
+        """
+        Tests writing the IR stream to a file descriptor.
+        """
+        with tempfile.TemporaryFile() as temp_file:
+            with ClpIrStreamWriter(
+                temp_file.fileno(),
+                TestCaseClpIrStreamWriter.ref_timestamp,
+                TestCaseClpIrStreamWriter.timestamp_format,
+                TestCaseClpIrStreamWriter.timezone,
+                enable_compression=False,
+            ) as writer:
+                self._write_log_events(writer)
+            os.lseek(temp_file.fileno(), 0, os.SEEK_SET)
+            self.assertEqual(self._get_expected_ir_stream(), temp_file.read())
+
+    def test_invalid_usage(self) -> None:
+        """
+        Tests the writer with invalid arguments, and after being closed.
+        """
+        with self.assertRaises(TypeError):
+            self._create_writer("sink")  # type: ignore
+        with self.assertRaises(ValueError):
+            self._create_writer(BytesIO(), compression_level=1000)
+        with self.assertRaises(ValueError):
+            self._create_writer(BytesIO(), flush_threshold=-1)
+
+        sink: BytesIO = BytesIO()
+        writer: ClpIrStreamWriter = self._create_writer(sink, enable_compression=False)
+        with self.assertRaises(TypeError):
+            writer.write_log_event(str(0), "log message")  # type: ignore
+        with self.assertRaises(TypeError):
+            writer.write_log_event(0, 0)  # type: ignore
+        writer.close()
+        writer.close()
+        with self.assertRaises(ValueError):
+            writer.write_log_event(0, "log message")
+        with self.assertRaises(ValueError):
+            writer.flush()
+        self.assertEqual(bytes(FourByteEncoder.encode_end_of_ir()), sink.getvalue()[-1:])
+
+
+class TestCaseAsyncClpIrStreamWriter(TestCLPBase):
+    """
+    Class for testing clp_ffi_py.ir.AsyncClpIrStreamWriter.
+    """
+
+    ref_timestamp: int = TestCaseClpIrStreamWriter.ref_timestamp
+    timestamp_format: str = TestCaseClpIrStreamWriter.timestamp_format
+    timezone: str = TestCaseClpIrStreamWriter.timezone
+    log_events: List[Tuple[int, str]] = TestCaseClpIrStreamWriter.log_events
+
+    def _create_writer(self, sink: object, **kwargs: object) -> AsyncClpIrStreamWriter:
+        return AsyncClpIrStreamWriter(
+            sink,  # type: ignore
+            TestCaseAsyncClpIrStreamWriter.ref_timestamp,
+            TestCaseAsyncClpIrStreamWriter.timestamp_format,
+            TestCaseAsyncClpIrStreamWriter.timezone,
+            **kwargs,  # type: ignore
+        )
+
+    def _write_log_events(self, writer: AsyncClpIrStreamWriter) -> None:
+        for timestamp, log_message in TestCaseAsyncClpIrStreamWriter.log_events:
+            self.assertTrue(writer.write_log_event(timestamp, log_message))
+
+    def _read_file(self, file: IO[bytes]) -> bytes:
+        os.lseek(file.fileno(), 0, os.SEEK_SET)
+        return file.read()
+
+    def test_uncompressed_stream(self) -> None:
+        """
+        Tests that the uncompressed IR stream is identical to the one encoded by
+        FourByteEncoder, regardless of the queue capacity and flush threshold.
+        """
+        for queue_capacity in [1, 2, 65536]:
+            for flush_threshold in [0, 65536]:
+                with tempfile.TemporaryFile() as temp_file:
+                    with self._create_writer(
+                        temp_file,
+                        enable_compression=False,
+                        queue_capacity=queue_capacity,
+                        flush_threshold=flush_threshold,
+                    ) as writer:
+                        self._write_log_events(writer)
+                        self.assertEqual(
+                            len(TestCaseAsyncClpIrStreamWriter.log_events),
+                            writer.get_num_log_events(),
+                        )
+                    self.assertEqual(
+                        TestCaseClpIrStreamWriter._get_expected_ir_stream(),
+                        self._read_file(temp_file),
+                        f"Queue capacity: {queue_capacity}, flush threshold: {flush_threshold}",
+                    )
+
+    def test_compressed_stream(self) -> None:
+        """
+        Tests that the compressed IR stream can be decompressed and decoded.
+        """
+        with tempfile.TemporaryFile() as temp_file:
+            with self._create_writer(temp_file.fileno()) as writer:
+                self._write_log_events(writer)
+            self.assertEqual(
+                TestCaseClpIrStreamWriter._get_expected_ir_stream(),
+                ZstdDecompressor().decompressobj().decompress(self._read_file(temp_file)),
+            )
+
+            os.lseek(temp_file.fileno(), 0, os.SEEK_SET)
+            reader: ClpIrStreamReader = ClpIrStreamReader(temp_file)
+            log_events: List[LogEvent] = list(reader)
+            self.assertEqual(len(TestCaseAsyncClpIrStreamWriter.log_events), len(log_events))
+            for idx, (timestamp, log_message) in enumerate(
+                TestCaseAsyncClpIrStreamWriter.log_events
+            ):
+                self._check_log_event(log_events[idx], log_message, timestamp, idx)
+
+    def test_sink_reference(self) -> None:
+        """
+        Tests that the writer keeps the sink alive until it's deallocated, so
+        that the sink's file descriptor isn't closed under the background
+        thread.
+        """
+        with tempfile.TemporaryDirectory() as temp_dir:
+            path: str = os.path.join(temp_dir, "stream.clp")
+            sink: Optional[IO[bytes]] = open(path, "wb")
+            sink_ref: weakref.ref[IO[bytes]] = weakref.ref(sink)  # type: ignore
+            writer: Optional[AsyncClpIrStreamWriter] = self._create_writer(
+                sink, enable_compression=False
+            )
+            sink = None
+            gc.collect()
+            self.assertIsNotNone(sink_ref())
+
+            assert writer is not None
+            self._write_log_events(writer)
+            writer.close()
+            self.assertIsNotNone(sink_ref())
+            writer = None
+            gc.collect()
+            self.assertIsNone(sink_ref())
+
+            with open(path, "rb") as file:
+                self.assertEqual(TestCaseClpIrStreamWriter._get_expected_ir_stream(), file.read())
+
+    def test_flush(self) -> None:
+        """
+        Tests that `flush` waits until all the enqueued log events are written,
+        and that the flush interval bounds how long log events stay buffered.
+        """
+        expected_ir_stream: bytes = TestCaseClpIrStreamWriter._get_expected_ir_stream()
+        with tempfile.TemporaryFile() as temp_file:
+            writer: AsyncClpIrStreamWriter = self._create_writer(
+                temp_file, flush_interval_ms=3600 * 1000
+            )
+            self._write_log_events(writer)
+            writer.flush()
+            self.assertEqual(
+                expected_ir_stream[:-1],
+                ZstdDecompressor().decompressobj().decompress(self._read_file(temp_file)),
+            )
+            writer.close()
+            self.assertEqual(
+                expected_ir_stream,
+                ZstdDecompressor().decompressobj().decompress(self._read_file(temp_file)),
+            )
+
+        with tempfile.TemporaryFile() as temp_file:
+            with self._create_writer(
+                temp_file, enable_compression=False, flush_interval_ms=10
+            ) as writer:
+                self._write_log_events(writer)
+                deadline: float = time.monotonic() + 10
+                while time.monotonic() < deadline:
+                    if expected_ir_stream[:-1] == self._read_file(temp_file):
+                        break
+                    time.sleep(0.01)
+                self.assertEqual(expected_ir_stream[:-1], self._read_file(temp_file))
+
+    def test_concurrent_writes(self) -> None:
+        """
+        Tests writing log events from multiple threads into a small queue, with
+        each overflow policy.
+        """
+        num_threads: int = 4
+        num_log_events_per_thread: int = 2000
+        for overflow_policy in ["block", "drop"]:
+            with tempfile.TemporaryFile() as temp_file:
+                writer: AsyncClpIrStreamWriter = self._create_writer(
+                    temp_file, queue_capacity=4, overflow_policy=overflow_policy
+                )
+
+                def write_log_events(thread_idx: int) -> None:
+                    for idx in range(num_log_events_per_thread):
+                        writer.write_log_event(
+                            TestCaseAsyncClpIrStreamWriter.ref_timestamp + idx,
+                            f" INFO Thread {thread_idx} wrote log event {idx}\n",
+                        )
+
+                threads: List[threading.Thread] = [
+                    threading.Thread(target=write_log_events, args=(thread_idx,))
+                    for thread_idx in range(num_threads)
+                ]
+                for thread in threads:
+                    thread.start()
+                for thread in threads:
+                    thread.join()
+                writer.close()
+
+                num_log_events: int = writer.get_num_log_events()
+                num_dropped_log_events: int = writer.get_num_dropped_log_events()
+                self.assertEqual(
+                    num_threads * num_log_events_per_thread,
+                    num_log_events + num_dropped_log_events,
+                )
+                if "block" == overflow_policy:
+                    self.assertEqual(0, num_dropped_log_events)
+
+                os.lseek(temp_file.fileno(), 0, os.SEEK_SET)
+                log_events: List[LogEvent] = list(ClpIrStreamReader(temp_file))
+                self.assertEqual(num_log_events, len(log_events))
+
+    def test_invalid_usage(self) -> None:
+        """
+        Tests the writer with invalid arguments, after a failed write, and after
+        being closed.
+        """
+        with self.assertRaises(TypeError):
+            self._create_writer("sink")
+        with self.assertRaises(OSError):
+            self._create_writer(BytesIO())
+        with tempfile.TemporaryFile() as temp_file:
+            with self.assertRaises(ValueError):
+                self._create_writer(temp_file, compression_level=1000)
+            with self.assertRaises(ValueError):
+                self._create_writer(temp_file, queue_capacity=0)
+            with self.assertRaises(ValueError):
+                self._create_writer(temp_file, flush_interval_ms=0)
+            with self.assertRaises(ValueError):
+                self._create_writer(temp_file, flush_threshold=-1)
+            with self.assertRaises(ValueError):
+                self._create_writer(temp_file, overflow_policy="wait")
+
+            writer: AsyncClpIrStreamWriter = self._create_writer(
+                temp_file, enable_compression=False
+            )
+            with self.assertRaises(TypeError):
+                writer.write_log_event(str(0), "log message")  # type: ignore
+            with self.assertRaises(TypeError):
+                writer.write_log_event(0, 0)  # type: ignore
+            writer.close()
+            writer.close()
+            with self.assertRaises(ValueError):
+                writer.write_log_event(0, "log message")
+            with self.assertRaises(ValueError):
+                writer.flush()
+            self.assertEqual(
+                bytes(FourByteEncoder.encode_end_of_ir()), self._read_file(temp_file)[-1:]
+            )
+
+        with tempfile.NamedTemporaryFile() as temp_file:
+            read_only_fd: int = os.open(temp_file.name, os.O_RDONLY)
+            try:
+                writer = self._create_writer(read_only_fd)
+                writer.write_log_event(0, "log message")
+                with self.assertRaises(OSError):
+                    writer.flush()
+                with self.assertRaises(OSError):
+                    writer.close()
+            finally:
+                os.close(read_only_fd)
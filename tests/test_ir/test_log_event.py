@@ -1,11 +1,13 @@
 import pickle
 from datetime import tzinfo
-from typing import Optional
+from io import BytesIO
+from typing import Any, Dict, List, Optional, Union
 
 import dateutil.tz
 from test_ir.test_utils import TestCLPBase
 
-from clp_ffi_py.ir import LogEvent, Metadata
+from clp_ffi_py.ir import Decoder, DecoderBuffer, FourByteEncoder, LogEvent, Metadata
+from clp_ffi_py.utils import get_formatted_timestamp
 
 
 class TestCaseLogEvent(TestCLPBase):
@@ -55,6 +57,39 @@ class TestCaseLogEvent(TestCLPBase):
         log_event = LogEvent(timestamp=timestamp, log_message=log_message)
         self._check_log_event(log_event, log_message, timestamp, 0)
 
+    def test_invalid_init(self) -> None:
+        """
+        Test the initialization of LogEvent object with invalid arguments.
+        """
+        log_message: str = " This is a test log message"
+        timestamp: int = 932724000000
+        with self.assertRaises(TypeError):
+            LogEvent(log_message)  # type: ignore
+        with self.assertRaises(TypeError):
+            LogEvent(log_message, timestamp, 0, None, None)  # type: ignore
+        with self.assertRaises(TypeError):
+            LogEvent(log_message, timestamp, log_message=log_message)  # type: ignore
+        with self.assertRaises(TypeError):
+            LogEvent(log_message, timestamp, idx=0)  # type: ignore
+        with self.assertRaises(TypeError):
+            LogEvent(log_message, str(timestamp))  # type: ignore
+        with self.assertRaises(TypeError):
+            LogEvent(log_message, timestamp, metadata=log_message)  # type: ignore
+
+    def test_init_with_embedded_nul(self) -> None:
+        """
+        Test that both the call and `__init__` keep embedded NULs in the log
+        message.
+        """
+        log_message: str = " This is a test\x00log message"
+        timestamp: int = 932724000000
+        idx: int = 14111813
+        log_event: LogEvent = LogEvent(log_message, timestamp, idx)
+        self._check_log_event(log_event, log_message, timestamp, idx)
+        log_event = LogEvent.__new__(LogEvent)
+        log_event.__init__(log_message, timestamp, idx)  # type: ignore
+        self._check_log_event(log_event, log_message, timestamp, idx)
+
     def test_formatted_message(self) -> None:
         """
         Test the reconstruction of the raw message.
@@ -108,6 +143,61 @@ class TestCaseLogEvent(TestCLPBase):
             f"Raw message: {formatted_message}; Expected: {expected_formatted_message}",
         )
 
+    def test_formatted_timestamp(self) -> None:
+        """
+        Test that the timestamps formatted natively in the metadata's timezone
+        (or UTC) match the ones formatted by `get_formatted_timestamp`.
+        """
+        log_message: str = " This is a test log message"
+        timestamps: List[int] = [
+            0,
+            -1,
+            999,
+            -1001,
+            932724000000,
+            932724000001,
+            932724000999,
+            1678604399999,
+            1678604400000,
+            1699163999999,
+            1699164000000,
+            4102444800123,
+            253402214400000,
+        ]
+        timezone_ids: List[Optional[str]] = [
+            None,
+            "UTC",
+            "America/New_York",
+            "Asia/Kathmandu",
+            "Australia/Lord_Howe",
+            "Europe/London",
+        ]
+        for timezone_id in timezone_ids:
+            metadata: Optional[Metadata] = None
+            timezone: Optional[tzinfo] = None
+            if timezone_id is not None:
+                metadata = Metadata(0, "yy/MM/dd HH:mm:ss", timezone_id)
+                timezone = metadata.get_timezone()
+            for idx, timestamp in enumerate(timestamps):
+                log_event: LogEvent = LogEvent(log_message, timestamp, idx, metadata)
+                expected_formatted_message: str = (
+                    f"{get_formatted_timestamp(timestamp, timezone)}{log_message}"
+                )
+                formatted_message: str = log_event.get_formatted_message()
+                self.assertEqual(
+                    formatted_message,
+                    expected_formatted_message,
+                    f"Timezone: {timezone_id}; Timestamp: {timestamp}",
+                )
+                # Pickling a log event formats its timestamp as well
+                log_event = LogEvent(log_message, timestamp, idx, metadata)
+                reconstructed_log_event: LogEvent = pickle.loads(pickle.dumps(log_event))
+                self.assertEqual(
+                    reconstructed_log_event.get_formatted_message(),
+                    expected_formatted_message,
+                    f"Timezone: {timezone_id}; Timestamp: {timestamp}",
+                )
+
     def test_pickle(self) -> None:
         """
         Test the reconstruction of LogEvent object from pickling data.
@@ -146,3 +236,67 @@ class TestCaseLogEvent(TestCLPBase):
             expected_formatted_message,
             f"Raw message: {formatted_message}; Expected: {expected_formatted_message}",
         )
+
+    def test_attributes(self) -> None:
+        """
+        Test the attributes of LogEvent object set through the pickling
+        interface.
+        """
+        log_event: LogEvent = LogEvent(" This is a test log message", 932724000000)
+        self.assertIsNone(log_event.get_attributes())
+
+        attributes: Dict[str, Optional[Union[str, int]]] = {
+            "pid": 1234,
+            "tag": "ActivityManager",
+            "empty": None,
+        }
+        state: Dict[str, Any] = log_event.__getstate__()
+        state["attributes"] = attributes
+        log_event = LogEvent.__new__(LogEvent)
+        log_event.__setstate__(state)
+        self.assertEqual(log_event.get_attributes(), attributes)
+
+        # The returned dict is a copy, so modifying it doesn't affect the
+        # attributes of the log event
+        returned_attributes = log_event.get_attributes()
+        self.assertIsNotNone(returned_attributes)
+        returned_attributes["pid"] = 0
+        self.assertEqual(log_event.get_attributes(), attributes)
+
+        reconstructed_log_event: LogEvent = pickle.loads(pickle.dumps(log_event))
+        self.assertEqual(reconstructed_log_event.get_attributes(), attributes)
+
+    def test_log_message_materialization(self) -> None:
+        """
+        Test that log messages are converted into Python strings without being
+        altered, and that the string is cached by the log event.
+        """
+        timestamp: int = 932724000000
+        log_messages: List[str] = [
+            " This is an ASCII log message",
+            " This is a non-ASCII log message: Grüße, 日志, \U0001F600",
+            " This log message contains an embedded NUL: \x00 and continues",
+            "",
+        ]
+        ir_stream: bytearray = FourByteEncoder.encode_preamble(
+            timestamp, "yy/MM/dd HH:mm:ss", "Asia/Hong_Kong"
+        )
+        for log_message in log_messages:
+            ir_stream += FourByteEncoder.encode_message_and_timestamp_delta(
+                0, log_message.encode()
+            )
+        ir_stream += FourByteEncoder.encode_end_of_ir()
+
+        decoder_buffer: DecoderBuffer = DecoderBuffer(BytesIO(ir_stream))
+        Decoder.decode_preamble(decoder_buffer)
+        for log_message in log_messages:
+            log_event: Optional[LogEvent] = Decoder.decode_next_log_event(decoder_buffer)
+            assert None is not log_event
+            self.assertEqual(log_message, log_event.get_log_message())
+            self.assertIs(log_event.get_log_message(), log_event.get_log_message())
+            self.assertTrue(log_event.get_formatted_message().endswith(log_message))
+            # Pickling must preserve the whole log message, including any
+            # embedded NUL
+            reconstructed_log_event: LogEvent = pickle.loads(pickle.dumps(log_event))
+            self.assertEqual(log_message, reconstructed_log_event.get_log_message())
+        self.assertIsNone(Decoder.decode_next_log_event(decoder_buffer))
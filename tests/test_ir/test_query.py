@@ -1,5 +1,6 @@
 import pickle
-from typing import List
+import re
+from typing import Any, Dict, List, Optional, Union
 
 from test_ir.test_utils import TestCLPBase
 
@@ -7,6 +8,20 @@ from clp_ffi_py.ir import (
     LogEvent,
     Query,
 )
+from clp_ffi_py.query_expression import (
+    AndExpression,
+    AttributeEquals,
+    AttributeIn,
+    AttributeIsNull,
+    AttributePredicate,
+    AttributePrefix,
+    AttributeRange,
+    NotExpression,
+    OrExpression,
+    QueryExpression,
+    TimeRange,
+)
+from clp_ffi_py.regex_query import RegexQuery
 from clp_ffi_py.wildcard_query import WildcardQuery
 
 
@@ -342,3 +357,422 @@ class TestCaseQuery(TestCLPBase):
         log_event = LogEvent("I'm finally matching something... QAQ", 3213)
         self.assertEqual(query.match_log_event(log_event), True, description)
         self.assertEqual(log_event.match_query(query), True, description)
+
+
+class TestCaseRegexQuery(TestCLPBase):
+    """
+    Class for testing clp_ffi_py.ir.Query with regex queries.
+    """
+
+    def test_init(self) -> None:
+        """
+        Test the construction of Query object with regex queries.
+        """
+        regex_queries: List[RegexQuery]
+        query: Query
+
+        query = Query(regex_queries=[])
+        self._check_regex_queries(query, None)
+
+        regex_queries = [RegexQuery(r"lord of \w+ades"), RegexQuery(r"^\d{4}-\d{2}$", True)]
+        query = Query(regex_queries=regex_queries)
+        self._check_regex_queries(query, regex_queries)
+        self.assertEqual(query.get_wildcard_queries(), None)
+
+        exception_captured: bool = False
+        try:
+            query = Query(regex_queries=[RegexQuery("(unbalanced")])
+        except RuntimeError:
+            exception_captured = True
+        self.assertEqual(exception_captured, True, "Invalid regex should fail to compile.")
+
+        # Patterns that `re` rejects, and non-ASCII patterns, which aren't
+        # supported.
+        for pattern in [r"[\d-z]", r"a**", r"^*", "caf\u00e9", r"\xe9"]:
+            exception_captured = False
+            try:
+                query = Query(regex_queries=[RegexQuery(pattern)])
+            except RuntimeError:
+                exception_captured = True
+            self.assertEqual(
+                exception_captured, True, f'Pattern "{pattern}" should fail to compile.'
+            )
+
+        exception_captured = False
+        try:
+            query = Query(regex_queries=["not a RegexQuery"])  # type: ignore
+        except TypeError:
+            exception_captured = True
+        self.assertEqual(exception_captured, True, "Regex queries must be RegexQuery objects.")
+
+    def test_pickle(self) -> None:
+        """
+        Test the reconstruction of Query object with regex queries from pickling
+        data.
+        """
+        regex_queries: List[RegexQuery] = [
+            RegexQuery(r"(?:foo|bar)+\s*baz$"),
+            RegexQuery(r"[^a-z]{2,}", True),
+        ]
+        query: Query = Query(
+            search_time_lower_bound=3190,
+            search_time_upper_bound=3270,
+            wildcard_queries=[WildcardQuery("*pleiades*")],
+            regex_queries=regex_queries,
+        )
+        reconstructed_query: Query = pickle.loads(pickle.dumps(query))
+        self._check_query(
+            reconstructed_query,
+            query.get_search_time_lower_bound(),
+            query.get_search_time_upper_bound(),
+            query.get_wildcard_queries(),
+            query.get_search_time_termination_margin(),
+        )
+        self._check_regex_queries(reconstructed_query, regex_queries)
+
+    def test_log_event_match(self) -> None:
+        """
+        Test the match between a Query object with regex queries and a LogEvent
+        object. The results are validated against Python's `re.search` with the
+        `re.ASCII` flag, including on non-ASCII messages.
+        """
+        patterns: List[str] = [
+            r"error",
+            r"^INFO",
+            r"\d+ms$",
+            r"id=[0-9a-f]{8}\s",
+            r"(?:GET|POST) /api/\w+",
+            r"a.c",
+            r"colou?r",
+            r"x{2,3}y",
+            r"[^\s]+@[^\s]+\.com",
+            r"^$",
+            r"(ab|cd)*ef",
+            r"()*x",
+            r"(^)*caf",
+            r"^.{4}$",
+            r"a.b",
+            r"[^a]b",
+            r"\W\w",
+            r"[\d-]+",
+        ]
+        messages: List[str] = [
+            "",
+            "INFO request took 1234ms",
+            "INFO request took 1234ms\n",
+            "WARN An Error occurred",
+            "error: id=deadbeef done",
+            "id=deadbeefcafe",
+            "GET /api/users",
+            "PUT /api/users",
+            "abc a\nc",
+            "The colour and the color",
+            "xxy xy xxxxy",
+            "mail pleiades@clp.com now",
+            "ababcdef",
+            "abcdeF",
+            "caf\u00e9",
+            "CAF\u00c9",
+            "a\u00e9b",
+            "\u65e5\u672cb",
+            "x\U0001f600y",
+            "1\u00df-2",
+        ]
+        for pattern in patterns:
+            for case_sensitive in [True, False]:
+                query: Query = Query(regex_queries=[RegexQuery(pattern, case_sensitive)])
+                flags: int = re.ASCII if case_sensitive else re.ASCII | re.IGNORECASE
+                for message in messages:
+                    log_event: LogEvent = LogEvent(message, 0)
+                    ref_match: bool = re.search(pattern, message, flags) is not None
+                    description: str = (
+                        f'Pattern: "{pattern}"; Case sensitive: {case_sensitive}; Message:'
+                        f' "{message}"; Expected: {ref_match}'
+                    )
+                    self.assertEqual(query.match_log_event(log_event), ref_match, description)
+                    self.assertEqual(log_event.match_query(query), ref_match, description)
+
+        description: str = (
+            "Log event whose message matches any one of the wildcard or regex queries should be"
+            " considered as a match of the query."
+        )
+        query = Query(
+            wildcard_queries=[WildcardQuery("*pleiades*")],
+            regex_queries=[RegexQuery(r"T\.T$", True)],
+        )
+        self.assertEqual(query.match_log_event(LogEvent("Hi Pleiades", 0)), True, description)
+        self.assertEqual(query.match_log_event(LogEvent("QAQ T.T", 0)), True, description)
+        self.assertEqual(query.match_log_event(LogEvent("QAQ t.t", 0)), False, description)
+
+    def _check_regex_queries(
+        self, query: Query, ref_regex_queries: Optional[List[RegexQuery]]
+    ) -> None:
+        """
+        Given a Query object, check if the stored regex queries match the input
+        references.
+
+        :param query: Input Query object to validate.
+        :param ref_regex_queries: Reference regex query list.
+        """
+        regex_queries: Optional[List[RegexQuery]] = query.get_regex_queries()
+        if ref_regex_queries is None or 0 == len(ref_regex_queries):
+            self.assertEqual(regex_queries, None, "Regex query list should be None.")
+            return
+        self.assertNotEqual(regex_queries, None, "Regex query list should not be None.")
+        assert regex_queries is not None
+        self.assertEqual(len(regex_queries), len(ref_regex_queries))
+        for regex_query, ref_regex_query in zip(regex_queries, ref_regex_queries):
+            self.assertEqual(regex_query.regex_query, ref_regex_query.regex_query)
+            self.assertEqual(regex_query.case_sensitive, ref_regex_query.case_sensitive)
+
+
+class TestCaseQueryExpression(TestCLPBase):
+    """
+    Class for testing clp_ffi_py.ir.Query with boolean query expressions.
+    """
+
+    def test_init(self) -> None:
+        """
+        Test the construction of Query object with query expressions.
+        """
+        query: Query = Query()
+        self.assertEqual(query.get_expression(), None)
+
+        expression: QueryExpression = AndExpression(
+            WildcardQuery("*pleiades*"), NotExpression(RegexQuery(r"\d+"))
+        )
+        query = Query(expression=expression)
+        self.assertIs(query.get_expression(), expression)
+
+        exception_captured: bool = False
+        try:
+            Query(expression="not an expression")  # type: ignore
+        except TypeError:
+            exception_captured = True
+        self.assertTrue(exception_captured, "Unsupported operand type should be rejected.")
+
+        exception_captured = False
+        try:
+            Query(expression=OrExpression(RegexQuery("(unbalanced")))
+        except RuntimeError:
+            exception_captured = True
+        self.assertTrue(exception_captured, "Invalid regex in an expression should be rejected.")
+
+        exception_captured = False
+        try:
+            AndExpression()
+        except ValueError:
+            exception_captured = True
+        self.assertTrue(exception_captured, "Empty AND expression should be rejected.")
+
+    def test_pickle(self) -> None:
+        """
+        Test the reconstruction of Query object with query expressions from
+        pickling data.
+        """
+        query: Query = Query(
+            expression=OrExpression(
+                WildcardQuery("*pleiades*"), TimeRange(upper_bound=1024)
+            )
+            & ~AttributeEquals("tag", "QAQ"),
+        )
+        reconstructed_query: Query = pickle.loads(pickle.dumps(query))
+        self.assertEqual(str(reconstructed_query.get_expression()), str(query.get_expression()))
+        log_events: List[LogEvent] = [
+            self._create_log_event("pleiades", 2048, {"tag": "T.T"}),
+            self._create_log_event("pleiades", 2048, {"tag": "QAQ"}),
+            self._create_log_event("whatever", 512, {"tag": None}),
+            self._create_log_event("whatever", 2048, {"tag": "T.T"}),
+        ]
+        for log_event in log_events:
+            self.assertEqual(
+                reconstructed_query.match_log_event(log_event), query.match_log_event(log_event)
+            )
+
+    def test_log_event_match(self) -> None:
+        """
+        Test the match between a Query object with query expressions and a
+        LogEvent object.
+        """
+        messages: List[str] = ["", "alpha", "beta", "alpha beta", "gamma", "alpha gamma"]
+        timestamps: List[int] = [0, 3190, 3270, 9999]
+        priorities: List[Optional[int]] = [None, 3, 5]
+        alpha: WildcardQuery = WildcardQuery("*alpha*")
+        beta: RegexQuery = RegexQuery(r"\bbeta$")
+        gamma: WildcardQuery = WildcardQuery("*GAMMA*", True)
+        in_range: TimeRange = TimeRange(3190, 3270)
+        warn: AttributeEquals = AttributeEquals("priority", 5)
+        no_priority: AttributeEquals = AttributeEquals("priority", None)
+
+        expressions: List[QueryExpression] = [
+            AndExpression(alpha),
+            AndExpression(alpha, beta),
+            OrExpression(alpha, beta),
+            NotExpression(alpha),
+            NotExpression(NotExpression(alpha)),
+            AndExpression(alpha, AndExpression(beta, NotExpression(gamma))),
+            OrExpression(AndExpression(alpha, in_range), AndExpression(beta, ~in_range)),
+            ~(OrExpression(alpha, gamma) & warn) | no_priority,
+            AndExpression(OrExpression(warn, no_priority), NotExpression(OrExpression(beta))),
+        ]
+        for expression in expressions:
+            query: Query = Query(expression=expression)
+            for message in messages:
+                for timestamp in timestamps:
+                    for priority in priorities:
+                        log_event: LogEvent = self._create_log_event(
+                            message, timestamp, {"priority": priority}
+                        )
+                        ref_match: bool = self._evaluate(expression, log_event)
+                        description: str = (
+                            f"Expression: {expression}; Log event: {log_event}; Expected:"
+                            f" {ref_match}"
+                        )
+                        self.assertEqual(query.match_log_event(log_event), ref_match, description)
+                        self.assertEqual(log_event.match_query(query), ref_match, description)
+
+        description: str = "The expression is applied on top of the other criteria."
+        query = Query(
+            search_time_lower_bound=3190,
+            search_time_upper_bound=3270,
+            wildcard_queries=[WildcardQuery("*alpha*")],
+            expression=NotExpression(RegexQuery("beta")),
+        )
+        self.assertTrue(query.match_log_event(LogEvent("alpha", 3200)), description)
+        self.assertFalse(query.match_log_event(LogEvent("alpha beta", 3200)), description)
+        self.assertFalse(query.match_log_event(LogEvent("gamma", 3200)), description)
+        self.assertFalse(query.match_log_event(LogEvent("alpha", 9999)), description)
+
+        exception_captured: bool = False
+        try:
+            Query(expression=AttributeEquals("unknown", 1)).match_log_event(LogEvent("", 0))
+        except RuntimeError:
+            exception_captured = True
+        self.assertTrue(exception_captured, "Unknown attribute names should be rejected.")
+
+    def test_attribute_predicates(self) -> None:
+        """
+        Test the match between a Query object with typed attribute predicates
+        and a LogEvent object.
+        """
+        attribute_values: List[Optional[Union[str, int]]] = [
+            None,
+            0,
+            3,
+            5,
+            7,
+            -(2**63),
+            2**63 - 1,
+            "",
+            "Net",
+            "NetworkManager",
+            "net",
+            "5",
+        ]
+        expressions: List[QueryExpression] = [
+            AttributeRange("attr", lower_bound=5),
+            AttributeRange("attr", upper_bound=5),
+            AttributeRange("attr", 3, 5),
+            AttributeRange("attr", 5, 3),
+            AttributeRange("attr"),
+            AttributeIn("attr", [3, 7, "Net"]),
+            AttributeIn("attr", [None, "5"]),
+            AttributeIn("attr", []),
+            AttributeIn("attr", (value for value in range(1000))),
+            AttributePrefix("attr", "Net"),
+            AttributePrefix("attr", ""),
+            AttributeIsNull("attr"),
+            ~AttributeIsNull("attr") & AttributeRange("attr", 0, 4),
+            AttributePrefix("attr", "Net") | AttributeIn("attr", [5, 7]),
+        ]
+        for expression in expressions:
+            query: Query = Query(expression=expression)
+            reconstructed_query: Query = pickle.loads(pickle.dumps(query))
+            for attribute_value in attribute_values:
+                log_event: LogEvent = self._create_log_event("", 0, {"attr": attribute_value})
+                ref_match: bool = self._evaluate(expression, log_event)
+                description: str = (
+                    f"Expression: {expression}; Log event: {log_event}; Expected: {ref_match}"
+                )
+                self.assertEqual(query.match_log_event(log_event), ref_match, description)
+                self.assertEqual(
+                    reconstructed_query.match_log_event(log_event), ref_match, description
+                )
+
+        exception_captured: bool = False
+        try:
+            Query(expression=AttributeIn("attr", [1.5]))
+        except TypeError:
+            exception_captured = True
+        self.assertTrue(exception_captured, "Unsupported attribute values should be rejected.")
+
+        exception_captured = False
+        try:
+            Query(expression=AttributeRange("attr", lower_bound="5"))  # type: ignore
+        except TypeError:
+            exception_captured = True
+        self.assertTrue(exception_captured, "Non-integer range bounds should be rejected.")
+
+    def _create_log_event(
+        self, log_message: str, timestamp: int, attributes: Dict[str, Optional[Union[str, int]]]
+    ) -> LogEvent:
+        """
+        Creates a log event with the given attributes through the pickling
+        interface, since attributes can't be given to the LogEvent constructor.
+
+        :param log_message: The log message.
+        :param timestamp: The timestamp.
+        :param attributes: The attributes.
+        :return: The created log event.
+        """
+        state: Dict[str, Any] = LogEvent(log_message, timestamp).__getstate__()
+        state["attributes"] = attributes
+        log_event: LogEvent = LogEvent.__new__(LogEvent)
+        log_event.__setstate__(state)
+        return log_event
+
+    def _evaluate(self, expression: object, log_event: LogEvent) -> bool:
+        """
+        Evaluates the given expression against the given log event in Python.
+
+        :param expression: The expression to evaluate.
+        :param log_event: The log event to evaluate against.
+        :return: Whether the log event matches the expression.
+        """
+        if isinstance(expression, AndExpression):
+            return all(self._evaluate(operand, log_event) for operand in expression.operands)
+        if isinstance(expression, OrExpression):
+            return any(self._evaluate(operand, log_event) for operand in expression.operands)
+        if isinstance(expression, NotExpression):
+            return not self._evaluate(expression.operand, log_event)
+        if isinstance(expression, TimeRange):
+            timestamp: int = log_event.get_timestamp()
+            lower_bound: Optional[int] = expression.lower_bound
+            upper_bound: Optional[int] = expression.upper_bound
+            return (lower_bound is None or lower_bound <= timestamp) and (
+                upper_bound is None or timestamp <= upper_bound
+            )
+        if isinstance(expression, AttributePredicate):
+            attributes: Optional[Dict[str, Optional[Union[str, int]]]] = (
+                log_event.get_attributes()
+            )
+            assert attributes is not None
+            value: Optional[Union[str, int]] = attributes[expression.name]
+            if isinstance(expression, AttributeEquals):
+                return value == expression.value
+            if isinstance(expression, AttributeRange):
+                if not isinstance(value, int):
+                    return False
+                return (expression.lower_bound is None or expression.lower_bound <= value) and (
+                    expression.upper_bound is None or value <= expression.upper_bound
+                )
+            if isinstance(expression, AttributeIn):
+                return any(
+                    type(value) is type(candidate) and value == candidate
+                    for candidate in expression.values
+                )
+            if isinstance(expression, AttributePrefix):
+                return isinstance(value, str) and value.startswith(expression.prefix)
+            if isinstance(expression, AttributeIsNull):
+                return value is None
+        return Query(expression=expression).match_log_event(log_event)  # type: ignore
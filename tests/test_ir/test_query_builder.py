@@ -7,6 +7,8 @@ from clp_ffi_py.ir import (
     QueryBuilder,
     QueryBuilderException,
 )
+from clp_ffi_py.query_expression import OrExpression, TimeRange
+from clp_ffi_py.regex_query import RegexQuery
 from clp_ffi_py.wildcard_query import WildcardQuery
 
 
@@ -194,6 +196,56 @@ class TestCaseQueryBuilder(TestCLPBase):
             0,
         )
 
+    def test_regex_queries(self) -> None:
+        """
+        Tests QueryBuilder by building Query objects with regex queries.
+        """
+        query_builder: QueryBuilder = QueryBuilder()
+        query: Query
+
+        query_builder.regex_queries.append(RegexQuery(""))
+        self.assertEqual(
+            len(query_builder.regex_queries), 0, "The regex query list should be size of 0"
+        )
+        self.assertEqual(query_builder.build().get_regex_queries(), None)
+
+        regex_queries: List[RegexQuery] = [RegexQuery(r"a+b"), RegexQuery(r"^c\d{2}$", True)]
+        query_builder.add_regex_query(regex_queries[0].regex_query)
+        query_builder.add_regex_queries(regex_queries[1:])
+        query = query_builder.build()
+        built_regex_queries: Optional[List[RegexQuery]] = query.get_regex_queries()
+        assert built_regex_queries is not None
+        self.assertEqual(len(built_regex_queries), len(regex_queries))
+        for built_regex_query, ref_regex_query in zip(built_regex_queries, regex_queries):
+            self.assertEqual(built_regex_query.regex_query, ref_regex_query.regex_query)
+            self.assertEqual(built_regex_query.case_sensitive, ref_regex_query.case_sensitive)
+
+        query_builder.reset_regex_queries()
+        self.assertEqual(query_builder.build().get_regex_queries(), None)
+
+        query_builder.add_regex_query(r"a+b")
+        query_builder.reset()
+        self.assertEqual(query_builder.build().get_regex_queries(), None)
+
+    def test_expression(self) -> None:
+        """
+        Tests QueryBuilder by building Query objects with a query expression.
+        """
+        query_builder: QueryBuilder = QueryBuilder()
+        self.assertEqual(query_builder.expression, None)
+        self.assertEqual(query_builder.build().get_expression(), None)
+
+        expression: OrExpression = OrExpression(WildcardQuery("*a*"), ~TimeRange(3190, 3270))
+        query_builder.set_expression(expression)
+        self.assertIs(query_builder.expression, expression)
+        self.assertIs(query_builder.build().get_expression(), expression)
+
+        query_builder.reset_expression()
+        self.assertEqual(query_builder.build().get_expression(), None)
+
+        query_builder.set_expression(expression).reset()
+        self.assertEqual(query_builder.build().get_expression(), None)
+
     def test_exception(self) -> None:
         """
         Tests whether QueryBuilderException is triggered as expected.
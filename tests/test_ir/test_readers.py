@@ -1,5 +1,9 @@
+import json
+import os
+import tempfile
+from io import BytesIO
 from pathlib import Path
-from typing import List, Optional, Tuple
+from typing import Any, Dict, List, Optional, Tuple
 
 from test_ir.test_decoder import (
     TestCaseDecoderBase,
@@ -12,20 +16,31 @@ from test_ir.test_utils import TestCLPBase
 from clp_ffi_py.ir import (
     ClpIrFileReader,
     ClpIrStreamReader,
+    FourByteEncoder,
     IncompleteStreamError,
     LogEvent,
     Metadata,
     Query,
+    QueryBuilder,
 )
 
 
 def read_log_stream(
-    log_path: Path, query: Optional[Query], enable_compression: bool
+    log_path: Path,
+    query: Optional[Query],
+    enable_compression: bool,
+    trusted_stream: bool = False,
+    message_intern_cache_capacity: int = 0,
 ) -> Tuple[Metadata, List[LogEvent]]:
     metadata: Metadata
     log_events: List[LogEvent] = []
     with open(str(log_path), "rb") as fin:
-        reader = ClpIrStreamReader(fin, enable_compression=enable_compression)
+        reader = ClpIrStreamReader(
+            fin,
+            enable_compression=enable_compression,
+            trusted_stream=trusted_stream,
+            message_intern_cache_capacity=message_intern_cache_capacity,
+        )
         if None is query:
             for log_event in reader:
                 log_events.append(log_event)
@@ -179,6 +194,50 @@ class TestCaseReaderTimeRangeWildcardQueryZstd(TestCaseReaderTimeRangeWildcardQu
         super().setUp()
 
 
+class TestCaseReaderTrustedStream(TestCaseReaderTimeRangeWildcardQueryBase):
+    """
+    Tests stream reader against zstd compressed IR stream with the query that
+    specifies a search timestamp and wildcard queries, with the stream marked
+    as trusted.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = True
+        self.has_query = True
+        self.num_test_iterations = 10
+        super().setUp()
+
+    # override
+    def _decode_log_stream(
+        self, log_path: Path, query: Optional[Query]
+    ) -> Tuple[Metadata, List[LogEvent]]:
+        return read_log_stream(log_path, query, self.enable_compression, trusted_stream=True)
+
+
+class TestCaseReaderMessageIntern(TestCaseReaderTimeRangeWildcardQueryBase):
+    """
+    Tests stream reader against zstd compressed IR stream with the query that
+    specifies a search timestamp and wildcard queries, with the log messages
+    interned.
+    """
+
+    # override
+    def setUp(self) -> None:
+        self.enable_compression = True
+        self.has_query = True
+        self.num_test_iterations = 10
+        super().setUp()
+
+    # override
+    def _decode_log_stream(
+        self, log_path: Path, query: Optional[Query]
+    ) -> Tuple[Metadata, List[LogEvent]]:
+        return read_log_stream(
+            log_path, query, self.enable_compression, message_intern_cache_capacity=64
+        )
+
+
 class TestIncompleteIRStream(TestCLPBase):
     """
     Tests on reading an incomplete stream.
@@ -231,3 +290,143 @@ class TestIncompleteIRStream(TestCLPBase):
         )
         self.assertFalse(other_exception_captured, "No other exception should be set.")
         self.assertTrue(None is log_event, "None is not reached.")
+
+
+class TestCaseReaderExport(TestCLPBase):
+    """
+    Tests exporting log events from a stream reader natively.
+    """
+
+    log_messages: List[str] = [
+        " This is an ASCII log message",
+        ' This log message has "quotes", a \\ and a\ttab\n',
+        " This is a non-ASCII log message: Grüße, 日志, \U0001F600",
+        " This log message contains control characters: \x00\x1f",
+        "",
+    ]
+
+    def _create_ir_stream(self) -> bytes:
+        ref_timestamp: int = 1678604399000
+        ir_stream: bytearray = FourByteEncoder.encode_preamble(
+            ref_timestamp, "yy/MM/dd HH:mm:ss", "America/New_York"
+        )
+        for log_message in TestCaseReaderExport.log_messages:
+            ir_stream += FourByteEncoder.encode_message_and_timestamp_delta(
+                500, log_message.encode()
+            )
+        ir_stream += FourByteEncoder.encode_end_of_ir()
+        return bytes(ir_stream)
+
+    def _read_log_events(self, query: Optional[Query] = None) -> List[LogEvent]:
+        reader: ClpIrStreamReader = ClpIrStreamReader(
+            BytesIO(self._create_ir_stream()), enable_compression=False
+        )
+        log_events: List[LogEvent] = list(reader if None is query else reader.search(query))
+        reader.close()
+        return log_events
+
+    def _export(self, format: str = "text", query: Optional[Query] = None) -> Tuple[int, bytes]:
+        sink: BytesIO = BytesIO()
+        reader: ClpIrStreamReader = ClpIrStreamReader(
+            BytesIO(self._create_ir_stream()), enable_compression=False
+        )
+        num_exported_log_events: int = reader.export(sink, format=format, query=query)
+        reader.close()
+        return num_exported_log_events, sink.getvalue()
+
+    def test_export_text(self) -> None:
+        """
+        Tests that the text export matches the formatted messages.
+        """
+        log_events: List[LogEvent] = self._read_log_events()
+        num_exported_log_events: int
+        exported: bytes
+        num_exported_log_events, exported = self._export()
+        self.assertEqual(len(log_events), num_exported_log_events)
+        self.assertEqual("".join(str(log_event) for log_event in log_events), exported.decode())
+
+    def test_export_json_lines(self) -> None:
+        """
+        Tests that each exported JSON line matches the state of the log event.
+        """
+        log_events: List[LogEvent] = self._read_log_events()
+        num_exported_log_events: int
+        exported: bytes
+        num_exported_log_events, exported = self._export("jsonl")
+        self.assertEqual(len(log_events), num_exported_log_events)
+        lines: List[bytes] = exported.splitlines()
+        self.assertEqual(len(log_events), len(lines))
+        for log_event, line in zip(log_events, lines):
+            exported_state: Dict[str, Any] = json.loads(line)
+            state: Dict[str, Any] = log_event.__getstate__()
+            self.assertEqual(state["log_message"], exported_state["log_message"])
+            self.assertEqual(state["timestamp"], exported_state["timestamp"])
+            self.assertEqual(state["formatted_timestamp"], exported_state["formatted_timestamp"])
+            self.assertEqual(state["index"], exported_state["index"])
+            self.assertIsNone(exported_state["attributes"])
+
+    def test_export_json_lines_invalid_utf8(self) -> None:
+        """
+        Tests that a log message that isn't valid UTF-8 is exported as a valid
+        JSON line, with its invalid sequences replaced by U+FFFD.
+        """
+        invalid_log_message: bytes = b" Invalid \xff UTF-8 \xe6\x97 message\n"
+        ir_stream: bytearray = FourByteEncoder.encode_preamble(
+            1678604399000, "yy/MM/dd HH:mm:ss", "America/New_York"
+        )
+        ir_stream += FourByteEncoder.encode_message_and_timestamp_delta(500, invalid_log_message)
+        ir_stream += FourByteEncoder.encode_end_of_ir()
+
+        sink: BytesIO = BytesIO()
+        reader: ClpIrStreamReader = ClpIrStreamReader(
+            BytesIO(bytes(ir_stream)), enable_compression=False
+        )
+        self.assertEqual(1, reader.export(sink, format="jsonl"))
+        reader.close()
+        exported_state: Dict[str, Any] = json.loads(sink.getvalue().decode())
+        self.assertEqual(
+            invalid_log_message.decode(errors="replace"), exported_state["log_message"]
+        )
+
+    def test_export_with_query(self) -> None:
+        """
+        Tests that only the log events matching the query are exported.
+        """
+        query: Query = QueryBuilder().add_wildcard_query("*non-ASCII*").build()
+        log_events: List[LogEvent] = self._read_log_events(query)
+        self.assertEqual(1, len(log_events))
+        num_exported_log_events: int
+        exported: bytes
+        num_exported_log_events, exported = self._export(query=query)
+        self.assertEqual(1, num_exported_log_events)
+        self.assertEqual(str(log_events[0]), exported.decode())
+
+    def test_export_to_file_descriptor(self) -> None:
+        """
+        Tests exporting log events to a file descriptor.
+        """
+        log_events: List[LogEvent] = self._read_log_events()
+        with tempfile.TemporaryFile() as temp_file:
+            reader: ClpIrStreamReader = ClpIrStreamReader(
+                BytesIO(self._create_ir_stream()), enable_compression=False
+            )
+            self.assertEqual(len(log_events), reader.export(temp_file.fileno()))
+            reader.close()
+            os.lseek(temp_file.fileno(), 0, os.SEEK_SET)
+            exported: bytes = temp_file.read()
+        self.assertEqual("".join(str(log_event) for log_event in log_events), exported.decode())
+
+    def test_invalid_export(self) -> None:
+        """
+        Tests exporting log events with invalid arguments.
+        """
+        reader: ClpIrStreamReader = ClpIrStreamReader(
+            BytesIO(self._create_ir_stream()), enable_compression=False
+        )
+        with self.assertRaises(ValueError):
+            reader.export(BytesIO(), format="csv")
+        with self.assertRaises(ValueError):
+            reader.export(-1)
+        with self.assertRaises(TypeError):
+            reader.export("sink")  # type: ignore
+        reader.close()